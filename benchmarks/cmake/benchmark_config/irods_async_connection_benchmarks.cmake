@@ -0,0 +1,26 @@
+# Measures the client side of the server. Requires a running server and an authenticated
+# client environment, so it is only run by the run_benchmarks target when
+# IRODS_BENCHMARKS_RUN_SERVER_BENCHMARKS is set.
+set(IRODS_BENCHMARK_TARGET irods_async_connection_benchmarks)
+
+set(IRODS_BENCHMARK_REQUIRES_SERVER YES)
+
+set(IRODS_BENCHMARK_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_async_connection.cpp)
+
+set(IRODS_BENCHMARK_INCLUDE_PATH ${CMAKE_CURRENT_SOURCE_DIR}/include
+                                 ${CMAKE_BINARY_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/api/include
+                                 ${CMAKE_SOURCE_DIR}/server/core/include
+                                 ${CMAKE_SOURCE_DIR}/server/icat/include
+                                 ${IRODS_EXTERNALS_FULLPATH_BOOST}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_JSON}/include)
+
+set(IRODS_BENCHMARK_LINK_LIBRARIES irods_common
+                                   irods_client)
+
+set(IRODS_BENCHMARK_COMPILE_DEFINITIONS ${IRODS_COMPILE_DEFINITIONS})
+
+set(IRODS_BENCHMARK_COMPILE_OPTIONS)
@@ -0,0 +1,35 @@
+set(IRODS_BENCHMARK_TARGET irods_core_benchmarks)
+
+set(IRODS_BENCHMARK_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_buffer_encryption.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_dstream.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_hasher.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_hierarchy_parser.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_key_value_proxy.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_packstruct.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_rule_execution_context.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_transfer_compression.cpp)
+
+set(IRODS_BENCHMARK_INCLUDE_PATH ${CMAKE_CURRENT_SOURCE_DIR}/include
+                                 ${CMAKE_BINARY_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/api/include
+                                 ${CMAKE_SOURCE_DIR}/lib/filesystem/include
+                                 ${CMAKE_SOURCE_DIR}/lib/hasher/include
+                                 ${CMAKE_SOURCE_DIR}/server/core/include
+                                 ${CMAKE_SOURCE_DIR}/server/re/include
+                                 ${IRODS_EXTERNALS_FULLPATH_BOOST}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_FMT}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_JSON}/include
+                                 ${OPENSSL_INCLUDE_DIR})
+
+set(IRODS_BENCHMARK_LINK_LIBRARIES irods_common
+                                   irods_plugin_dependencies
+                                   irods_server
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_filesystem.so
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_system.so
+                                   ${IRODS_EXTERNALS_FULLPATH_FMT}/lib/libfmt.so
+                                   ${OPENSSL_CRYPTO_LIBRARY})
+
+set(IRODS_BENCHMARK_COMPILE_DEFINITIONS ${IRODS_COMPILE_DEFINITIONS})
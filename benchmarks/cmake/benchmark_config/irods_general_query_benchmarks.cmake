@@ -0,0 +1,33 @@
+# Compiles the general query translation units of the database plugin directly. The
+# routines that talk to the database are replaced by src/mock_catalog.cpp.
+set(IRODS_BENCHMARK_TARGET irods_general_query_benchmarks)
+
+set(IRODS_BENCHMARK_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_general_query.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/mock_catalog.cpp
+                                 ${CMAKE_SOURCE_DIR}/plugins/database/src/general_query.cpp
+                                 ${CMAKE_SOURCE_DIR}/plugins/database/src/general_query_setup.cpp)
+
+set(IRODS_BENCHMARK_INCLUDE_PATH ${CMAKE_CURRENT_SOURCE_DIR}/include
+                                 ${CMAKE_BINARY_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/api/include
+                                 ${CMAKE_SOURCE_DIR}/lib/hasher/include
+                                 ${CMAKE_SOURCE_DIR}/server/core/include
+                                 ${CMAKE_SOURCE_DIR}/server/icat/include
+                                 ${CMAKE_SOURCE_DIR}/server/re/include
+                                 ${CMAKE_SOURCE_DIR}/plugins/database/include
+                                 ${IRODS_EXTERNALS_FULLPATH_BOOST}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_FMT}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_JSON}/include)
+
+set(IRODS_BENCHMARK_LINK_LIBRARIES irods_server
+                                   irods_plugin_dependencies
+                                   irods_common
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_filesystem.so
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_system.so
+                                   ${IRODS_EXTERNALS_FULLPATH_FMT}/lib/libfmt.so)
+
+set(IRODS_BENCHMARK_COMPILE_DEFINITIONS ENABLE_RE ${IRODS_COMPILE_DEFINITIONS})
+set(IRODS_BENCHMARK_COMPILE_OPTIONS -Wno-write-strings)
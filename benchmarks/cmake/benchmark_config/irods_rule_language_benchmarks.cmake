@@ -0,0 +1,57 @@
+# Compiles the sources of the iRODS Rule Language rule engine plugin, except for its entry
+# point. The globals defined by the entry point are provided by src/mock_rule_engine.cpp.
+set(IRODS_BENCHMARK_TARGET irods_rule_language_benchmarks)
+
+set(IRODS_RULE_LANGUAGE_SOURCE_DIR ${CMAKE_SOURCE_DIR}/plugins/rule_engines/irods_rule_engine_plugin-irods_rule_language)
+
+set(IRODS_BENCHMARK_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/bench_rule_language.cpp
+                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/mock_rule_engine.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/arithmetics.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/cache.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/configuration.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/conversion.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/datetime.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/filesystem.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/msiHelper.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/index.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/nre.reHelpers1.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/nre.reHelpers2.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/nre.reLib1.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/parser.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/reVariableMap.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/reVariableMap.gen.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/restructs.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/rules.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/typing.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/utils.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/rsRe.cpp
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/functions.cpp)
+
+set(IRODS_BENCHMARK_INCLUDE_PATH ${CMAKE_CURRENT_SOURCE_DIR}/include
+                                 ${CMAKE_BINARY_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/api/include
+                                 ${CMAKE_SOURCE_DIR}/lib/core/include
+                                 ${CMAKE_SOURCE_DIR}/lib/hasher/include
+                                 ${IRODS_RULE_LANGUAGE_SOURCE_DIR}/include
+                                 ${CMAKE_SOURCE_DIR}/server/api/include
+                                 ${CMAKE_SOURCE_DIR}/server/core/include
+                                 ${CMAKE_SOURCE_DIR}/server/drivers/include
+                                 ${CMAKE_SOURCE_DIR}/server/icat/include
+                                 ${CMAKE_SOURCE_DIR}/server/re/include
+                                 ${IRODS_EXTERNALS_FULLPATH_BOOST}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_CATCH2}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_FMT}/include
+                                 ${IRODS_EXTERNALS_FULLPATH_JSON}/include
+                                 ${OPENSSL_INCLUDE_DIR})
+
+set(IRODS_BENCHMARK_LINK_LIBRARIES irods_server
+                                   irods_common
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_filesystem.so
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_system.so
+                                   ${IRODS_EXTERNALS_FULLPATH_BOOST}/lib/libboost_regex.so
+                                   ${IRODS_EXTERNALS_FULLPATH_FMT}/lib/libfmt.so
+                                   dl)
+
+set(IRODS_BENCHMARK_COMPILE_DEFINITIONS ${IRODS_COMPILE_DEFINITIONS})
+set(IRODS_BENCHMARK_COMPILE_OPTIONS -Wno-write-strings)
@@ -0,0 +1,14 @@
+# utils.cmake
+# ~~~~~~~~~~~
+# Defines helper functions and other utilities for benchmarking.
+
+# A macro rather than a function so that the variables are unset in the caller's scope.
+macro(unset_irods_benchmark_variables)
+    unset(IRODS_BENCHMARK_TARGET)
+    unset(IRODS_BENCHMARK_SOURCE_FILES)
+    unset(IRODS_BENCHMARK_INCLUDE_PATH)
+    unset(IRODS_BENCHMARK_LINK_LIBRARIES)
+    unset(IRODS_BENCHMARK_COMPILE_DEFINITIONS)
+    unset(IRODS_BENCHMARK_COMPILE_OPTIONS)
+    unset(IRODS_BENCHMARK_REQUIRES_SERVER)
+endmacro()
@@ -0,0 +1,136 @@
+#ifndef IRODS_BENCHMARKS_BENCHMARK_HPP
+#define IRODS_BENCHMARKS_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace irods::benchmarks
+{
+    /// The measurements of a single benchmark.
+    ///
+    /// Times are per iteration, in nanoseconds.
+    struct result
+    {
+        std::string name;
+        std::int64_t iterations;
+        std::int64_t samples;
+        double real_time;
+        double cpu_time;
+        double min_time;
+        double max_time;
+        double stddev;
+        std::int64_t bytes_per_iteration;
+    }; // struct result
+
+    /// Options controlling how long each benchmark runs. Set from the command line.
+    struct options
+    {
+        std::chrono::milliseconds min_time{500};
+        std::int64_t samples{10};
+    }; // struct options
+
+    /// Returns the options used by run().
+    auto get_options() noexcept -> options&;
+
+    /// Returns the results of every benchmark run so far, in the order they were run.
+    auto get_results() noexcept -> std::vector<result>&;
+
+    /// Records a result and prints it to stdout.
+    auto report(result _result) -> const result&;
+
+    /// Prevents the compiler from optimizing away the computation of \p _value.
+    template <typename T>
+    inline auto do_not_optimize(const T& _value) -> void
+    {
+        asm volatile("" : : "r,m"(_value) : "memory");
+    }
+
+    /// Measures \p _func and records the result under \p _name.
+    ///
+    /// \p _func is first invoked repeatedly to find an iteration count that makes a sample last
+    /// about min_time / samples. The time per iteration is then measured over \p samples such
+    /// batches. Each call to \p _func counts as one iteration.
+    ///
+    /// \param[in] _name                The name of the benchmark (e.g. "packStruct/DataObjInp_PI/xml").
+    /// \param[in] _func                The operation to measure.
+    /// \param[in] _bytes_per_iteration The number of bytes processed by each call, or zero.
+    ///
+    /// \return The recorded result.
+    template <typename Function>
+    auto run(const std::string& _name, Function&& _func, std::int64_t _bytes_per_iteration = 0) -> const result&
+    {
+        using clock_type = std::chrono::steady_clock;
+        using nanoseconds = std::chrono::duration<double, std::nano>;
+
+        const auto& opts = get_options();
+        const auto target = std::chrono::duration_cast<nanoseconds>(opts.min_time) / opts.samples;
+
+        // Warm up and find the number of iterations per sample.
+        std::int64_t iterations = 1;
+
+        while (true) {
+            const auto start = clock_type::now();
+
+            for (std::int64_t i = 0; i < iterations; ++i) {
+                _func();
+            }
+
+            const nanoseconds elapsed = clock_type::now() - start;
+
+            if (elapsed >= target || iterations >= (std::int64_t{1} << 40)) {
+                break;
+            }
+
+            // Aim slightly above the target so the next attempt usually succeeds.
+            const auto factor = elapsed.count() > 0 ? 1.2 * target / elapsed : 10.0;
+            iterations = std::max(iterations + 1, static_cast<std::int64_t>(iterations * std::min(factor, 10.0)));
+        }
+
+        std::vector<double> times;
+        times.reserve(opts.samples);
+
+        std::clock_t cpu_total{};
+
+        for (std::int64_t s = 0; s < opts.samples; ++s) {
+            const auto cpu_start = std::clock();
+            const auto start = clock_type::now();
+
+            for (std::int64_t i = 0; i < iterations; ++i) {
+                _func();
+            }
+
+            const nanoseconds elapsed = clock_type::now() - start;
+            cpu_total += std::clock() - cpu_start;
+
+            times.push_back(elapsed.count() / iterations);
+        }
+
+        result r{};
+        r.name = _name;
+        r.iterations = iterations * opts.samples;
+        r.samples = opts.samples;
+        r.cpu_time = 1e9 * cpu_total / CLOCKS_PER_SEC / r.iterations;
+        r.min_time = *std::min_element(std::begin(times), std::end(times));
+        r.max_time = *std::max_element(std::begin(times), std::end(times));
+        r.bytes_per_iteration = _bytes_per_iteration;
+
+        for (auto t : times) {
+            r.real_time += t / times.size();
+        }
+
+        for (auto t : times) {
+            r.stddev += (t - r.real_time) * (t - r.real_time) / times.size();
+        }
+
+        r.stddev = std::sqrt(r.stddev);
+
+        return report(std::move(r));
+    }
+} // namespace irods::benchmarks
+
+#endif // IRODS_BENCHMARKS_BENCHMARK_HPP
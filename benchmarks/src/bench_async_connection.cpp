@@ -0,0 +1,99 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "async_connection.hpp"
+#include "getRodsEnv.h"
+#include "obf.h"
+#include "rcMisc.h"
+#include "rodsClient.h"
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/yield.hpp>
+
+namespace bm = irods::benchmarks;
+namespace ix = irods::experimental;
+
+namespace
+{
+    // Connects, logs in and stats a path a number of times, one operation after the other.
+    struct stat_session : boost::asio::coroutine
+    {
+        ix::async_connection* conn;
+        const rodsEnv* env;
+        const std::string* password;
+        std::string path;
+        int iterations;
+        int* completed;
+        int* failed;
+
+        void operator()(int _status = 0, rodsObjStat_t* _stat = nullptr)
+        {
+            if (_stat) {
+                freeRodsObjStat(_stat);
+            }
+
+            if (_status < 0) {
+                ++*failed;
+                return;
+            }
+
+            reenter (this) {
+                yield conn->async_connect(env->rodsHost, env->rodsPort, env->rodsUserName, env->rodsZone, *this);
+                yield conn->async_login(*password, *this);
+
+                while (iterations-- > 0) {
+                    yield conn->async_stat(path, *this);
+                    ++*completed;
+                }
+
+                yield conn->async_disconnect(*this);
+            }
+        }
+    }; // struct stat_session
+} // anonymous namespace
+
+// Requires a running server and an authenticated client environment (see iinit).
+TEST_CASE("async_connection")
+{
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    char password[MAX_PASSWORD_LEN + 2]{};
+    obfGetPw(password);
+    const std::string pw = password;
+
+    // Each iteration drives every session from a single thread until all of its stats complete.
+    constexpr int stats_per_session = 10;
+
+    for (const int session_count : {1, 16, 64, 256}) {
+        int failed = 0;
+
+        bm::run("async_connection/stat/" + std::to_string(session_count), [&] {
+            boost::asio::io_context io_context;
+            std::vector<std::unique_ptr<ix::async_connection>> conns;
+            int completed = 0;
+
+            for (int i = 0; i < session_count; ++i) {
+                conns.push_back(std::make_unique<ix::async_connection>(io_context));
+                stat_session{{}, conns.back().get(), &env, &pw, env.rodsHome, stats_per_session, &completed, &failed}();
+            }
+
+            io_context.run();
+
+            bm::do_not_optimize(completed);
+        });
+
+        REQUIRE(failed == 0);
+    }
+}
+
+#include <boost/asio/unyield.hpp>
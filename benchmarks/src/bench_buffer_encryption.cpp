@@ -0,0 +1,48 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "irods_buffer_encryption.hpp"
+
+namespace bm = irods::benchmarks;
+
+TEST_CASE("buffer_crypt")
+{
+    // The values of a typical irods_environment.json.
+    constexpr int key_size = 32;
+    constexpr int salt_size = 8;
+    constexpr int hash_rounds = 16;
+
+    irods::buffer_crypt crypt{key_size, salt_size, hash_rounds, "AES-256-CBC"};
+
+    irods::buffer_crypt::array_t key;
+    REQUIRE(irods::buffer_crypt::generate_key(key, key_size).ok());
+
+    irods::buffer_crypt::array_t iv;
+    REQUIRE(crypt.initialization_vector(iv).ok());
+
+    bm::run("buffer_crypt/generate_key", [&] {
+        irods::buffer_crypt::array_t k;
+        irods::buffer_crypt::generate_key(k, key_size);
+        bm::do_not_optimize(k);
+    });
+
+    for (const auto size : {4 * 1024, 4 * 1024 * 1024}) {
+        const irods::buffer_crypt::array_t plaintext(size, 'x');
+
+        irods::buffer_crypt::array_t ciphertext;
+        REQUIRE(crypt.encrypt(key, iv, plaintext, ciphertext).ok());
+
+        bm::run("buffer_crypt/encrypt/" + std::to_string(size), [&] {
+            irods::buffer_crypt::array_t out;
+            crypt.encrypt(key, iv, plaintext, out);
+            bm::do_not_optimize(out);
+        }, size);
+
+        bm::run("buffer_crypt/decrypt/" + std::to_string(size), [&] {
+            irods::buffer_crypt::array_t out;
+            crypt.decrypt(key, iv, ciphertext, out);
+            bm::do_not_optimize(out);
+        }, size);
+    }
+}
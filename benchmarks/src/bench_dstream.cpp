@@ -0,0 +1,181 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "dstream.hpp"
+#include "transport/transport.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace bm = irods::benchmarks;
+namespace io = irods::experimental::io;
+
+namespace
+{
+    // A transport backed by memory. Isolates the cost of the stream buffer from the network
+    // and the server.
+    class memory_transport final : public io::transport<char>
+    {
+    public:
+        explicit memory_transport(std::vector<char>& _storage)
+            : storage_{_storage}
+        {
+        }
+
+        bool open(const irods::experimental::filesystem::path&, std::ios_base::openmode _mode) override
+        {
+            if (_mode & std::ios_base::trunc) {
+                storage_.clear();
+            }
+
+            position_ = 0;
+            open_ = true;
+            return true;
+        }
+
+        bool open(const irods::experimental::filesystem::path& _p, const io::replica_number&, std::ios_base::openmode _m) override
+        {
+            return open(_p, _m);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _p, const io::root_resource_name&, std::ios_base::openmode _m) override
+        {
+            return open(_p, _m);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _p, const io::leaf_resource_name&, std::ios_base::openmode _m) override
+        {
+            return open(_p, _m);
+        }
+
+        bool open(const io::replica_token&,
+                  const irods::experimental::filesystem::path& _p,
+                  const io::replica_number&,
+                  std::ios_base::openmode _m) override
+        {
+            return open(_p, _m);
+        }
+
+        bool open(const io::replica_token&,
+                  const irods::experimental::filesystem::path& _p,
+                  const io::leaf_resource_name&,
+                  std::ios_base::openmode _m) override
+        {
+            return open(_p, _m);
+        }
+
+        bool close(const io::on_close_success* = nullptr) override
+        {
+            open_ = false;
+            return true;
+        }
+
+        std::streamsize receive(char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            const auto count = std::min<std::streamsize>(_buffer_size, storage_.size() - position_);
+            std::memcpy(_buffer, storage_.data() + position_, count);
+            position_ += count;
+            return count;
+        }
+
+        std::streamsize send(const char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            if (position_ + _buffer_size > static_cast<std::streamsize>(storage_.size())) {
+                storage_.resize(position_ + _buffer_size);
+            }
+
+            std::memcpy(storage_.data() + position_, _buffer, _buffer_size);
+            position_ += _buffer_size;
+            return _buffer_size;
+        }
+
+        pos_type seekpos(off_type _offset, std::ios_base::seekdir _dir) override
+        {
+            switch (_dir) {
+                case std::ios_base::beg: position_ = _offset; break;
+                case std::ios_base::cur: position_ += _offset; break;
+                case std::ios_base::end: position_ = storage_.size() + _offset; break;
+                default: return pos_type{off_type{-1}};
+            }
+
+            return position_;
+        }
+
+        bool is_open() const noexcept override
+        {
+            return open_;
+        }
+
+        int file_descriptor() const noexcept override
+        {
+            return 3;
+        }
+
+        const io::root_resource_name& root_resource_name() const override
+        {
+            return root_resource_name_;
+        }
+
+        const io::leaf_resource_name& leaf_resource_name() const override
+        {
+            return leaf_resource_name_;
+        }
+
+        const io::replica_number& replica_number() const override
+        {
+            return replica_number_;
+        }
+
+        const io::replica_token& replica_token() const override
+        {
+            return replica_token_;
+        }
+
+    private:
+        std::vector<char>& storage_;
+        std::streamsize position_ = 0;
+        bool open_ = false;
+        io::root_resource_name root_resource_name_{"demoResc"};
+        io::leaf_resource_name leaf_resource_name_{"demoResc"};
+        io::replica_number replica_number_{0};
+        io::replica_token replica_token_{};
+    }; // class memory_transport
+} // anonymous namespace
+
+TEST_CASE("dstream")
+{
+    constexpr std::streamsize total_size = 16 * 1024 * 1024;
+
+    std::vector<char> storage;
+    storage.reserve(total_size);
+
+    memory_transport tp{storage};
+    const auto* path = "/tempZone/home/rods/benchmarks/dstream.bin";
+
+    // Small writes go through the 4 KiB stream buffer; large writes bypass it.
+    for (const std::streamsize write_size : {64, 4 * 1024, 1024 * 1024}) {
+        const std::vector<char> data(write_size, 'x');
+
+        bm::run("dstream/write/" + std::to_string(write_size), [&] {
+            io::odstream out{tp, path, std::ios_base::out | std::ios_base::trunc};
+
+            for (std::streamsize written = 0; written < total_size; written += write_size) {
+                out.write(data.data(), write_size);
+            }
+        }, total_size);
+    }
+
+    for (const std::streamsize read_size : {64, 4 * 1024, 1024 * 1024}) {
+        std::vector<char> data(read_size);
+
+        bm::run("dstream/read/" + std::to_string(read_size), [&] {
+            io::idstream in{tp, path};
+
+            while (in.read(data.data(), read_size)) {
+                bm::do_not_optimize(data.data());
+            }
+        }, total_size);
+    }
+}
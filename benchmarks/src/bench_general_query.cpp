@@ -0,0 +1,184 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "irods_at_scope_exit.hpp"
+#include "low_level_odbc.hpp"
+#include "rcMisc.h"
+#include "rodsGenQuery.h"
+
+#include <string>
+#include <vector>
+
+// Defined by the database plugin (see general_query.cpp).
+int generateSQL(genQueryInp_t genQueryInp, char* resultingSQL, char* resultingCountSQL);
+void clearGenQuerySqlTemplateCache();
+void clearGenQueryJoinPathCache();
+
+namespace bm = irods::benchmarks;
+
+namespace
+{
+    struct generated_sql
+    {
+        std::string sql;
+        std::vector<std::string> bind_values;
+
+        auto operator==(const generated_sql& _other) const -> bool
+        {
+            return sql == _other.sql && bind_values == _other.bind_values;
+        }
+    };
+
+    auto generate(const genQueryInp_t& _input) -> generated_sql
+    {
+        std::vector<char> sql(MAX_SQL_SIZE_GENERAL_QUERY);
+        std::vector<char> count_sql(MAX_SQL_SIZE_GENERAL_QUERY);
+
+        cllBindVarCount = 0;
+        REQUIRE(generateSQL(_input, sql.data(), count_sql.data()) >= 0);
+
+        generated_sql result{sql.data(), {}};
+        for (int i = 0; i < cllBindVarCount; ++i) {
+            result.bind_values.emplace_back(cllBindVars[i]);
+        }
+        cllBindVarCount = 0;
+
+        return result;
+    }
+
+    // Returns a copy of _input whose quoted condition values are different.
+    auto with_other_values(const genQueryInp_t& _input) -> genQueryInp_t
+    {
+        genQueryInp_t copy{};
+
+        for (int i = 0; i < _input.selectInp.len; ++i) {
+            addInxIval(&copy.selectInp, _input.selectInp.inx[i], _input.selectInp.value[i]);
+        }
+
+        for (int i = 0; i < _input.sqlCondInp.len; ++i) {
+            std::string condition = _input.sqlCondInp.value[i];
+            if (const auto last_quote = condition.rfind('\''); last_quote != std::string::npos) {
+                condition.insert(last_quote, "_other");
+            }
+            addInxVal(&copy.sqlCondInp, _input.sqlCondInp.inx[i], condition.c_str());
+        }
+
+        copy.maxRows = _input.maxRows;
+
+        return copy;
+    }
+
+    // Measures the translation of a general query into SQL. No database is involved.
+    //
+    // generateSQL remembers the join paths it computes and the SQL of the queries it has seen
+    // before. The query is measured with neither, with the join paths only, and with both.
+    auto run_generate_sql(const std::string& _name, genQueryInp_t& _input) -> void
+    {
+        // The remembered SQL must match the SQL generated from scratch, including for other
+        // condition values.
+        clearGenQueryJoinPathCache();
+        clearGenQuerySqlTemplateCache();
+        const auto uncached = generate(_input);
+        REQUIRE(generate(_input) == uncached);
+
+        genQueryInp_t other = with_other_values(_input);
+        irods::at_scope_exit clear_other{[&other] { clearGenQueryInp(&other); }};
+        const auto other_cached = generate(other);
+        clearGenQueryJoinPathCache();
+        clearGenQuerySqlTemplateCache();
+        REQUIRE(generate(other) == other_cached);
+        REQUIRE(other_cached.sql == uncached.sql);
+        REQUIRE(other_cached.bind_values != uncached.bind_values);
+
+        std::vector<char> sql(MAX_SQL_SIZE_GENERAL_QUERY);
+        std::vector<char> count_sql(MAX_SQL_SIZE_GENERAL_QUERY);
+
+        bm::run("generateSQL/" + _name + "/uncached", [&] {
+            clearGenQueryJoinPathCache();
+            clearGenQuerySqlTemplateCache();
+            generateSQL(_input, sql.data(), count_sql.data());
+            bm::do_not_optimize(sql.data());
+
+            // Each call appends its condition values to the bind variables.
+            cllBindVarCount = 0;
+        });
+
+        bm::run("generateSQL/" + _name + "/join_paths_cached", [&] {
+            clearGenQuerySqlTemplateCache();
+            generateSQL(_input, sql.data(), count_sql.data());
+            bm::do_not_optimize(sql.data());
+            cllBindVarCount = 0;
+        });
+
+        bm::run("generateSQL/" + _name + "/sql_cached", [&] {
+            generateSQL(_input, sql.data(), count_sql.data());
+            bm::do_not_optimize(sql.data());
+            cllBindVarCount = 0;
+        });
+    }
+} // anonymous namespace
+
+TEST_CASE("general query")
+{
+    SECTION("data objects in a collection")
+    {
+        genQueryInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_SIZE, 1);
+        addInxIval(&input.selectInp, COL_D_MODIFY_TIME, 1);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, "= '/tempZone/home/rods'");
+        input.maxRows = MAX_SQL_ROWS;
+
+        run_generate_sql("data_objects_in_collection", input);
+    }
+
+    SECTION("replicas and resources")
+    {
+        genQueryInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+        addInxIval(&input.selectInp, COL_COLL_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_REPL_NUM, 1);
+        addInxIval(&input.selectInp, COL_D_RESC_ID, 1);
+        addInxIval(&input.selectInp, COL_D_DATA_PATH, 1);
+        addInxIval(&input.selectInp, COL_D_REPL_STATUS, 1);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, "like '/tempZone/home/rods/%'");
+        addInxVal(&input.sqlCondInp, COL_R_RESC_NAME, "= 'demoResc'");
+        input.maxRows = MAX_SQL_ROWS;
+
+        run_generate_sql("replicas_and_resources", input);
+    }
+
+    SECTION("metadata attached to data objects")
+    {
+        genQueryInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+        addInxIval(&input.selectInp, COL_COLL_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_META_DATA_ATTR_VALUE, 1);
+        addInxVal(&input.sqlCondInp, COL_META_DATA_ATTR_NAME, "= 'experiment'");
+        addInxVal(&input.sqlCondInp, COL_META_DATA_ATTR_VALUE, "like 'run_%'");
+        input.maxRows = MAX_SQL_ROWS;
+
+        run_generate_sql("data_object_metadata", input);
+    }
+
+    SECTION("aggregate")
+    {
+        genQueryInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+        addInxIval(&input.selectInp, COL_R_RESC_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_SIZE, SELECT_SUM);
+        addInxIval(&input.selectInp, COL_D_DATA_ID, SELECT_COUNT);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, "like '/tempZone/%'");
+        input.maxRows = MAX_SQL_ROWS;
+
+        run_generate_sql("aggregate", input);
+    }
+}
@@ -0,0 +1,35 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "irods_hasher_factory.hpp"
+#include "ADLER32Strategy.hpp"
+#include "MD5Strategy.hpp"
+#include "SHA1Strategy.hpp"
+#include "SHA256Strategy.hpp"
+#include "SHA512Strategy.hpp"
+
+#include <string>
+
+namespace bm = irods::benchmarks;
+
+TEST_CASE("Hasher")
+{
+    // Checksums are computed over buffers of the size used by the transfer code paths.
+    const std::string small(4 * 1024, 'x');
+    const std::string large(4 * 1024 * 1024, 'x');
+
+    for (const auto* name : {&irods::MD5_NAME, &irods::SHA1_NAME, &irods::SHA256_NAME, &irods::SHA512_NAME, &irods::ADLER32_NAME}) {
+        for (const auto* buffer : {&small, &large}) {
+            bm::run("Hasher/" + *name + "/" + std::to_string(buffer->size()), [&] {
+                irods::Hasher hasher;
+                irods::getHasher(*name, hasher);
+                hasher.update(*buffer);
+
+                std::string digest;
+                hasher.digest(digest);
+                bm::do_not_optimize(digest);
+            }, buffer->size());
+        }
+    }
+}
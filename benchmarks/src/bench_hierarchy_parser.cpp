@@ -0,0 +1,48 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "irods_hierarchy_parser.hpp"
+
+#include <string>
+
+namespace bm = irods::benchmarks;
+
+TEST_CASE("hierarchy_parser")
+{
+    const std::string hierarchy = "root_resc;passthru_resc;replication_resc;compound_resc;archive_resc";
+
+    bm::run("hierarchy_parser/set_string", [&] {
+        irods::hierarchy_parser parser;
+        parser.set_string(hierarchy);
+        bm::do_not_optimize(parser);
+    });
+
+    irods::hierarchy_parser parser{hierarchy};
+
+    bm::run("hierarchy_parser/str", [&] {
+        bm::do_not_optimize(parser.str());
+    });
+
+    bm::run("hierarchy_parser/first_resc", [&] {
+        bm::do_not_optimize(parser.first_resc());
+    });
+
+    bm::run("hierarchy_parser/last_resc", [&] {
+        bm::do_not_optimize(parser.last_resc());
+    });
+
+    bm::run("hierarchy_parser/num_levels", [&] {
+        bm::do_not_optimize(parser.num_levels());
+    });
+
+    bm::run("hierarchy_parser/contains", [&] {
+        bm::do_not_optimize(parser.contains("archive_resc"));
+    });
+
+    bm::run("hierarchy_parser/add_child", [&] {
+        irods::hierarchy_parser p{parser};
+        p.add_child("leaf_resc");
+        bm::do_not_optimize(p);
+    });
+}
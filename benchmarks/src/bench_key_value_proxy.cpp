@@ -0,0 +1,45 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "irods_at_scope_exit.hpp"
+#include "key_value_proxy.hpp"
+#include "rcMisc.h"
+
+#include <string>
+
+namespace bm = irods::benchmarks;
+namespace ix = irods::experimental;
+
+TEST_CASE("key_value_proxy")
+{
+    // Requests usually carry a handful of keywords.
+    keyValPair_t kvp{};
+    irods::at_scope_exit clear_kvp{[&kvp] { clearKeyVal(&kvp); }};
+
+    for (int i = 0; i < 16; ++i) {
+        addKeyVal(&kvp, ("keyword_" + std::to_string(i)).data(), ("value_" + std::to_string(i)).data());
+    }
+
+    auto proxy = ix::make_key_value_proxy(kvp);
+
+    bm::run("keyValPair/getValByKey", [&] {
+        bm::do_not_optimize(getValByKey(&kvp, "keyword_15"));
+    });
+
+    bm::run("key_value_proxy/contains", [&] {
+        bm::do_not_optimize(proxy.contains("keyword_15"));
+    });
+
+    bm::run("key_value_proxy/at", [&] {
+        bm::do_not_optimize(proxy.at("keyword_15").value());
+    });
+
+    bm::run("keyValPair/addKeyVal", [&] {
+        addKeyVal(&kvp, "keyword_15", "new_value");
+    });
+
+    bm::run("key_value_proxy/operator[]", [&] {
+        proxy["keyword_15"] = "new_value";
+    });
+}
@@ -0,0 +1,143 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "dataObjInpOut.h"
+#include "irods_at_scope_exit.hpp"
+#include "packStruct.h"
+#include "rcMisc.h"
+#include "rodsGenQuery.h"
+
+#include <fcntl.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace bm = irods::benchmarks;
+
+namespace
+{
+    constexpr const char* peer_version = "rods4.2.9";
+
+    // Packs the structure once, then measures packing and unpacking it with the given protocol.
+    //
+    // The unpacked structure is released by free_unpacked. Fixed-size structures only need
+    // std::free; structures owning memory need their clear function as well.
+    template <typename T, typename Free>
+    auto run_pack_and_unpack(const std::string& _name,
+                             const T& _input,
+                             const char* _pack_instruction,
+                             irodsProt_t _protocol,
+                             Free free_unpacked) -> void
+    {
+        const auto* protocol_name = _protocol == XML_PROT ? "xml" : "native";
+
+        bytesBuf_t* packed = nullptr;
+        REQUIRE(pack_struct(&_input, &packed, _pack_instruction, nullptr, 0, _protocol, peer_version) >= 0);
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        bm::run("packStruct/" + _name + "/" + protocol_name, [&] {
+            bytesBuf_t* bbuf = nullptr;
+            pack_struct(&_input, &bbuf, _pack_instruction, nullptr, 0, _protocol, peer_version);
+            bm::do_not_optimize(bbuf);
+            freeBBuf(bbuf);
+        }, packed->len);
+
+        bm::run("unpackStruct/" + _name + "/" + protocol_name, [&] {
+            T* output = nullptr;
+            unpack_struct(packed->buf, reinterpret_cast<void**>(&output), _pack_instruction, nullptr, _protocol, peer_version);
+            bm::do_not_optimize(output);
+            free_unpacked(output);
+        }, packed->len);
+    }
+
+    auto make_data_obj_inp() -> dataObjInp_t
+    {
+        dataObjInp_t input{};
+        std::strncpy(input.objPath, "/tempZone/home/rods/benchmarks/a_data_object_with_a_long_name.txt", MAX_NAME_LEN);
+        input.createMode = 0600;
+        input.openFlags = O_WRONLY | O_CREAT | O_TRUNC;
+        input.dataSize = 1024 * 1024;
+        input.numThreads = 4;
+        input.oprType = PUT_OPR;
+        addKeyVal(&input.condInput, DEST_RESC_NAME_KW, "demoResc");
+        addKeyVal(&input.condInput, DATA_TYPE_KW, "generic");
+        addKeyVal(&input.condInput, REG_CHKSUM_KW, "");
+        return input;
+    }
+
+    auto make_gen_query_inp() -> genQueryInp_t
+    {
+        genQueryInp_t input{};
+        input.maxRows = MAX_SQL_ROWS;
+        addInxIval(&input.selectInp, COL_COLL_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_SIZE, 1);
+        addInxIval(&input.selectInp, COL_D_MODIFY_TIME, 1);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, "like '/tempZone/home/rods/%'");
+        addInxVal(&input.sqlCondInp, COL_DATA_NAME, "like '%.txt'");
+        return input;
+    }
+
+    // A typical page of results: 256 rows of 4 attributes.
+    auto make_gen_query_out() -> genQueryOut_t
+    {
+        constexpr int rows = 256;
+        constexpr int attributes = 4;
+        constexpr int length = 64;
+
+        genQueryOut_t output{};
+        output.rowCnt = rows;
+        output.attriCnt = attributes;
+        output.totalRowCount = rows;
+
+        for (int a = 0; a < attributes; ++a) {
+            auto& result = output.sqlResult[a];
+            result.attriInx = COL_DATA_NAME + a;
+            result.len = length;
+            result.value = static_cast<char*>(std::calloc(rows, length));
+
+            for (int r = 0; r < rows; ++r) {
+                std::snprintf(result.value + r * length, length, "value_%d_%d", a, r);
+            }
+        }
+
+        return output;
+    }
+} // anonymous namespace
+
+TEST_CASE("packStruct")
+{
+    for (const auto protocol : {XML_PROT, NATIVE_PROT}) {
+        {
+            auto input = make_data_obj_inp();
+            irods::at_scope_exit clear_input{[&input] { clearKeyVal(&input.condInput); }};
+
+            run_pack_and_unpack("DataObjInp_PI", input, "DataObjInp_PI", protocol, [](dataObjInp_t* _p) {
+                clearDataObjInp(_p);
+                std::free(_p);
+            });
+        }
+
+        {
+            auto input = make_gen_query_inp();
+            irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+            run_pack_and_unpack("GenQueryInp_PI", input, "GenQueryInp_PI", protocol, [](genQueryInp_t* _p) {
+                clearGenQueryInp(_p);
+                std::free(_p);
+            });
+        }
+
+        {
+            auto output = make_gen_query_out();
+            irods::at_scope_exit clear_output{[&output] { clearGenQueryOut(&output); }};
+
+            run_pack_and_unpack("GenQueryOut_PI", output, "GenQueryOut_PI", protocol, [](genQueryOut_t* _p) {
+                freeGenQueryOut(&_p);
+            });
+        }
+    }
+}
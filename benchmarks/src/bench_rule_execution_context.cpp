@@ -0,0 +1,99 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "irods_at_scope_exit.hpp"
+#include "irods_re_structs.hpp"
+#include "json_deserialization.hpp"
+#include "json_serialization.hpp"
+#include "msParam.h"
+#include "rcMisc.h"
+#include "rule_execution_context.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace bm = irods::benchmarks;
+namespace rec = irods::rule_execution_context;
+
+namespace
+{
+    auto make_user_info(const char* _name) -> userInfo_t
+    {
+        userInfo_t info{};
+        std::strncpy(info.userName, _name, sizeof(info.userName) - 1);
+        std::strncpy(info.userType, "rodsuser", sizeof(info.userType) - 1);
+        std::strncpy(info.rodsZone, "tempZone", sizeof(info.rodsZone) - 1);
+        std::strncpy(info.authInfo.authScheme, "native", sizeof(info.authInfo.authScheme) - 1);
+        std::strncpy(info.authInfo.host, "irods.example.org", sizeof(info.authInfo.host) - 1);
+        info.authInfo.authFlag = 3;
+        return info;
+    }
+
+    auto release_rei(ruleExecInfo_t& _rei) -> void
+    {
+        // freeRuleExecInfoInternals() only frees the keyValPair_t itself, not its entries.
+        clearKeyVal(_rei.condInputData);
+        freeRuleExecInfoInternals(&_rei, FREE_MS_PARAM);
+    }
+} // anonymous namespace
+
+TEST_CASE("rule execution context")
+{
+    // The context of a typical delay rule: a few string arguments and an output argument,
+    // submitted by a user through a PEP.
+    msParamArray_t params{};
+    irods::at_scope_exit clear_params{[&params] { clearMsParamArray(&params, 1); }};
+
+    // String values are copied by addMsParam().
+    addMsParam(&params, "*logical_path", STR_MS_T, const_cast<char*>("/tempZone/home/alice/project/data/file_000123.dat"), nullptr);
+    addMsParam(&params, "*destination", STR_MS_T, const_cast<char*>("archiveResc"), nullptr);
+    addMsParam(&params, "*attribute", STR_MS_T, const_cast<char*>("irods::replication::status"), nullptr);
+    addMsParam(&params, "*value", STR_MS_T, const_cast<char*>("pending"), nullptr);
+    addMsParam(&params, "*status", nullptr, nullptr, nullptr);
+
+    auto client = make_user_info("alice");
+    auto proxy = make_user_info("rods");
+
+    keyValPair_t cond_input{};
+    irods::at_scope_exit clear_cond_input{[&cond_input] { clearKeyVal(&cond_input); }};
+    addKeyVal(&cond_input, "instance_name", "irods_rule_engine_plugin-irods_rule_language-instance");
+
+    ruleExecInfo_t rei{};
+    std::strncpy(rei.ruleName, "replicate_to_archive", sizeof(rei.ruleName) - 1);
+    std::strncpy(rei.pluginInstanceName, "irods_rule_engine_plugin-irods_rule_language-instance", sizeof(rei.pluginInstanceName) - 1);
+    std::strncpy(rei.rescName, "demoResc", sizeof(rei.rescName) - 1);
+    rei.msParamArray = &params;
+    rei.uoic = &client;
+    rei.uoip = &proxy;
+    rei.condInputData = &cond_input;
+
+    const auto json_context = irods::to_json(&rei).dump();
+    const auto binary_context = rec::encode(rei);
+
+    // Submission: the context is encoded once per delay rule.
+    bm::run("rule_execution_context/encode/json", [&] {
+        bm::do_not_optimize(irods::to_json(&rei).dump());
+    }, json_context.size());
+
+    bm::run("rule_execution_context/encode/binary", [&] {
+        bm::do_not_optimize(rec::encode(rei));
+    }, binary_context.size());
+
+    // Execution: the context is decoded every time the delay server runs the rule.
+    bm::run("rule_execution_context/decode/json", [&] {
+        auto r = irods::to_rule_execution_info(json_context);
+        bm::do_not_optimize(r);
+        release_rei(r);
+    }, json_context.size());
+
+    bm::run("rule_execution_context/decode/binary", [&] {
+        auto r = rec::decode(binary_context);
+        bm::do_not_optimize(r);
+        release_rei(r);
+    }, binary_context.size());
+
+    std::printf("%-60s %10zu bytes\n", "rule_execution_context/size/json", json_context.size());
+    std::printf("%-60s %10zu bytes\n", "rule_execution_context/size/binary", binary_context.size());
+}
@@ -0,0 +1,210 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "configuration.hpp"
+#include "functions.hpp"
+#include "parser.hpp"
+#include "rcConnect.h"
+#include "reGlobalsExtern.hpp"
+#include "reVariableMap.gen.hpp"
+#include "reVariableMap.hpp"
+#include "region.h"
+#include "restructs.hpp"
+#include "rules.hpp"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+// Defined in configuration.cpp.
+void clearRuleEngineConfig();
+void generateRegions();
+void generateRuleSets();
+
+namespace bm = irods::benchmarks;
+
+namespace
+{
+    // Sets up the function tables the same way loading a rule base does, minus the rule
+    // base files.
+    auto initialize_rule_engine() -> void
+    {
+        static const bool initialized = [] {
+            clearRuleEngineConfig();
+            generateRegions();
+            generateRuleSets();
+            generateFunctionDescriptionTables();
+            getSystemFunctions(ruleEngineConfig.sysFuncDescIndex->current, ruleEngineConfig.sysRegion);
+            createCoreRuleIndex();
+            createAppRuleIndex();
+            ruleEngineConfig.ruleEngineStatus = INITIALIZED;
+            return true;
+        }();
+
+        static_cast<void>(initialized);
+    }
+
+    // Session variables mapped the same way as in core.dvm. The first mapping of objPath and
+    // dataSize refers to a structure that is not set, as is the case for most PEPs.
+    auto initialize_session_variables() -> void
+    {
+        static const bool initialized = [] {
+            const std::pair<const char*, const char*> mappings[] = {
+                {"objPath", "rei->doi->objPath"},
+                {"objPath", "rei->doinp->objPath"},
+                {"dataSize", "rei->doi->dataSize"},
+                {"dataSize", "rei->doinp->dataSize"},
+                {"userNameClient", "rei->uoic->userName"},
+                {"rodsZoneClient", "rei->uoic->rodsZone"},
+                {"userNameProxy", "rei->uoip->userName"},
+                {"clientAddr", "rei->rsComm->clientAddr"},
+                {"connectCnt", "rei->rsComm->connectCnt"},
+                {"ruleName", "rei->ruleName"},
+                {"status", "rei->status"},
+                {"numThreads", "rei->doinp->numThreads"}
+            };
+
+            for (const auto& [name, var_map] : mappings) {
+                const auto i = coreRuleVarDef.MaxNumOfDVars++;
+                coreRuleVarDef.varName[i] = strdup(name);
+                coreRuleVarDef.action[i] = strdup("");
+                coreRuleVarDef.var2CMap[i] = strdup(var_map);
+                coreRuleVarDef.varId[i] = i;
+            }
+
+            return true;
+        }();
+
+        static_cast<void>(initialized);
+    }
+
+    // A rule base resembling a small core.re.
+    constexpr const char* rule_base = R"(
+acPreConnect(*OUT) { *OUT = "CS_NEG_DONT_CARE"; }
+acSetNumThreads { msiSetNumThreads("default", "0", "default"); }
+acSetRescSchemeForCreate { msiSetDefaultResc("demoResc", "null"); }
+acPostProcForPut {
+    if ($objPath like "/tempZone/home/*/archive/*") {
+        msiDataObjRepl($objPath, "destRescName=archiveResc", *status);
+    }
+    else {
+        writeLine("serverLog", "stored " ++ $objPath);
+    }
+}
+count_replicas(*path, *count) {
+    *count = 0;
+    foreach (*row in SELECT DATA_REPL_NUM where COLL_NAME = '*path') {
+        *count = *count + 1;
+    }
+}
+fibonacci(*n) = if *n < 2 then *n else fibonacci(*n - 1) + fibonacci(*n - 2)
+)";
+} // anonymous namespace
+
+TEST_CASE("rule language")
+{
+    initialize_rule_engine();
+
+    SECTION("parse rule base")
+    {
+        std::string buffer = rule_base;
+
+        bm::run("parseRuleSet/rule_base", [&] {
+            Region* r = make_region(0, nullptr);
+
+            rError_t errmsg{};
+            RuleSet* rule_set = newRuleSet(r);
+            Env* env = newEnv(newHashTable2(100, r), nullptr, nullptr, r);
+
+            Pointer* p = newPointer2(buffer.data());
+            int errloc = 0;
+            bm::do_not_optimize(parseRuleSet(p, rule_set, env, &errloc, &errmsg, r));
+            deletePointer(p);
+
+            freeRErrorContent(&errmsg);
+            region_free(r);
+        }, buffer.size());
+    }
+
+    SECTION("evaluate expressions")
+    {
+        const auto evaluate = [](const std::string& _name, std::string _expression) {
+            bm::run("parseAndComputeExpression/" + _name, [&] {
+                Region* r = make_region(0, nullptr);
+
+                rError_t errmsg{};
+                ruleExecInfo_t rei{};
+                bm::do_not_optimize(parseAndComputeExpression(_expression.data(), defaultEnv(r), &rei, 0, &errmsg, r));
+
+                freeRErrorContent(&errmsg);
+                region_free(r);
+            });
+        };
+
+        evaluate("arithmetic", "1 + 2 * 3 - 4 / 2");
+        evaluate("string_concatenation", R"("/tempZone/home/" ++ "rods" ++ "/" ++ "file.txt")");
+        evaluate("conditional", R"(if 10 > 5 && "abc" like "a*" then "yes" else "no")");
+        evaluate("let", R"(let *x = 21 in *x * 2)");
+    }
+
+    SECTION("read session variables")
+    {
+        initialize_session_variables();
+
+        rsComm_t comm{};
+        std::strncpy(comm.clientAddr, "192.168.1.10", sizeof(comm.clientAddr) - 1);
+
+        dataObjInp_t input{};
+        std::strncpy(input.objPath, "/tempZone/home/rods/benchmarks/a_data_object.txt", sizeof(input.objPath) - 1);
+        input.dataSize = 1024 * 1024;
+        input.numThreads = 4;
+
+        userInfo_t client{};
+        std::strncpy(client.userName, "rods", sizeof(client.userName) - 1);
+        std::strncpy(client.rodsZone, "tempZone", sizeof(client.rodsZone) - 1);
+
+        ruleExecInfo_t rei{};
+        std::strncpy(rei.ruleName, "acPostProcForPut", sizeof(rei.ruleName) - 1);
+        rei.rsComm = &comm;
+        rei.doinp = &input;
+        rei.uoic = &client;
+        rei.uoip = &client;
+
+        // A policy reading a dozen session variables, as many PEPs do.
+        std::string expression = R"($objPath ++ $userNameClient ++ $rodsZoneClient ++ $userNameProxy ++ )"
+                                 R"($clientAddr ++ $ruleName ++ str($dataSize) ++ str($numThreads) ++ )"
+                                 R"(str($connectCnt) ++ str($status) ++ $objPath ++ $userNameClient)";
+
+        bm::run("parseAndComputeExpression/session_variables", [&] {
+            Region* r = make_region(0, nullptr);
+
+            rError_t errmsg{};
+            bm::do_not_optimize(parseAndComputeExpression(expression.data(), defaultEnv(r), &rei, 0, &errmsg, r));
+
+            freeRErrorContent(&errmsg);
+            region_free(r);
+        });
+
+        // Resolving a variable map by path, then through the accessors of each structure.
+        for (const auto* var_map : {"rei->ruleName", "rei->doinp->objPath", "rei->uoic->userName"}) {
+            std::string buffer = var_map;
+
+            bm::run(std::string{"getVarValue/"} + var_map, [&] {
+                Region* r = make_region(0, nullptr);
+                Res* value = nullptr;
+                bm::do_not_optimize(getVarValue(buffer.data(), &rei, &value, r));
+                region_free(r);
+            });
+
+            std::string accessors = buffer.substr(std::strlen("rei->"));
+
+            bm::run(std::string{"getValFromRuleExecInfo/"} + var_map, [&] {
+                Region* r = make_region(0, nullptr);
+                Res* value = nullptr;
+                bm::do_not_optimize(getValFromRuleExecInfo(accessors.data(), &rei, &value, r));
+                region_free(r);
+            });
+        }
+    }
+}
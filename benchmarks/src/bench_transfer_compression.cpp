@@ -0,0 +1,205 @@
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+
+#include "transfer_compression.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace bm = irods::benchmarks;
+namespace tc = irods::experimental::transfer_compression;
+
+namespace
+{
+    // The default transfer buffer size for parallel transfers.
+    constexpr std::size_t buffer_size = 4 * 1024 * 1024;
+
+    // The number of buffers sent through the loopback per iteration.
+    constexpr int buffers_per_transfer = 4;
+
+    auto text_data() -> std::vector<unsigned char>
+    {
+        std::mt19937 gen{1};
+        std::uniform_int_distribution<int> sensor{0, 63};
+        std::normal_distribution<double> reading{21.0, 2.0};
+
+        std::vector<unsigned char> data;
+        data.reserve(buffer_size);
+
+        char line[128];
+        for (int second = 0; data.size() < buffer_size; ++second) {
+            const auto n = std::snprintf(line, sizeof(line), "2020-06-01T%02d:%02d:%02dZ sensor=%d temperature=%.3f status=ok\n",
+                                         (second / 3600) % 24, (second / 60) % 60, second % 60, sensor(gen), reading(gen));
+            data.insert(data.end(), line, line + n);
+        }
+
+        data.resize(buffer_size);
+        return data;
+    }
+
+    // Smoothly varying double precision samples with noise in the low bits, like the
+    // datasets of an HDF5 file.
+    auto array_data() -> std::vector<unsigned char>
+    {
+        std::mt19937 gen{2};
+        std::normal_distribution<double> noise{0.0, 1e-3};
+
+        std::vector<double> samples(buffer_size / sizeof(double));
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = std::round((20.0 + std::sin(i / 1000.0) + noise(gen)) * 1000.0) / 1000.0;
+        }
+
+        std::vector<unsigned char> data(buffer_size);
+        std::memcpy(data.data(), samples.data(), buffer_size);
+        return data;
+    }
+
+    auto sparse_data() -> std::vector<unsigned char>
+    {
+        std::vector<unsigned char> data(buffer_size);
+        for (std::size_t i = 0; i < data.size(); i += 4096) {
+            data[i] = static_cast<unsigned char>(i / 4096);
+        }
+        return data;
+    }
+
+    // Already compressed data (e.g. images, archives).
+    auto noise_data() -> std::vector<unsigned char>
+    {
+        std::mt19937 gen{3};
+        std::vector<unsigned char> data(buffer_size);
+        for (auto& c : data) {
+            c = static_cast<unsigned char>(gen());
+        }
+        return data;
+    }
+
+    auto write_all(int _fd, const unsigned char* _data, std::size_t _size) -> void
+    {
+        while (_size > 0) {
+            const auto n = ::write(_fd, _data, _size);
+            if (n <= 0) {
+                throw std::system_error{errno, std::generic_category(), "write"};
+            }
+            _data += n;
+            _size -= n;
+        }
+    }
+
+    auto read_all(int _fd, unsigned char* _data, std::size_t _size) -> void
+    {
+        while (_size > 0) {
+            const auto n = ::read(_fd, _data, _size);
+            if (n <= 0) {
+                throw std::system_error{errno, std::generic_category(), "read"};
+            }
+            _data += n;
+            _size -= n;
+        }
+    }
+
+    // Sends buffers_per_transfer copies of _data through a local socket, the way a portal
+    // stream does: raw when _codec is codec::none, in frames otherwise.
+    auto loopback(const std::vector<unsigned char>& _data, tc::codec _codec, int _level) -> void
+    {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+        std::thread sender{[&] {
+            tc::encoder encoder{_codec, _level};
+            std::vector<unsigned char> frame;
+
+            for (int i = 0; i < buffers_per_transfer; ++i) {
+                if (tc::codec::none == _codec) {
+                    write_all(fds[0], _data.data(), _data.size());
+                }
+                else {
+                    encoder.encode(_data.data(), _data.size(), frame);
+                    write_all(fds[0], frame.data(), frame.size());
+                }
+            }
+        }};
+
+        std::vector<unsigned char> frame;
+        std::vector<unsigned char> raw(_data.size());
+
+        for (int i = 0; i < buffers_per_transfer; ++i) {
+            if (tc::codec::none == _codec) {
+                read_all(fds[1], raw.data(), raw.size());
+            }
+            else {
+                frame.resize(tc::frame_header_size);
+                read_all(fds[1], frame.data(), frame.size());
+                const auto header = tc::read_frame_header(frame.data());
+                frame.resize(tc::frame_header_size + header.payload_size);
+                read_all(fds[1], frame.data() + tc::frame_header_size, header.payload_size);
+                tc::decode(frame.data(), frame.size(), raw);
+            }
+        }
+
+        sender.join();
+        ::close(fds[0]);
+        ::close(fds[1]);
+
+        bm::do_not_optimize(raw);
+    }
+} // anonymous namespace
+
+TEST_CASE("transfer compression")
+{
+    const std::pair<const char*, std::vector<unsigned char>> data_sets[] = {
+        {"text", text_data()},
+        {"array", array_data()},
+        {"sparse", sparse_data()},
+        {"random", noise_data()}
+    };
+
+    const std::pair<const char*, int> levels[] = {{"deflate-1", 1}, {"deflate-6", 6}};
+
+    for (const auto& [type, data] : data_sets) {
+        const std::string prefix = "transfer_compression/";
+        std::vector<unsigned char> frame;
+        std::vector<unsigned char> raw;
+
+        for (const auto& [name, level] : levels) {
+            tc::encoder encoder{tc::codec::deflate, level};
+
+            bm::run(prefix + "encode/" + type + "/" + name, [&] {
+                encoder.encode(data.data(), data.size(), frame);
+                bm::do_not_optimize(frame);
+            }, data.size());
+
+            std::printf("%-60s %10.2f\n", (prefix + "ratio/" + type + "/" + name).c_str(), encoder.stats().ratio());
+        }
+
+        tc::encoder encoder{tc::codec::deflate, 1};
+        encoder.encode(data.data(), data.size(), frame);
+
+        bm::run(prefix + "decode/" + type, [&] {
+            tc::decode(frame.data(), frame.size(), raw);
+            bm::do_not_optimize(raw);
+        }, data.size());
+
+        const auto bytes = static_cast<std::int64_t>(data.size()) * buffers_per_transfer;
+
+        bm::run(prefix + "loopback/" + type + "/raw", [&] {
+            loopback(data, tc::codec::none, 0);
+        }, bytes);
+
+        bm::run(prefix + "loopback/" + type + "/deflate-1", [&] {
+            loopback(data, tc::codec::deflate, 1);
+        }, bytes);
+    }
+}
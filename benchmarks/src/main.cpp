@@ -0,0 +1,147 @@
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include "benchmark.hpp"
+#include "rodsVersion.h"
+
+#include <json.hpp>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+namespace bm = irods::benchmarks;
+
+namespace irods::benchmarks
+{
+    auto get_options() noexcept -> options&
+    {
+        static options opts;
+        return opts;
+    }
+
+    auto get_results() noexcept -> std::vector<result>&
+    {
+        static std::vector<result> results;
+        return results;
+    }
+
+    auto report(result _result) -> const result&
+    {
+        std::printf("%-60s %14.1f ns %14.1f ns %12lld", _result.name.c_str(), _result.real_time,
+                    _result.cpu_time, static_cast<long long>(_result.iterations));
+
+        if (_result.bytes_per_iteration > 0) {
+            std::printf(" %10.1f MiB/s", _result.bytes_per_iteration / _result.real_time * 1e9 / (1024 * 1024));
+        }
+
+        std::printf("\n");
+
+        return get_results().emplace_back(std::move(_result));
+    }
+} // namespace irods::benchmarks
+
+namespace
+{
+    // Writes the results in the format used by Google Benchmark, so that existing tools for
+    // comparing runs (e.g. compare.py) can be used to track the results across commits.
+    auto write_json(const std::string& _filename) -> bool
+    {
+        using json = nlohmann::json;
+
+        char hostname[256]{};
+        gethostname(hostname, sizeof(hostname) - 1);
+
+        char date[64]{};
+        const auto now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%FT%T%z", std::localtime(&now));
+
+        auto benchmarks = json::array();
+
+        for (const auto& r : bm::get_results()) {
+            auto b = json{{"name", r.name},
+                          {"run_name", r.name},
+                          {"run_type", "iteration"},
+                          {"iterations", r.iterations},
+                          {"repetitions", r.samples},
+                          {"real_time", r.real_time},
+                          {"cpu_time", r.cpu_time},
+                          {"min_time", r.min_time},
+                          {"max_time", r.max_time},
+                          {"stddev", r.stddev},
+                          {"time_unit", "ns"}};
+
+            if (r.bytes_per_iteration > 0) {
+                b["bytes_per_second"] = r.bytes_per_iteration / r.real_time * 1e9;
+            }
+
+            benchmarks.push_back(std::move(b));
+        }
+
+        const json doc{{"context", {{"date", date},
+                                    {"host_name", hostname},
+                                    {"irods_version", RODS_REL_VERSION},
+                                    {"num_cpus", sysconf(_SC_NPROCESSORS_ONLN)},
+#ifdef NDEBUG
+                                    {"library_build_type", "release"}
+#else
+                                    {"library_build_type", "debug"}
+#endif
+                                   }},
+                       {"benchmarks", benchmarks}};
+
+        std::ofstream out{_filename};
+        out << doc.dump(4) << '\n';
+
+        return static_cast<bool>(out);
+    }
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    std::string json_file;
+    int min_time_in_milliseconds = 500;
+    int samples = 10;
+
+    using namespace Catch::clara;
+
+    session.cli(session.cli()
+                | Opt(json_file, "filename")["--benchmark-out"]("write the results to a JSON file")
+                | Opt(min_time_in_milliseconds, "milliseconds")["--benchmark-min-time"]("minimum time to spend on each benchmark")
+                | Opt(samples, "count")["--benchmark-samples"]("number of samples taken by each benchmark"));
+
+    if (const auto ec = session.applyCommandLine(argc, argv); ec != 0) {
+        return ec;
+    }
+
+    if (min_time_in_milliseconds <= 0 || samples <= 0) {
+        std::cerr << "error: --benchmark-min-time and --benchmark-samples must be greater than zero.\n";
+        return 1;
+    }
+
+    auto& opts = bm::get_options();
+    opts.min_time = std::chrono::milliseconds{min_time_in_milliseconds};
+    opts.samples = samples;
+
+    // Keep the output of --help and the --list-* options free of the results header.
+    const auto& cfg = session.configData();
+    const bool runs_benchmarks = !cfg.showHelp && !cfg.listTests && !cfg.listTestNamesOnly && !cfg.listTags && !cfg.listReporters;
+
+    if (runs_benchmarks) {
+        std::printf("%-60s %17s %17s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+    }
+
+    const auto ec = session.run();
+
+    if (!json_file.empty() && !write_json(json_file)) {
+        std::cerr << "error: could not write results to [" << json_file << "].\n";
+        return 1;
+    }
+
+    return ec;
+}
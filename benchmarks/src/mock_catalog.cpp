@@ -0,0 +1,39 @@
+// Stand-ins for the database access routines referenced by the general query translation
+// unit. generateSQL only builds the SQL text, so none of these are reached by the
+// benchmarks; they exist to satisfy the linker without pulling in ODBC.
+
+#include "low_level_odbc.hpp"
+#include "mid_level.hpp"
+
+int cllBindVarCount = 0;
+const char* cllBindVars[MAX_BIND_VARS];
+
+int cllGetRowCount(icatSessionStruct*, int)
+{
+    return CAT_SQL_ERR;
+}
+
+int cmlFreeStatement(int, icatSessionStruct*)
+{
+    return 0;
+}
+
+int cmlGetFirstRowFromSql(const char*, int*, int, icatSessionStruct*)
+{
+    return CAT_NO_ROWS_FOUND;
+}
+
+int cmlGetNextRowFromStatement(int, icatSessionStruct*)
+{
+    return CAT_NO_ROWS_FOUND;
+}
+
+rodsLong_t cmlCheckDirId(const char*, const char*, const char*, const char*, icatSessionStruct*)
+{
+    return CAT_NO_ACCESS_PERMISSION;
+}
+
+int cmlCheckDataObjId(const char*, const char*, const char*, const char*, const char*, const char*, icatSessionStruct*)
+{
+    return CAT_NO_ACCESS_PERMISSION;
+}
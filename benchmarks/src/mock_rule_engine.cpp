@@ -0,0 +1,21 @@
+// Definitions normally provided by the rule engine plugin's entry point, which is left out
+// of the benchmarks so that the rule language can be exercised without the plugin framework.
+
+#include "reGlobalsExtern.hpp"
+
+ruleStruct_t coreRuleStrct;
+rulevardef_t coreRuleVarDef;
+rulefmapdef_t coreRuleFuncMapDef;
+ruleStruct_t appRuleStrct;
+rulevardef_t appRuleVarDef;
+rulefmapdef_t appRuleFuncMapDef;
+
+int reTestFlag = 0;
+int reLoopBackFlag = 0;
+int GlobalAllRuleExecFlag = 0;
+int GlobalREDebugFlag = 0;
+int GlobalREAuditFlag = 0;
+char* reDebugStackFull[REDEBUG_STACK_SIZE_FULL];
+struct reDebugStack reDebugStackCurr[REDEBUG_STACK_SIZE_CURR];
+int reDebugStackFullPtr = 0;
+int reDebugStackCurrPtr = 0;
@@ -20,10 +20,12 @@ set(
   IRODS_LIB_CORE_INCLUDE_HEADERS
   ${CMAKE_SOURCE_DIR}/lib/core/include/alignPointer.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/apiHandler.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/async_connection.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/base64.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/bunUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/chksumUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/client_connection.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/connection_health.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/connection_pool.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/cpUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/dispatch_processor.hpp
@@ -158,6 +160,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/stringOpr.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/termiosUtil.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/thread_pool.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/transfer_compression.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/trimUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/user.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/user_administration.hpp
@@ -190,6 +193,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/api/include/atomic_apply_acl_operations.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/atomic_apply_metadata_operations.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/authenticate.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/batch_query.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/bulkDataObjPut.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/bulkDataObjReg.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/chkNVPathPerm.h
@@ -339,6 +343,7 @@ set(
   IRODS_SERVER_API_INCLUDE_HEADERS
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_atomic_apply_acl_operations.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_atomic_apply_metadata_operations.hpp
+  ${CMAKE_SOURCE_DIR}/server/api/include/rs_batch_query.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_get_file_descriptor_info.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_replica_open.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_replica_close.hpp
@@ -481,11 +486,14 @@ set(
 
 set(
   IRODS_SERVER_CORE_INCLUDE_HEADERS
+  ${CMAKE_SOURCE_DIR}/server/core/include/agent_connection_health.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/api_profiler.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/client_api_whitelist.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/collection.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/dataObjOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_access_table.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_state_table.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/replication_checkpoint.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/fileOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/finalize_utilities.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/initServer.hpp
@@ -526,11 +534,18 @@ set(
   ${CMAKE_SOURCE_DIR}/server/core/include/json_deserialization.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/json_serialization.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/miscServerFunct.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/multi_source_copy.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/network_topology.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/objDesc.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/objMetaOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/physPath.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/procLog.h
   ${CMAKE_SOURCE_DIR}/server/core/include/resource.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/redirect_token.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/rule_execution_context.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/resource_free_space_table.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/special_collection_index.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/transfer_scheduler.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/rodsAgent.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/rodsConnect.h
   ${CMAKE_SOURCE_DIR}/server/core/include/rodsServer.hpp
@@ -540,6 +555,7 @@ set(
   ${CMAKE_SOURCE_DIR}/server/core/include/rsLog.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/scoped_client_identity.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/scoped_privileged_client.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/server_connection_broker.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/server_utilities.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/specColl.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/voting.hpp
@@ -616,6 +632,7 @@ install(
     PATTERN */filesystem/filesystem.hpp
     PATTERN */filesystem/filesystem.tpp
     PATTERN */filesystem/filesystem_error.hpp
+    PATTERN */filesystem/metadata_cache.hpp
     PATTERN */filesystem/object_status.hpp
     PATTERN */filesystem/path.hpp
     PATTERN */filesystem/path_traits.hpp
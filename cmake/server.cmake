@@ -166,6 +166,14 @@ install(
   PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE GROUP_READ GROUP_EXECUTE WORLD_READ WORLD_EXECUTE
   )
 
+install(
+  FILES
+  ${CMAKE_BINARY_DIR}/test/load_generator/irodsLoadGenerator
+  DESTINATION ${CMAKE_INSTALL_SBINDIR}
+  COMPONENT ${IRODS_PACKAGE_COMPONENT_SERVER_NAME}
+  PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE GROUP_READ GROUP_EXECUTE WORLD_READ WORLD_EXECUTE
+  )
+
 install(
   FILES
   ${CMAKE_SOURCE_DIR}/irodsctl
@@ -0,0 +1,83 @@
+#ifndef IRODS_BATCH_QUERY_H
+#define IRODS_BATCH_QUERY_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Executes a list of independent GenQuery and specific queries in a single round trip.
+///
+/// All queries are executed by the same agent (and therefore the same catalog session)
+/// in the order they appear in \p _json_input. The failure of one query does not prevent
+/// the remaining queries from executing. Each result set carries its own error code.
+///
+/// \p _json_input must have the following JSON structure:
+/// \code{.js}
+/// {
+///   "queries": [
+///     {
+///       "query_string": string,
+///       "query_type": string,
+///       "arguments": [string],
+///       "zone_hint": string,
+///       "row_limit": integer,
+///       "row_offset": integer
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// \p query_string is the GenQuery string or the name/SQL of a specific query.
+///
+/// \p query_type must be "general" or "specific". Defaults to "general".
+///
+/// \p arguments are the bind arguments for a specific query. Ignored for GenQuery.
+///
+/// \p zone_hint, \p row_limit and \p row_offset are optional and behave the same as
+/// their counterparts in irods::query.
+///
+/// On success, \p _json_output will have the following JSON structure:
+/// \code{.js}
+/// {
+///   "results": [
+///     {
+///       "error_code": integer,
+///       "error_message": string,
+///       "rows": [[string]]
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// The results appear in the same order as the queries. \p error_message is only present
+/// when \p error_code is non-zero. A query that matches no rows has an \p error_code of zero
+/// and an empty \p rows array.
+///
+/// On failure, \p _json_output will have the following JSON structure:
+/// \code{.js}
+/// {
+///   "error_message": string
+/// }
+/// \endcode
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  A JSON string containing the batch of queries.
+/// \param[out] _json_output A JSON string containing the result sets. The caller is
+///                          responsible for freeing this string.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval non-zero On failure.
+///
+/// \since 4.2.9
+int rc_batch_query(RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_BATCH_QUERY_H
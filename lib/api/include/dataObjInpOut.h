@@ -195,6 +195,7 @@ typedef struct PortalOpr {
 /* definition for flags */
 #define STREAMING_FLAG          0x1
 #define NO_CHK_COPY_LEN_FLAG    0x2
+#define TRANSFER_COMPRESSION_FLAG   0x4     /* see transfer_compression.hpp */
 
 typedef struct TransferHeader {
     int oprType;
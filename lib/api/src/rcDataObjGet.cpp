@@ -22,6 +22,7 @@
 #include "irods_server_properties.hpp"
 #include "irods_stacktrace.hpp"
 #include "checksum.hpp"
+#include "transfer_compression.hpp"
 
 /**
  * \fn rcDataObjGet (rcComm_t *conn, dataObjInp_t *dataObjInp,
@@ -111,6 +112,12 @@ rcDataObjGet( rcComm_t *conn, dataObjInp_t *dataObjInp, char *locFilePath ) {
         }
     }
 
+    // Offer to compress the data if it is sent through a portal.
+    if ( getValByKey( &dataObjInp->condInput, TRANSFER_COMPRESSION_KW ) == NULL ) {
+        const std::string codecs{irods::experimental::transfer_compression::supported_codecs()};
+        addKeyVal( &dataObjInp->condInput, TRANSFER_COMPRESSION_KW, codecs.c_str() );
+    }
+
     portalOprOut_t *portalOprOut = NULL;
     bytesBuf_t dataObjOutBBuf;
     int status = _rcDataObjGet( conn, dataObjInp, &portalOprOut, &dataObjOutBBuf );
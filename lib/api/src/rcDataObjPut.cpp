@@ -18,6 +18,7 @@
 
 // =-=-=-=-=-=-=-
 #include "irods_client_server_negotiation.hpp"
+#include "transfer_compression.hpp"
 
 /**
  * \fn rcDataObjPut (rcComm_t *conn, dataObjInp_t *dataObjInp,
@@ -143,6 +144,12 @@ rcDataObjPut( rcComm_t *conn, dataObjInp_t *dataObjInp, char *locFilePath ) {
         }
     }
 
+    // Offer to compress the data if it is sent through a portal.
+    if ( getValByKey( &dataObjInp->condInput, TRANSFER_COMPRESSION_KW ) == NULL ) {
+        const std::string codecs{irods::experimental::transfer_compression::supported_codecs()};
+        addKeyVal( &dataObjInp->condInput, TRANSFER_COMPRESSION_KW, codecs.c_str() );
+    }
+
     dataObjInp->oprType = PUT_OPR;
 
     status = _rcDataObjPut( conn, dataObjInp, &dataObjInpBBuf, &portalOprOut );
@@ -31,7 +31,12 @@
  *      \n              -- DEST_RESC_NAME_KW - "value" = The destination Resource.
  *      \n              -- DEF_RESC_NAME_KW - "value" - The default dest resource. Only used
  *                              to create a new file, no overwrite of existing files.
- * \param[out] outHost - the address of the best host.
+ *      \n              -- REQUEST_REDIRECT_TOKEN_KW - Ask for a redirect token (since 4.2.9).
+ * \param[out] outHost - the address of the best host. If a redirect token was requested
+ *                       and the server supports it, the host is followed by a newline and
+ *                       the token. Passing the token as REDIRECT_TOKEN_KW to rcDataObjPut or
+ *                       rcDataObjOpen on that host for the same objPath within 60 seconds
+ *                       saves the host from resolving the resource hierarchy again.
  *
  * \return integer
  * \retval 0 on success.
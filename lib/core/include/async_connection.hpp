@@ -0,0 +1,202 @@
+#ifndef IRODS_ASYNC_CONNECTION_HPP
+#define IRODS_ASYNC_CONNECTION_HPP
+
+/// \file
+
+#include "rodsDef.h"
+#include "rodsGenQuery.h"
+#include "dataObjInpOut.h"
+#include "objStat.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace irods::experimental
+{
+    /// An asynchronous connection to an iRODS server.
+    ///
+    /// Every operation is initiated immediately and completes by invoking the handler passed
+    /// to it from the thread running the io_context. No thread is blocked while waiting on the
+    /// server, so a single thread running an io_context can drive thousands of connections.
+    ///
+    /// Handlers receive the status returned by the server, just like the corresponding
+    /// functions of the C API (e.g. rcObjStat). Negative values are iRODS error codes. Results
+    /// handed to a handler are owned by the handler.
+    ///
+    /// The iRODS protocol is strictly request/response, therefore a connection supports at
+    /// most one outstanding operation at a time. Use several connections to issue operations
+    /// concurrently. Operations may be chained from within handlers or from a stackless
+    /// coroutine (see boost::asio::coroutine).
+    ///
+    /// Only unencrypted connections and native authentication are supported. The server
+    /// must not require SSL (i.e. its negotiation policy must not be CS_NEG_REQUIRE).
+    ///
+    /// The connection must outlive its outstanding operations.
+    ///
+    /// \since 4.2.9
+    class async_connection
+    {
+    public:
+        /// The type of handler invoked when an operation completes.
+        ///
+        /// \since 4.2.9
+        using completion_handler = std::function<void(int _status)>;
+
+        /// The type of handler invoked when an operation producing a result completes.
+        ///
+        /// The result is null if the operation failed. Otherwise, the handler must free it
+        /// (e.g. via freeGenQueryOut or freeRodsObjStat).
+        ///
+        /// \since 4.2.9
+        template <typename T>
+        using result_handler = std::function<void(int _status, T* _result)>;
+
+        /// Constructs an unconnected connection.
+        ///
+        /// \param[in] _io_context The io_context used to perform the operations.
+        ///
+        /// \since 4.2.9
+        explicit async_connection(boost::asio::io_context& _io_context);
+
+        async_connection(const async_connection&) = delete;
+        auto operator=(const async_connection&) -> async_connection& = delete;
+
+        /// Closes the underlying socket.
+        ///
+        /// \since 4.2.9
+        ~async_connection();
+
+        /// Connects to an iRODS server.
+        ///
+        /// \param[in] _host     The host name of the iRODS server.
+        /// \param[in] _port     The port to connect to.
+        /// \param[in] _username The user to connect as.
+        /// \param[in] _zone     The zone of the user.
+        /// \param[in] _handler  The handler invoked on completion.
+        ///
+        /// \since 4.2.9
+        auto async_connect(std::string_view _host,
+                           int _port,
+                           std::string_view _username,
+                           std::string_view _zone,
+                           completion_handler _handler) -> void;
+
+        /// Authenticates the user passed to async_connect using native authentication.
+        ///
+        /// \param[in] _password The password of the user.
+        /// \param[in] _handler  The handler invoked on completion.
+        ///
+        /// \since 4.2.9
+        auto async_login(std::string_view _password, completion_handler _handler) -> void;
+
+        /// Executes a general query.
+        ///
+        /// \since 4.2.9
+        auto async_gen_query(const genQueryInp_t& _input, result_handler<genQueryOut_t> _handler) -> void;
+
+        /// Returns information about a data object or collection.
+        ///
+        /// \since 4.2.9
+        auto async_stat(std::string_view _path, result_handler<rodsObjStat_t> _handler) -> void;
+
+        /// Opens or creates a data object.
+        ///
+        /// The status passed to the handler is the L1 descriptor of the data object.
+        ///
+        /// \since 4.2.9
+        auto async_open(const dataObjInp_t& _input, completion_handler _handler) -> void;
+
+        /// Reads from an open data object.
+        ///
+        /// The bytes are read from the socket directly into \p _buffer. The status passed to
+        /// the handler is the number of bytes read.
+        ///
+        /// \param[in] _fd      The L1 descriptor of the data object.
+        /// \param[in] _buffer  The buffer to read into. Must remain valid until completion.
+        /// \param[in] _count   The number of bytes to read.
+        /// \param[in] _handler The handler invoked on completion.
+        ///
+        /// \since 4.2.9
+        auto async_read(int _fd, void* _buffer, int _count, completion_handler _handler) -> void;
+
+        /// Writes to an open data object.
+        ///
+        /// The bytes are written to the socket directly from \p _buffer. The status passed to
+        /// the handler is the number of bytes written.
+        ///
+        /// \param[in] _fd      The L1 descriptor of the data object.
+        /// \param[in] _buffer  The bytes to write. Must remain valid until completion.
+        /// \param[in] _count   The number of bytes to write.
+        /// \param[in] _handler The handler invoked on completion.
+        ///
+        /// \since 4.2.9
+        auto async_write(int _fd, const void* _buffer, int _count, completion_handler _handler) -> void;
+
+        /// Closes an open data object.
+        ///
+        /// \since 4.2.9
+        auto async_close(int _fd, completion_handler _handler) -> void;
+
+        /// Invokes an API whose input and output structures are described by the client API
+        /// table.
+        ///
+        /// \param[in] _api_number The API number of the operation.
+        /// \param[in] _input      The input structure, or null. It is packed before this
+        ///                        function returns.
+        /// \param[in] _input_bs   The input byte stream, or null. The bytes it refers to must
+        ///                        remain valid until completion.
+        /// \param[in] _output_bs  The buffer to read the output byte stream into, or null.
+        ///                        Must remain valid until completion. On completion, its
+        ///                        length is set to the number of bytes read.
+        /// \param[in] _handler    The handler invoked on completion. Receives the unpacked
+        ///                        output structure, if any.
+        ///
+        /// \since 4.2.9
+        auto async_call(int _api_number,
+                        const void* _input,
+                        const bytesBuf_t* _input_bs,
+                        bytesBuf_t* _output_bs,
+                        result_handler<void> _handler) -> void;
+
+        /// Informs the server that the client is done and closes the connection.
+        ///
+        /// \since 4.2.9
+        auto async_disconnect(completion_handler _handler) -> void;
+
+        /// Closes the connection. Outstanding operations complete with an error.
+        ///
+        /// \since 4.2.9
+        auto close() noexcept -> void;
+
+        /// Checks whether the connection is open.
+        ///
+        /// \since 4.2.9
+        auto is_open() const noexcept -> bool;
+
+        /// Returns the release version reported by the server (e.g. "rods4.2.9").
+        ///
+        /// \since 4.2.9
+        auto server_version() const noexcept -> const std::string&;
+
+    private:
+        struct exchange;
+        struct exchange_op;
+        struct connect_op;
+
+        auto start(std::shared_ptr<exchange> _exchange) -> void;
+
+        boost::asio::io_context& io_context_;
+        boost::asio::ip::tcp::resolver resolver_;
+        boost::asio::ip::tcp::socket socket_;
+        std::string username_;
+        std::string zone_;
+        std::string server_version_;
+    }; // class async_connection
+} // namespace irods::experimental
+
+#endif // IRODS_ASYNC_CONNECTION_HPP
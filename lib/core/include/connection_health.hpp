@@ -0,0 +1,128 @@
+#ifndef IRODS_CONNECTION_HEALTH_HPP
+#define IRODS_CONNECTION_HEALTH_HPP
+
+/// \file
+
+#include "rcConnect.h"
+
+#include <cstddef>
+#include <string>
+
+/// Detection of dead peers on the connections between clients and agents.
+///
+/// Two mechanisms are provided:
+/// - TCP keepalive and TCP_USER_TIMEOUT tuning, applied by rodsSetSockOpt() to every socket
+///   the process opens or accepts. Keepalive probes detect a peer that disappeared while the
+///   connection was idle (e.g. a NAT mapping expired or a laptop was closed). The user timeout
+///   bounds how long sent data may remain unacknowledged, which detects a peer that
+///   disappeared in the middle of a request, with millisecond granularity.
+/// - An application-level heartbeat. A client sends a RODS_HEARTBEAT_T message to its agent,
+///   which answers with the number of seconds it waits for the next message before ending
+///   the session. The heartbeat verifies a connection without a catalog query (e.g. before a
+///   pooled connection is reused). No in-tree client sends heartbeats periodically, so they
+///   do not keep idle sessions alive. Agents that predate the heartbeat end the session when
+///   they receive one, and they report the same release version as agents that answer it.
+///   Support is therefore negotiated when the connection is established: the client adds
+///   heartbeat_request to the option of its startup pack, and agents that answer heartbeats
+///   set heartbeat_supported in the status of the version they send back. Clients only send
+///   heartbeats over connections on which the agent did so.
+namespace irods::experimental::connection_health
+{
+    /// Added by clients to the option of the startup pack to ask whether the agent answers
+    /// heartbeats.
+    ///
+    /// \since 4.2.9
+    inline constexpr char heartbeat_request[] = "request_heartbeat";
+
+    /// The environment variable through which the server forwards heartbeat_request to the
+    /// agent serving the connection.
+    ///
+    /// \since 4.2.9
+    inline constexpr char heartbeat_request_env_var[] = "RODS_HEARTBEAT_REQUEST";
+
+    /// The bit set in the status of the version message by agents that answer heartbeats, if
+    /// the client asked. Clients predating the negotiation only treat a negative status as an
+    /// error.
+    ///
+    /// \since 4.2.9
+    inline constexpr int heartbeat_supported = 0x1;
+
+    /// Keepalive and user timeout settings for TCP sockets. A value of zero leaves the
+    /// corresponding kernel default in place.
+    ///
+    /// \since 4.2.9
+    struct tcp_keepalive_options
+    {
+        /// The time a connection must be idle before the first keepalive probe is sent.
+        int idle_in_seconds = 0;
+
+        /// The time between keepalive probes.
+        int interval_in_seconds = 0;
+
+        /// The number of unanswered probes after which the connection is dropped.
+        int probe_count = 0;
+
+        /// The time sent data may remain unacknowledged before the connection is dropped.
+        int user_timeout_in_milliseconds = 0;
+    }; // struct tcp_keepalive_options
+
+    /// Applies \p _options to \p _socket. SO_KEEPALIVE is expected to be enabled already.
+    ///
+    /// \return 0 on success, or the status of the first setsockopt() call that failed.
+    ///
+    /// \since 4.2.9
+    auto set_tcp_keepalive_options(int _socket, const tcp_keepalive_options& _options) noexcept -> int;
+
+    /// Sets the options rodsSetSockOpt() applies to the sockets of the calling process.
+    ///
+    /// Child processes inherit the options set before they are forked.
+    ///
+    /// \since 4.2.9
+    auto set_default_tcp_keepalive_options(const tcp_keepalive_options& _options) noexcept -> void;
+
+    /// Returns the options rodsSetSockOpt() applies to the sockets of the calling process.
+    ///
+    /// \since 4.2.9
+    auto default_tcp_keepalive_options() noexcept -> const tcp_keepalive_options&;
+
+    /// Appends heartbeat_request to the option of a startup pack.
+    ///
+    /// The request is only appended directly after the client-server negotiation token
+    /// (REQ_SVR_NEG). Nothing is appended if \p _option does not end with that token or has no
+    /// room left, in which case the agent will not report that it answers heartbeats.
+    ///
+    /// \param[in,out] _option The null-terminated option string.
+    /// \param[in]     _size   The size of the buffer holding \p _option.
+    ///
+    /// \since 4.2.9
+    auto add_heartbeat_request(char* _option, std::size_t _size) noexcept -> void;
+
+    /// Removes heartbeat_request from the option of a startup pack.
+    ///
+    /// \param[in,out] _option The option string received from the client.
+    ///
+    /// \return A boolean indicating whether the client asked whether heartbeats are answered.
+    ///
+    /// \since 4.2.9
+    auto remove_heartbeat_request(std::string& _option) -> bool;
+
+    /// Returns whether the agent that sent \p _version said it answers heartbeats.
+    ///
+    /// \since 4.2.9
+    auto server_supports_heartbeat(const version_t& _version) noexcept -> bool;
+
+    /// Sends a heartbeat to the agent serving \p _conn and waits for its answer.
+    ///
+    /// \param[in] _conn              The connection to check.
+    /// \param[in] _timeout_in_seconds The time to wait for the answer.
+    ///
+    /// \return The number of seconds the agent waits for the next message before ending the
+    ///         session, or a negative error code. SYS_NOT_SUPPORTED is returned without
+    ///         sending anything if the agent did not say it answers heartbeats when the
+    ///         connection was established.
+    ///
+    /// \since 4.2.9
+    auto send_heartbeat(rcComm_t& _conn, int _timeout_in_seconds = 10) -> int;
+} // namespace irods::experimental::connection_health
+
+#endif // IRODS_CONNECTION_HEALTH_HPP
@@ -71,9 +71,52 @@ namespace irods
 
     extern const std::string CFG_DNS_CACHE_KW;
     extern const std::string CFG_HOSTNAME_CACHE_KW;
+    extern const std::string CFG_RESOURCE_FREE_SPACE_MONITOR_KW;
+    extern const std::string CFG_API_PROFILER_KW;
+    extern const std::string CFG_SPECIAL_COLLECTION_INDEX_KW;
+    extern const std::string CFG_SERVER_CONNECTION_BROKER_KW;
+    extern const std::string CFG_MULTI_SOURCE_REPLICATION_KW;
+    extern const std::string CFG_RESUMABLE_REPLICATION_KW;
+    extern const std::string CFG_TRANSFER_SCHEDULER_KW;
+    extern const std::string CFG_NETWORK_TOPOLOGY_KW;
+    extern const std::string CFG_PARALLEL_TRANSFER_COMPRESSION_KW;
+    extern const std::string CFG_AGENT_CONNECTION_HEALTH_KW;
 
     extern const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW;
     extern const std::string CFG_EVICTION_AGE_IN_SECONDS_KW;
+    extern const std::string CFG_SAMPLING_INTERVAL_IN_SECONDS_KW;
+    extern const std::string CFG_CATALOG_UPDATE_INTERVAL_IN_SECONDS_KW;
+    extern const std::string CFG_MAXIMUM_SAMPLE_AGE_IN_SECONDS_KW;
+    extern const std::string CFG_API_NUMBERS_KW;
+    extern const std::string CFG_SAMPLING_FREQUENCY_IN_HZ_KW;
+    extern const std::string CFG_SAMPLING_CLOCK_KW;
+    extern const std::string CFG_OUTPUT_DIRECTORY_KW;
+    extern const std::string CFG_REFRESH_INTERVAL_IN_SECONDS_KW;
+    extern const std::string CFG_MAXIMUM_IDLE_CONNECTIONS_KW;
+    extern const std::string CFG_MAXIMUM_IDLE_CONNECTIONS_PER_PEER_KW;
+    extern const std::string CFG_IDLE_TIMEOUT_IN_SECONDS_KW;
+    extern const std::string CFG_MINIMUM_DATA_SIZE_IN_BYTES_KW;
+    extern const std::string CFG_MAXIMUM_NUMBER_OF_SOURCES_KW;
+    extern const std::string CFG_MINIMUM_DATA_SIZE_IN_MEGABYTES_KW;
+    extern const std::string CFG_CHECKPOINT_INTERVAL_IN_MEGABYTES_KW;
+    extern const std::string CFG_MAXIMUM_NUMBER_OF_STREAMS_KW;
+    extern const std::string CFG_MAXIMUM_NUMBER_OF_STREAMS_PER_USER_KW;
+    extern const std::string CFG_MAXIMUM_MEGABYTES_PER_SECOND_KW;
+    extern const std::string CFG_MAXIMUM_MEGABYTES_PER_SECOND_PER_USER_KW;
+    extern const std::string CFG_USER_WEIGHTS_KW;
+    extern const std::string CFG_HOSTS_KW;
+    extern const std::string CFG_HOST_KW;
+    extern const std::string CFG_SITE_KW;
+    extern const std::string CFG_RACK_KW;
+    extern const std::string CFG_SAME_RACK_MEGABYTES_PER_SECOND_KW;
+    extern const std::string CFG_SAME_SITE_MEGABYTES_PER_SECOND_KW;
+    extern const std::string CFG_REMOTE_SITE_MEGABYTES_PER_SECOND_KW;
+    extern const std::string CFG_CODEC_KW;
+    extern const std::string CFG_LEVEL_KW;
+    extern const std::string CFG_TCP_KEEPALIVE_IDLE_IN_SECONDS_KW;
+    extern const std::string CFG_TCP_KEEPALIVE_INTERVAL_IN_SECONDS_KW;
+    extern const std::string CFG_TCP_KEEPALIVE_PROBES_KW;
+    extern const std::string CFG_TCP_USER_TIMEOUT_IN_MILLISECONDS_KW;
 
     // service_account_environment.json keywords
     extern const std::string CFG_IRODS_USER_NAME_KW;
@@ -44,6 +44,21 @@ namespace irods
 
     extern const std::string SERVER_CONFIG_FILE;
 
+    /// A typed copy of the server configuration values that are read on hot paths
+    /// (e.g. once per buffer during a data transfer).
+    ///
+    /// The members mirror the "advanced_settings" section of server_config.json. Members whose
+    /// value is missing or invalid hold the default defined by the server_config schema.
+    ///
+    /// \since 4.2.9
+    struct server_configuration
+    {
+        int default_number_of_transfer_threads;
+        int maximum_size_for_single_buffer_in_megabytes;
+        int transfer_buffer_size_for_parallel_transfer_in_megabytes;
+        int transfer_chunk_size_for_parallel_transfer_in_megabytes;
+    }; // struct server_configuration
+
     class server_properties
     {
     public:
@@ -83,14 +98,26 @@ namespace irods
 
         void remove( const std::string& _key );
 
+        /// Returns the typed configuration built by the most recent call to capture().
+        ///
+        /// \since 4.2.9
+        const server_configuration& configuration() const noexcept {
+            return configuration_;
+        }
+
     private:
         server_properties();
 
+        // Rebuilds configuration_ from the current properties.
+        void capture_configuration();
+
         server_properties( server_properties const& ) = delete;
         server_properties& operator=( server_properties const& ) = delete;
 
         /// @brief properties lookup table
         configuration_parser config_props_;
+
+        server_configuration configuration_;
     }; // class server_properties
 
     template< typename T >
@@ -125,6 +152,22 @@ namespace irods
         return irods::get_server_property<T>(configuration_parser::key_path_t{CFG_ADVANCED_SETTINGS_KW, _prop});
     } // get_advanced_setting
 
+    /// Returns the server configuration captured by the most recent call to
+    /// server_properties::capture().
+    ///
+    /// Unlike get_server_property and get_advanced_setting, reading a member of the returned
+    /// object involves no string lookups or type checks. Changes made through
+    /// set_server_property are not reflected. Like the rest of the server properties, the
+    /// object is rewritten by capture(), which must not be called while other threads read it.
+    ///
+    /// The server captures its configuration on startup, so reads on the server never fail.
+    ///
+    /// \since 4.2.9
+    inline auto get_server_configuration() -> const server_configuration&
+    {
+        return server_properties::instance().configuration();
+    } // get_server_configuration
+
     /// Returns the amount of shared memory that should be allocated for the DNS cache.
     ///
     /// \return An integer representing the size in bytes.
@@ -161,6 +204,64 @@ namespace irods
     /// \since 4.2.9
     auto get_hostname_cache_eviction_age() noexcept -> int;
 
+    /// Returns the number of seconds between samples of local resource vault free space.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 10               If an error occurred or the interval was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.2.9
+    auto get_resource_free_space_sampling_interval() noexcept -> int;
+
+    /// Returns the minimum number of seconds between catalog updates of resource free space.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 300              If an error occurred or the interval was less than zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.2.9
+    auto get_resource_free_space_catalog_update_interval() noexcept -> int;
+
+    /// Returns the age at which a free space sample is no longer trusted by resource voting.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 60               If an error occurred or the age was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.2.9
+    auto get_resource_free_space_maximum_sample_age() noexcept -> int;
+
+    /// Returns the amount of shared memory that should be allocated for the special collection index.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 1000000          If an error occurred or the size was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.2.9
+    auto get_special_collection_index_shared_memory_size() noexcept -> int;
+
+    /// Returns the age at which the special collection index is rebuilt from the catalog.
+    ///
+    /// The index learns about every change made through the iRODS APIs on its own. The interval
+    /// bounds how long changes made directly in the catalog database go unnoticed. Zero
+    /// disables the index, which must be done if several catalog providers share a database.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 300              If an error occurred or the interval was less than zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.2.9
+    auto get_special_collection_index_refresh_interval() noexcept -> int;
+
+    /// Returns the amount of shared memory that should be allocated for the transfer scheduler.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 1000000          If an error occurred or the size was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.2.9
+    auto get_transfer_scheduler_shared_memory_size() noexcept -> int;
+
     /// Parses hosts_config.json into a JSON object if available and stores it in the server
     /// property map with key \p irods::HOSTS_CONFIG_JSON_OBJECT_KW.
     ///
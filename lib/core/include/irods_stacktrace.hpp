@@ -13,11 +13,20 @@ namespace irods {
             stacktrace();
             virtual ~stacktrace(void) = default;
             const std::string& dump() const;
+
+            /// @brief resolve the name of the function containing each address
+            ///
+            /// Names are demangled when possible. Addresses which cannot be resolved
+            /// are reported as the name of the containing object (e.g. "libc.so.6")
+            /// or as "[unknown]". The result has the same order as \p _addresses.
+            ///
+            /// @since 4.2.9
+            static std::vector<std::string> resolve_function_names( const std::vector<void*>& _addresses );
         private:
             static const int max_stack_size = 50;
 
             /// @brief function to demangle the c++ function names
-            void demangle_symbol( const std::string& _symbol, std::string& _rtn_name, std::string& _rtn_offset ) const;
+            static void demangle_symbol( const std::string& _symbol, std::string& _rtn_name, std::string& _rtn_offset );
 
             typedef struct stack_entry_s {
                 std::string function;
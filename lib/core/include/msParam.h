@@ -131,6 +131,7 @@ typedef struct ValidKeyWd {
 #define RBUDP_PACK_SIZE_FLAG    0x8000000
 #define BULK_OPR_FLAG           0x10000000
 #define UNREG_FLAG              0x20000000
+#define RESUME_FLAG             0x40000000
 
 #ifdef __cplusplus
 extern "C" {
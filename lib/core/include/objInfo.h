@@ -24,6 +24,7 @@
 #define GZIP_TAR_DT_STR         "gzipTar"  // JMC - backport 4632
 #define BZIP2_TAR_DT_STR        "bzip2Tar" // JMC - backport 4632
 #define ZIP_DT_STR              "zipFile"  // JMC - backport 4633
+#define ZSTD_TAR_DT_STR         "zstdTar"
 #define MSSO_DT_STR             "msso file"
 
 /* bundle are types for internal phybun use */ // JMC - backport 4658
@@ -31,6 +32,7 @@
 #define GZIP_TAR_BUNDLE_DT_STR  "gzipTar bundle"   // JMC - backport 4658
 #define BZIP2_TAR_BUNDLE_DT_STR "bzip2Tar bundle"  // JMC - backport 4658
 #define ZIP_BUNDLE_DT_STR       "zipFile bundle"   // JMC - backport 4658
+#define ZSTD_TAR_BUNDLE_DT_STR  "zstdTar bundle"
 
 #define HAAW_DT_STR             "haaw file"
 #define MAX_LINK_CNT            20      /* max number soft link in a path */
@@ -31,6 +31,8 @@
 #include <functional>
 #include <memory>
 #include <atomic>
+#include <deque>
+#include <optional>
 
 namespace irods::experimental::io
 {
@@ -72,6 +74,11 @@ namespace irods::experimental::io
 
     /// A class that enables parallel transfer of objects across multiple streams.
     ///
+    /// The bytes to transfer are divided into chunks. Each channel starts with a contiguous
+    /// run of chunks and, once it has run out of chunks, takes chunks that have not been
+    /// started yet from the channel with the most chunks left. A slow channel therefore only
+    /// delays the transfer by the time it needs for a single chunk.
+    ///
     /// Instances of this class are not copyable or moveable.
     ///
     /// \tparam SourceStream The stream type of the streams that will be read from.
@@ -93,6 +100,28 @@ namespace irods::experimental::io
         using sink_stream_close_handler_type = std::function<void (sink_stream_type&, bool)>;
         // clang-format on
 
+        /// The chunk size used when none is specified.
+        static constexpr std::int64_t default_chunk_size = 4 * 1024 * 1024;
+
+        /// Information about the work done by a single channel.
+        ///
+        /// \since 4.2.9
+        struct channel_statistics
+        {
+            std::int64_t bytes_transferred;
+            std::int64_t chunks_transferred;
+            std::int64_t chunks_stolen;
+            std::chrono::nanoseconds active_time;
+
+            /// Returns the number of bytes transferred per second while the channel was active.
+            auto throughput() const noexcept -> double
+            {
+                using seconds = std::chrono::duration<double>;
+                const auto s = std::chrono::duration_cast<seconds>(active_time).count();
+                return s > 0 ? bytes_transferred / s : 0;
+            }
+        }; // struct channel_statistics
+
         /// Constructs an instance of the parallel_transfer_engine and starts transferring data.
         ///
         /// \throws parallel_transfer_engine_error
@@ -106,6 +135,7 @@ namespace irods::experimental::io
         /// \param[in] _offset                    The offset within the source and sink streams.
         /// \param[in] _transfer_buffer_size      The buffer size used by each stream to move bytes.
         /// \param[in] _restart_file_directory    The directory that will be used to store restart information.
+        /// \param[in] _chunk_size                The number of bytes handed to a channel at a time.
         parallel_transfer_engine(source_stream_factory_type _source_stream_factory,
                                  sink_stream_factory_type _sink_stream_factory,
                                  sink_stream_close_handler_type _sink_stream_close_handler,
@@ -113,12 +143,14 @@ namespace irods::experimental::io
                                  std::int16_t _number_of_channels,
                                  std::int64_t _offset,
                                  std::int64_t _transfer_buffer_size,
-                                 std::string _restart_file_directory)
+                                 std::string _restart_file_directory,
+                                 std::int64_t _chunk_size = default_chunk_size)
             : thread_pool_{std::make_unique<irods::thread_pool>(_number_of_channels)}
             , stop_{}
             , file_mapping_{}
             , mapped_region_{}
-            , progress_(_number_of_channels)
+            , chunk_progress_{}
+            , channels_{}
             , tasks_running_(_number_of_channels)
             , errors_{}
             , errors_mutex_{}
@@ -130,10 +162,18 @@ namespace irods::experimental::io
             , number_of_channels_{_number_of_channels}
             , offset_{_offset}
             , transfer_buffer_size_{_transfer_buffer_size}
+            , chunk_size_{_chunk_size}
+            , number_of_chunks_{}
             , restart_file_dir_{std::move(_restart_file_directory)}
             , restart_handle_{make_restart_handle()}
             , restart_file_exists_{}
         {
+            if (chunk_size_ <= 0) {
+                throw parallel_transfer_engine_error{"Chunk size must be greater than zero."};
+            }
+
+            number_of_chunks_ = (total_bytes_to_transfer_ + chunk_size_ - 1) / chunk_size_;
+
             init_transfer_progress_state();
             start_transfer();
         }
@@ -157,7 +197,8 @@ namespace irods::experimental::io
             , stop_{}
             , file_mapping_{}
             , mapped_region_{}
-            , progress_{}
+            , chunk_progress_{}
+            , channels_{}
             , tasks_running_{}
             , errors_{}
             , errors_mutex_{}
@@ -169,6 +210,8 @@ namespace irods::experimental::io
             , number_of_channels_{}
             , offset_{}
             , transfer_buffer_size_{}
+            , chunk_size_{}
+            , number_of_chunks_{}
             , restart_file_dir_{}
             , restart_handle_{_restart_handle}
             , restart_file_exists_{}
@@ -231,12 +274,23 @@ namespace irods::experimental::io
         /// \retval false Otherwise.
         auto success() -> bool
         {
-            return errors_.empty() && std::all_of(std::cbegin(progress_), std::cend(progress_), [](auto& _p) {
-                using namespace std::chrono_literals;
-                return _p.running->valid() &&
-                       _p.running->wait_for(0s) == std::future_status::ready &&
-                       _p.progress->sent == _p.progress->chunk_size;
+            using namespace std::chrono_literals;
+
+            const auto all_tasks_finished = std::all_of(std::begin(tasks_running_), std::end(tasks_running_), [](auto& _f) {
+                return _f.valid() && _f.wait_for(0s) == std::future_status::ready;
             });
+
+            if (!errors_.empty() || !all_tasks_finished) {
+                return false;
+            }
+
+            for (std::int64_t i = 0; i < number_of_chunks_; ++i) {
+                if (chunk_progress_[i].sent != chunk_length(i)) {
+                    return false;
+                }
+            }
+
+            return true;
         }
 
         /// Returns information about errors encountered during the transfer.
@@ -256,6 +310,26 @@ namespace irods::experimental::io
             return restart_handle_;
         }
 
+        /// Returns information about the work done by each channel so far.
+        ///
+        /// May be called while the transfer is in progress. Element N describes channel N.
+        ///
+        /// \since 4.2.9
+        auto statistics() const -> std::vector<channel_statistics>
+        {
+            std::vector<channel_statistics> stats;
+            stats.reserve(channels_.size());
+
+            for (auto& c : channels_) {
+                stats.push_back({c->bytes_transferred.load(),
+                                 c->chunks_transferred.load(),
+                                 c->chunks_stolen.load(),
+                                 std::chrono::nanoseconds{c->active_nanoseconds.load()}});
+            }
+
+            return stats;
+        }
+
     private:
         class latch
         {
@@ -304,26 +378,33 @@ namespace irods::experimental::io
             std::int64_t number_of_streams;
             std::int64_t offset;
             std::int64_t transfer_buffer_size;
+            std::int64_t chunk_size;
+            std::int64_t number_of_chunks;
         };
 
+        // Lives in the restart file. One per chunk.
         struct progress
         {
-            std::int64_t chunk_size;
             std::int64_t sent;
         };
 
-        struct transfer_progress
+        struct channel
         {
-            std::future<void>* running;
-            progress* progress;
+            std::mutex mutex;
+            std::deque<std::int64_t> chunks; // The chunks that have not been started yet.
+
+            std::atomic<std::int64_t> bytes_transferred{};
+            std::atomic<std::int64_t> chunks_transferred{};
+            std::atomic<std::int64_t> chunks_stolen{};
+            std::atomic<std::int64_t> active_nanoseconds{};
         };
 
         auto init_memory_mapped_progress_file(const std::string& _filename, bool _create_file) -> std::byte*
         {
             if (_create_file) {
                 if (std::ofstream out{_filename}; out) {
-                    const std::size_t storage_size = sizeof(restart_header) + number_of_channels_ * sizeof(progress) - 1;
-                    out.seekp(storage_size, std::ios_base::beg);
+                    const std::size_t storage_size = sizeof(restart_header) + number_of_chunks_ * sizeof(progress);
+                    out.seekp(storage_size - 1, std::ios_base::beg);
                     out.put(0);
                 }
                 else {
@@ -349,6 +430,8 @@ namespace irods::experimental::io
             header->number_of_streams = number_of_channels_;
             header->offset = offset_;
             header->transfer_buffer_size = transfer_buffer_size_;
+            header->chunk_size = chunk_size_;
+            header->number_of_chunks = number_of_chunks_;
 
             return header;
         }
@@ -380,41 +463,133 @@ namespace irods::experimental::io
 
                 constexpr auto create_new_file = false;
                 auto* storage = init_memory_mapped_progress_file(restart_handle_, create_new_file);
+
+                if (mapped_region_->get_size() < sizeof(restart_header)) {
+                    throw parallel_transfer_engine_error{"Invalid restart file"};
+                }
+
                 auto* header = new (storage) restart_header;
 
                 total_bytes_to_transfer_ = header->total_bytes_to_transfer;
                 number_of_channels_ = header->number_of_streams;
                 offset_ = header->offset;
                 transfer_buffer_size_ = header->transfer_buffer_size;
+                chunk_size_ = header->chunk_size;
+                number_of_chunks_ = header->number_of_chunks;
+
+                if (chunk_size_ <= 0 ||
+                    number_of_channels_ <= 0 ||
+                    number_of_chunks_ != (total_bytes_to_transfer_ + chunk_size_ - 1) / chunk_size_ ||
+                    mapped_region_->get_size() < sizeof(restart_header) + number_of_chunks_ * sizeof(progress))
+                {
+                    throw parallel_transfer_engine_error{"Invalid restart file"};
+                }
 
                 thread_pool_ = std::make_unique<irods::thread_pool>(number_of_channels_);
-                progress_.resize(number_of_channels_);
                 tasks_running_.resize(number_of_channels_);
                 latch_ = std::make_unique<latch>(number_of_channels_ - 1);
 
-                auto* task_progress_storage = storage + sizeof(restart_header);
-
-                for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
-                    progress_[i].running = &tasks_running_[i];
-                    progress_[i].progress = new (task_progress_storage + (i * sizeof(progress))) progress;
-                }
+                chunk_progress_ = new (storage + sizeof(restart_header)) progress[number_of_chunks_];
             }
             else {
                 constexpr auto create_new_file = true;
                 auto* storage = init_memory_mapped_progress_file(restart_handle_, create_new_file);
                 construct_progress_header(storage);
 
-                auto* task_progress_storage = storage + sizeof(restart_header);
-                const auto chunk_size = total_bytes_to_transfer_ / number_of_channels_;
+                chunk_progress_ = new (storage + sizeof(restart_header)) progress[number_of_chunks_]{};
+            }
+
+            distribute_chunks();
+        }
+
+        // Hands each channel a contiguous run of the chunks that are not complete, so that each
+        // stream reads and writes sequentially until it has to take chunks from another channel.
+        auto distribute_chunks() -> void
+        {
+            std::vector<std::int64_t> remaining;
+
+            for (std::int64_t i = 0; i < number_of_chunks_; ++i) {
+                if (chunk_progress_[i].sent < chunk_length(i)) {
+                    remaining.push_back(i);
+                }
+            }
+
+            const auto n = static_cast<std::int64_t>(remaining.size());
+
+            channels_.clear();
+
+            for (std::int64_t i = 0; i < number_of_channels_; ++i) {
+                auto& c = channels_.emplace_back(std::make_unique<channel>());
+
+                const auto first = i * n / number_of_channels_;
+                const auto last = (i + 1) * n / number_of_channels_;
+
+                c->chunks.assign(std::begin(remaining) + first, std::begin(remaining) + last);
+            }
+        }
+
+        auto chunk_length(std::int64_t _chunk) const noexcept -> std::int64_t
+        {
+            return std::min(chunk_size_, total_bytes_to_transfer_ - _chunk * chunk_size_);
+        }
+
+        // Returns the position in the streams at which the remaining bytes of the chunk start.
+        auto chunk_position(std::int64_t _chunk) const noexcept -> std::int64_t
+        {
+            return offset_ + _chunk * chunk_size_ + chunk_progress_[_chunk].sent;
+        }
+
+        // Returns the position at which the first chunk of the channel starts, or the end of
+        // the range if the channel has no chunks.
+        auto first_position(std::int64_t _channel) const -> std::int64_t
+        {
+            const auto& chunks = channels_[_channel]->chunks;
+            return chunks.empty() ? offset_ + total_bytes_to_transfer_ : chunk_position(chunks.front());
+        }
+
+        // Returns the next chunk of the channel. If it has none left, takes the last chunk of the
+        // channel with the most chunks left. Returns an empty optional once every chunk has been
+        // handed out.
+        auto next_chunk(std::int64_t _channel) -> std::optional<std::int64_t>
+        {
+            auto& self = *channels_[_channel];
+
+            {
+                std::lock_guard lock{self.mutex};
+
+                if (!self.chunks.empty()) {
+                    const auto chunk = self.chunks.front();
+                    self.chunks.pop_front();
+                    return chunk;
+                }
+            }
+
+            while (true) {
+                channel* victim = nullptr;
+                std::size_t most_chunks = 0;
+
+                for (auto& c : channels_) {
+                    std::lock_guard lock{c->mutex};
+
+                    if (c->chunks.size() > most_chunks) {
+                        most_chunks = c->chunks.size();
+                        victim = c.get();
+                    }
+                }
 
-                for (decltype(number_of_channels_) i = 0; i < number_of_channels_; ++i) {
-                    progress_[i].running = &tasks_running_[i];
-                    progress_[i].progress = new (task_progress_storage + i * sizeof(progress)) progress{};
-                    progress_[i].progress->chunk_size = chunk_size;
+                if (!victim) {
+                    return std::nullopt;
                 }
 
-                // Add any remaining bytes to the last stream's chunk size.
-                progress_.back().progress->chunk_size += (total_bytes_to_transfer_ % number_of_channels_);
+                // The victim may have taken its last chunk since it was chosen.
+                std::lock_guard lock{victim->mutex};
+
+                if (!victim->chunks.empty()) {
+                    const auto chunk = victim->chunks.back();
+                    victim->chunks.pop_back();
+                    ++self.chunks_stolen;
+                    return chunk;
+                }
             }
         }
 
@@ -423,24 +598,23 @@ namespace irods::experimental::io
             // Triggering a restart means the caller has verified that the source object exists.
             // The parallel transfer engine makes no attempts to verify existence of any source.
             // That is the sole responsibility of the caller.
-            const auto mode = std::ios_base::out | (restart_file_exists_ ? std::ios_base::in : 0);
-            const auto offset = offset_ + progress_[0].progress->sent;
+            const auto mode = std::ios_base::out | (restart_file_exists_ ? std::ios_base::in : std::ios_base::openmode{});
+            const auto offset = first_position(0);
             auto primary_in_stream = create_source_stream(offset);
             auto primary_out_stream = create_sink_stream(mode, offset);
 
-            const auto chunk_size = total_bytes_to_transfer_ / number_of_channels_;
-
             for (decltype(number_of_channels_) i = 1; i < number_of_channels_; ++i) {
                 constexpr auto wait_for_sibling_tasks_to_finish = false;
                 const auto mode = std::ios_base::in | std::ios_base::out;
-                const auto offset = i * chunk_size + offset_ + progress_[i].progress->sent;
+                const auto offset = first_position(i);
 
                 auto secondary_in_stream = create_source_stream(offset, &primary_in_stream);
                 auto secondary_out_stream = create_sink_stream(mode, offset, &primary_out_stream);
 
                 schedule_transfer_task_on_thread_pool(secondary_in_stream,
                                                       secondary_out_stream,
-                                                      progress_[i],
+                                                      i,
+                                                      offset,
                                                       tasks_running_[i],
                                                       wait_for_sibling_tasks_to_finish);
             }
@@ -448,7 +622,8 @@ namespace irods::experimental::io
             constexpr auto wait_for_sibling_tasks_to_finish = true;
             schedule_transfer_task_on_thread_pool(primary_in_stream,
                                                   primary_out_stream,
-                                                  progress_[0],
+                                                  0,
+                                                  offset,
                                                   tasks_running_[0],
                                                   wait_for_sibling_tasks_to_finish);
         }
@@ -486,39 +661,90 @@ namespace irods::experimental::io
             return out;
         }
 
+        // Moves the remaining bytes of a chunk. Returns false if the transfer cannot continue.
+        auto transfer_chunk(source_stream_type& _in,
+                            sink_stream_type& _out,
+                            std::vector<typename source_stream_type::char_type>& _buf,
+                            std::int64_t _chunk,
+                            std::int64_t& _position,
+                            channel& _channel) -> bool
+        {
+            auto& progress = chunk_progress_[_chunk];
+            const auto length = chunk_length(_chunk);
+
+            // Streams only need to be repositioned when the chunk does not follow the previous one.
+            if (const auto position = chunk_position(_chunk); position != _position) {
+                if (!_in.seekg(position)) {
+                    std::lock_guard lock{errors_mutex_};
+                    errors_.emplace_back(parallel_transfer_error::stream_seek, "Seek error on input stream");
+                    return false;
+                }
+
+                if (!_out.seekp(position)) {
+                    std::lock_guard lock{errors_mutex_};
+                    errors_.emplace_back(parallel_transfer_error::stream_seek, "Seek error on output stream");
+                    return false;
+                }
+
+                _position = position;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+
+            while (!stop_.load() && progress.sent < length) {
+                if (!_in) {
+                    std::lock_guard lock{errors_mutex_};
+                    errors_.emplace_back(parallel_transfer_error::stream_read, "Source stream in bad state");
+                    return false;
+                }
+
+                if (!_out) {
+                    std::lock_guard lock{errors_mutex_};
+                    errors_.emplace_back(parallel_transfer_error::stream_write, "Sink stream in bad state");
+                    return false;
+                }
+
+                _in.read(_buf.data(), std::min(length - progress.sent, static_cast<std::int64_t>(_buf.size())));
+                _out.write(_buf.data(), _in.gcount());
+                progress.sent += _in.gcount();
+                _position += _in.gcount();
+                _channel.bytes_transferred += _in.gcount();
+            }
+
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            _channel.active_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+            if (progress.sent == length) {
+                ++_channel.chunks_transferred;
+            }
+
+            return true;
+        }
+
         auto schedule_transfer_task_on_thread_pool(source_stream_type& _source_stream,
                                                    sink_stream_type& _sink_stream,
-                                                   transfer_progress& _progress,
+                                                   std::int64_t _channel,
+                                                   std::int64_t _position,
                                                    std::future<void>& _result,
                                                    bool _wait_for_sibling_tasks_to_finish) -> void
         {
             std::packaged_task<void()> task{[this,
                                              in = std::move(_source_stream),
                                              out = std::move(_sink_stream),
-                                             &_progress,
+                                             _channel,
+                                             _position,
                                              _wait_for_sibling_tasks_to_finish]() mutable
             {
                 try {
                     std::vector<typename source_stream_type::char_type> buf(transfer_buffer_size_);
+                    auto& c = *channels_[_channel];
 
-                    while (!stop_.load() && _progress.progress->sent < _progress.progress->chunk_size) {
-                        if (!in) {
-                            std::lock_guard lock{errors_mutex_};
-                            errors_.emplace_back(parallel_transfer_error::stream_read, "Source stream in bad state");
-                            break;
-                        }
+                    while (!stop_.load()) {
+                        const auto chunk = next_chunk(_channel);
 
-                        if (!out) {
-                            std::lock_guard lock{errors_mutex_};
-                            errors_.emplace_back(parallel_transfer_error::stream_write, "Sink stream in bad state");
+                        if (!chunk || !transfer_chunk(in, out, buf, *chunk, _position, c)) {
                             break;
                         }
-
-                        in.read(buf.data(), std::min({_progress.progress->chunk_size - _progress.progress->sent,
-                                                      static_cast<std::int64_t>(buf.size()),
-                                                      _progress.progress->chunk_size}));
-                        out.write(buf.data(), in.gcount());
-                        _progress.progress->sent += in.gcount();
                     }
 
                     if (_wait_for_sibling_tasks_to_finish) {
@@ -563,7 +789,8 @@ namespace irods::experimental::io
         std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;
         std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;
 
-        std::vector<transfer_progress> progress_;
+        progress* chunk_progress_;
+        std::vector<std::unique_ptr<channel>> channels_;
         std::vector<std::future<void>> tasks_running_;
         error_type errors_;
         std::mutex errors_mutex_;
@@ -577,6 +804,8 @@ namespace irods::experimental::io
         std::int64_t number_of_channels_;
         std::int64_t offset_;
         std::int64_t transfer_buffer_size_;
+        std::int64_t chunk_size_;
+        std::int64_t number_of_chunks_;
 
         std::string restart_file_dir_;
         std::string restart_handle_;
@@ -619,6 +848,7 @@ namespace irods::experimental::io
             , total_bytes_to_transfer_{_total_bytes_to_transfer}
             , offset_{}
             , transfer_buffer_size_{8192}
+            , chunk_size_{parallel_transfer_engine_type::default_chunk_size}
             , number_of_channels_{3}
             , restart_file_dir_{default_restart_file_directory()}
         {
@@ -675,6 +905,20 @@ namespace irods::experimental::io
             return *this;
         }
 
+        /// \brief Sets the number of bytes handed to a channel at a time.
+        ///
+        /// Smaller chunks balance the work better across channels of different speeds, at the
+        /// cost of more frequent repositioning of the streams. Defaults to 4 MiB.
+        ///
+        /// \throws parallel_transfer_engine_builder_error If the value is less than or equal to zero.
+        ///
+        /// \return A reference to the builder object.
+        auto chunk_size(std::int64_t _chunk_size) -> parallel_transfer_engine_builder&
+        {
+            chunk_size_ = _chunk_size;
+            return *this;
+        }
+
         /// \brief Sets the offset of the source and sink streams' read/write position.
         ///
         /// Defaults to 0.
@@ -701,6 +945,7 @@ namespace irods::experimental::io
             throw_if_less_than_or_equal_to_zero(number_of_channels_, "number of channels");
             throw_if_less_than_zero(total_bytes_to_transfer_, "total bytes to transfer");
             throw_if_less_than_or_equal_to_zero(transfer_buffer_size_, "transfer buffer size");
+            throw_if_less_than_or_equal_to_zero(chunk_size_, "chunk size");
             throw_if_less_than_zero(offset_, "offset");
 
             return {source_stream_factory_,
@@ -710,7 +955,8 @@ namespace irods::experimental::io
                     number_of_channels_,
                     offset_,
                     transfer_buffer_size_,
-                    restart_file_dir_};
+                    restart_file_dir_,
+                    chunk_size_};
         }
 
     private:
@@ -748,6 +994,7 @@ namespace irods::experimental::io
         std::int64_t total_bytes_to_transfer_;
         std::int64_t offset_;
         std::int64_t transfer_buffer_size_;
+        std::int64_t chunk_size_;
         std::int16_t number_of_channels_;
 
         std::string restart_file_dir_;
@@ -140,6 +140,11 @@ typedef struct {
     char* acl_string;
     int kv_pass;
     char* kv_pass_string;
+
+    int resume;
+
+    int multiSource;
+    char* multiSourceValue;
 } rodsArguments_t;
 
 #ifdef __cplusplus
@@ -4,6 +4,16 @@
 #include "irods_query.hpp"
 #include "rodsErrorTable.h"
 
+#ifdef IRODS_QUERY_ENABLE_SERVER_SIDE_API
+    #include "rs_batch_query.hpp"
+#else
+    #include "batch_query.h"
+#endif // IRODS_QUERY_ENABLE_SERVER_SIDE_API
+
+#include "json.hpp"
+
+#include <cstdlib>
+#include <string>
 #include <vector>
 
 namespace irods::experimental
@@ -14,6 +24,16 @@ namespace irods::experimental
         specific
     };
 
+    /// Holds the result set of a single query executed as part of a batch.
+    ///
+    /// \since 4.2.9
+    struct batch_query_result
+    {
+        int error_code;
+        std::string error_message;
+        std::vector<std::vector<std::string>> rows;
+    }; // struct batch_query_result
+
     class query_builder
     {
     public:
@@ -82,6 +102,81 @@ namespace irods::experimental
                     type_ == query_type::general ? T::GENERAL : T::SPECIFIC};
         }
 
+        /// Executes all queries in a single round trip using the current builder options.
+        ///
+        /// The queries are executed in order by the same agent. A failed query does not stop
+        /// the remaining queries from executing. Check the error code of each result.
+        ///
+        /// \throws irods::exception If the batch could not be executed.
+        ///
+        /// \since 4.2.9
+        template <typename ConnectionType>
+        auto build(ConnectionType& _conn, const std::vector<std::string>& _queries) -> std::vector<batch_query_result>
+        {
+            using json = nlohmann::json;
+
+            if (_queries.empty()) {
+                THROW(USER_INPUT_STRING_ERR, "query list is empty");
+            }
+
+            json query_list = json::array();
+
+            for (const auto& q : _queries) {
+                if (q.empty()) {
+                    THROW(USER_INPUT_STRING_ERR, "query string is empty");
+                }
+
+                json query{
+                    {"query_string", q},
+                    {"query_type", type_ == query_type::general ? "general" : "specific"},
+                    {"zone_hint", zone_hint_},
+                    {"row_limit", limit_},
+                    {"row_offset", offset_}
+                };
+
+                if (args_) {
+                    query["arguments"] = *args_;
+                }
+
+                query_list.push_back(std::move(query));
+            }
+
+            const auto input = json{{"queries", query_list}}.dump();
+            char* output{};
+
+#ifdef IRODS_QUERY_ENABLE_SERVER_SIDE_API
+            const auto ec = rs_batch_query(&_conn, input.data(), &output);
+#else
+            const auto ec = rc_batch_query(&_conn, input.data(), &output);
+#endif // IRODS_QUERY_ENABLE_SERVER_SIDE_API
+
+            json json_output;
+
+            try {
+                json_output = json::parse(output ? output : "{}");
+                std::free(output);
+            }
+            catch (const json::exception& e) {
+                std::free(output);
+                THROW(ec < 0 ? ec : SYS_INTERNAL_ERR, e.what());
+            }
+
+            if (ec < 0) {
+                THROW(ec, json_output.value("error_message", "batch query failed"));
+            }
+
+            std::vector<batch_query_result> results;
+            results.reserve(_queries.size());
+
+            for (const auto& r : json_output.at("results")) {
+                results.push_back({r.at("error_code").get<int>(),
+                                   r.value("error_message", ""),
+                                   r.at("rows").get<std::vector<std::vector<std::string>>>()});
+            }
+
+            return results;
+        }
+
     private:
         const std::vector<std::string>* args_{};
         std::string zone_hint_;
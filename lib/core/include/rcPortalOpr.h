@@ -15,6 +15,9 @@
 #include "QUANTAnet_rbudpBase_c.h"
 #include "QUANTAnet_rbudpSender_c.h"
 #include "QUANTAnet_rbudpReceiver_c.h"
+#include "transfer_compression.hpp"
+
+#include <vector>
 
 #define MAX_PROGRESS_CNT	8
 
@@ -26,6 +29,7 @@ typedef struct RcPortalTransferInp {
     int status;
     rodsLong_t	bytesWritten;
     unsigned char shared_secret[ NAME_LEN ];
+    irods::experimental::transfer_compression::statistics compression_stats;
 } rcPortalTransferInp_t;
 
 typedef enum {
@@ -105,4 +109,18 @@ catDataObj( rcComm_t *conn, char *objPath );
 #ifdef __cplusplus
 }
 #endif
+
+/* readFrame - read a compressed frame (see transfer_compression.hpp) whose
+ * data is at most maxRawSize bytes.
+ */
+int
+readFrame( int sock, rodsLong_t maxRawSize, std::vector<unsigned char>& frame );
+
+/* decodeFrame - decode a compressed frame whose data is at most maxRawSize
+ * bytes into raw.
+ */
+int
+decodeFrame( irods::experimental::transfer_compression::decoder& decoder,
+             const std::vector<unsigned char>& frame, rodsLong_t maxRawSize,
+             std::vector<unsigned char>& raw );
 #endif	// RC_PORTAL_OPR_H__
@@ -76,6 +76,7 @@
 #define VERY_VERBOSE_KW                             "veryVerbose"
 #define RBUDP_SEND_RATE_KW                          "rbudpSendRate"
 #define RBUDP_PACK_SIZE_KW                          "rbudpPackSize"
+#define TRANSFER_COMPRESSION_KW                     "transferCompression" /* codecs the client accepts for parallel transfers */
 #define ZONE_KW                                     "zone"
 #define REMOTE_ZONE_OPR_KW                          "remoteZoneOpr"
 #define REPL_DATA_OBJ_INP_KW                        "replDataObjInp"
@@ -97,6 +98,7 @@
 #define NO_TRANSLATE_LINKPT_KW                      "noTranslateMntpt"  /* don't translate mntpt */
 #define BULK_OPR_KW                                 "bulkOpr"  /* the bulk operation */
 #define NON_BULK_OPR_KW                             "nonBulkOpr"  /* non bulk operation */
+#define RESUME_KW                                   "resume"  /* skip members registered by an earlier extraction */
 #define EXEC_CMD_RULE_KW                            "execCmdRule" /* the rule that invoke execCmd */
 #define EXEC_MY_RULE_KW                             "execMyRule" /* the rule is invoked by rsExecMyRule */
 #define STREAM_STDOUT_KW                            "streamStdout"   /* the stream stdout for
@@ -244,6 +246,9 @@
 #define STAGE_OBJ_KW                                "stage_object"
 #define SYNC_OBJ_KW                                 "sync_object"
 #define IN_REPL_KW                                  "in_repl"
+#define REDIRECT_TOKEN_KW                           "redirect_token" /* signed hierarchy from getHostForPut/Get */
+#define REQUEST_REDIRECT_TOKEN_KW                   "request_redirect_token" /* client accepts a redirect token */
+#define MULTI_SOURCE_KW                             "multi_source" /* replicate from several good replicas at once. optional value is the number of sources */
 
 // =-=-=-=-=-=-=-
 // irods tcp keyword definitions
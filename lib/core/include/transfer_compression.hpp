@@ -0,0 +1,214 @@
+#ifndef IRODS_TRANSFER_COMPRESSION_HPP
+#define IRODS_TRANSFER_COMPRESSION_HPP
+
+/// \file
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/// Compression of the data sent through a parallel transfer portal.
+///
+/// The client offers the codecs it supports (TRANSFER_COMPRESSION_KW) when it opens a data
+/// object for a put or a get. The server chooses one of them according to its configuration
+/// (advanced_settings.parallel_transfer_compression in server_config.json) and announces its
+/// choice in the flags of every transfer header. Servers and clients that do not know about
+/// compression never set or offer it, so they keep exchanging raw bytes.
+///
+/// When compression is in use, every buffer the sender reads is sent as one frame: a header
+/// of frame_header_size bytes (the codec of the payload in byte 0, bytes 1 to 3 reserved,
+/// the raw size in bytes 4 to 7 and the payload size in bytes 8 to 11, in network byte
+/// order) followed by the payload. Frames do not depend on each other, so a frame decodes
+/// at whatever offset of the data object the transfer header places it, and restarted
+/// transfers behave as before. A frame whose data does not shrink is sent as is
+/// (codec::none), so incompressible data costs only the frame header.
+///
+/// Codecs are identified by a byte on the wire. A new codec is added by giving it a value
+/// in the codec enumeration and a case in the encoder and in decode().
+namespace irods::experimental::transfer_compression
+{
+    /// The compression methods known to this library.
+    ///
+    /// \since 4.2.9
+    enum class codec : std::uint8_t
+    {
+        none = 0,
+        deflate = 1
+    }; // enum class codec
+
+    /// The size of the header in front of every frame.
+    ///
+    /// \since 4.2.9
+    constexpr std::size_t frame_header_size = 12;
+
+    /// The lowest and highest compression levels. Higher levels compress better, slower.
+    ///
+    /// \since 4.2.9
+    constexpr int minimum_level = 1;
+    constexpr int maximum_level = 9;
+
+    /// Returns the name of \p _codec, as used in configuration files and keywords.
+    ///
+    /// \since 4.2.9
+    auto to_string(codec _codec) noexcept -> std::string_view;
+
+    /// Returns the codec named \p _name.
+    ///
+    /// \return The codec, or std::nullopt if the name is not known.
+    ///
+    /// \since 4.2.9
+    auto to_codec(std::string_view _name) noexcept -> std::optional<codec>;
+
+    /// Returns the codecs this library supports, as a comma separated list suitable for
+    /// TRANSFER_COMPRESSION_KW.
+    ///
+    /// \since 4.2.9
+    auto supported_codecs() noexcept -> std::string_view;
+
+    /// Chooses the codec to use for a transfer.
+    ///
+    /// \param[in] _offered    The codecs offered by the client, as a comma separated list.
+    /// \param[in] _configured The codec the server is configured to use.
+    ///
+    /// \return \p _configured if the client offered it, codec::none otherwise.
+    ///
+    /// \since 4.2.9
+    auto negotiate(std::string_view _offered, codec _configured) noexcept -> codec;
+
+    /// Returns the transfer header flags announcing the use of \p _codec at \p _level.
+    ///
+    /// \return 0 if \p _codec is codec::none.
+    ///
+    /// \since 4.2.9
+    auto to_flags(codec _codec, int _level) noexcept -> int;
+
+    /// Returns the codec announced in the flags of a transfer header.
+    ///
+    /// \return codec::none if the flags do not announce compression.
+    ///
+    /// \since 4.2.9
+    auto codec_from_flags(int _flags) noexcept -> codec;
+
+    /// Returns the compression level announced in the flags of a transfer header.
+    ///
+    /// \since 4.2.9
+    auto level_from_flags(int _flags) noexcept -> int;
+
+    /// The volume of a transfer before and after compression.
+    ///
+    /// The members are not initialized, so that the structure may be part of the C structures
+    /// describing a transfer. Value-initialize it (statistics{}) to start from zero.
+    ///
+    /// \since 4.2.9
+    struct statistics
+    {
+        /// The number of frames sent or received.
+        std::int64_t frames;
+
+        /// The number of frames sent as is because their data did not shrink.
+        std::int64_t bypassed_frames;
+
+        /// The number of bytes of the data object.
+        std::int64_t raw_bytes;
+
+        /// The number of bytes sent or received, including frame headers.
+        std::int64_t wire_bytes;
+
+        /// Returns raw_bytes / wire_bytes, or 1 if nothing was transferred.
+        auto ratio() const noexcept -> double;
+
+        auto operator+=(const statistics& _other) noexcept -> statistics&;
+    }; // struct statistics
+
+    /// Turns buffers into frames.
+    ///
+    /// An encoder is used by one thread for one stream. After a buffer fails to shrink, the
+    /// encoder does not try to compress the next one or more buffers (up to 16, doubling each
+    /// time compression fails again), so a stream of incompressible data is mostly sent as is
+    /// without paying for the attempts.
+    ///
+    /// \since 4.2.9
+    class encoder
+    {
+    public:
+        /// \param[in] _codec The codec to compress with.
+        /// \param[in] _level The compression level, clamped to [minimum_level, maximum_level].
+        encoder(codec _codec, int _level) noexcept;
+
+        /// Encodes \p _size bytes at \p _data into one frame.
+        ///
+        /// \param[in]  _data  The raw bytes.
+        /// \param[in]  _size  The number of raw bytes. Must not exceed UINT32_MAX.
+        /// \param[out] _frame Receives the frame, header included.
+        ///
+        /// \throws irods::exception If the codec fails.
+        ///
+        /// \return The size of the frame.
+        auto encode(const unsigned char* _data, std::size_t _size, std::vector<unsigned char>& _frame) -> std::size_t;
+
+        /// Returns the statistics of the frames encoded so far.
+        auto stats() const noexcept -> const statistics&;
+
+    private:
+        codec codec_;
+        int level_;
+        int buffers_to_skip_;
+        int skip_after_failure_;
+        statistics stats_;
+    }; // class encoder
+
+    /// The header of a frame.
+    ///
+    /// \since 4.2.9
+    struct frame_header
+    {
+        codec method;
+        std::uint32_t raw_size;
+        std::uint32_t payload_size;
+    }; // struct frame_header
+
+    /// Reads the header at the beginning of a frame.
+    ///
+    /// \param[in] _data At least frame_header_size bytes.
+    ///
+    /// \throws irods::exception If the codec is not known or the sizes are inconsistent.
+    ///
+    /// \since 4.2.9
+    auto read_frame_header(const unsigned char* _data) -> frame_header;
+
+    /// Decodes a frame.
+    ///
+    /// \param[in]  _frame The frame, header included.
+    /// \param[in]  _size  The size of the frame.
+    /// \param[out] _out   Receives the raw bytes.
+    ///
+    /// \throws irods::exception If the frame is malformed or the payload does not decode to
+    ///                          the size given in the header.
+    ///
+    /// \return The number of raw bytes.
+    ///
+    /// \since 4.2.9
+    auto decode(const unsigned char* _frame, std::size_t _size, std::vector<unsigned char>& _out) -> std::size_t;
+
+    /// Turns frames back into buffers, keeping statistics of the frames decoded.
+    ///
+    /// \since 4.2.9
+    class decoder
+    {
+    public:
+        decoder() noexcept;
+
+        /// Decodes a frame. See decode(const unsigned char*, std::size_t, std::vector<unsigned char>&).
+        auto decode(const unsigned char* _frame, std::size_t _size, std::vector<unsigned char>& _out) -> std::size_t;
+
+        /// Returns the statistics of the frames decoded so far.
+        auto stats() const noexcept -> const statistics&;
+
+    private:
+        statistics stats_;
+    }; // class decoder
+} // namespace irods::experimental::transfer_compression
+
+#endif // IRODS_TRANSFER_COMPRESSION_HPP
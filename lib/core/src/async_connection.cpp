@@ -0,0 +1,585 @@
+#include "async_connection.hpp"
+
+#include "apiNumber.h"
+#include "authRequest.h"
+#include "authResponse.h"
+#include "irods_client_api_table.hpp"
+#include "packStruct.h"
+#include "procApiRequest.h"
+#include "rcGlobalExtern.h"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsVersion.h"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <openssl/md5.h>
+
+#include <arpa/inet.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <boost/asio/yield.hpp>
+
+namespace irods::experimental
+{
+    namespace
+    {
+        // Builds the header length, header and message of a request. The byte stream is not
+        // copied. It is sent from the caller's buffer.
+        auto make_request(const char* _type,
+                          const bytesBuf_t* _msg,
+                          const bytesBuf_t* _bs,
+                          int _int_info,
+                          std::vector<char>& _request,
+                          boost::asio::const_buffer& _request_bs) -> int
+        {
+            msgHeader_t header{};
+            std::snprintf(header.type, sizeof(header.type), "%s", _type);
+            header.msgLen = _msg ? _msg->len : 0;
+            header.bsLen = _bs ? _bs->len : 0;
+            header.intInfo = _int_info;
+
+            // The header is always XML.
+            bytesBuf_t* packed_header{};
+            if (const auto ec = pack_struct(&header, &packed_header, "MsgHeader_PI", RodsPackTable, 0, XML_PROT, nullptr); ec < 0) {
+                return ec;
+            }
+
+            const std::uint32_t header_length = htonl(packed_header->len);
+
+            _request.resize(sizeof(header_length) + packed_header->len + header.msgLen);
+
+            auto* out = _request.data();
+            std::memcpy(out, &header_length, sizeof(header_length));
+            out += sizeof(header_length);
+            std::memcpy(out, packed_header->buf, packed_header->len);
+            out += packed_header->len;
+
+            if (header.msgLen > 0) {
+                std::memcpy(out, _msg->buf, header.msgLen);
+            }
+
+            freeBBuf(packed_header);
+
+            if (header.bsLen > 0) {
+                _request_bs = boost::asio::const_buffer{_bs->buf, static_cast<std::size_t>(header.bsLen)};
+            }
+
+            return 0;
+        } // make_request
+    } // anonymous namespace
+
+    // Holds the state of a single request/reply exchange with the server.
+    struct async_connection::exchange
+    {
+        std::vector<char> request;
+        boost::asio::const_buffer request_bs;
+        bool expects_reply = true;
+
+        std::uint32_t reply_header_length{};
+        std::vector<char> reply_header;
+        msgHeader_t reply{};
+        std::vector<char> reply_msg;
+        std::vector<char> reply_error;
+        boost::asio::mutable_buffer reply_bs;
+        std::vector<char> discarded_bs;
+
+        // Invoked with a negative error code if the exchange failed before a complete reply
+        // was read, and with zero otherwise.
+        std::function<void(int _ec, exchange& _exchange)> on_reply;
+    }; // struct exchange
+
+    // Sends a request and reads the reply.
+    struct async_connection::exchange_op : boost::asio::coroutine
+    {
+        async_connection* conn;
+        std::shared_ptr<exchange> x;
+
+        void operator()(const boost::system::error_code& _ec = {}, std::size_t = 0)
+        {
+            reenter (this) {
+                yield {
+                    const std::array<boost::asio::const_buffer, 2> request{boost::asio::buffer(x->request), x->request_bs};
+                    boost::asio::async_write(conn->socket_, request, std::move(*this));
+                }
+
+                if (_ec) {
+                    return fail(SYS_SOCK_WRITE_ERR);
+                }
+
+                if (!x->expects_reply) {
+                    return x->on_reply(0, *x);
+                }
+
+                yield boost::asio::async_read(conn->socket_,
+                                              boost::asio::buffer(&x->reply_header_length, sizeof(x->reply_header_length)),
+                                              std::move(*this));
+
+                if (_ec) {
+                    return fail(SYS_SOCK_READ_ERR);
+                }
+
+                x->reply_header_length = ntohl(x->reply_header_length);
+
+                if (x->reply_header_length == 0 || x->reply_header_length > MAX_NAME_LEN) {
+                    return fail(SYS_HEADER_READ_LEN_ERR);
+                }
+
+                x->reply_header.assign(x->reply_header_length + 1, '\0');
+
+                yield boost::asio::async_read(conn->socket_,
+                                              boost::asio::buffer(x->reply_header.data(), x->reply_header_length),
+                                              std::move(*this));
+
+                if (_ec) {
+                    return fail(SYS_SOCK_READ_ERR);
+                }
+
+                if (const auto ec = unpack_reply_header(); ec < 0) {
+                    return fail(ec);
+                }
+
+                yield {
+                    const auto& h = x->reply;
+
+                    // Leave room for a terminating null, as the network plugins do.
+                    x->reply_msg.assign(h.msgLen + 1, '\0');
+                    x->reply_error.assign(h.errorLen + 1, '\0');
+
+                    // The byte stream is read directly into the caller's buffer when it fits.
+                    // Otherwise it is drained so that the connection remains usable.
+                    if (static_cast<std::size_t>(h.bsLen) > x->reply_bs.size()) {
+                        x->discarded_bs.resize(h.bsLen);
+                        x->reply_bs = boost::asio::buffer(x->discarded_bs);
+                    }
+
+                    const std::array<boost::asio::mutable_buffer, 3> reply{
+                        boost::asio::buffer(x->reply_msg.data(), h.msgLen),
+                        boost::asio::buffer(x->reply_error.data(), h.errorLen),
+                        boost::asio::buffer(x->reply_bs, h.bsLen)};
+
+                    boost::asio::async_read(conn->socket_, reply, std::move(*this));
+                }
+
+                if (_ec) {
+                    return fail(SYS_SOCK_READ_ERR);
+                }
+
+                x->on_reply(0, *x);
+            }
+        }
+
+        auto unpack_reply_header() -> int
+        {
+            // The header is always XML.
+            msgHeader_t* header{};
+            if (const auto ec = unpack_struct(x->reply_header.data(), reinterpret_cast<void**>(&header), "MsgHeader_PI", RodsPackTable, XML_PROT, nullptr); ec < 0) {
+                return ec;
+            }
+
+            x->reply = *header;
+            std::free(header);
+
+            if (x->reply.msgLen < 0 || x->reply.errorLen < 0 || x->reply.bsLen < 0) {
+                return SYS_HEADER_READ_LEN_ERR;
+            }
+
+            return 0;
+        }
+
+        auto fail(int _ec) -> void
+        {
+            // The position in the stream is unknown, so the connection cannot be used anymore.
+            conn->close();
+            x->on_reply(_ec, *x);
+        }
+    }; // struct exchange_op
+
+    // Resolves the host, connects and exchanges the startup pack for the version of the server.
+    struct async_connection::connect_op : boost::asio::coroutine
+    {
+        async_connection* conn;
+        std::string host;
+        std::string port;
+        std::shared_ptr<exchange> startup;
+
+        void operator()(const boost::system::error_code& _ec, const boost::asio::ip::tcp::endpoint&)
+        {
+            (*this)(_ec);
+        }
+
+        void operator()(const boost::system::error_code& _ec = {},
+                        boost::asio::ip::tcp::resolver::results_type _endpoints = {})
+        {
+            reenter (this) {
+                yield conn->resolver_.async_resolve(host, port, std::move(*this));
+
+                if (_ec) {
+                    return startup->on_reply(USER_RODS_HOSTNAME_ERR, *startup);
+                }
+
+                yield boost::asio::async_connect(conn->socket_, _endpoints, std::move(*this));
+
+                if (_ec) {
+                    conn->close();
+                    return startup->on_reply(USER_SOCK_CONNECT_ERR, *startup);
+                }
+
+                {
+                    boost::system::error_code ignored;
+                    conn->socket_.set_option(boost::asio::ip::tcp::no_delay{true}, ignored);
+                    conn->socket_.set_option(boost::asio::socket_base::keep_alive{true}, ignored);
+                }
+
+                conn->start(std::move(startup));
+            }
+        }
+    }; // struct connect_op
+
+    async_connection::async_connection(boost::asio::io_context& _io_context)
+        : io_context_{_io_context}
+        , resolver_{_io_context}
+        , socket_{_io_context}
+        , username_{}
+        , zone_{}
+        , server_version_{}
+    {
+    }
+
+    async_connection::~async_connection()
+    {
+        close();
+    }
+
+    auto async_connection::async_connect(std::string_view _host,
+                                         int _port,
+                                         std::string_view _username,
+                                         std::string_view _zone,
+                                         completion_handler _handler) -> void
+    {
+        username_ = _username;
+        zone_ = _zone;
+
+        startupPack_t startup_pack{};
+        startup_pack.irodsProt = NATIVE_PROT;
+        std::snprintf(startup_pack.proxyUser, sizeof(startup_pack.proxyUser), "%s", username_.c_str());
+        std::snprintf(startup_pack.proxyRodsZone, sizeof(startup_pack.proxyRodsZone), "%s", zone_.c_str());
+        std::snprintf(startup_pack.clientUser, sizeof(startup_pack.clientUser), "%s", username_.c_str());
+        std::snprintf(startup_pack.clientRodsZone, sizeof(startup_pack.clientRodsZone), "%s", zone_.c_str());
+        std::snprintf(startup_pack.relVersion, sizeof(startup_pack.relVersion), "%s", RODS_REL_VERSION);
+        std::snprintf(startup_pack.apiVersion, sizeof(startup_pack.apiVersion), "%s", RODS_API_VERSION);
+
+        auto startup = std::make_shared<exchange>();
+
+        // The startup pack is always XML.
+        bytesBuf_t* packed{};
+        auto ec = pack_struct(&startup_pack, &packed, "StartupPack_PI", RodsPackTable, 0, XML_PROT, nullptr);
+
+        if (ec >= 0) {
+            ec = make_request(RODS_CONNECT_T, packed, nullptr, 0, startup->request, startup->request_bs);
+            freeBBuf(packed);
+        }
+
+        if (ec < 0) {
+            boost::asio::post(io_context_, [ec, handler = std::move(_handler)] { handler(ec); });
+            return;
+        }
+
+        startup->on_reply = [this, handler = std::move(_handler)](int _ec, exchange& _x) {
+            if (_ec < 0) {
+                return handler(_ec);
+            }
+
+            if (std::strcmp(_x.reply.type, RODS_VERSION_T) != 0) {
+                close();
+                return handler(SYS_HEADER_TYPE_LEN_ERR);
+            }
+
+            // The version is always XML.
+            version_t* version{};
+            if (const auto ec = unpack_struct(_x.reply_msg.data(), reinterpret_cast<void**>(&version), "Version_PI", RodsPackTable, XML_PROT, nullptr); ec < 0) {
+                close();
+                return handler(ec);
+            }
+
+            const auto status = version->status;
+            server_version_ = version->relVersion;
+            std::free(version);
+
+            if (status < 0) {
+                close();
+            }
+
+            handler(status);
+        };
+
+        connect_op{{}, this, std::string{_host}, std::to_string(_port), std::move(startup)}();
+    } // async_connect
+
+    auto async_connection::async_login(std::string_view _password, completion_handler _handler) -> void
+    {
+        auto on_challenge = [this, password = std::string{_password}, handler = std::move(_handler)](int _status, void* _output) mutable {
+            auto* request = static_cast<authRequestOut_t*>(_output);
+
+            if (_status < 0 || !request || !request->challenge) {
+                if (request) {
+                    std::free(request->challenge);
+                    std::free(request);
+                }
+
+                return handler(_status < 0 ? _status : SYS_NULL_INPUT);
+            }
+
+            // The response is the MD5 digest of the challenge followed by the password.
+            char md5_buf[CHALLENGE_LEN + MAX_PASSWORD_LEN + 2]{};
+            std::memcpy(md5_buf, request->challenge, CHALLENGE_LEN);
+            std::strncpy(md5_buf + CHALLENGE_LEN, password.c_str(), MAX_PASSWORD_LEN);
+
+            std::free(request->challenge);
+            std::free(request);
+
+            char digest[RESPONSE_LEN + 2]{};
+            MD5_CTX context;
+            MD5_Init(&context);
+            MD5_Update(&context, reinterpret_cast<unsigned char*>(md5_buf), CHALLENGE_LEN + MAX_PASSWORD_LEN);
+            MD5_Final(reinterpret_cast<unsigned char*>(digest), &context);
+
+            // Make sure the digest does not end early.
+            for (int i = 0; i < RESPONSE_LEN; ++i) {
+                if (digest[i] == '\0') {
+                    ++digest[i];
+                }
+            }
+
+            auto user_and_zone = username_ + '#' + zone_;
+
+            authResponseInp_t response{};
+            response.response = digest;
+            response.username = user_and_zone.data();
+
+            async_call(AUTH_RESPONSE_AN, &response, nullptr, nullptr, [handler = std::move(handler)](int _status, void*) {
+                handler(_status);
+            });
+        };
+
+        async_call(AUTH_REQUEST_AN, nullptr, nullptr, nullptr, std::move(on_challenge));
+    } // async_login
+
+    auto async_connection::async_gen_query(const genQueryInp_t& _input, result_handler<genQueryOut_t> _handler) -> void
+    {
+        async_call(GEN_QUERY_AN, &_input, nullptr, nullptr, [handler = std::move(_handler)](int _status, void* _output) {
+            auto* output = static_cast<genQueryOut_t*>(_output);
+
+            if (_status < 0 && output) {
+                freeGenQueryOut(&output);
+            }
+
+            handler(_status, output);
+        });
+    } // async_gen_query
+
+    auto async_connection::async_stat(std::string_view _path, result_handler<rodsObjStat_t> _handler) -> void
+    {
+        dataObjInp_t input{};
+        std::snprintf(input.objPath, sizeof(input.objPath), "%.*s", static_cast<int>(_path.size()), _path.data());
+
+        async_call(OBJ_STAT_AN, &input, nullptr, nullptr, [handler = std::move(_handler)](int _status, void* _output) {
+            auto* output = static_cast<rodsObjStat_t*>(_output);
+
+            if (_status < 0 && output) {
+                freeRodsObjStat(output);
+                output = nullptr;
+            }
+
+            handler(_status, output);
+        });
+    } // async_stat
+
+    auto async_connection::async_open(const dataObjInp_t& _input, completion_handler _handler) -> void
+    {
+        async_call(DATA_OBJ_OPEN_AN, &_input, nullptr, nullptr, [handler = std::move(_handler)](int _status, void*) {
+            handler(_status);
+        });
+    } // async_open
+
+    auto async_connection::async_read(int _fd, void* _buffer, int _count, completion_handler _handler) -> void
+    {
+        openedDataObjInp_t input{};
+        input.l1descInx = _fd;
+        input.len = _count;
+
+        // Describes the caller's buffer until the read completes.
+        auto output_bs = std::make_shared<bytesBuf_t>();
+        output_bs->buf = _buffer;
+        output_bs->len = _count;
+
+        async_call(DATA_OBJ_READ_AN, &input, nullptr, output_bs.get(), [output_bs, handler = std::move(_handler)](int _status, void*) {
+            handler(_status);
+        });
+    } // async_read
+
+    auto async_connection::async_write(int _fd, const void* _buffer, int _count, completion_handler _handler) -> void
+    {
+        openedDataObjInp_t input{};
+        input.l1descInx = _fd;
+        input.len = _count;
+
+        bytesBuf_t input_bs{};
+        input_bs.buf = const_cast<void*>(_buffer);
+        input_bs.len = _count;
+
+        async_call(DATA_OBJ_WRITE_AN, &input, &input_bs, nullptr, [handler = std::move(_handler)](int _status, void*) {
+            handler(_status);
+        });
+    } // async_write
+
+    auto async_connection::async_close(int _fd, completion_handler _handler) -> void
+    {
+        openedDataObjInp_t input{};
+        input.l1descInx = _fd;
+
+        async_call(DATA_OBJ_CLOSE_AN, &input, nullptr, nullptr, [handler = std::move(_handler)](int _status, void*) {
+            handler(_status);
+        });
+    } // async_close
+
+    auto async_connection::async_call(int _api_number,
+                                      const void* _input,
+                                      const bytesBuf_t* _input_bs,
+                                      bytesBuf_t* _output_bs,
+                                      result_handler<void> _handler) -> void
+    {
+        const auto post_error = [this, &_handler](int _ec) {
+            boost::asio::post(io_context_, [_ec, handler = std::move(_handler)] { handler(_ec, nullptr); });
+        };
+
+        const auto api_index = apiTableLookup(_api_number);
+
+        if (api_index < 0) {
+            return post_error(api_index);
+        }
+
+        auto& api_table = irods::get_client_api_table();
+        const auto& api = *api_table[api_index];
+
+        auto x = std::make_shared<exchange>();
+
+        bytesBuf_t* packed_input{};
+
+        if (api.inPackInstruct) {
+            if (!_input) {
+                return post_error(USER_API_INPUT_ERR);
+            }
+
+            const auto ec = pack_struct(_input, &packed_input, api.inPackInstruct, RodsPackTable, 0, NATIVE_PROT, server_version_.c_str());
+
+            if (ec < 0) {
+                return post_error(ec);
+            }
+        }
+
+        const auto ec = make_request(RODS_API_REQ_T,
+                                     packed_input,
+                                     api.inBsFlag > 0 ? _input_bs : nullptr,
+                                     _api_number,
+                                     x->request,
+                                     x->request_bs);
+        freeBBuf(packed_input);
+
+        if (ec < 0) {
+            return post_error(ec);
+        }
+
+        if (_output_bs && _output_bs->buf && _output_bs->len > 0) {
+            x->reply_bs = boost::asio::buffer(_output_bs->buf, _output_bs->len);
+        }
+
+        x->on_reply = [this, out_pack_instruct = api.outPackInstruct, _output_bs, handler = std::move(_handler)](int _ec, exchange& _x) {
+            if (_ec < 0) {
+                return handler(_ec, nullptr);
+            }
+
+            if (std::strcmp(_x.reply.type, RODS_API_REPLY_T) != 0) {
+                close();
+                return handler(SYS_HEADER_TYPE_LEN_ERR, nullptr);
+            }
+
+            const auto status = _x.reply.intInfo;
+
+            if (!_x.discarded_bs.empty()) {
+                return handler(status < 0 ? status : USER_API_INPUT_ERR, nullptr);
+            }
+
+            if (_output_bs) {
+                _output_bs->len = _x.reply.bsLen;
+            }
+
+            void* output{};
+
+            if (out_pack_instruct && _x.reply.msgLen > 0) {
+                const auto ec = unpack_struct(_x.reply_msg.data(), &output, out_pack_instruct, RodsPackTable, NATIVE_PROT, server_version_.c_str());
+
+                if (ec < 0) {
+                    return handler(status < 0 ? status : ec, nullptr);
+                }
+            }
+
+            handler(status, output);
+        };
+
+        start(std::move(x));
+    } // async_call
+
+    auto async_connection::async_disconnect(completion_handler _handler) -> void
+    {
+        auto x = std::make_shared<exchange>();
+        x->expects_reply = false;
+
+        if (const auto ec = make_request(RODS_DISCONNECT_T, nullptr, nullptr, 0, x->request, x->request_bs); ec < 0) {
+            boost::asio::post(io_context_, [ec, handler = std::move(_handler)] { handler(ec); });
+            return;
+        }
+
+        x->on_reply = [this, handler = std::move(_handler)](int _ec, exchange&) {
+            close();
+            handler(_ec);
+        };
+
+        start(std::move(x));
+    } // async_disconnect
+
+    auto async_connection::close() noexcept -> void
+    {
+        boost::system::error_code ignored;
+        resolver_.cancel();
+        socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+    } // close
+
+    auto async_connection::is_open() const noexcept -> bool
+    {
+        return socket_.is_open();
+    } // is_open
+
+    auto async_connection::server_version() const noexcept -> const std::string&
+    {
+        return server_version_;
+    } // server_version
+
+    auto async_connection::start(std::shared_ptr<exchange> _exchange) -> void
+    {
+        exchange_op{{}, this, std::move(_exchange)}();
+    } // start
+} // namespace irods::experimental
+
+#include <boost/asio/unyield.hpp>
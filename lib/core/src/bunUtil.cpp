@@ -113,6 +113,10 @@ initCondForBunOpr( rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs,
                 addKeyVal( &structFileExtAndRegInp->condInput, DATA_TYPE_KW, ZIP_DT_STR );
                 // =-=-=-=-=-=-=-
             }
+            else if ( strcmp( rodsArgs->dataTypeString, ZSTD_TAR_DT_STR ) == 0 ||
+                      strcmp( rodsArgs->dataTypeString, "zstd" ) == 0 ) {
+                addKeyVal( &structFileExtAndRegInp->condInput, DATA_TYPE_KW, ZSTD_TAR_DT_STR );
+            }
             else {
                 rodsLog( LOG_ERROR, "bunUtil: Unknown dataType %s for ibun", // JMC - backport 4648
                          rodsArgs->dataTypeString );
@@ -167,6 +171,10 @@ initCondForBunOpr( rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs,
         addKeyVal( &structFileExtAndRegInp->condInput, BULK_OPR_KW, "" );
     }
 
+    if ( rodsArgs->resume == True ) {  /* --resume - skip members of an earlier extraction */
+        addKeyVal( &structFileExtAndRegInp->condInput, RESUME_KW, "" );
+    }
+
     return 0;
 }
 
@@ -0,0 +1,149 @@
+#include "connection_health.hpp"
+
+#include "irods_log.hpp"
+#include "irods_network_factory.hpp"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "sockCommNetworkInterface.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+namespace irods::experimental::connection_health
+{
+    namespace
+    {
+        tcp_keepalive_options g_default_options;
+
+        auto set_option(int _socket, int _level, int _name, int _value, const char* _description) noexcept -> int
+        {
+            if (_value <= 0) {
+                return 0;
+            }
+
+            const int status = setsockopt(_socket, _level, _name, &_value, sizeof(_value));
+
+            if (status < 0) {
+                rodsLog(LOG_ERROR, "set_tcp_keepalive_options: failed to set %s to %d, errno %d", _description, _value, errno);
+            }
+
+            return status;
+        } // set_option
+    } // anonymous namespace
+
+    auto set_tcp_keepalive_options(int _socket, const tcp_keepalive_options& _options) noexcept -> int
+    {
+        int saved_status = 0;
+
+        const auto keep_first_error = [&saved_status](int _status) {
+            if (_status < 0 && 0 == saved_status) {
+                saved_status = _status;
+            }
+        };
+
+#ifdef TCP_KEEPIDLE
+        keep_first_error(set_option(_socket, IPPROTO_TCP, TCP_KEEPIDLE, _options.idle_in_seconds, "TCP_KEEPIDLE"));
+#endif
+#ifdef TCP_KEEPINTVL
+        keep_first_error(set_option(_socket, IPPROTO_TCP, TCP_KEEPINTVL, _options.interval_in_seconds, "TCP_KEEPINTVL"));
+#endif
+#ifdef TCP_KEEPCNT
+        keep_first_error(set_option(_socket, IPPROTO_TCP, TCP_KEEPCNT, _options.probe_count, "TCP_KEEPCNT"));
+#endif
+#ifdef TCP_USER_TIMEOUT
+        keep_first_error(set_option(_socket, IPPROTO_TCP, TCP_USER_TIMEOUT, _options.user_timeout_in_milliseconds, "TCP_USER_TIMEOUT"));
+#endif
+
+        return saved_status;
+    } // set_tcp_keepalive_options
+
+    auto set_default_tcp_keepalive_options(const tcp_keepalive_options& _options) noexcept -> void
+    {
+        g_default_options = _options;
+    } // set_default_tcp_keepalive_options
+
+    auto default_tcp_keepalive_options() noexcept -> const tcp_keepalive_options&
+    {
+        return g_default_options;
+    } // default_tcp_keepalive_options
+
+    auto add_heartbeat_request(char* _option, std::size_t _size) noexcept -> void
+    {
+        const auto length = std::strlen(_option);
+        const auto negotiation_length = std::strlen(REQ_SVR_NEG);
+
+        // Servers predating the request only drop it as part of the negotiation token. Anywhere
+        // else it would be forwarded to the agent as the name of the client program.
+        if (length < negotiation_length || std::strcmp(_option + length - negotiation_length, REQ_SVR_NEG) != 0) {
+            return;
+        }
+
+        if (_size - length <= std::strlen(heartbeat_request)) {
+            rodsLog(LOG_DEBUG, "add_heartbeat_request: insufficient room in option string [%s]", _option);
+            return;
+        }
+
+        std::strncat(_option, heartbeat_request, _size - length - 1);
+    } // add_heartbeat_request
+
+    auto remove_heartbeat_request(std::string& _option) -> bool
+    {
+        const auto pos = _option.find(heartbeat_request);
+
+        if (std::string::npos == pos) {
+            return false;
+        }
+
+        _option.erase(pos, std::strlen(heartbeat_request));
+
+        return true;
+    } // remove_heartbeat_request
+
+    auto server_supports_heartbeat(const version_t& _version) noexcept -> bool
+    {
+        return _version.status > 0 && (_version.status & heartbeat_supported) != 0;
+    } // server_supports_heartbeat
+
+    auto send_heartbeat(rcComm_t& _conn, int _timeout_in_seconds) -> int
+    {
+        if (!_conn.svrVersion || !server_supports_heartbeat(*_conn.svrVersion)) {
+            return SYS_NOT_SUPPORTED;
+        }
+
+        irods::network_object_ptr net_obj;
+        irods::error ret = irods::network_factory(&_conn, net_obj);
+        if (!ret.ok()) {
+            irods::log(PASS(ret));
+            return ret.code();
+        }
+
+        ret = sendRodsMsg(net_obj, RODS_HEARTBEAT_T, nullptr, nullptr, nullptr, 0, _conn.irodsProt);
+        if (!ret.ok()) {
+            irods::log(PASS(ret));
+            return ret.code();
+        }
+
+        msgHeader_t header{};
+        struct timeval tv{};
+        tv.tv_sec = _timeout_in_seconds;
+
+        ret = readMsgHeader(net_obj, &header, &tv);
+        if (!ret.ok()) {
+            irods::log(PASS(ret));
+            return ret.code();
+        }
+
+        if (std::strcmp(header.type, RODS_HEARTBEAT_T) != 0) {
+            rodsLog(LOG_ERROR, "send_heartbeat: wrong msg type [%s], expected [%s]", header.type, RODS_HEARTBEAT_T);
+            return SYS_HEADER_TYPE_LEN_ERR;
+        }
+
+        return header.intInfo;
+    } // send_heartbeat
+} // namespace irods::experimental::connection_health
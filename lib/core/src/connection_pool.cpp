@@ -1,6 +1,8 @@
 #include "connection_pool.hpp"
 
+#include "connection_health.hpp"
 #include "irods_query.hpp"
+#include "rodsErrorTable.h"
 #include "thread_pool.hpp"
 
 #include <stdexcept>
@@ -172,7 +174,17 @@ namespace irods
         }
 
         try {
-            query<rcComm_t>{ctx.conn.get(), "select ZONE_NAME where ZONE_TYPE = 'local'"};
+            // A heartbeat checks the connection without a round trip to the catalog.
+            // Agents that did not say they answer heartbeats are sent a query instead.
+            const auto ec = experimental::connection_health::send_heartbeat(*ctx.conn);
+
+            if (SYS_NOT_SUPPORTED == ec) {
+                query<rcComm_t>{ctx.conn.get(), "select ZONE_NAME where ZONE_TYPE = 'local'"};
+            }
+            else if (ec < 0) {
+                return false;
+            }
+
             if (std::time(nullptr) - ctx.creation_time > refresh_time_) {
                 return false;
             }
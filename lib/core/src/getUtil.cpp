@@ -122,10 +122,26 @@ getUtil( rcComm_t **myConn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         }
         if ( targPath->objType == LOCAL_FILE_T ) {
             rmKeyVal( &dataObjOprInp.condInput, TRANSLATED_PATH_KW );
+
+            if ( myRodsArgs->redirectConn == True ) {
+                /* connect directly to the resource server of the data object. the
+                 * redirect token spares that server a second hierarchy resolution */
+                rstrcpy( dataObjOprInp.objPath, rodsPathInp->srcPath[i].outPath, MAX_NAME_LEN );
+                addKeyVal( &dataObjOprInp.condInput, REQUEST_REDIRECT_TOKEN_KW, "" );
+                redirectConnToRescSvr( myConn, &dataObjOprInp, myRodsEnv,
+                                       myRodsArgs->reconnect == True ? RECONN_TIMEOUT : NO_RECONN );
+                rmKeyVal( &dataObjOprInp.condInput, REQUEST_REDIRECT_TOKEN_KW );
+                conn = *myConn;
+                myRodsArgs->redirectConn = 0;    /* only do it once */
+            }
+
             status = getDataObjUtil( conn, rodsPathInp->srcPath[i].outPath,
                                      targPath->outPath, rodsPathInp->srcPath[i].size,
                                      rodsPathInp->srcPath[i].objMode,
                                      myRodsArgs, &dataObjOprInp );
+
+            /* the token is bound to this data object */
+            rmKeyVal( &dataObjOprInp.condInput, REDIRECT_TOKEN_KW );
         }
         else if ( targPath->objType ==  LOCAL_DIR_T ) {
             setStateForRestart( &rodsRestart, targPath, myRodsArgs );
@@ -68,9 +68,52 @@ namespace irods
 
     const std::string CFG_DNS_CACHE_KW("dns_cache");
     const std::string CFG_HOSTNAME_CACHE_KW("hostname_cache");
+    const std::string CFG_RESOURCE_FREE_SPACE_MONITOR_KW("resource_free_space_monitor");
+    const std::string CFG_API_PROFILER_KW("api_profiler");
+    const std::string CFG_SPECIAL_COLLECTION_INDEX_KW("special_collection_index");
+    const std::string CFG_SERVER_CONNECTION_BROKER_KW("server_connection_broker");
+    const std::string CFG_MULTI_SOURCE_REPLICATION_KW("multi_source_replication");
+    const std::string CFG_RESUMABLE_REPLICATION_KW("resumable_replication");
+    const std::string CFG_TRANSFER_SCHEDULER_KW("transfer_scheduler");
+    const std::string CFG_NETWORK_TOPOLOGY_KW("network_topology");
+    const std::string CFG_PARALLEL_TRANSFER_COMPRESSION_KW("parallel_transfer_compression");
+    const std::string CFG_AGENT_CONNECTION_HEALTH_KW("agent_connection_health");
 
     const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW("shared_memory_size_in_bytes");
     const std::string CFG_EVICTION_AGE_IN_SECONDS_KW("eviction_age_in_seconds");
+    const std::string CFG_SAMPLING_INTERVAL_IN_SECONDS_KW("sampling_interval_in_seconds");
+    const std::string CFG_CATALOG_UPDATE_INTERVAL_IN_SECONDS_KW("catalog_update_interval_in_seconds");
+    const std::string CFG_MAXIMUM_SAMPLE_AGE_IN_SECONDS_KW("maximum_sample_age_in_seconds");
+    const std::string CFG_API_NUMBERS_KW("api_numbers");
+    const std::string CFG_SAMPLING_FREQUENCY_IN_HZ_KW("sampling_frequency_in_hz");
+    const std::string CFG_SAMPLING_CLOCK_KW("sampling_clock");
+    const std::string CFG_OUTPUT_DIRECTORY_KW("output_directory");
+    const std::string CFG_REFRESH_INTERVAL_IN_SECONDS_KW("refresh_interval_in_seconds");
+    const std::string CFG_MAXIMUM_IDLE_CONNECTIONS_KW("maximum_idle_connections");
+    const std::string CFG_MAXIMUM_IDLE_CONNECTIONS_PER_PEER_KW("maximum_idle_connections_per_peer");
+    const std::string CFG_IDLE_TIMEOUT_IN_SECONDS_KW("idle_timeout_in_seconds");
+    const std::string CFG_MINIMUM_DATA_SIZE_IN_BYTES_KW("minimum_data_size_in_bytes");
+    const std::string CFG_MAXIMUM_NUMBER_OF_SOURCES_KW("maximum_number_of_sources");
+    const std::string CFG_MINIMUM_DATA_SIZE_IN_MEGABYTES_KW("minimum_data_size_in_megabytes");
+    const std::string CFG_CHECKPOINT_INTERVAL_IN_MEGABYTES_KW("checkpoint_interval_in_megabytes");
+    const std::string CFG_MAXIMUM_NUMBER_OF_STREAMS_KW("maximum_number_of_streams");
+    const std::string CFG_MAXIMUM_NUMBER_OF_STREAMS_PER_USER_KW("maximum_number_of_streams_per_user");
+    const std::string CFG_MAXIMUM_MEGABYTES_PER_SECOND_KW("maximum_megabytes_per_second");
+    const std::string CFG_MAXIMUM_MEGABYTES_PER_SECOND_PER_USER_KW("maximum_megabytes_per_second_per_user");
+    const std::string CFG_USER_WEIGHTS_KW("user_weights");
+    const std::string CFG_HOSTS_KW("hosts");
+    const std::string CFG_HOST_KW("host");
+    const std::string CFG_SITE_KW("site");
+    const std::string CFG_RACK_KW("rack");
+    const std::string CFG_SAME_RACK_MEGABYTES_PER_SECOND_KW("same_rack_megabytes_per_second");
+    const std::string CFG_SAME_SITE_MEGABYTES_PER_SECOND_KW("same_site_megabytes_per_second");
+    const std::string CFG_REMOTE_SITE_MEGABYTES_PER_SECOND_KW("remote_site_megabytes_per_second");
+    const std::string CFG_CODEC_KW("codec");
+    const std::string CFG_LEVEL_KW("level");
+    const std::string CFG_TCP_KEEPALIVE_IDLE_IN_SECONDS_KW("tcp_keepalive_idle_in_seconds");
+    const std::string CFG_TCP_KEEPALIVE_INTERVAL_IN_SECONDS_KW("tcp_keepalive_interval_in_seconds");
+    const std::string CFG_TCP_KEEPALIVE_PROBES_KW("tcp_keepalive_probes");
+    const std::string CFG_TCP_USER_TIMEOUT_IN_MILLISECONDS_KW("tcp_user_timeout_in_milliseconds");
 
     // service_account_environment.json keywords
     const std::string CFG_IRODS_USER_NAME_KW( "irods_user_name" );
@@ -30,6 +30,8 @@ namespace irods
     } // instance
 
     server_properties::server_properties()
+        : config_props_{}
+        , configuration_{}
     {
         capture();
     } // ctor
@@ -46,6 +48,8 @@ namespace irods
         if ( ret.ok() ) {
             capture_json( db_cfg );
         }
+
+        capture_configuration();
     } // capture
 
     void server_properties::capture_json( const std::string& _filename )
@@ -56,6 +60,27 @@ namespace irods
         }
     } // capture_json
 
+    void server_properties::capture_configuration()
+    {
+        const auto get = [this](const std::string& _key, int _default) noexcept -> int {
+            try {
+                return config_props_.get<const int>(configuration_parser::key_path_t{CFG_ADVANCED_SETTINGS_KW, _key});
+            }
+            catch (...) {
+                rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Using default [%d].",
+                        CFG_ADVANCED_SETTINGS_KW.data(), _key.data(), _default);
+                return _default;
+            }
+        };
+
+        // The defaults match the ones defined by the server_config schema.
+        auto& config = configuration_;
+        config.default_number_of_transfer_threads = get(CFG_DEF_NUMBER_TRANSFER_THREADS, 4);
+        config.maximum_size_for_single_buffer_in_megabytes = get(CFG_MAX_SIZE_FOR_SINGLE_BUFFER, 32);
+        config.transfer_buffer_size_for_parallel_transfer_in_megabytes = get(CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS, 4);
+        config.transfer_chunk_size_for_parallel_transfer_in_megabytes = get(CFG_TRANS_CHUNK_SIZE_PARA_TRANS, 40);
+    } // capture_configuration
+
     void server_properties::remove( const std::string& _key )
     {
         config_props_.remove( _key );
@@ -158,6 +183,144 @@ namespace irods
         return 3600;
     } // get_hostname_cache_eviction_age
 
+    auto get_resource_free_space_sampling_interval() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_FREE_SPACE_MONITOR_KW).at(CFG_SAMPLING_INTERVAL_IN_SECONDS_KW);
+            const auto seconds = boost::any_cast<int>(wrapped);
+
+            if (seconds > 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid sampling interval for resource free space monitor [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_FREE_SPACE_MONITOR_KW.data(), CFG_SAMPLING_INTERVAL_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default sampling interval for resource free space monitor [default=10].");
+
+        return 10;
+    } // get_resource_free_space_sampling_interval
+
+    auto get_resource_free_space_catalog_update_interval() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_FREE_SPACE_MONITOR_KW).at(CFG_CATALOG_UPDATE_INTERVAL_IN_SECONDS_KW);
+            const auto seconds = boost::any_cast<int>(wrapped);
+
+            if (seconds >= 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid catalog update interval for resource free space monitor [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_FREE_SPACE_MONITOR_KW.data(), CFG_CATALOG_UPDATE_INTERVAL_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default catalog update interval for resource free space monitor [default=300].");
+
+        return 300;
+    } // get_resource_free_space_catalog_update_interval
+
+    auto get_resource_free_space_maximum_sample_age() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_FREE_SPACE_MONITOR_KW).at(CFG_MAXIMUM_SAMPLE_AGE_IN_SECONDS_KW);
+            const auto seconds = boost::any_cast<int>(wrapped);
+
+            if (seconds > 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid maximum sample age for resource free space monitor [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_FREE_SPACE_MONITOR_KW.data(), CFG_MAXIMUM_SAMPLE_AGE_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default maximum sample age for resource free space monitor [default=60].");
+
+        return 60;
+    } // get_resource_free_space_maximum_sample_age
+
+    auto get_special_collection_index_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_SPECIAL_COLLECTION_INDEX_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto bytes = boost::any_cast<int>(wrapped);
+
+            if (bytes > 0) {
+                return bytes;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for special collection index [size=%d].", bytes);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_SPECIAL_COLLECTION_INDEX_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for special collection index [default=1000000].");
+
+        return 1'000'000;
+    } // get_special_collection_index_shared_memory_size
+
+    auto get_special_collection_index_refresh_interval() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_SPECIAL_COLLECTION_INDEX_KW).at(CFG_REFRESH_INTERVAL_IN_SECONDS_KW);
+            const auto seconds = boost::any_cast<int>(wrapped);
+
+            if (seconds >= 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid refresh interval for special collection index [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_SPECIAL_COLLECTION_INDEX_KW.data(), CFG_REFRESH_INTERVAL_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default refresh interval for special collection index [default=300].");
+
+        return 300;
+    } // get_special_collection_index_refresh_interval
+
+    auto get_transfer_scheduler_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_TRANSFER_SCHEDULER_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto bytes = boost::any_cast<int>(wrapped);
+
+            if (bytes > 0) {
+                return bytes;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for transfer scheduler [size=%d].", bytes);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_TRANSFER_SCHEDULER_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for transfer scheduler [default=1000000].");
+
+        return 1'000'000;
+    } // get_transfer_scheduler_shared_memory_size
+
     void parse_and_store_hosts_configuration_file_as_json() noexcept
     {
         try {
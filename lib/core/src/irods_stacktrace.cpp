@@ -87,11 +87,59 @@ namespace irods {
         return *dump_;
     }
 
+    std::vector<std::string> stacktrace::resolve_function_names( const std::vector<void*>& _addresses ) {
+        std::vector<std::string> names;
+        names.reserve( _addresses.size() );
+
+        if ( _addresses.empty() ) {
+            return names;
+        }
+
+        char** symbols = backtrace_symbols( _addresses.data(), static_cast<int>( _addresses.size() ) );
+        if ( !symbols ) {
+            names.assign( _addresses.size(), "[unknown]" );
+            return names;
+        }
+
+        for ( std::size_t i = 0; i < _addresses.size(); ++i ) {
+            const std::string symbol = symbols[i] ? symbols[i] : "";
+
+            std::string demangled;
+            std::string offset;
+            demangle_symbol( symbol, demangled, offset );
+
+            if ( demangled != symbol ) {
+                names.push_back( demangled );
+                continue;
+            }
+
+            // Symbols look like "object(name+offset) [address]". Fall back to the raw
+            // (e.g. C) function name, then to the basename of the containing object.
+            const auto open_paren = symbol.find( '(' );
+            if ( open_paren == std::string::npos ) {
+                names.push_back( "[unknown]" );
+                continue;
+            }
+
+            const auto name_end = symbol.find_first_of( "+)", open_paren );
+            if ( name_end != std::string::npos && name_end > open_paren + 1 ) {
+                names.push_back( symbol.substr( open_paren + 1, name_end - open_paren - 1 ) );
+                continue;
+            }
+
+            const auto object = symbol.substr( 0, open_paren );
+            const auto slash = object.rfind( '/' );
+            names.push_back( object.empty() ? "[unknown]" : object.substr( slash == std::string::npos ? 0 : slash + 1 ) );
+        }
+
+        free( symbols );
+        return names;
+    }
+
     void stacktrace::demangle_symbol (
         const std::string& _symbol,
         std::string& _rtn_name,
-        std::string& _rtn_offset ) const {
-        error result = SUCCESS();
+        std::string& _rtn_offset ) {
         _rtn_name = _symbol; // if we cannot demangle the symbol return the original.
         _rtn_offset.clear();
 
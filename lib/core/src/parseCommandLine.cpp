@@ -192,6 +192,26 @@ parseCmdLineOpt( int argc, char **argv, const char *optString, int includeLong,
                 rodsArgs->add = True;
                 argv[i] = "-Z";
             }
+            if ( strcmp( "--resume", argv[i] ) == 0 ) {
+                rodsArgs->resume = True;
+                argv[i] = "-Z";
+            }
+            /* --multi-source or --multi-source=<number of sources> */
+            if ( strcmp( "--multi-source", argv[i] ) == 0 ) {
+                rodsArgs->multiSource = True;
+                argv[i] = "-Z";
+            }
+            else if ( strncmp( "--multi-source=", argv[i], strlen( "--multi-source=" ) ) == 0 ) {
+                const char *value = argv[i] + strlen( "--multi-source=" );
+                if ( atoi( value ) < 2 ) {
+                    rodsLog( LOG_ERROR,
+                             "--multi-source option needs a number of sources greater than 1" );
+                    return USER_INPUT_OPTION_ERR;
+                }
+                rodsArgs->multiSource = True;
+                rodsArgs->multiSourceValue = strdup( value );
+                argv[i] = "-Z";
+            }
             if ( strcmp( "--showFirstLine", argv[i] ) == 0 ) {
                 rodsArgs->showFirstLine = True;
                 argv[i] = "-Z";
@@ -116,6 +116,11 @@ initCondForPhybunOpr( rodsArguments_t *rodsArgs,
             addKeyVal( &phyBundleCollInp->condInput, DATA_TYPE_KW,
                        ZIP_BUNDLE_DT_STR );
         }
+        else if ( strcmp( rodsArgs->dataTypeString, ZSTD_TAR_DT_STR ) == 0 ||
+                  strcmp( rodsArgs->dataTypeString, "zstd" ) == 0 ) {
+            addKeyVal( &phyBundleCollInp->condInput, DATA_TYPE_KW,
+                       ZSTD_TAR_BUNDLE_DT_STR );
+        }
         else {
             addKeyVal( &phyBundleCollInp->condInput, DATA_TYPE_KW,
                        rodsArgs->dataTypeString );
@@ -277,9 +277,25 @@ putUtil( rcComm_t **myConn, rodsEnv *myRodsEnv,
             }
 
             dataObjOprInp.createMode = rodsPathInp->srcPath[i].objMode;
+
+            if ( myRodsArgs->redirectConn == True && myRodsArgs->force != True ) {
+                /* connect directly to the resource server of the data object. the
+                 * redirect token spares that server a second hierarchy resolution */
+                rstrcpy( dataObjOprInp.objPath, targPath->outPath, MAX_NAME_LEN );
+                addKeyVal( &dataObjOprInp.condInput, REQUEST_REDIRECT_TOKEN_KW, "" );
+                redirectConnToRescSvr( myConn, &dataObjOprInp, myRodsEnv,
+                                       myRodsArgs->reconnect == True ? RECONN_TIMEOUT : NO_RECONN );
+                rmKeyVal( &dataObjOprInp.condInput, REQUEST_REDIRECT_TOKEN_KW );
+                conn = *myConn;
+                myRodsArgs->redirectConn = 0;    /* only do it once */
+            }
+
             status = putFileUtil( conn, rodsPathInp->srcPath[i].outPath,
                                   targPath->outPath, rodsPathInp->srcPath[i].size,
                                   myRodsArgs, &dataObjOprInp );
+
+            /* the token is bound to this data object */
+            rmKeyVal( &dataObjOprInp.condInput, REDIRECT_TOKEN_KW );
         }
         else if ( targPath->objType == COLL_OBJ_T ) {
 
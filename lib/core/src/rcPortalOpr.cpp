@@ -17,6 +17,9 @@
 #include "irods_stacktrace.hpp"
 #include "irods_buffer_encryption.hpp"
 #include "irods_client_server_negotiation.hpp"
+#include "irods_exception.hpp"
+#include "irods_log.hpp"
+#include "transfer_compression.hpp"
 
 #include <openssl/md5.h>
 
@@ -30,6 +33,20 @@
 #include <boost/filesystem/convenience.hpp>
 using namespace boost::filesystem;
 
+namespace tc = irods::experimental::transfer_compression;
+
+namespace {
+    void logCompressionStats( const char* _fn, const tc::statistics& _stats ) {
+        if ( _stats.frames == 0 ) {
+            return;
+        }
+
+        rodsLog( LOG_DEBUG,
+                 "%s: %lld bytes transferred as %lld bytes, compression ratio %.2f, %lld of %lld frames sent uncompressed",
+                 _fn, _stats.raw_bytes, _stats.wire_bytes, _stats.ratio(),
+                 _stats.bypassed_frames, _stats.frames );
+    }
+}
 
 
 int
@@ -89,6 +106,69 @@ rcvTranHeader( int sock, transferHeader_t *myHeader ) {
     return 0;
 }
 
+int
+readFrame( int sock, rodsLong_t maxRawSize, std::vector<unsigned char>& frame ) {
+    frame.resize( tc::frame_header_size );
+
+    int retVal = myRead( sock, frame.data(), tc::frame_header_size, NULL, NULL );
+    if ( retVal != ( int ) tc::frame_header_size ) {
+        rodsLog( LOG_ERROR,
+                 "readFrame: toread = %d, read = %d",
+                 ( int ) tc::frame_header_size, retVal );
+        return retVal < 0 ? retVal : SYS_COPY_LEN_ERR;
+    }
+
+    tc::frame_header header;
+    try {
+        header = tc::read_frame_header( frame.data() );
+    }
+    catch ( const irods::exception& e ) {
+        irods::log( e );
+        return e.code();
+    }
+
+    if ( header.raw_size > maxRawSize ) {
+        rodsLog( LOG_ERROR,
+                 "readFrame: frame of %u bytes exceeds the %lld bytes expected",
+                 header.raw_size, maxRawSize );
+        return SYS_COPY_LEN_ERR;
+    }
+
+    frame.resize( tc::frame_header_size + header.payload_size );
+
+    retVal = myRead( sock, frame.data() + tc::frame_header_size, header.payload_size, NULL, NULL );
+    if ( retVal != ( int ) header.payload_size ) {
+        rodsLog( LOG_ERROR,
+                 "readFrame: toread = %u, read = %d",
+                 header.payload_size, retVal );
+        return retVal < 0 ? retVal : SYS_COPY_LEN_ERR;
+    }
+
+    return 0;
+}
+
+int
+decodeFrame( tc::decoder& decoder, const std::vector<unsigned char>& frame,
+             rodsLong_t maxRawSize, std::vector<unsigned char>& raw ) {
+    try {
+        if ( frame.size() < tc::frame_header_size ||
+                tc::read_frame_header( frame.data() ).raw_size > maxRawSize ) {
+            rodsLog( LOG_ERROR,
+                     "decodeFrame: frame exceeds the %lld bytes expected",
+                     maxRawSize );
+            return SYS_COPY_LEN_ERR;
+        }
+
+        decoder.decode( frame.data(), frame.size(), raw );
+    }
+    catch ( const irods::exception& e ) {
+        irods::log( e );
+        return e.code();
+    }
+
+    return 0;
+}
+
 int
 fillBBufWithFile( rcComm_t *conn, bytesBuf_t *myBBuf, char *locFilePath,
                   rodsLong_t dataSize ) {
@@ -135,7 +215,7 @@ fillBBufWithFile( rcComm_t *conn, bytesBuf_t *myBBuf, char *locFilePath,
 int
 putFileToPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
                  char *locFilePath, char *objPath, rodsLong_t dataSize ) {
-    rcPortalTransferInp_t myInput[MAX_NUM_CONFIG_TRAN_THR];
+    rcPortalTransferInp_t myInput[MAX_NUM_CONFIG_TRAN_THR]{};
     int retVal = 0;
 
     if ( portalOprOut == NULL || portalOprOut->numThreads <= 0 ) {
@@ -188,6 +268,7 @@ putFileToPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
         fillRcPortalTransferInp( conn, &myInput[0], sock, in_fd, 0 );
 
         rcPartialDataPut( &myInput[0] );
+        logCompressionStats( "putFileToPortal", myInput[0].compression_stats );
         if ( myInput[0].status < 0 ) {
             return myInput[0].status;
         }
@@ -205,6 +286,7 @@ putFileToPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
     }
     else {
         rodsLong_t totalWritten = 0;
+        tc::statistics compressionStats{};
         std::unique_ptr<boost::scoped_thread<>> tid[MAX_NUM_CONFIG_TRAN_THR];
         memset( tid, 0, sizeof( tid ) );
 
@@ -246,10 +328,12 @@ putFileToPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
                 }
             }
             totalWritten += myInput[i].bytesWritten;
+            compressionStats += myInput[i].compression_stats;
             if ( myInput[i].status < 0 ) {
                 retVal = myInput[i].status;
             }
         }
+        logCompressionStats( "putFileToPortal", compressionStats );
         if ( retVal < 0 ) {
             return retVal;
         }
@@ -281,6 +365,7 @@ fillRcPortalTransferInp( rcComm_t *conn, rcPortalTransferInp_t *myInput,
     myInput->destFd = destFd;
     myInput->srcFd = srcFd;
     myInput->threadNum = threadNum;
+    myInput->compression_stats = {};
     memcpy( myInput->shared_secret, conn->shared_secret, NAME_LEN );
 
     return 0;
@@ -363,6 +448,11 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
     unsigned char* buf = ( unsigned char* )malloc( buf_size );
     transferHeader_t myHeader;
 
+    // =-=-=-=-=-=-=-
+    // the server asks for compressed frames in the flags of the header
+    std::optional<tc::encoder> compressor;
+    std::vector<unsigned char> frame;
+
     while ( myInput->status >= 0 ) {
         rodsLong_t toPut;
 
@@ -375,6 +465,11 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
         if ( myHeader.oprType == DONE_OPR ) {
             break;
         }
+
+        const tc::codec codec = tc::codec_from_flags( myHeader.flags );
+        if ( codec != tc::codec::none && !compressor ) {
+            compressor.emplace( codec, tc::level_from_flags( myHeader.flags ) );
+        }
         if ( myHeader.offset != curOffset ) {
             curOffset = myHeader.offset;
             if ( lseek( srcFd, curOffset, SEEK_SET ) < 0 ) {
@@ -415,10 +510,29 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
                 break;
             }
 
+            // =-=-=-=-=-=-=-
+            // compress the buffer into a frame, which is then
+            // encrypted like a plain buffer
+            int new_size = bytesRead;
+            if ( codec != tc::codec::none ) {
+                try {
+                    new_size = compressor->encode( buf, bytesRead, frame );
+                }
+                catch ( const irods::exception& e ) {
+                    irods::log( e );
+                    myInput->status = e.code();
+                    break;
+                }
+
+                std::copy(
+                    frame.begin(),
+                    frame.end(),
+                    &buf[0] );
+            }
+
             // =-=-=-=-=-=-=-
             // compute an iv for this particular transmission and use
             // it to encrypt this buffer
-            int new_size = bytesRead;
             if ( use_encryption_flg ) {
                 irods::error ret = crypt.initialization_vector( iv );
                 if ( !ret.ok() ) {
@@ -431,7 +545,7 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
                 // encrypt
                 in_buf.assign(
                     &buf[0],
-                    &buf[ bytesRead ] );
+                    &buf[ new_size ] );
                 ret = crypt.encrypt(
                           shared_secret,
                           iv,
@@ -518,6 +632,9 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
         }
     }
 
+    if ( compressor ) {
+        myInput->compression_stats = compressor->stats();
+    }
 
     free( buf );
     close( srcFd );
@@ -832,7 +949,7 @@ getFile( rcComm_t *conn, int l1descInx, char *locFilePath, char *objPath,
 int
 getFileFromPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
                    char *locFilePath, char *objPath, rodsLong_t dataSize ) {
-    rcPortalTransferInp_t myInput[MAX_NUM_CONFIG_TRAN_THR];
+    rcPortalTransferInp_t myInput[MAX_NUM_CONFIG_TRAN_THR]{};
     int retVal = 0;
 
     if ( portalOprOut == NULL || portalOprOut->numThreads <= 0 ) {
@@ -883,6 +1000,7 @@ getFileFromPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
         }
         fillRcPortalTransferInp( conn, &myInput[0], out_fd, sock, 0640 );
         rcPartialDataGet( &myInput[0] );
+        logCompressionStats( "getFileFromPortal", myInput[0].compression_stats );
         if ( myInput[0].status < 0 ) {
             return myInput[0].status;
         }
@@ -900,6 +1018,7 @@ getFileFromPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
     }
     else {
         rodsLong_t totalWritten = 0;
+        tc::statistics compressionStats{};
         std::unique_ptr<boost::scoped_thread<>> tid[MAX_NUM_CONFIG_TRAN_THR];
         memset( tid, 0, sizeof( tid ) );
 
@@ -948,10 +1067,12 @@ getFileFromPortal( rcComm_t *conn, portalOprOut_t *portalOprOut,
                 }
             }
             totalWritten += myInput[i].bytesWritten;
+            compressionStats += myInput[i].compression_stats;
             if ( myInput[i].status < 0 ) {
                 retVal = myInput[i].status;
             }
         }
+        logCompressionStats( "getFileFromPortal", compressionStats );
         if ( retVal < 0 ) {
             return retVal;
         }
@@ -1049,6 +1170,12 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
     rodsLong_t buf_size = ( 2 * trans_buff_sz ) * sizeof( unsigned char );
     buf = ( unsigned char* )malloc( buf_size );
 
+    // =-=-=-=-=-=-=-
+    // the server announces compressed frames in the flags of the header
+    tc::decoder decompressor;
+    std::vector<unsigned char> frame;
+    std::vector<unsigned char> raw;
+
     while ( myInput->status >= 0 ) {
 
         myInput->status = rcvTranHeader( srcFd, &myHeader );
@@ -1060,6 +1187,9 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
         if ( myHeader.oprType == DONE_OPR ) {
             break;
         }
+
+        const bool decompress_flg =
+            ( tc::codec_from_flags( myHeader.flags ) != tc::codec::none );
         if ( myHeader.offset != curOffset ) {
             curOffset = myHeader.offset;
             if ( lseek( destFd, curOffset, SEEK_SET ) < 0 ) {
@@ -1102,22 +1232,36 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
                     break;
                 }
             }
+            else if ( decompress_flg ) {
+                // =-=-=-=-=-=-=-
+                // without encryption, a frame carries the size of its payload
+                myInput->status = readFrame( srcFd, toGet, frame );
+                if ( myInput->status < 0 ) {
+                    break;
+                }
+                new_size = frame.size();
+            }
 
             // =-=-=-=-=-=-=-
             // now read the provided number of bytes as suggested by
             // the incoming size
-            bytesRead = myRead(
-                            srcFd,
-                            buf,
-                            new_size,
-                            &bytesRead,
-                            NULL );
-            if ( bytesRead != new_size ) {
-                myInput->status = SYS_COPY_LEN_ERR - errno;
-                rodsLogError( LOG_ERROR, myInput->status,
-                              "rcPartialDataGet: toGet %lld, bytesRead %d",
-                              toGet, bytesRead );
-                break;
+            if ( !decompress_flg || use_encryption_flg ) {
+                bytesRead = myRead(
+                                srcFd,
+                                buf,
+                                new_size,
+                                &bytesRead,
+                                NULL );
+                if ( bytesRead != new_size ) {
+                    myInput->status = SYS_COPY_LEN_ERR - errno;
+                    rodsLogError( LOG_ERROR, myInput->status,
+                                  "rcPartialDataGet: toGet %lld, bytesRead %d",
+                                  toGet, bytesRead );
+                    break;
+                }
+            }
+            else {
+                bytesRead = new_size;
             }
 
             // =-=-=-=-=-=-=-
@@ -1151,9 +1295,24 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
 
             }
 
+            // =-=-=-=-=-=-=-
+            // decompress the frame before writing
+            unsigned char* out_buf = buf;
+            if ( decompress_flg ) {
+                if ( use_encryption_flg ) {
+                    frame.assign( &buf[0], &buf[ plain_size ] );
+                }
+                myInput->status = decodeFrame( decompressor, frame, toGet, raw );
+                if ( myInput->status < 0 ) {
+                    break;
+                }
+                plain_size = raw.size();
+                out_buf = raw.data();
+            }
+
             bytesWritten = myWrite(
                                destFd,
-                               buf,
+                               out_buf,
                                plain_size,
                                &bytesWritten );
             if ( bytesWritten != plain_size ) {
@@ -1197,6 +1356,8 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
         }
     }
 
+    myInput->compression_stats = decompressor.stats();
+
     free( buf );
     close( destFd );
     CLOSE_SOCK( srcFd );
@@ -254,6 +254,11 @@ initCondForRepl( rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs,
                  "initCondForPut: --wlock not supported, changing it to --rlock" );
         addKeyVal( &dataObjInp->condInput, LOCK_TYPE_KW, READ_LOCK_TYPE );
     }
+    if ( rodsArgs->multiSource == True ) {
+        /* an empty value lets the server use as many sources as it allows */
+        addKeyVal( &dataObjInp->condInput, MULTI_SOURCE_KW,
+                   rodsArgs->multiSourceValue ? rodsArgs->multiSourceValue : "" );
+    }
 
     return 0;
 }
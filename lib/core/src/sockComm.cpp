@@ -36,6 +36,7 @@
 #include "irods_random.hpp"
 #include "hostname_cache.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "connection_health.hpp"
 
 #include <json.hpp>
 
@@ -647,6 +648,13 @@ rodsSetSockOpt( int sock, int tcp_buffer_size ) {
         rodsLog(LOG_ERROR, "rodsSetSockOpt: failed to set SO_KEEPALIVE, errno %d", errno);
         savedStatus = status;
     }
+    else {
+        namespace ch = irods::experimental::connection_health;
+        status = ch::set_tcp_keepalive_options( sock, ch::default_tcp_keepalive_options() );
+        if ( status < 0 ) {
+            savedStatus = status;
+        }
+    }
 
     struct linger linger;
     linger.l_onoff = 1;
@@ -1153,6 +1161,10 @@ sendStartupPack( rcComm_t *conn, int connectCnt, int reconnFlag ) {
         }
     }
 
+    // ask the agent whether it answers heartbeats. the request is only added right after
+    // the negotiation token so that servers predating it strip it along with that token.
+    irods::experimental::connection_health::add_heartbeat_request( startupPack.option, sizeof( startupPack.option ) );
+
     /* always use XML_PROT for the startupPack */
     status = pack_struct( ( void * ) &startupPack, &startupPackBBuf,
                          "StartupPack_PI", RodsPackTable, 0, XML_PROT, nullptr);
@@ -1557,11 +1569,29 @@ redirectConnToRescSvr( rcComm_t **conn, dataObjInp_t *dataObjInp,
         return 0;
     }
 
-    if ( status < 0 || outHost == NULL || strcmp( outHost, THIS_ADDRESS ) == 0 ) {
+    if ( status < 0 || outHost == NULL ) {
+        free( outHost );
         return status;
     }
 
-    status = rcReconnect( conn, outHost, myEnv, reconnFlag );
+    // if the caller set REQUEST_REDIRECT_TOKEN_KW, a server that supports it follows the
+    // host with a newline and a token carrying the hierarchy it resolved. hand the token
+    // to the server that performs the transfer so that it does not resolve it again.
+    rmKeyVal( &dataObjInp->condInput, REDIRECT_TOKEN_KW );
+    if ( char* token = strchr( outHost, '\n' ) ) {
+        *token++ = '\0';
+        addKeyVal( &dataObjInp->condInput, REDIRECT_TOKEN_KW, token );
+    }
+
+    if ( strcmp( outHost, THIS_ADDRESS ) != 0 ) {
+        status = rcReconnect( conn, outHost, myEnv, reconnFlag );
+        if ( status < 0 ) {
+            // the token only applies to the host it was issued for
+            rmKeyVal( &dataObjInp->condInput, REDIRECT_TOKEN_KW );
+        }
+    }
+
+    free( outHost );
     return status;
 }
 
@@ -0,0 +1,310 @@
+#include "transfer_compression.hpp"
+
+#include "dataObjInpOut.h"
+#include "irods_exception.hpp"
+#include "rodsErrorTable.h"
+
+#include <fmt/format.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <arpa/inet.h>
+
+namespace irods::experimental::transfer_compression
+{
+    namespace
+    {
+        // Layout of the codec and the level in the flags of a transfer header.
+        constexpr int codec_shift = 8;
+        constexpr int level_shift = 16;
+        constexpr int byte_mask = 0xff;
+
+        // The longest run of buffers the encoder sends without trying to compress them.
+        constexpr int maximum_buffers_to_skip = 16;
+
+        auto is_known(std::uint8_t _value) noexcept -> bool
+        {
+            return _value == static_cast<std::uint8_t>(codec::none) ||
+                   _value == static_cast<std::uint8_t>(codec::deflate);
+        } // is_known
+
+        auto clamp_level(int _level) noexcept -> int
+        {
+            return std::clamp(_level, minimum_level, maximum_level);
+        } // clamp_level
+
+        auto write_frame_header(const frame_header& _header, unsigned char* _out) noexcept -> void
+        {
+            const std::uint32_t raw_size = htonl(_header.raw_size);
+            const std::uint32_t payload_size = htonl(_header.payload_size);
+
+            _out[0] = static_cast<unsigned char>(_header.method);
+            _out[1] = _out[2] = _out[3] = 0;
+            std::memcpy(_out + 4, &raw_size, sizeof(raw_size));
+            std::memcpy(_out + 8, &payload_size, sizeof(payload_size));
+        } // write_frame_header
+
+        // Compresses _size bytes into _out (after the frame header).
+        // Returns the size of the payload, or std::nullopt if the data did not shrink.
+        auto deflate(const unsigned char* _data, std::size_t _size, int _level, std::vector<unsigned char>& _out)
+            -> std::optional<std::size_t>
+        {
+            auto payload_size = static_cast<uLongf>(compressBound(static_cast<uLong>(_size)));
+            _out.resize(frame_header_size + payload_size);
+
+            const auto ec = compress2(_out.data() + frame_header_size, &payload_size, _data, static_cast<uLong>(_size), _level);
+
+            if (Z_OK != ec) {
+                THROW(SYS_LIBRARY_ERROR, fmt::format("transfer_compression: deflate failed [error code={}]", ec));
+            }
+
+            if (payload_size >= _size) {
+                return std::nullopt;
+            }
+
+            return payload_size;
+        } // deflate
+    } // anonymous namespace
+
+    auto to_string(codec _codec) noexcept -> std::string_view
+    {
+        switch (_codec) {
+            case codec::deflate: return "deflate";
+            default:             return "none";
+        }
+    } // to_string
+
+    auto to_codec(std::string_view _name) noexcept -> std::optional<codec>
+    {
+        if (_name == "none") {
+            return codec::none;
+        }
+
+        if (_name == "deflate") {
+            return codec::deflate;
+        }
+
+        return std::nullopt;
+    } // to_codec
+
+    auto supported_codecs() noexcept -> std::string_view
+    {
+        return "deflate";
+    } // supported_codecs
+
+    auto negotiate(std::string_view _offered, codec _configured) noexcept -> codec
+    {
+        if (codec::none == _configured) {
+            return codec::none;
+        }
+
+        const auto name = to_string(_configured);
+
+        while (!_offered.empty()) {
+            const auto comma = _offered.find(',');
+            const auto offer = _offered.substr(0, comma);
+
+            if (offer == name) {
+                return _configured;
+            }
+
+            if (std::string_view::npos == comma) {
+                break;
+            }
+
+            _offered.remove_prefix(comma + 1);
+        }
+
+        return codec::none;
+    } // negotiate
+
+    auto to_flags(codec _codec, int _level) noexcept -> int
+    {
+        if (codec::none == _codec) {
+            return 0;
+        }
+
+        return TRANSFER_COMPRESSION_FLAG |
+               (static_cast<int>(_codec) << codec_shift) |
+               (clamp_level(_level) << level_shift);
+    } // to_flags
+
+    auto codec_from_flags(int _flags) noexcept -> codec
+    {
+        if (0 == (_flags & TRANSFER_COMPRESSION_FLAG)) {
+            return codec::none;
+        }
+
+        const auto value = static_cast<std::uint8_t>((_flags >> codec_shift) & byte_mask);
+
+        return is_known(value) ? static_cast<codec>(value) : codec::none;
+    } // codec_from_flags
+
+    auto level_from_flags(int _flags) noexcept -> int
+    {
+        return clamp_level((_flags >> level_shift) & byte_mask);
+    } // level_from_flags
+
+    auto statistics::ratio() const noexcept -> double
+    {
+        if (0 == wire_bytes) {
+            return 1.0;
+        }
+
+        return static_cast<double>(raw_bytes) / static_cast<double>(wire_bytes);
+    } // statistics::ratio
+
+    auto statistics::operator+=(const statistics& _other) noexcept -> statistics&
+    {
+        frames += _other.frames;
+        bypassed_frames += _other.bypassed_frames;
+        raw_bytes += _other.raw_bytes;
+        wire_bytes += _other.wire_bytes;
+        return *this;
+    } // statistics::operator+=
+
+    encoder::encoder(codec _codec, int _level) noexcept
+        : codec_{_codec}
+        , level_{clamp_level(_level)}
+        , buffers_to_skip_{}
+        , skip_after_failure_{1}
+        , stats_{}
+    {
+    } // encoder
+
+    auto encoder::encode(const unsigned char* _data, std::size_t _size, std::vector<unsigned char>& _frame) -> std::size_t
+    {
+        if (_size > std::numeric_limits<std::uint32_t>::max()) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("transfer_compression: buffer too large for a frame [size={}]", _size));
+        }
+
+        std::optional<std::size_t> payload_size;
+
+        if (buffers_to_skip_ > 0) {
+            --buffers_to_skip_;
+        }
+        else if (codec::deflate == codec_) {
+            payload_size = deflate(_data, _size, level_, _frame);
+
+            if (payload_size) {
+                skip_after_failure_ = 1;
+            }
+            else {
+                buffers_to_skip_ = skip_after_failure_;
+                skip_after_failure_ = std::min(2 * skip_after_failure_, maximum_buffers_to_skip);
+            }
+        }
+
+        frame_header header{codec_, static_cast<std::uint32_t>(_size), static_cast<std::uint32_t>(_size)};
+
+        if (payload_size) {
+            header.payload_size = static_cast<std::uint32_t>(*payload_size);
+            _frame.resize(frame_header_size + *payload_size);
+        }
+        else {
+            header.method = codec::none;
+            _frame.resize(frame_header_size + _size);
+            std::copy(_data, _data + _size, _frame.data() + frame_header_size);
+            ++stats_.bypassed_frames;
+        }
+
+        write_frame_header(header, _frame.data());
+
+        ++stats_.frames;
+        stats_.raw_bytes += _size;
+        stats_.wire_bytes += _frame.size();
+
+        return _frame.size();
+    } // encoder::encode
+
+    auto encoder::stats() const noexcept -> const statistics&
+    {
+        return stats_;
+    } // encoder::stats
+
+    auto read_frame_header(const unsigned char* _data) -> frame_header
+    {
+        if (!is_known(_data[0])) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("transfer_compression: unknown codec in frame [codec={}]", _data[0]));
+        }
+
+        std::uint32_t raw_size;
+        std::uint32_t payload_size;
+        std::memcpy(&raw_size, _data + 4, sizeof(raw_size));
+        std::memcpy(&payload_size, _data + 8, sizeof(payload_size));
+
+        frame_header header{static_cast<codec>(_data[0]), ntohl(raw_size), ntohl(payload_size)};
+
+        // Payloads never grow, because a buffer that does not shrink is sent as is.
+        if (header.payload_size > header.raw_size ||
+            (codec::none == header.method && header.payload_size != header.raw_size))
+        {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("transfer_compression: inconsistent frame sizes [raw={}, payload={}]",
+                                                       header.raw_size, header.payload_size));
+        }
+
+        return header;
+    } // read_frame_header
+
+    auto decode(const unsigned char* _frame, std::size_t _size, std::vector<unsigned char>& _out) -> std::size_t
+    {
+        if (_size < frame_header_size) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("transfer_compression: frame too short [size={}]", _size));
+        }
+
+        const auto header = read_frame_header(_frame);
+
+        if (_size != frame_header_size + header.payload_size) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("transfer_compression: frame size does not match its header [size={}, payload={}]",
+                                                       _size, header.payload_size));
+        }
+
+        const auto* payload = _frame + frame_header_size;
+
+        _out.resize(header.raw_size);
+
+        if (codec::none == header.method) {
+            std::copy(payload, payload + header.payload_size, _out.data());
+            return _out.size();
+        }
+
+        auto raw_size = static_cast<uLongf>(header.raw_size);
+        const auto ec = uncompress(_out.data(), &raw_size, payload, static_cast<uLong>(header.payload_size));
+
+        if (Z_OK != ec || raw_size != header.raw_size) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("transfer_compression: payload does not decode [error code={}, expected={}, decoded={}]",
+                                                       ec, header.raw_size, raw_size));
+        }
+
+        return _out.size();
+    } // decode
+
+    decoder::decoder() noexcept
+        : stats_{}
+    {
+    } // decoder
+
+    auto decoder::decode(const unsigned char* _frame, std::size_t _size, std::vector<unsigned char>& _out) -> std::size_t
+    {
+        const auto raw_size = transfer_compression::decode(_frame, _size, _out);
+
+        if (codec::none == static_cast<codec>(_frame[0])) {
+            ++stats_.bypassed_frames;
+        }
+
+        ++stats_.frames;
+        stats_.raw_bytes += raw_size;
+        stats_.wire_bytes += _size;
+
+        return raw_size;
+    } // decoder::decode
+
+    auto decoder::stats() const noexcept -> const statistics&
+    {
+        return stats_;
+    } // decoder::stats
+} // namespace irods::experimental::transfer_compression
@@ -4,6 +4,7 @@
 #include "filesystem/filesystem.hpp"
 #include "filesystem/filesystem_error.hpp"
 #include "filesystem/path.hpp"
+#include "filesystem/metadata_cache.hpp"
 #include "filesystem/collection_iterator.hpp"
 #include "filesystem/recursive_collection_iterator.hpp"
 
@@ -193,6 +193,17 @@ namespace irods::experimental::filesystem
                   typename = std::enable_if_t<std::is_same_v<std::decay_t<typename Container::value_type>, metadata>>>
         auto remove_metadata(rxComm& _comm, const path& _p, const Container& _container) -> void;
 
+        /// \brief Discards the cached information about a path and the paths under it.
+        ///
+        /// Does nothing unless a metadata cache is installed for the calling thread. Clients that
+        /// modify objects through other APIs (e.g. dstream) can use this to observe their changes
+        /// before the cached information expires.
+        ///
+        /// \param[in] _p The path to a data object or collection.
+        ///
+        /// \see metadata_cache
+        auto invalidate_metadata_cache(const path& _p) -> void;
+
         #include "filesystem/filesystem.tpp"
     } // namespace NAMESPACE_IMPL
 } // namespace irods::experimental::filesystem
@@ -0,0 +1,170 @@
+#ifndef IRODS_FILESYSTEM_METADATA_CACHE_HPP
+#define IRODS_FILESYSTEM_METADATA_CACHE_HPP
+
+/// \file
+
+#include "filesystem/config.hpp"
+#include "filesystem/filesystem.hpp"
+#include "filesystem/object_status.hpp"
+#include "filesystem/path.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace irods::experimental::filesystem::NAMESPACE_IMPL
+{
+    /// A bounded cache of the information the filesystem library fetches about paths.
+    ///
+    /// The cache is opt-in. Once installed for a thread via scoped_metadata_cache, status(),
+    /// get_metadata(), data_object_size() and last_write_time() (and every function built on
+    /// top of them, such as exists() and is_collection()) answer from the cache until the
+    /// cached information expires. Functions of this library that modify the catalog discard
+    /// the information they invalidate. Changes made by other clients or through other APIs
+    /// are only observed once the cached information expires, so the time-to-live bounds how
+    /// stale the answers may be.
+    ///
+    /// What a path looks like depends on who is asking, so cached information is only
+    /// returned to connections with the same identity (host, proxy user and client user) as
+    /// the connection it was fetched through. Invalidation discards the information cached
+    /// for every identity.
+    ///
+    /// Instances are safe to share between threads and connections.
+    ///
+    /// \since 4.2.9
+    class metadata_cache
+    {
+    public:
+        /// Counters describing how effective the cache is.
+        ///
+        /// \since 4.2.9
+        struct statistics_type
+        {
+            std::uint64_t hits;
+            std::uint64_t misses;
+            std::uint64_t evictions;
+            std::uint64_t invalidations;
+        }; // struct statistics_type
+
+        /// Constructs an empty cache.
+        ///
+        /// \param[in] _capacity The maximum number of paths held by the cache. When full,
+        ///                      the least recently used path is evicted.
+        /// \param[in] _ttl      How long cached information is trusted.
+        ///
+        /// \since 4.2.9
+        metadata_cache(std::size_t _capacity, std::chrono::milliseconds _ttl);
+
+        metadata_cache(const metadata_cache&) = delete;
+        auto operator=(const metadata_cache&) -> metadata_cache& = delete;
+
+        // clang-format off
+        auto find_status(rxComm& _comm, const path& _p) -> std::optional<object_status>;
+        auto find_metadata(rxComm& _comm, const path& _p) -> std::optional<std::vector<metadata>>;
+        auto find_data_object_size(rxComm& _comm, const path& _p) -> std::optional<std::uintmax_t>;
+        auto find_last_write_time(rxComm& _comm, const path& _p) -> std::optional<object_time_type>;
+
+        auto insert_status(rxComm& _comm, const path& _p, const object_status& _s) -> void;
+        auto insert_metadata(rxComm& _comm, const path& _p, const std::vector<metadata>& _md) -> void;
+        auto insert_data_object_size(rxComm& _comm, const path& _p, std::uintmax_t _size) -> void;
+        auto insert_last_write_time(rxComm& _comm, const path& _p, object_time_type _mtime) -> void;
+        // clang-format on
+
+        /// Discards everything cached about \p _p.
+        ///
+        /// \since 4.2.9
+        auto invalidate(const path& _p) -> void;
+
+        /// Discards everything cached about \p _p and the paths under it.
+        ///
+        /// \since 4.2.9
+        auto invalidate_all(const path& _p) -> void;
+
+        /// Discards everything.
+        ///
+        /// \since 4.2.9
+        auto clear() -> void;
+
+        /// Returns the number of paths held by the cache.
+        ///
+        /// \since 4.2.9
+        auto size() const -> std::size_t;
+
+        /// \since 4.2.9
+        auto statistics() const -> statistics_type;
+
+    private:
+        using clock_type = std::chrono::steady_clock;
+
+        template <typename T>
+        struct timed_value
+        {
+            T value;
+            clock_type::time_point expiration;
+        }; // struct timed_value
+
+        struct values
+        {
+            std::optional<timed_value<object_status>> status;
+            std::optional<timed_value<std::vector<metadata>>> metadata_entries;
+            std::optional<timed_value<std::uintmax_t>> data_object_size;
+            std::optional<timed_value<object_time_type>> last_write_time;
+        }; // struct values
+
+        struct entry
+        {
+            std::unordered_map<std::string, values> values_by_identity;
+            std::list<std::string>::iterator lru_position;
+        }; // struct entry
+
+        template <typename T>
+        auto find(rxComm& _comm, const path& _p, std::optional<timed_value<T>> values::*_member)
+            -> std::optional<T>;
+
+        template <typename T>
+        auto insert(rxComm& _comm,
+                    const path& _p,
+                    std::optional<timed_value<T>> values::*_member,
+                    const T& _value) -> void;
+
+        const std::size_t capacity_;
+        const std::chrono::milliseconds ttl_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, entry> entries_;
+        std::list<std::string> lru_; // Most recently used first.
+        statistics_type stats_;
+    }; // class metadata_cache
+
+    /// Installs a metadata cache for the calling thread for the lifetime of this object.
+    ///
+    /// The previously installed cache, if any, is restored on destruction.
+    ///
+    /// \since 4.2.9
+    class scoped_metadata_cache
+    {
+    public:
+        explicit scoped_metadata_cache(metadata_cache& _cache) noexcept;
+
+        scoped_metadata_cache(const scoped_metadata_cache&) = delete;
+        auto operator=(const scoped_metadata_cache&) -> scoped_metadata_cache& = delete;
+
+        ~scoped_metadata_cache();
+
+    private:
+        metadata_cache* previous_;
+    }; // class scoped_metadata_cache
+
+    /// Returns the metadata cache installed for the calling thread, or nullptr.
+    ///
+    /// \since 4.2.9
+    auto current_metadata_cache() noexcept -> metadata_cache*;
+} // namespace irods::experimental::filesystem::NAMESPACE_IMPL
+
+#endif // IRODS_FILESYSTEM_METADATA_CACHE_HPP
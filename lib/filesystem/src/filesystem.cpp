@@ -2,6 +2,7 @@
 
 #include "filesystem/path.hpp"
 #include "filesystem/collection_iterator.hpp"
+#include "filesystem/metadata_cache.hpp"
 
 // clang-format off
 #ifdef IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
@@ -214,6 +215,17 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
             return collection_iterator{} == collection_iterator{_comm, _p};
         }
 
+        // Discards the cached information invalidated by creating, removing or renaming _p,
+        // including the mtime of the parent collection.
+        auto invalidate_path_and_parent(const path& _p) -> void
+        {
+            invalidate_metadata_cache(_p);
+
+            if (auto* cache = current_metadata_cache(); cache) {
+                cache->invalidate(_p.parent_path());
+            }
+        }
+
         auto remove_impl(rxComm& _comm, const path& _p, extended_remove_options _opts) -> bool
         {
             detail::throw_if_path_length_exceeds_limit(_p);
@@ -236,7 +248,10 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
                     addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
                 }
 
-                return rxDataObjUnlink(&_comm, &input) == 0;
+                const auto ec = rxDataObjUnlink(&_comm, &input);
+                invalidate_path_and_parent(_p);
+
+                return ec == 0;
             }
 
             if (is_collection(s)) {
@@ -257,7 +272,10 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
                     addKeyVal(&input.condInput, RECURSIVE_OPR__KW, "");
                 }
 
-                return rxRmColl(&_comm, &input, _opts.progress) >= 0;
+                const auto ec = rxRmColl(&_comm, &input, _opts.progress);
+                invalidate_path_and_parent(_p);
+
+                return ec >= 0;
             }
 
             throw filesystem_error{"cannot remove: unknown object type", _p, make_error_code(CAT_NOT_A_DATAOBJ_AND_NOT_A_COLLECTION)};
@@ -321,7 +339,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
             std::strncpy(units_buf, _metadata.units.c_str(), _metadata.units.size());
             input.arg5 = units_buf;
 
-            if (const auto ec = rxModAVUMetadata(&_comm, &input); ec != 0) {
+            const auto ec = rxModAVUMetadata(&_comm, &input);
+
+            invalidate_metadata_cache(_p);
+
+            if (ec != 0) {
                 std::string_view op_full_name = (op == "rm") ? "remove" : op;
                 throw filesystem_error{fmt::format("cannot {} metadata", op_full_name), _p, make_error_code(ec)};
             }
@@ -433,7 +455,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         std::strncpy(input.destDataObjInp.objPath, _to.c_str(), std::strlen(_to.c_str()));
         addKeyVal(&input.destDataObjInp.condInput, DEST_RESC_NAME_KW, "");
 
-        if (const auto ec = rxDataObjCopy(&_comm, &input); ec < 0) {
+        const auto ec = rxDataObjCopy(&_comm, &input);
+
+        invalidate_path_and_parent(_to);
+
+        if (ec < 0) {
             throw filesystem_error{"cannot copy data object", _from, _to, make_error_code(ec)};
         }
 
@@ -455,7 +481,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         collInp_t input{};
         std::strncpy(input.collName, _p.c_str(), std::strlen(_p.c_str()));
 
-        if (const auto ec = rxCollCreate(&_comm, &input); ec != 0) {
+        const auto ec = rxCollCreate(&_comm, &input);
+
+        invalidate_path_and_parent(_p);
+
+        if (ec != 0) {
             throw filesystem_error{"cannot create collection", _p, make_error_code(ec)};
         }
 
@@ -497,7 +527,16 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         std::strncpy(input.collName, _p.c_str(), std::strlen(_p.c_str()));
         addKeyVal(&input.condInput, RECURSIVE_OPR__KW, "");
 
-        return rxCollCreate(&_comm, &input) == 0;
+        const auto ec = rxCollCreate(&_comm, &input);
+
+        // Any of the ancestors may have been created as well.
+        if (auto* cache = current_metadata_cache(); cache) {
+            for (auto p = _p; p.has_relative_path(); p = p.parent_path()) {
+                cache->invalidate(p);
+            }
+        }
+
+        return ec == 0;
     }
 
     auto exists(const object_status& _s) noexcept -> bool
@@ -577,6 +616,14 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         detail::throw_if_path_is_empty(_p);
         detail::throw_if_path_length_exceeds_limit(_p);
 
+        auto* cache = current_metadata_cache();
+
+        if (cache) {
+            if (auto size = cache->find_data_object_size(_comm, _p); size) {
+                return *size;
+            }
+        }
+
         if (!is_data_object(_comm, _p)) {
             throw filesystem_error{"path does not point to a data object", _p, make_error_code(SYS_INVALID_INPUT_PARAM)};
         }
@@ -618,6 +665,10 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
             }
         }
 
+        if (cache) {
+            cache->insert_data_object_size(_comm, _p, size);
+        }
+
         return size;
     }
 
@@ -685,6 +736,14 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
 
     auto last_write_time(rxComm& _comm, const path& _p) -> object_time_type
     {
+        auto* cache = current_metadata_cache();
+
+        if (cache) {
+            if (auto mtime = cache->find_last_write_time(_comm, _p); mtime) {
+                return *mtime;
+            }
+        }
+
         std::string gql;
 
         if (const auto s = status(_comm, _p); is_data_object(s)) {
@@ -711,7 +770,13 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         }
 
         for (auto&& row : qb.build(_comm, gql)) {
-            return object_time_type{std::chrono::seconds{std::stoull(row[0])}};
+            const auto mtime = object_time_type{std::chrono::seconds{std::stoull(row[0])}};
+
+            if (cache) {
+                cache->insert_last_write_time(_comm, _p, mtime);
+            }
+
+            return mtime;
         }
 
         throw filesystem_error{"cannot get mtime", _p, make_error_code(CAT_NO_ROWS_FOUND)};
@@ -732,7 +797,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         std::strncpy(input.collName, _p.c_str(), std::strlen(_p.c_str()));
         addKeyVal(&input.condInput, COLLECTION_MTIME_KW, timestamp.c_str());
 
-        if (const auto ec = rxModColl(&_comm, &input); ec != 0) {
+        const auto ec = rxModColl(&_comm, &input);
+
+        invalidate_metadata_cache(_p);
+
+        if (ec != 0) {
             throw filesystem_error{"cannot set mtime", _p, make_error_code(ec)};
         }
     }
@@ -876,7 +945,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
 
         input.accessLevel = access;
 
-        if (const auto ec = rxModAccessControl(&_comm, &input); ec != 0) {
+        const auto ec = rxModAccessControl(&_comm, &input);
+
+        invalidate_metadata_cache(_p);
+
+        if (ec != 0) {
             throw filesystem_error{"cannot set permissions", _p, make_error_code(ec)};
         }
     }
@@ -946,7 +1019,12 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         std::strncpy(input.srcDataObjInp.objPath, _old_p.c_str(), std::strlen(_old_p.c_str()));
         std::strncpy(input.destDataObjInp.objPath, _new_p.c_str(), std::strlen(_new_p.c_str()));
 
-        if (const auto ec = rxDataObjRename(&_comm, &input); ec < 0) {
+        const auto ec = rxDataObjRename(&_comm, &input);
+
+        invalidate_path_and_parent(_old_p);
+        invalidate_path_and_parent(_new_p);
+
+        if (ec < 0) {
             throw filesystem_error{"cannot rename object", _old_p, _new_p, make_error_code(ec)};
         }
     }
@@ -1001,6 +1079,14 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
 
     auto status(rxComm& _comm, const path& _p) -> object_status
     {
+        auto* cache = current_metadata_cache();
+
+        if (cache) {
+            if (auto status = cache->find_status(_comm, _p); status) {
+                return *status;
+            }
+        }
+
         const auto s = stat(_comm, _p);
 
         if (s.error < 0) {
@@ -1039,7 +1125,11 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
                 status.type(object_type::none);
                 break;
         }
-        
+
+        if (cache) {
+            cache->insert_status(_comm, _p, status);
+        }
+
         return status;
     }
 
@@ -1053,6 +1143,14 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
         detail::throw_if_path_is_empty(_p);
         detail::throw_if_path_length_exceeds_limit(_p);
 
+        auto* cache = current_metadata_cache();
+
+        if (cache) {
+            if (auto md = cache->find_metadata(_comm, _p); md) {
+                return *md;
+            }
+        }
+
         std::string sql;
 
         if (const auto s = status(_comm, _p); is_data_object(s)) {
@@ -1083,6 +1181,10 @@ namespace irods::experimental::filesystem::NAMESPACE_IMPL
             results.push_back({row[0], row[1], row[2]});
         }
 
+        if (cache) {
+            cache->insert_metadata(_comm, _p, results);
+        }
+
         return results;
     }
 
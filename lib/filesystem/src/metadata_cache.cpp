@@ -0,0 +1,253 @@
+#include "filesystem/metadata_cache.hpp"
+
+#include "rcConnect.h"
+
+#include <algorithm>
+
+namespace irods::experimental::filesystem::NAMESPACE_IMPL
+{
+    namespace
+    {
+        thread_local metadata_cache* g_current_cache = nullptr;
+
+        // Maps equivalent spellings of a path (e.g. with a trailing separator) to the same entry.
+        auto key_of(const path& _p) -> std::string
+        {
+            auto key = _p.lexically_normal().string();
+
+            if (key.size() > 1 && path::preferred_separator == key.back()) {
+                key.pop_back();
+            }
+
+            return key;
+        } // key_of
+
+        // Identifies who the catalog answers through _comm. Permissions and visibility depend on
+        // the proxy and client users, and the same names may exist on different hosts.
+        auto identity_of(const rxComm& _comm) -> std::string
+        {
+            std::string id;
+
+#ifdef IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+            id += _comm.clientAddr;
+#else
+            id += _comm.host;
+            id += ':';
+            id += std::to_string(_comm.portNum);
+#endif // IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+
+            for (const auto* user : {&_comm.proxyUser, &_comm.clientUser}) {
+                id += '\0';
+                id += user->userName;
+                id += '#';
+                id += user->rodsZone;
+            }
+
+            return id;
+        } // identity_of
+
+        auto is_under(const std::string& _p, const std::string& _prefix) -> bool
+        {
+            if (_p.size() <= _prefix.size() || _p.compare(0, _prefix.size(), _prefix) != 0) {
+                return false;
+            }
+
+            return path::preferred_separator == _prefix.back() ||
+                   path::preferred_separator == _p[_prefix.size()];
+        } // is_under
+    } // anonymous namespace
+
+    metadata_cache::metadata_cache(std::size_t _capacity, std::chrono::milliseconds _ttl)
+        : capacity_{std::max<std::size_t>(_capacity, 1)}
+        , ttl_{_ttl}
+        , mutex_{}
+        , entries_{}
+        , lru_{}
+        , stats_{}
+    {
+    }
+
+    template <typename T>
+    auto metadata_cache::find(rxComm& _comm, const path& _p, std::optional<timed_value<T>> values::*_member)
+        -> std::optional<T>
+    {
+        const auto key = key_of(_p);
+        const auto id = identity_of(_comm);
+
+        std::scoped_lock lk{mutex_};
+
+        const auto iter = entries_.find(key);
+
+        if (iter == std::end(entries_)) {
+            ++stats_.misses;
+            return std::nullopt;
+        }
+
+        auto& e = iter->second;
+        const auto values_iter = e.values_by_identity.find(id);
+
+        if (values_iter == std::end(e.values_by_identity)) {
+            ++stats_.misses;
+            return std::nullopt;
+        }
+
+        auto& value = values_iter->second.*_member;
+
+        if (!value || value->expiration <= clock_type::now()) {
+            value.reset();
+            ++stats_.misses;
+            return std::nullopt;
+        }
+
+        lru_.splice(std::begin(lru_), lru_, e.lru_position);
+        ++stats_.hits;
+
+        return value->value;
+    } // find
+
+    template <typename T>
+    auto metadata_cache::insert(rxComm& _comm,
+                                const path& _p,
+                                std::optional<timed_value<T>> values::*_member,
+                                const T& _value) -> void
+    {
+        auto key = key_of(_p);
+        auto id = identity_of(_comm);
+
+        std::scoped_lock lk{mutex_};
+
+        auto iter = entries_.find(key);
+
+        if (iter == std::end(entries_)) {
+            if (entries_.size() == capacity_) {
+                entries_.erase(lru_.back());
+                lru_.pop_back();
+                ++stats_.evictions;
+            }
+
+            lru_.push_front(key);
+            iter = entries_.emplace(std::move(key), entry{}).first;
+            iter->second.lru_position = std::begin(lru_);
+        }
+        else {
+            lru_.splice(std::begin(lru_), lru_, iter->second.lru_position);
+        }
+
+        iter->second.values_by_identity[std::move(id)].*_member = timed_value<T>{_value, clock_type::now() + ttl_};
+    } // insert
+
+    auto metadata_cache::find_status(rxComm& _comm, const path& _p) -> std::optional<object_status>
+    {
+        return find(_comm, _p, &values::status);
+    } // find_status
+
+    auto metadata_cache::find_metadata(rxComm& _comm, const path& _p) -> std::optional<std::vector<metadata>>
+    {
+        return find(_comm, _p, &values::metadata_entries);
+    } // find_metadata
+
+    auto metadata_cache::find_data_object_size(rxComm& _comm, const path& _p) -> std::optional<std::uintmax_t>
+    {
+        return find(_comm, _p, &values::data_object_size);
+    } // find_data_object_size
+
+    auto metadata_cache::find_last_write_time(rxComm& _comm, const path& _p) -> std::optional<object_time_type>
+    {
+        return find(_comm, _p, &values::last_write_time);
+    } // find_last_write_time
+
+    auto metadata_cache::insert_status(rxComm& _comm, const path& _p, const object_status& _s) -> void
+    {
+        insert(_comm, _p, &values::status, _s);
+    } // insert_status
+
+    auto metadata_cache::insert_metadata(rxComm& _comm, const path& _p, const std::vector<metadata>& _md) -> void
+    {
+        insert(_comm, _p, &values::metadata_entries, _md);
+    } // insert_metadata
+
+    auto metadata_cache::insert_data_object_size(rxComm& _comm, const path& _p, std::uintmax_t _size) -> void
+    {
+        insert(_comm, _p, &values::data_object_size, _size);
+    } // insert_data_object_size
+
+    auto metadata_cache::insert_last_write_time(rxComm& _comm, const path& _p, object_time_type _mtime) -> void
+    {
+        insert(_comm, _p, &values::last_write_time, _mtime);
+    } // insert_last_write_time
+
+    auto metadata_cache::invalidate(const path& _p) -> void
+    {
+        const auto key = key_of(_p);
+
+        std::scoped_lock lk{mutex_};
+
+        if (const auto iter = entries_.find(key); iter != std::end(entries_)) {
+            lru_.erase(iter->second.lru_position);
+            entries_.erase(iter);
+            ++stats_.invalidations;
+        }
+    } // invalidate
+
+    auto metadata_cache::invalidate_all(const path& _p) -> void
+    {
+        const auto prefix = key_of(_p);
+
+        std::scoped_lock lk{mutex_};
+
+        for (auto iter = std::begin(entries_); iter != std::end(entries_);) {
+            if (iter->first == prefix || is_under(iter->first, prefix)) {
+                lru_.erase(iter->second.lru_position);
+                iter = entries_.erase(iter);
+                ++stats_.invalidations;
+            }
+            else {
+                ++iter;
+            }
+        }
+    } // invalidate_all
+
+    auto metadata_cache::clear() -> void
+    {
+        std::scoped_lock lk{mutex_};
+
+        stats_.invalidations += entries_.size();
+        entries_.clear();
+        lru_.clear();
+    } // clear
+
+    auto metadata_cache::size() const -> std::size_t
+    {
+        std::scoped_lock lk{mutex_};
+        return entries_.size();
+    } // size
+
+    auto metadata_cache::statistics() const -> statistics_type
+    {
+        std::scoped_lock lk{mutex_};
+        return stats_;
+    } // statistics
+
+    scoped_metadata_cache::scoped_metadata_cache(metadata_cache& _cache) noexcept
+        : previous_{g_current_cache}
+    {
+        g_current_cache = &_cache;
+    }
+
+    scoped_metadata_cache::~scoped_metadata_cache()
+    {
+        g_current_cache = previous_;
+    }
+
+    auto current_metadata_cache() noexcept -> metadata_cache*
+    {
+        return g_current_cache;
+    } // current_metadata_cache
+
+    auto invalidate_metadata_cache(const path& _p) -> void
+    {
+        if (g_current_cache) {
+            g_current_cache->invalidate_all(_p);
+        }
+    } // invalidate_metadata_cache
+} // namespace irods::experimental::filesystem::NAMESPACE_IMPL
@@ -0,0 +1,307 @@
+#include "api_plugin_number.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsErrorTable.h"
+#include "rodsPackInstruct.h"
+#include "client_api_whitelist.hpp"
+
+#include "apiHandler.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "batch_query.h"
+
+#include "irods_exception.hpp"
+#include "irods_logger.hpp"
+#include "catalog_utilities.hpp"
+
+#define IRODS_QUERY_ENABLE_SERVER_SIDE_API
+#include "irods_query.hpp"
+
+#include "json.hpp"
+#include "fmt/format.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ The expected JSON format:
+ ~~~~~~~~~~~~~~~~~~~~~~~~~
+ {
+     // Cannot be empty.
+     "queries": [
+         {
+             // Cannot be empty.
+             "query_string": string,
+
+             // Must be "general" or "specific".
+             // Defaults to "general".
+             "query_type": string,
+
+             // Only used by specific queries.
+             // Not required to exist.
+             "arguments": [string],
+
+             // Not required to exist.
+             "zone_hint": string,
+
+             // Must be greater than or equal to zero.
+             // Defaults to zero (i.e. no limit).
+             "row_limit": integer,
+
+             // Must be greater than or equal to zero.
+             // Defaults to zero.
+             "row_offset": integer
+         }
+     ]
+ }
+*/
+
+namespace
+{
+    // clang-format off
+    namespace ic    = irods::experimental::catalog;
+
+    using log       = irods::experimental::log;
+    using json      = nlohmann::json;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+
+    // JSON Input Properties
+    constexpr std::string_view prop_queries      = "queries";
+    constexpr std::string_view prop_query_string = "query_string";
+    constexpr std::string_view prop_query_type   = "query_type";
+    constexpr std::string_view prop_arguments    = "arguments";
+    constexpr std::string_view prop_zone_hint    = "zone_hint";
+    constexpr std::string_view prop_row_limit    = "row_limit";
+    constexpr std::string_view prop_row_offset   = "row_offset";
+    // clang-format on
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_batch_query(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto to_bytes_buffer(const std::string& _s) -> bytesBuf_t*;
+
+    auto make_error_object(const std::string& _error_msg) -> json;
+
+    auto execute_query(rsComm_t& _comm, const json& _query) -> json;
+
+    auto rs_batch_query(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto call_batch_query(irods::api_entry* _api,
+                          rsComm_t* _comm,
+                          bytesBuf_t* _input,
+                          bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    }
+
+    auto to_bytes_buffer(const std::string& _s) -> bytesBuf_t*
+    {
+        constexpr auto allocate = [](const auto bytes) noexcept
+        {
+            return std::memset(std::malloc(bytes), 0, bytes);
+        };
+
+        const auto buf_size = _s.length() + 1;
+
+        auto* buf = static_cast<char*>(allocate(sizeof(char) * buf_size));
+        std::strncpy(buf, _s.c_str(), _s.length());
+
+        auto* bbp = static_cast<bytesBuf_t*>(allocate(sizeof(bytesBuf_t)));
+        bbp->len = buf_size;
+        bbp->buf = buf;
+
+        return bbp;
+    }
+
+    auto make_error_object(const std::string& _error_msg) -> json
+    {
+        return json{{"error_message", _error_msg}};
+    }
+
+    auto execute_query(rsComm_t& _comm, const json& _query) -> json
+    {
+        using query_type = irods::query<rsComm_t>;
+
+        json result{{"error_code", 0}, {"rows", json::array()}};
+
+        try {
+            const auto query_string = _query.at(prop_query_string.data()).get<std::string>();
+
+            if (query_string.empty()) {
+                result["error_code"] = USER_INPUT_STRING_ERR;
+                result["error_message"] = "Query string is empty";
+                return result;
+            }
+
+            const auto type = query_type::convert_string_to_query_type(_query.value(prop_query_type.data(), "general"));
+            const auto zone_hint = _query.value(prop_zone_hint.data(), std::string{});
+            const auto row_limit = _query.value(prop_row_limit.data(), std::uintmax_t{0});
+            const auto row_offset = _query.value(prop_row_offset.data(), std::uintmax_t{0});
+
+            std::vector<std::string> args;
+
+            if (const auto iter = _query.find(prop_arguments.data()); iter != std::end(_query)) {
+                args = iter->get<std::vector<std::string>>();
+            }
+
+            auto& rows = result["rows"];
+
+            for (auto&& row : query_type{&_comm, query_string, &args, zone_hint, row_limit, row_offset, type}) {
+                rows.push_back(row);
+            }
+        }
+        catch (const irods::exception& e) {
+            log::api::error({{"log_message", "Query in batch failed"},
+                             {"error_message", e.client_display_what()}});
+
+            result["error_code"] = e.code();
+            result["error_message"] = e.client_display_what();
+            result["rows"] = json::array();
+        }
+        catch (const json::exception& e) {
+            result["error_code"] = INPUT_ARG_NOT_WELL_FORMED_ERR;
+            result["error_message"] = e.what();
+            result["rows"] = json::array();
+        }
+
+        return result;
+    }
+
+    auto rs_batch_query(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        if (!_input || !_input->buf || _input->len <= 0) {
+            log::api::error("Missing JSON input");
+            *_output = to_bytes_buffer(make_error_object("Invalid input").dump());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        // Every query in the batch ends up at the catalog service provider. Redirecting the
+        // entire batch once avoids forwarding each query individually.
+        try {
+            if (!ic::connected_to_catalog_provider(*_comm)) {
+                log::api::trace("Redirecting request to catalog service provider ...");
+
+                auto host_info = ic::redirect_to_catalog_provider(*_comm);
+
+                // The buffer is not null-terminated.
+                const std::string json_input(static_cast<const char*>(_input->buf), _input->len);
+                char* json_output = nullptr;
+
+                const auto ec = rc_batch_query(host_info.conn, json_input.c_str(), &json_output);
+                *_output = to_bytes_buffer(json_output ? json_output : "{}");
+                std::free(json_output);
+
+                return ec;
+            }
+
+            ic::throw_if_catalog_provider_service_role_is_invalid();
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            *_output = to_bytes_buffer(make_error_object(e.client_display_what()).dump());
+            return e.code();
+        }
+
+        json input;
+
+        try {
+            input = json::parse(std::string(static_cast<const char*>(_input->buf), _input->len));
+        }
+        catch (const json::parse_error& e) {
+            // clang-format off
+            log::api::error({{"log_message", "Failed to parse input into JSON"},
+                             {"error_message", e.what()}});
+            // clang-format on
+
+            *_output = to_bytes_buffer(make_error_object(e.what()).dump());
+
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        const auto iter = input.find(prop_queries.data());
+
+        if (iter == std::end(input) || !iter->is_array() || iter->empty()) {
+            log::api::error("Missing or empty [{}] property", prop_queries);
+            *_output = to_bytes_buffer(make_error_object(fmt::format("Missing or empty [{}] property", prop_queries)).dump());
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        json results = json::array();
+
+        for (const auto& query : *iter) {
+            results.push_back(execute_query(*_comm, query));
+        }
+
+        *_output = to_bytes_buffer(json{{"results", results}}.dump());
+
+        return 0;
+    }
+
+    const operation op = rs_batch_query;
+    #define CALL_BATCH_QUERY call_batch_query
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_BATCH_QUERY nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(BATCH_QUERY_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{BATCH_QUERY_APN,        // API number
+                        RODS_API_VERSION,       // API version
+                        REMOTE_USER_AUTH,       // Client auth
+                        REMOTE_USER_AUTH,       // Proxy auth
+                        "BytesBuf_PI", 0,       // In PI / bs flag
+                        "BytesBuf_PI", 0,       // Out PI / bs flag
+                        op,                     // Operation
+                        "api_batch_query",      // Operation name
+                        nullptr,                // Clear function
+                        (funcPtr) CALL_BATCH_QUERY};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+}
@@ -32,7 +32,10 @@
 #include <boost/algorithm/string.hpp>
 
 #include <string>
+#include <string_view>
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 extern int logSQLGenQuery;
 
@@ -1812,6 +1815,331 @@ generateSpecialQuery( genQueryInp_t genQueryInp, char *resultingSQL ) {
     return 0;
 }
 
+namespace
+{
+    // Linking the tables of a query walks the foreign key graph (see tScan). The outcome only
+    // depends on the tables the query references, the table it starts from, and the text
+    // generated so far for the from clause, so it is remembered for the lifetime of the agent.
+    // Clients issue the same few queries over and over again.
+    struct join_path
+    {
+        std::string from;   // The text tScan appends to fromSQL.
+        std::string where;  // The text tScan appends to whereSQL.
+    };
+
+    constexpr std::size_t join_path_cache_capacity = 1024;
+
+    std::unordered_map<std::string, join_path> join_path_cache;
+
+    std::string make_join_path_key( int _starting_table )
+    {
+        std::string key = std::to_string( _starting_table );
+
+        // tScan only separates its first condition with "AND" if the where clause is not empty.
+        key += strlen( whereSQL ) > 6 ? 'w' : '-';
+
+        for ( int i = 0; i < nTables; i++ ) {
+            if ( Tables[i].flag == 1 ) {
+                key += ',';
+                key += std::to_string( i );
+            }
+        }
+
+        key += ':';
+        key += fromSQL;
+
+        return key;
+    }
+
+    // Equivalent to calling tScan( _starting_table, -1 ) and checking that every table was linked.
+    int link_tables( int _starting_table )
+    {
+        auto key = make_join_path_key( _starting_table );
+
+        if ( const auto iter = join_path_cache.find( key ); iter != std::end( join_path_cache ) ) {
+            if ( !rstrcat( fromSQL, iter->second.from.c_str(), MAX_SQL_SIZE_GQ ) ||
+                 !rstrcat( whereSQL, iter->second.where.c_str(), MAX_SQL_SIZE_GQ ) ) {
+                return CAT_FAILED_TO_LINK_TABLES;
+            }
+
+            nToFind = 0;
+
+            return 0;
+        }
+
+        const auto from_length = strlen( fromSQL );
+        const auto where_length = strlen( whereSQL );
+
+        if ( tScan( _starting_table, -1 ) != 1 || nToFind != 0 ) {
+            return CAT_FAILED_TO_LINK_TABLES;
+        }
+
+        if ( join_path_cache.size() >= join_path_cache_capacity ) {
+            join_path_cache.clear();
+        }
+
+        join_path_cache.emplace( std::move( key ), join_path{ fromSQL + from_length, whereSQL + where_length } );
+
+        return 0;
+    }
+
+    // The SQL generated for a query does not depend on the values of its conditions, which
+    // are passed as bind variables. For queries whose conditions are all plain comparisons
+    // against a quoted value (or IS NULL / IS NOT NULL), the generated SQL and the origin of
+    // each bind variable are remembered by the shape of the query. Repeating the query, with
+    // the same or other values, then skips the table linking and string building entirely.
+    struct sql_template
+    {
+        std::string sql;
+        std::string count_sql;
+
+        // For each bind variable, in order: the index of the condition whose quoted value it
+        // is, or one of the *_bind_source constants below.
+        std::vector<int> bind_sources;
+    };
+
+    constexpr int access_control_user_bind_source = -1;
+    constexpr int access_control_zone_bind_source = -2;
+    constexpr int session_ticket_bind_source = -3;
+
+    constexpr std::size_t sql_template_cache_capacity = 1024;
+
+    std::unordered_map<std::string, sql_template> sql_template_cache;
+
+    // The condition values bound by the last query answered from sql_template_cache. Like the
+    // values bound by insertWhere, they must stay valid until the next query is generated.
+    std::vector<std::string> sql_template_bind_values;
+
+    bool starts_with_keyword( std::string_view _condition, std::string_view _keyword )
+    {
+        while ( !_condition.empty() && _condition.front() == ' ' ) {
+            _condition.remove_prefix( 1 );
+        }
+
+        return _condition.compare( 0, _keyword.size(), _keyword ) == 0;
+    }
+
+    // Returns the shape of the query, or an empty string if its SQL cannot be cached.
+    std::string make_sql_template_key( const genQueryInp_t& _input )
+    {
+        // With MySQL the offset is part of the SQL text. Queries with an offset are rare.
+        if ( _input.rowOffset > 0 ) {
+            return {};
+        }
+
+        std::string key = std::to_string( _input.options );
+        key += '|';
+
+        for ( int i = 0; i < _input.selectInp.len; i++ ) {
+            key += std::to_string( _input.selectInp.inx[i] );
+            key += ':';
+            key += std::to_string( _input.selectInp.value[i] );
+            key += ',';
+        }
+
+        key += '|';
+
+        int data_attr_names = 0;
+        int coll_attr_names = 0;
+
+        for ( int i = 0; i < _input.sqlCondInp.len; i++ ) {
+            const int column = _input.sqlCondInp.inx[i];
+            char* condition = _input.sqlCondInp.value[i];
+
+            // Multiple AVU conditions rewrite the where clause (see handleMultiDataAVUConditions).
+            data_attr_names += column == COL_META_DATA_ATTR_NAME;
+            coll_attr_names += column == COL_META_COLL_ATTR_NAME;
+
+            if ( data_attr_names > 1 || coll_attr_names > 1 || compoundConditionSpecified( condition ) ) {
+                return {};
+            }
+
+            key += std::to_string( column );
+            key += ':';
+
+            const char* first_quote = strchr( condition, '\'' );
+
+            if ( !first_quote ) {
+                if ( strcmp( condition, "IS NULL" ) != 0 && strcmp( condition, "IS NOT NULL" ) != 0 ) {
+                    return {};
+                }
+
+                key += condition;
+            }
+            else {
+                // The SQL of these operators depends on the value (see insertWhere).
+                const std::string_view op{ condition, static_cast<std::size_t>( first_quote - condition ) };
+
+                if ( starts_with_keyword( op, "in" ) || starts_with_keyword( op, "IN" ) ||
+                     starts_with_keyword( op, "between" ) || starts_with_keyword( op, "BETWEEN" ) ||
+                     op.find( "begin_of" ) != std::string_view::npos ||
+                     op.find( "parent_of" ) != std::string_view::npos ) {
+                    return {};
+                }
+
+                key += op;
+                key += '\'';
+            }
+
+            key += ',';
+        }
+
+        // See genqAppendAccessCheck.
+        key += '|';
+        key += std::to_string( accessControlPriv );
+        key += ':';
+        key += std::to_string( accessControlControlFlag );
+        key += strncmp( accessControlUserName, ANONYMOUS_USER, MAX_NAME_LEN ) == 0 ? 'a' : '-';
+        key += sessionTicket[0] != '\0' ? 't' : '-';
+
+        return key;
+    }
+
+    // Answers generateSQL from sql_template_cache. Returns false if the SQL must be generated.
+    bool generate_sql_from_template( const std::string& _key, genQueryInp_t& _input,
+                                     char* _resulting_sql, [[maybe_unused]] char* _resulting_count_sql )
+    {
+        const auto iter = sql_template_cache.find( _key );
+
+        if ( iter == std::end( sql_template_cache ) ) {
+            return false;
+        }
+
+        const auto& t = iter->second;
+
+        // Leave the bind variable limit, including the slots genqAppendAccessCheck reserves, to
+        // the code that reports it.
+        if ( cllBindVarCount + static_cast<int>( t.bind_sources.size() ) + 6 >= MAX_BIND_VARS ) {
+            return false;
+        }
+
+        // Extract the values the same way insertWhere does, leaving the error handling for
+        // unusual values to it.
+        sql_template_bind_values.clear();
+        std::size_t total_size = 0;
+
+        for ( int i = 0; i < _input.sqlCondInp.len; i++ ) {
+            char* condition = _input.sqlCondInp.value[i];
+            const char* first_quote = strchr( condition, '\'' );
+
+            if ( first_quote ) {
+                const char* last_quote = strrchr( condition, '\'' );
+
+                if ( last_quote == first_quote ) {
+                    return false;
+                }
+
+                sql_template_bind_values.emplace_back( first_quote + 1, last_quote - first_quote - 1 );
+                total_size += last_quote - first_quote;
+            }
+            else {
+                sql_template_bind_values.emplace_back();
+            }
+        }
+
+        if ( total_size > MAX_SQL_SIZE_GQ ) {
+            return false;
+        }
+
+        for ( const auto source : t.bind_sources ) {
+            switch ( source ) {
+                case access_control_user_bind_source:
+                    cllBindVars[cllBindVarCount++] = accessControlUserName;
+                    break;
+
+                case access_control_zone_bind_source:
+                    cllBindVars[cllBindVarCount++] = accessControlZone;
+                    break;
+
+                case session_ticket_bind_source:
+                    cllBindVars[cllBindVarCount++] = sessionTicket;
+                    break;
+
+                default:
+                    cllBindVars[cllBindVarCount++] = sql_template_bind_values[source].c_str();
+                    break;
+            }
+        }
+
+        // Like generateSQL, consume the 'n' of the numeric comparisons (n<, n>, n=).
+        for ( int i = 0; i < _input.sqlCondInp.len; i++ ) {
+            char* cptr = _input.sqlCondInp.value[i];
+            while ( *cptr == ' ' ) {
+                cptr++;
+            }
+            if ( *cptr == 'n' && ( *( cptr + 1 ) == '<' || *( cptr + 1 ) == '>' || *( cptr + 1 ) == '=' ) ) {
+                *cptr = ' ';
+            }
+        }
+
+        strncpy( _resulting_sql, t.sql.c_str(), MAX_SQL_SIZE_GQ );
+#if ORA_ICAT
+        strncpy( _resulting_count_sql, t.count_sql.c_str(), MAX_SQL_SIZE_GQ );
+#endif
+
+        return true;
+    }
+
+    // Remembers the SQL just generated for _input. _first_bind is the value cllBindVarCount
+    // had before generateSQL bound the values of the query.
+    void remember_sql_template( std::string&& _key, const genQueryInp_t& _input, int _first_bind,
+                                const char* _resulting_sql, [[maybe_unused]] const char* _resulting_count_sql )
+    {
+        sql_template t{ _resulting_sql, {}, {} };
+#if ORA_ICAT
+        t.count_sql = _resulting_count_sql;
+#endif
+
+        // Conditions are bound in order, except for IS NULL and IS NOT NULL which are not bound.
+        int condition = 0;
+
+        for ( int i = _first_bind; i < cllBindVarCount; i++ ) {
+            const char* b = cllBindVars[i];
+
+            if ( b == accessControlUserName ) {
+                t.bind_sources.push_back( access_control_user_bind_source );
+            }
+            else if ( b == accessControlZone ) {
+                t.bind_sources.push_back( access_control_zone_bind_source );
+            }
+            else if ( b == sessionTicket ) {
+                t.bind_sources.push_back( session_ticket_bind_source );
+            }
+            else {
+                while ( condition < _input.sqlCondInp.len && !strchr( _input.sqlCondInp.value[condition], '\'' ) ) {
+                    condition++;
+                }
+
+                if ( condition == _input.sqlCondInp.len ) {
+                    return;
+                }
+
+                t.bind_sources.push_back( condition++ );
+            }
+        }
+
+        if ( sql_template_cache.size() >= sql_template_cache_capacity ) {
+            sql_template_cache.clear();
+        }
+
+        sql_template_cache.emplace( std::move( _key ), std::move( t ) );
+    }
+} // anonymous namespace
+
+/*
+ Discard the SQL and join paths remembered by generateSQL.  Only needed
+ to measure generateSQL without them.
+*/
+void
+clearGenQuerySqlTemplateCache() {
+    sql_template_cache.clear();
+}
+
+void
+clearGenQueryJoinPathCache() {
+    join_path_cache.clear();
+}
+
 /*
 Called by chlGenQuery to generate the SQL.
 */
@@ -1819,7 +2147,6 @@ int
 generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
              char *resultingCountSQL ) {
     int i, table, startingTable = 0;
-    int keepVal;
     char *condition;
     int status;
     int useGroupBy;
@@ -1841,6 +2168,13 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
     }
     firstCall = 0;
 
+    const int firstBind = cllBindVarCount;
+    std::string templateKey = make_sql_template_key( genQueryInp );
+    if ( !templateKey.empty() &&
+            generate_sql_from_template( templateKey, genQueryInp, resultingSQL, resultingCountSQL ) ) {
+        return 0;
+    }
+
     nToFind = 0;
     for ( i = 0; i < nTables; i++ ) {
         Tables[i].flag = 0;
@@ -1958,8 +2292,7 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
 
     }
 
-    keepVal = tScan( startingTable, -1 );
-    if ( keepVal != 1 || nToFind != 0 ) {
+    if ( link_tables( startingTable ) != 0 ) {
         rodsLog( LOG_ERROR, "error failed to link tables\n" );
         return CAT_FAILED_TO_LINK_TABLES;
     }
@@ -2078,6 +2411,11 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
     }
     strncpy( resultingCountSQL, countSQL, MAX_SQL_SIZE_GQ );
 #endif
+
+    if ( !templateKey.empty() ) {
+        remember_sql_template( std::move( templateKey ), genQueryInp, firstBind,
+                               resultingSQL, resultingCountSQL );
+    }
     return 0;
 }
 
@@ -179,6 +179,8 @@ insert into R_TOKN_MAIN values ('data_type',1702,'gzipTar bundle','','','','','1
 insert into R_TOKN_MAIN values ('data_type',1703,'bzip2Tar bundle','','','','','1324000000','1324000000');
 insert into R_TOKN_MAIN values ('data_type',1704,'zipFile bundle','','','','','1324000000','1324000000');
 insert into R_TOKN_MAIN values ('data_type',1705,'msso file','','','','','1324000000','1324000000');
+insert into R_TOKN_MAIN values ('data_type',1706,'zstdTar','','|.tar.zst|','','','1602720000','1602720000');
+insert into R_TOKN_MAIN values ('data_type',1707,'zstdTar bundle','','','','','1602720000','1602720000');
 
 
 insert into R_TOKN_MAIN values ('action_type',1800,'generic','','','','','1170000000','1170000000');
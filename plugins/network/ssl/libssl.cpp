@@ -1142,6 +1142,7 @@ irods::error read_bytes_buf(
         if ( !( result = ASSERT_ERROR( ret.ok() && bytes_read == _length, SYS_READ_MSG_BODY_LEN_ERR,
                                        "Read %d expected %d.", bytes_read, _length ) ).ok() ) {
             free( _buffer->buf );
+            _buffer->buf = NULL;
         }
     }
 
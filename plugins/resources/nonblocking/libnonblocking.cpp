@@ -1162,14 +1162,7 @@ non_blockingFileCopyPlugin( int         mode,
             result = ERROR( UNIX_FILE_STAT_ERR, msg_stream.str() );
         }
         else {
-            size_t trans_buff_size;
-            try {
-                trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-            } catch ( const irods::exception& e ) {
-                close( outFd );
-                close( inFd );
-                return irods::error(e);
-            }
+            size_t trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
             std::vector<char> myBuf( trans_buff_size );
 
@@ -33,6 +33,13 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
 
 // =-=-=-=-=-=-=-
 // boost includes
@@ -43,6 +50,9 @@
 // system includes
 #include "archive.h"
 #include "archive_entry.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // =-=-=-=-=-=-=-
 // structures and defines
@@ -310,6 +320,166 @@ ssize_t irods_file_write(
 
 } // irods_file_write
 
+// =-=-=-=-=-=-=-
+// regular members of an archive are decoded sequentially but written to the
+// cache directory by a bounded pool of writers. entries which are not regular
+// files (directories, links) are extracted inline once all pending writes have
+// completed so that the result matches a purely sequential extraction
+namespace {
+    // members larger than this are extracted inline by the decoder
+    constexpr std::int64_t WRITE_BEHIND_MAX_MEMBER_SIZE = 4 * 1024 * 1024;
+
+    // upper bound on the bytes held by pending writes at any time
+    constexpr std::uintmax_t WRITE_BEHIND_MAX_BYTES = 64 * 1024 * 1024;
+
+    constexpr int WRITE_BEHIND_THREAD_COUNT = 4;
+
+    struct pending_member {
+        std::string         path;
+        std::vector< char > data;
+        mode_t              mode;
+        std::time_t         mtime;
+    };
+
+    class member_write_behind {
+    public:
+        member_write_behind() {
+            for ( int i = 0; i < WRITE_BEHIND_THREAD_COUNT; ++i ) {
+                writers_.emplace_back( [this] { write_members(); } );
+            }
+        }
+
+        member_write_behind( const member_write_behind& ) = delete;
+        member_write_behind& operator=( const member_write_behind& ) = delete;
+
+        ~member_write_behind() {
+            {
+                std::lock_guard< std::mutex > lk{ mtx_ };
+                stop_ = true;
+            }
+            cv_.notify_all();
+
+            for ( auto& t : writers_ ) {
+                t.join();
+            }
+        }
+
+        // queues a member for writing. blocks while the memory budget is exhausted
+        // or while an earlier member with the same path is still being written.
+        void submit( pending_member&& _member ) {
+            std::unique_lock< std::mutex > lk{ mtx_ };
+            cv_.wait( lk, [this, &_member] {
+                return ( bytes_pending_ == 0 || bytes_pending_ + _member.data.size() <= WRITE_BEHIND_MAX_BYTES ) &&
+                       paths_in_flight_.count( _member.path ) == 0;
+            } );
+
+            bytes_pending_ += _member.data.size();
+            paths_in_flight_.insert( _member.path );
+            queue_.push_back( std::move( _member ) );
+            cv_.notify_all();
+        }
+
+        // blocks until every queued member has been written
+        void drain() {
+            std::unique_lock< std::mutex > lk{ mtx_ };
+            cv_.wait( lk, [this] { return queue_.empty() && paths_in_flight_.empty(); } );
+        }
+
+        // returns the number of members which could not be written
+        int error_count() {
+            std::lock_guard< std::mutex > lk{ mtx_ };
+            return error_count_;
+        }
+
+    private:
+        void write_members() {
+            while ( true ) {
+                pending_member m;
+
+                {
+                    std::unique_lock< std::mutex > lk{ mtx_ };
+                    cv_.wait( lk, [this] { return stop_ || !queue_.empty(); } );
+                    if ( queue_.empty() ) {
+                        return;
+                    }
+
+                    m = std::move( queue_.front() );
+                    queue_.pop_front();
+                }
+
+                const bool ok = write_file( m );
+
+                {
+                    std::lock_guard< std::mutex > lk{ mtx_ };
+                    bytes_pending_ -= m.data.size();
+                    paths_in_flight_.erase( m.path );
+                    if ( !ok ) {
+                        ++error_count_;
+                    }
+                }
+                cv_.notify_all();
+            }
+        }
+
+        static bool write_file( const pending_member& _m ) {
+            // match libarchive, which replaces rather than truncates existing files
+            unlink( _m.path.c_str() );
+
+            const int fd = open( _m.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, _m.mode );
+            if ( -1 == fd ) {
+                rodsLog( LOG_NOTICE, "extract_file - failed to create [%s], errno = %d", _m.path.c_str(), errno );
+                return false;
+            }
+
+            std::size_t total = 0;
+            while ( total < _m.data.size() ) {
+                const auto len = write( fd, _m.data.data() + total, _m.data.size() - total );
+                if ( len < 0 ) {
+                    if ( EINTR == errno ) {
+                        continue;
+                    }
+                    rodsLog( LOG_NOTICE, "extract_file - failed to write [%s], errno = %d", _m.path.c_str(), errno );
+                    close( fd );
+                    return false;
+                }
+                total += len;
+            }
+
+            const struct timespec times[ 2 ] = { { _m.mtime, 0 }, { _m.mtime, 0 } };
+            futimens( fd, times );
+
+            return 0 == close( fd );
+        }
+
+        std::vector< std::thread >   writers_;
+        std::deque< pending_member > queue_;
+        std::set< std::string >      paths_in_flight_;
+        std::mutex                   mtx_;
+        std::condition_variable      cv_;
+        std::uintmax_t               bytes_pending_ = 0;
+        int                          error_count_   = 0;
+        bool                         stop_          = false;
+    }; // class member_write_behind
+
+    // reads the data of the current archive entry into memory
+    bool read_entry_data( struct archive* _arch, std::vector< char >& _data ) {
+        std::size_t total = 0;
+        while ( total < _data.size() ) {
+            const auto len = archive_read_data( _arch, _data.data() + total, _data.size() - total );
+            if ( len < 0 ) {
+                return false;
+            }
+            if ( 0 == len ) {
+                break;
+            }
+            total += len;
+        }
+
+        _data.resize( total );
+        return true;
+    }
+} // anonymous namespace
+
 // =-=-=-=-=-=-=-
 // call archive file extraction for struct file
 irods::error extract_file( int _index ) {
@@ -386,23 +556,73 @@ irods::error extract_file( int _index ) {
     // =-=-=-=-=-=-=-
     // iterate over entries in the archive and write them to a resource
     struct archive_entry* entry;
-    while ( ARCHIVE_OK == archive_read_next_header( arch, &entry ) ) {
-        // =-=-=-=-=-=-=-
-        // redirect the path to the cache directory
-        std::string path = cache_dir + std::string( archive_entry_pathname( entry ) );
-        archive_entry_set_pathname( entry, path.c_str() );
+    {
+        member_write_behind writer;
+        std::string last_parent_dir;
 
-        // =-=-=-=-=-=-=-
-        // read data from entry and write it to a resource
-        if ( ARCHIVE_OK != archive_read_extract( arch, entry, flags ) ) {
-            std::stringstream msg;
-            msg << "extract_file - failed to write [";
-            msg << path;
-            msg << "]";
-            rodsLog( LOG_NOTICE, "%s", msg.str().c_str() );
-        }
+        while ( ARCHIVE_OK == archive_read_next_header( arch, &entry ) ) {
+            // =-=-=-=-=-=-=-
+            // redirect the path to the cache directory
+            std::string path = cache_dir + std::string( archive_entry_pathname( entry ) );
+            archive_entry_set_pathname( entry, path.c_str() );
 
-    } // while
+            // =-=-=-=-=-=-=-
+            // hand small regular files to the writers
+            if ( AE_IFREG == archive_entry_filetype( entry ) &&
+                    !archive_entry_hardlink( entry ) &&
+                    archive_entry_size_is_set( entry ) &&
+                    archive_entry_size( entry ) <= WRITE_BEHIND_MAX_MEMBER_SIZE ) {
+                const std::string parent_dir = boost::filesystem::path( path ).parent_path().string();
+                if ( parent_dir != last_parent_dir ) {
+                    boost::system::error_code ec;
+                    boost::filesystem::create_directories( parent_dir, ec );
+                    last_parent_dir = parent_dir;
+                }
+
+                pending_member member{ path,
+                                       std::vector< char >( archive_entry_size( entry ) ),
+                                       static_cast< mode_t >( archive_entry_perm( entry ) & 0777 ),
+                                       archive_entry_mtime( entry ) };
+
+                if ( read_entry_data( arch, member.data ) ) {
+                    writer.submit( std::move( member ) );
+                    continue;
+                }
+
+                std::stringstream msg;
+                msg << "extract_file - failed to read [";
+                msg << path;
+                msg << "] with error string [";
+                msg << archive_error_string( arch );
+                msg << "]";
+                rodsLog( LOG_NOTICE, "%s", msg.str().c_str() );
+                continue;
+            }
+
+            // =-=-=-=-=-=-=-
+            // anything else may depend on earlier members, e.g. hard links
+            writer.drain();
+            last_parent_dir.clear();
+
+            // =-=-=-=-=-=-=-
+            // read data from entry and write it to a resource
+            if ( ARCHIVE_OK != archive_read_extract( arch, entry, flags ) ) {
+                std::stringstream msg;
+                msg << "extract_file - failed to write [";
+                msg << path;
+                msg << "]";
+                rodsLog( LOG_NOTICE, "%s", msg.str().c_str() );
+            }
+
+        } // while
+
+        writer.drain();
+
+        if ( const int error_count = writer.error_count(); error_count > 0 ) {
+            rodsLog( LOG_NOTICE, "extract_file - failed to write %d members of [%s]",
+                     error_count, spec_coll->phyPath );
+        }
+    }
 
     // =-=-=-=-=-=-=-
     // release the archive back into the wild
@@ -2044,34 +2264,241 @@ irods::error tar_file_extract(
 } // tar_file_extract_plugin
 
 // =-=-=-=-=-=-=-
-// helper function to write an archive entry
-irods::error write_file_to_archive( const boost::filesystem::path _path,
-                                    const std::string&            _cache_dir,
-                                    struct archive*               _archive ) {
-    namespace fs = boost::filesystem;
-    struct archive_entry* entry = archive_entry_new();
+// members of a bundle which are read ahead of the archive writer. the vault
+// reads for upcoming members overlap with compressing and writing the current
+// one, bounded by both the number of reader threads and the bytes held in memory
+namespace {
+    // files larger than this are streamed by the writer rather than read ahead
+    constexpr std::uintmax_t READ_AHEAD_MAX_MEMBER_SIZE = 4 * 1024 * 1024;
+
+    // upper bound on the bytes held by read ahead buffers at any time
+    constexpr std::uintmax_t READ_AHEAD_MAX_BYTES = 64 * 1024 * 1024;
+
+    constexpr int READ_AHEAD_THREAD_COUNT = 4;
+
+    // block size used when streaming a member which was not read ahead
+    constexpr std::size_t ARCHIVE_BLOCK_SIZE = 1 * 1024 * 1024;
+
+    struct archive_member {
+        boost::filesystem::path path;
+        std::uintmax_t          size     = 0;
+        std::uintmax_t          reserved = 0;
+        std::time_t             mtime    = 0;
+        bool                    streamed = false;
+        bool                    ready    = false;
+        int                     error    = 0;
+        std::vector< char >     data;
+    };
+
+    class member_read_ahead {
+    public:
+        explicit member_read_ahead( const std::vector< boost::filesystem::path >& _listing )
+            : members_( _listing.size() )
+        {
+            for ( std::size_t i = 0; i < _listing.size(); ++i ) {
+                members_[ i ].path = _listing[ i ];
+            }
+
+            const auto thread_count = std::min< std::size_t >( READ_AHEAD_THREAD_COUNT, members_.size() );
+            for ( std::size_t i = 0; i < thread_count; ++i ) {
+                readers_.emplace_back( [this] { read_members(); } );
+            }
+        }
+
+        member_read_ahead( const member_read_ahead& ) = delete;
+        member_read_ahead& operator=( const member_read_ahead& ) = delete;
+
+        ~member_read_ahead() {
+            {
+                std::lock_guard< std::mutex > lk{ mtx_ };
+                stop_ = true;
+            }
+            cv_.notify_all();
+
+            for ( auto& t : readers_ ) {
+                t.join();
+            }
+        }
+
+        std::size_t size() const noexcept {
+            return members_.size();
+        }
+
+        // blocks until the member at _index has been stat'd and, if small
+        // enough, read into memory. members must be waited on in order.
+        archive_member& wait( std::size_t _index ) {
+            std::unique_lock< std::mutex > lk{ mtx_ };
+            cv_.wait( lk, [this, _index] { return members_[ _index ].ready; } );
+            return members_[ _index ];
+        }
+
+        // returns the read ahead buffer of the member to the budget
+        void release( std::size_t _index ) {
+            {
+                std::lock_guard< std::mutex > lk{ mtx_ };
+                auto& m = members_[ _index ];
+                bytes_in_flight_ -= m.reserved;
+                m.reserved = 0;
+                std::vector< char >{}.swap( m.data );
+            }
+            cv_.notify_all();
+        }
+
+    private:
+        void read_members() {
+            while ( true ) {
+                std::size_t index = 0;
+                struct stat st{};
+                int stat_error = 0;
+
+                {
+                    std::lock_guard< std::mutex > lk{ mtx_ };
+                    if ( stop_ || next_ >= members_.size() ) {
+                        return;
+                    }
+
+                    index = next_++;
+                }
+
+                auto& m = members_[ index ];
 
+                if ( stat( m.path.c_str(), &st ) != 0 ) {
+                    stat_error = errno;
+                }
+                else {
+                    m.size     = st.st_size;
+                    m.mtime    = st.st_mtime;
+                    m.streamed = m.size > READ_AHEAD_MAX_MEMBER_SIZE;
+                }
+
+                {
+                    // the budget is granted strictly in index order. the writer consumes
+                    // members in order, so a later member reserving first could hold the
+                    // bytes needed by the member the writer waits on, which would never
+                    // be read
+                    std::unique_lock< std::mutex > lk{ mtx_ };
+                    const bool reserve = 0 == stat_error && !m.streamed;
+
+                    cv_.wait( lk, [this, index, reserve, &m] {
+                        return stop_ || ( next_to_reserve_ == index &&
+                                          ( !reserve || bytes_in_flight_ + m.size <= READ_AHEAD_MAX_BYTES ) );
+                    } );
+
+                    if ( stop_ ) {
+                        return;
+                    }
+
+                    if ( reserve ) {
+                        m.reserved = m.size;
+                        bytes_in_flight_ += m.reserved;
+                    }
+
+                    ++next_to_reserve_;
+                }
+                cv_.notify_all();
+
+                int error = stat_error;
+
+                if ( 0 == error && !m.streamed ) {
+                    error = read_file( m );
+                }
+
+                {
+                    std::lock_guard< std::mutex > lk{ mtx_ };
+                    m.error = error;
+                    m.ready = true;
+                }
+                cv_.notify_all();
+            }
+        }
+
+        static int read_file( archive_member& _m ) {
+            const int fd = open( _m.path.c_str(), O_RDONLY );
+            if ( -1 == fd ) {
+                return errno;
+            }
+
+            _m.data.resize( _m.size );
+
+            std::size_t total = 0;
+            while ( total < _m.data.size() ) {
+                const auto len = read( fd, _m.data.data() + total, _m.data.size() - total );
+                if ( len < 0 ) {
+                    if ( EINTR == errno ) {
+                        continue;
+                    }
+                    const int error = errno;
+                    close( fd );
+                    return error;
+                }
+                if ( 0 == len ) {
+                    break;
+                }
+                total += len;
+            }
+
+            // the file may have shrunk since it was stat'd
+            _m.data.resize( total );
+            _m.size = total;
+
+            close( fd );
+            return 0;
+        }
+
+        std::vector< archive_member > members_;
+        std::vector< std::thread >    readers_;
+        std::mutex                    mtx_;
+        std::condition_variable       cv_;
+        std::size_t                   next_            = 0;
+        std::size_t                   next_to_reserve_ = 0;
+        std::uintmax_t                bytes_in_flight_ = 0;
+        bool                          stop_            = false;
+    }; // class member_read_ahead
+} // anonymous namespace
+
+// =-=-=-=-=-=-=-
+// helper function to write an archive entry
+irods::error write_file_to_archive( const archive_member& _member,
+                                    const std::string&    _cache_dir,
+                                    struct archive*       _archive ) {
     // =-=-=-=-=-=-=-
     // strip arch path from file name for header entry
-    std::string path_name  = _path.string();
-    std::string strip_file = path_name.substr( _cache_dir.size() + 1 ); // add one for the last '/'
-    archive_entry_set_pathname( entry, strip_file.c_str() );
+    std::string path_name  = _member.path.string();
 
-    // =-=-=-=-=-=-=-
-    // ask for the file size
-    archive_entry_set_size( entry, fs::file_size( _path ) );
-    archive_entry_set_filetype( entry, AE_IFREG );
+    if ( _member.error != 0 ) {
+        std::stringstream msg;
+        msg << "write_file_to_archive - failed to read file [";
+        msg << path_name;
+        msg << "] with error [";
+        msg << strerror( _member.error );
+        msg << "]";
+        return ERROR( UNIX_FILE_READ_ERR - _member.error, msg.str() );
+    }
 
     // =-=-=-=-=-=-=-
-    // set the permissions
-    //fs::perms pp;
-    //fs::permissions( _path, pp );
-    archive_entry_set_perm( entry, 0600 );
+    // open the file in question, if it was not read ahead
+    int fd = -1;
+    if ( _member.streamed ) {
+        fd = open( path_name.c_str(), O_RDONLY );
+        if ( -1 == fd )  {
+            std::stringstream msg;
+            msg << "write_file_to_archive - failed to open file for read [";
+            msg << path_name;
+            msg << "] with error [";
+            msg << strerror( errno );
+            msg << "]";
+            return ERROR( UNIX_FILE_OPEN_ERR - errno, msg.str() );
+        }
+    }
 
-    // =-=-=-=-=-=-=-
-    // set the time for the file
-    std::time_t tt = last_write_time( _path );
-    archive_entry_set_mtime( entry, tt, 0 );
+    struct archive_entry* entry = archive_entry_new();
+
+    std::string strip_file = path_name.substr( _cache_dir.size() + 1 ); // add one for the last '/'
+    archive_entry_set_pathname( entry, strip_file.c_str() );
+    archive_entry_set_size( entry, _member.size );
+    archive_entry_set_filetype( entry, AE_IFREG );
+    archive_entry_set_perm( entry, 0600 );
+    archive_entry_set_mtime( entry, _member.mtime, 0 );
 
     // =-=-=-=-=-=-=-
     // write out the header to the archive
@@ -2082,40 +2509,60 @@ irods::error write_file_to_archive( const boost::filesystem::path _path,
         msg << "] with error string [";
         msg << archive_error_string( _archive );
         msg << "]";
+        archive_entry_free( entry );
+        if ( -1 != fd ) {
+            close( fd );
+        }
         return ERROR( -1, msg.str() );
     }
 
+    archive_entry_free( entry );
+
     // =-=-=-=-=-=-=-
-    // JMC :: i didnt use ifstream as readsome() garbled the file
-    //     :: some reason.  revisit this for windows
-    // =-=-=-=-=-=-=-
-    // open the file in question
-    int fd = open( path_name.c_str(), O_RDONLY );
-    if ( -1 == fd )  {
+    // add the contents to the archive
+    irods::error result = SUCCESS();
+    if ( _member.streamed ) {
+        std::vector< char > buff( ARCHIVE_BLOCK_SIZE );
+        ssize_t len = 0;
+        while ( ( len = read( fd, buff.data(), buff.size() ) ) > 0 ) {
+            if ( archive_write_data( _archive, buff.data(), len ) < 0 ) {
+                break;
+            }
+        }
+
+        if ( len < 0 ) {
+            std::stringstream msg;
+            msg << "write_file_to_archive - failed to read file [";
+            msg << path_name;
+            msg << "] with error [";
+            msg << strerror( errno );
+            msg << "]";
+            result = ERROR( UNIX_FILE_READ_ERR - errno, msg.str() );
+        }
+        else if ( len > 0 ) {
+            std::stringstream msg;
+            msg << "write_file_to_archive - failed to write data for [";
+            msg << path_name;
+            msg << "] with error string [";
+            msg << archive_error_string( _archive );
+            msg << "]";
+            result = ERROR( -1, msg.str() );
+        }
+
+        close( fd );
+    }
+    else if ( !_member.data.empty() &&
+              archive_write_data( _archive, _member.data.data(), _member.data.size() ) < 0 ) {
         std::stringstream msg;
-        msg << "write_file_to_archive - failed to open file for read [";
+        msg << "write_file_to_archive - failed to write data for [";
         msg << path_name;
-        msg << "] with error [";
-        msg << strerror( errno );
+        msg << "] with error string [";
+        msg << archive_error_string( _archive );
         msg << "]";
-        return ERROR( -1, msg.str() );
-    }
-
-    // =-=-=-=-=-=-=-
-    // read in the file and add it to the archive
-    char buff[ 16384 ];
-    int len = read( fd, buff, sizeof( buff ) );
-    while ( len > 0 ) {
-        archive_write_data( _archive, buff, len );
-        len = read( fd, buff, sizeof( buff ) );
+        result = ERROR( -1, msg.str() );
     }
 
-    // =-=-=-=-=-=-=-
-    // clean up
-    close( fd );
-    archive_entry_free( entry );
-
-    return SUCCESS();
+    return result;
 
 } // write_file_to_archive
 
@@ -2306,6 +2753,31 @@ irods::error bundle_cache_dir( int         _index,
         // set the format of the tar archive
         archive_write_set_format_ustar( arch );
 
+    }
+    else if ( _data_type == ZSTD_TAR_DT_STR ) {
+#if ARCHIVE_VERSION_NUMBER >= 3003003
+        if ( archive_write_add_filter_zstd( arch ) != ARCHIVE_OK ) {
+            std::stringstream msg;
+            msg << "bundle_cache_dir - failed to set compression to zstd for archive [";
+            msg << spec_coll->phyPath;
+            msg << "] with error string [";
+            msg << archive_error_string( arch );
+            msg << "]";
+            return ERROR( -1, msg.str() );
+
+        }
+
+        // =-=-=-=-=-=-=-
+        // set the format of the tar archive
+        archive_write_set_format_ustar( arch );
+#else
+        std::stringstream msg;
+        msg << "bundle_cache_dir - zstd compression is not supported by this libarchive for archive [";
+        msg << spec_coll->phyPath;
+        msg << "]";
+        return ERROR( SYS_ZIP_FORMAT_NOT_SUPPORTED, msg.str() );
+#endif
+
     }
     else {
         if ( archive_write_add_filter_none( arch ) != ARCHIVE_OK ) {
@@ -2359,23 +2831,28 @@ irods::error bundle_cache_dir( int         _index,
 
     // =-=-=-=-=-=-=-
     // iterate over the dir listing and archive the files
+    // the members are read ahead by a bounded pool of readers, in listing order
     std::string cache_dir( spec_coll->cacheDir );
     irods::error arch_err = SUCCESS();
-    for ( size_t i = 0; i < listing.size(); ++i ) {
-        // =-=-=-=-=-=-=-
-        // strip off archive path from the filename
-        irods::error ret = write_file_to_archive( listing[ i ].string(), cache_dir, arch );
+    {
+        member_read_ahead members( listing );
+        for ( size_t i = 0; i < members.size(); ++i ) {
+            // =-=-=-=-=-=-=-
+            // strip off archive path from the filename
+            irods::error ret = write_file_to_archive( members.wait( i ), cache_dir, arch );
+            members.release( i );
 
-        if ( !ret.ok() ) {
-            std::stringstream msg;
-            msg << "bundle_cache_dir - failed to archive file [";
-            msg << listing[ i ].string();
-            msg << "]";
-            arch_err = PASSMSG( msg.str(), arch_err );
-            irods::log( PASSMSG( msg.str(), ret ) );
-        }
+            if ( !ret.ok() ) {
+                std::stringstream msg;
+                msg << "bundle_cache_dir - failed to archive file [";
+                msg << listing[ i ].string();
+                msg << "]";
+                arch_err = PASSMSG( msg.str(), arch_err );
+                irods::log( PASSMSG( msg.str(), ret ) );
+            }
 
-    } // for i
+        } // for i
+    }
 
     // =-=-=-=-=-=-=-
     // close the archive and clean up
@@ -134,13 +134,7 @@ static irods::error unix_file_copy(
             destFileName, err_status));
     }
 
-    size_t trans_buff_size;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    }
-    catch ( const irods::exception& e ) {
-        return irods::error(e);
-    }
+    size_t trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     std::vector<char> myBuf( trans_buff_size );
     int bytesRead{};
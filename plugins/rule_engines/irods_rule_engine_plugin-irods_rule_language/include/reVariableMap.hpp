@@ -25,6 +25,19 @@ ExprType *getVarType( char *varMap, Region *r );
 int getVarValue( char *varMap, ruleExecInfo_t *rei, Res **varValue, Region *r );
 int getVarNameFromVarMap( char *varMap, char *varName, char **varMapCPtr );
 
+/* A field reachable from ruleExecInfo_t, e.g. "rei->doi->objPath". */
+typedef struct {
+    const char *path;
+    int ( *getValue )( ruleExecInfo_t *rei, Res **varValue, Region *r );
+    int ( *setValue )( ruleExecInfo_t *rei, Res *newVarValue );
+    NodeType type;          /* T_INT, T_DOUBLE, T_STRING or T_IRODS */
+    const char *irodsType;  /* the type of a T_IRODS field */
+} VariablePath;
+
+/* Returns the field designated by a variable map, or NULL if the variable map must be
+ * resolved by the accessors (getValFromRuleExecInfo, ...). Defined in reVariableMap.gen.cpp. */
+const VariablePath *lookupVariablePath( const char *path );
+
 #define REVARIABLEMAP_HPP_
 
 
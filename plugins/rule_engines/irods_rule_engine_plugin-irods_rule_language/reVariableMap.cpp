@@ -5,6 +5,7 @@
 #include "reGlobalsExtern.hpp"
 #include "conversion.hpp"
 #include "reVariableMap.gen.hpp"
+#include "reVariableMap.hpp"
 #include "reVariables.hpp"
 #include "rcMisc.h"
 #ifdef DEBUG
@@ -138,6 +139,10 @@ ExprType *getVarType( char *varMap, Region *r ) {
     char *varMapCPtr;
     int i;
 
+    if ( const VariablePath *path = lookupVariablePath( varMap ) ) {
+        return path->type == T_IRODS ? newIRODSType( path->irodsType, r ) : newSimpType( path->type, r );
+    }
+
     i = getVarNameFromVarMap( varMap, varName, &varMapCPtr );
     if ( i != 0 ) {
         return newErrorRes( r, i );
@@ -158,6 +163,10 @@ getVarValue( char *varMap, ruleExecInfo_t *rei, Res **varValue, Region *r ) {
     char *varMapCPtr;
     int i;
 
+    if ( const VariablePath *path = lookupVariablePath( varMap ) ) {
+        return path->getValue( rei, varValue, r );
+    }
+
     i = getVarNameFromVarMap( varMap, varName, &varMapCPtr );
     if ( i != 0 ) {
         return i;
@@ -176,6 +185,9 @@ int
 setVarValue( char *varMap, ruleExecInfo_t *rei, Res *newVarValue ) {
     char varName[NAME_LEN];
     char *varMapCPtr;
+    if ( const VariablePath *path = lookupVariablePath( varMap ) ) {
+        return path->setValue( rei, newVarValue );
+    }
     int status = getVarNameFromVarMap( varMap, varName, &varMapCPtr );
     if ( status != 0 ) {
         return status;
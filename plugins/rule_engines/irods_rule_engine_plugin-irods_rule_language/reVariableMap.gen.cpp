@@ -4604,3 +4604,1329 @@ ExprType *getVarTypeFromFileOpenInp( char *varMap, Region *r ) {
 
     return newErrorType( UNDEFINED_VARIABLE_MAP_ERR, r );
 }
+
+
+/* BEGIN variable path index: generated by scripts/generate_variable_path_index.py */
+
+static int getValPath_rei_pluginInstanceName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->pluginInstanceName, r );
+}
+static int setValPath_rei_pluginInstanceName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->pluginInstanceName, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_status( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->status, r );
+}
+static int setValPath_rei_status( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->status ), newVarValue );
+}
+
+static int getValPath_rei_statusStr( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->statusStr, r );
+}
+static int setValPath_rei_statusStr( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->statusStr, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_ruleName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->ruleName, r );
+}
+static int setValPath_rei_ruleName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->ruleName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_rsComm( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->rsComm, NULL, RsComm_MS_T, r );
+}
+static int setValPath_rei_rsComm( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->rsComm ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_sock( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->sock, r );
+}
+static int setValPath_rei_rsComm_sock( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->sock ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_connectCnt( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->connectCnt, r );
+}
+static int setValPath_rei_rsComm_connectCnt( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->connectCnt ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_clientAddr( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->rsComm->clientAddr, r );
+}
+static int setValPath_rei_rsComm_clientAddr( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->rsComm->clientAddr, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_rsComm_option( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->rsComm->option, r );
+}
+static int setValPath_rei_rsComm_option( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->rsComm->option, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_rsComm_apiInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->apiInx, r );
+}
+static int setValPath_rei_rsComm_apiInx( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->apiInx ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_status( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->status, r );
+}
+static int setValPath_rei_rsComm_status( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->status ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_windowSize( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->windowSize, r );
+}
+static int setValPath_rei_rsComm_windowSize( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->windowSize ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_reconnFlag( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->reconnFlag, r );
+}
+static int setValPath_rei_rsComm_reconnFlag( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->reconnFlag ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_reconnSock( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->reconnSock, r );
+}
+static int setValPath_rei_rsComm_reconnSock( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->reconnSock ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_reconnPort( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->reconnPort, r );
+}
+static int setValPath_rei_rsComm_reconnPort( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->reconnPort ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_reconnectedSock( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->reconnectedSock, r );
+}
+static int setValPath_rei_rsComm_reconnectedSock( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->reconnectedSock ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_reconnAddr( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->rsComm->reconnAddr, r );
+}
+static int setValPath_rei_rsComm_reconnAddr( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrDupLeafValue( &( rei->rsComm->reconnAddr ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_cookie( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->cookie, r );
+}
+static int setValPath_rei_rsComm_cookie( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->cookie ), newVarValue );
+}
+
+static int getValPath_rei_rsComm_gsiRequest( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->rsComm->gsiRequest, r );
+}
+static int setValPath_rei_rsComm_gsiRequest( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->rsComm == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->rsComm->gsiRequest ), newVarValue );
+}
+
+static int getValPath_rei_l1descInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->l1descInx, r );
+}
+static int setValPath_rei_l1descInx( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->l1descInx ), newVarValue );
+}
+
+static int getValPath_rei_doinp( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->doinp, NULL, DataObjInp_MS_T, r );
+}
+static int setValPath_rei_doinp( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->doinp ), newVarValue );
+}
+
+static int getValPath_rei_doinp_objPath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doinp->objPath, r );
+}
+static int setValPath_rei_doinp_objPath( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doinp->objPath, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doinp_createMode( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doinp->createMode, r );
+}
+static int setValPath_rei_doinp_createMode( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doinp->createMode ), newVarValue );
+}
+
+static int getValPath_rei_doinp_openFlags( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doinp->openFlags, r );
+}
+static int setValPath_rei_doinp_openFlags( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doinp->openFlags ), newVarValue );
+}
+
+static int getValPath_rei_doinp_offset( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getLongLeafValue( varValue, rei->doinp->offset, r );
+}
+static int setValPath_rei_doinp_offset( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setLongLeafValue( &( rei->doinp->offset ), newVarValue );
+}
+
+static int getValPath_rei_doinp_dataSize( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getLongLeafValue( varValue, rei->doinp->dataSize, r );
+}
+static int setValPath_rei_doinp_dataSize( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setLongLeafValue( &( rei->doinp->dataSize ), newVarValue );
+}
+
+static int getValPath_rei_doinp_numThreads( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doinp->numThreads, r );
+}
+static int setValPath_rei_doinp_numThreads( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doinp->numThreads ), newVarValue );
+}
+
+static int getValPath_rei_doinp_oprType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doinp->oprType, r );
+}
+static int setValPath_rei_doinp_oprType( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doinp == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doinp->oprType ), newVarValue );
+}
+
+static int getValPath_rei_doi( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->doi, NULL, DataObjInfo_MS_T, r );
+}
+static int setValPath_rei_doi( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->doi ), newVarValue );
+}
+
+static int getValPath_rei_doi_objPath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->objPath, r );
+}
+static int setValPath_rei_doi_objPath( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->objPath, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_rescName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->rescName, r );
+}
+static int setValPath_rei_doi_rescName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->rescName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataType, r );
+}
+static int setValPath_rei_doi_dataType( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataType, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataSize( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getLongLeafValue( varValue, rei->doi->dataSize, r );
+}
+static int setValPath_rei_doi_dataSize( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setLongLeafValue( &( rei->doi->dataSize ), newVarValue );
+}
+
+static int getValPath_rei_doi_chksum( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->chksum, r );
+}
+static int setValPath_rei_doi_chksum( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->chksum, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_version( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->version, r );
+}
+static int setValPath_rei_doi_version( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->version, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_filePath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->filePath, r );
+}
+static int setValPath_rei_doi_filePath( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->filePath, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataOwnerName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataOwnerName, r );
+}
+static int setValPath_rei_doi_dataOwnerName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataOwnerName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataOwnerZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataOwnerZone, r );
+}
+static int setValPath_rei_doi_dataOwnerZone( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataOwnerZone, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_replNum( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->replNum, r );
+}
+static int setValPath_rei_doi_replNum( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->replNum ), newVarValue );
+}
+
+static int getValPath_rei_doi_replStatus( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->replStatus, r );
+}
+static int setValPath_rei_doi_replStatus( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->replStatus ), newVarValue );
+}
+
+static int getValPath_rei_doi_statusString( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->statusString, r );
+}
+static int setValPath_rei_doi_statusString( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->statusString, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getLongLeafValue( varValue, rei->doi->dataId, r );
+}
+static int setValPath_rei_doi_dataId( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setLongLeafValue( &( rei->doi->dataId ), newVarValue );
+}
+
+static int getValPath_rei_doi_collId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getLongLeafValue( varValue, rei->doi->collId, r );
+}
+static int setValPath_rei_doi_collId( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setLongLeafValue( &( rei->doi->collId ), newVarValue );
+}
+
+static int getValPath_rei_doi_dataMapId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->dataMapId, r );
+}
+static int setValPath_rei_doi_dataMapId( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->dataMapId ), newVarValue );
+}
+
+static int getValPath_rei_doi_flags( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->flags, r );
+}
+static int setValPath_rei_doi_flags( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->flags ), newVarValue );
+}
+
+static int getValPath_rei_doi_dataComments( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataComments, r );
+}
+static int setValPath_rei_doi_dataComments( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataComments, LONG_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataMode( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataMode, r );
+}
+static int setValPath_rei_doi_dataMode( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataMode, SHORT_STR_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataExpiry( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataExpiry, r );
+}
+static int setValPath_rei_doi_dataExpiry( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataExpiry, TIME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataCreate( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataCreate, r );
+}
+static int setValPath_rei_doi_dataCreate( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataCreate, TIME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataModify( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataModify, r );
+}
+static int setValPath_rei_doi_dataModify( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataModify, TIME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataAccess( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->dataAccess, r );
+}
+static int setValPath_rei_doi_dataAccess( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->dataAccess, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_dataAccessInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->dataAccessInx, r );
+}
+static int setValPath_rei_doi_dataAccessInx( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->dataAccessInx ), newVarValue );
+}
+
+static int getValPath_rei_doi_writeFlag( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->writeFlag, r );
+}
+static int setValPath_rei_doi_writeFlag( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->writeFlag ), newVarValue );
+}
+
+static int getValPath_rei_doi_destRescName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->destRescName, r );
+}
+static int setValPath_rei_doi_destRescName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->destRescName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_backupRescName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->backupRescName, r );
+}
+static int setValPath_rei_doi_backupRescName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->backupRescName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_subPath( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->doi->subPath, r );
+}
+static int setValPath_rei_doi_subPath( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->doi->subPath, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_doi_regUid( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->regUid, r );
+}
+static int setValPath_rei_doi_regUid( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->regUid ), newVarValue );
+}
+
+static int getValPath_rei_doi_otherFlags( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->doi->otherFlags, r );
+}
+static int setValPath_rei_doi_otherFlags( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->doi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->doi->otherFlags ), newVarValue );
+}
+
+static int getValPath_rei_uoic( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->uoic, NULL, UserInfo_MS_T, r );
+}
+static int setValPath_rei_uoic( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->uoic ), newVarValue );
+}
+
+static int getValPath_rei_uoic_userName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoic->userName, r );
+}
+static int setValPath_rei_uoic_userName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoic->userName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoic_rodsZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoic->rodsZone, r );
+}
+static int setValPath_rei_uoic_rodsZone( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoic->rodsZone, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoic_userType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoic->userType, r );
+}
+static int setValPath_rei_uoic_userType( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoic->userType, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoic_sysUid( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->uoic->sysUid, r );
+}
+static int setValPath_rei_uoic_sysUid( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoic == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->uoic->sysUid ), newVarValue );
+}
+
+static int getValPath_rei_uoip( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->uoip, NULL, UserInfo_MS_T, r );
+}
+static int setValPath_rei_uoip( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->uoip ), newVarValue );
+}
+
+static int getValPath_rei_uoip_userName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoip->userName, r );
+}
+static int setValPath_rei_uoip_userName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoip->userName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoip_rodsZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoip->rodsZone, r );
+}
+static int setValPath_rei_uoip_rodsZone( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoip->rodsZone, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoip_userType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoip->userType, r );
+}
+static int setValPath_rei_uoip_userType( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoip->userType, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoip_sysUid( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->uoip->sysUid, r );
+}
+static int setValPath_rei_uoip_sysUid( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoip == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->uoip->sysUid ), newVarValue );
+}
+
+static int getValPath_rei_coi( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->coi, NULL, CollInfo_MS_T, r );
+}
+static int setValPath_rei_coi( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->coi ), newVarValue );
+}
+
+static int getValPath_rei_coi_collId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getLongLeafValue( varValue, rei->coi->collId, r );
+}
+static int setValPath_rei_coi_collId( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setLongLeafValue( &( rei->coi->collId ), newVarValue );
+}
+
+static int getValPath_rei_coi_collName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collName, r );
+}
+static int setValPath_rei_coi_collName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collName, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collParentName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collParentName, r );
+}
+static int setValPath_rei_coi_collParentName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collParentName, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collOwnerName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collOwnerName, r );
+}
+static int setValPath_rei_coi_collOwnerName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collOwnerName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collOwnerZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collOwnerZone, r );
+}
+static int setValPath_rei_coi_collOwnerZone( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collOwnerZone, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collMapId( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->coi->collMapId, r );
+}
+static int setValPath_rei_coi_collMapId( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->coi->collMapId ), newVarValue );
+}
+
+static int getValPath_rei_coi_collAccessInx( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->coi->collAccessInx, r );
+}
+static int setValPath_rei_coi_collAccessInx( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->coi->collAccessInx ), newVarValue );
+}
+
+static int getValPath_rei_coi_collComments( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collComments, r );
+}
+static int setValPath_rei_coi_collComments( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collComments, LONG_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collInheritance( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collInheritance, r );
+}
+static int setValPath_rei_coi_collInheritance( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collInheritance, LONG_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collExpiry( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collExpiry, r );
+}
+static int setValPath_rei_coi_collExpiry( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collExpiry, TIME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collCreate( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collCreate, r );
+}
+static int setValPath_rei_coi_collCreate( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collCreate, TIME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collModify( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collModify, r );
+}
+static int setValPath_rei_coi_collModify( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collModify, TIME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collAccess( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collAccess, r );
+}
+static int setValPath_rei_coi_collAccess( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collAccess, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collType, r );
+}
+static int setValPath_rei_coi_collType( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collType, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collInfo1( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collInfo1, r );
+}
+static int setValPath_rei_coi_collInfo1( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collInfo1, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_coi_collInfo2( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->coi->collInfo2, r );
+}
+static int setValPath_rei_coi_collInfo2( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->coi == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->coi->collInfo2, MAX_NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoio( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->uoio, NULL, UserInfo_MS_T, r );
+}
+static int setValPath_rei_uoio( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->uoio ), newVarValue );
+}
+
+static int getValPath_rei_uoio_userName( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoio->userName, r );
+}
+static int setValPath_rei_uoio_userName( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoio->userName, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoio_rodsZone( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoio->rodsZone, r );
+}
+static int setValPath_rei_uoio_rodsZone( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoio->rodsZone, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoio_userType( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->uoio->userType, r );
+}
+static int setValPath_rei_uoio_userType( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->uoio->userType, NAME_LEN, newVarValue );
+}
+
+static int getValPath_rei_uoio_sysUid( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->uoio->sysUid, r );
+}
+static int setValPath_rei_uoio_sysUid( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->uoio == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->uoio->sysUid ), newVarValue );
+}
+
+static int getValPath_rei_condInputData( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getPtrLeafValue( varValue, ( void * ) rei->condInputData, NULL, KeyValPair_MS_T, r );
+}
+static int setValPath_rei_condInputData( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStructPtrLeafValue( ( void ** ) &( rei->condInputData ), newVarValue );
+}
+
+static int getValPath_rei_condInputData_len( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL || rei->condInputData == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getIntLeafValue( varValue, rei->condInputData->len, r );
+}
+static int setValPath_rei_condInputData_len( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL || rei->condInputData == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setIntLeafValue( &( rei->condInputData->len ), newVarValue );
+}
+
+static int getValPath_rei_ruleSet( ruleExecInfo_t *rei, Res **varValue, Region *r ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return getStrLeafValue( varValue, rei->ruleSet, r );
+}
+static int setValPath_rei_ruleSet( ruleExecInfo_t *rei, Res *newVarValue ) {
+    if ( rei == NULL ) {
+        return NULL_VALUE_ERR;
+    }
+    return setStrLeafValue( rei->ruleSet, RULE_SET_DEF_LENGTH, newVarValue );
+}
+
+static const VariablePath variablePaths[] = {
+    { "rei->ruleName", getValPath_rei_ruleName, setValPath_rei_ruleName, T_STRING, NULL },
+    { "rei->doi->dataComments", getValPath_rei_doi_dataComments, setValPath_rei_doi_dataComments, T_STRING, NULL },
+    { "rei->coi", getValPath_rei_coi, setValPath_rei_coi, T_IRODS, CollInfo_MS_T },
+    { "rei->rsComm->clientAddr", getValPath_rei_rsComm_clientAddr, setValPath_rei_rsComm_clientAddr, T_STRING, NULL },
+    { "rei->doinp->dataSize", getValPath_rei_doinp_dataSize, setValPath_rei_doinp_dataSize, T_DOUBLE, NULL },
+    { "rei->coi->collInfo1", getValPath_rei_coi_collInfo1, setValPath_rei_coi_collInfo1, T_STRING, NULL },
+    { "rei->uoip->userType", getValPath_rei_uoip_userType, setValPath_rei_uoip_userType, T_STRING, NULL },
+    { "rei->doinp->objPath", getValPath_rei_doinp_objPath, setValPath_rei_doinp_objPath, T_STRING, NULL },
+    { "rei->doi->filePath", getValPath_rei_doi_filePath, setValPath_rei_doi_filePath, T_STRING, NULL },
+    { "rei->rsComm", getValPath_rei_rsComm, setValPath_rei_rsComm, T_IRODS, RsComm_MS_T },
+    { "rei->doi->dataModify", getValPath_rei_doi_dataModify, setValPath_rei_doi_dataModify, T_STRING, NULL },
+    { "rei->coi->collMapId", getValPath_rei_coi_collMapId, setValPath_rei_coi_collMapId, T_INT, NULL },
+    { "rei->rsComm->reconnFlag", getValPath_rei_rsComm_reconnFlag, setValPath_rei_rsComm_reconnFlag, T_INT, NULL },
+    { "rei->rsComm->windowSize", getValPath_rei_rsComm_windowSize, setValPath_rei_rsComm_windowSize, T_INT, NULL },
+    { "rei->coi->collModify", getValPath_rei_coi_collModify, setValPath_rei_coi_collModify, T_STRING, NULL },
+    { "rei->doi->writeFlag", getValPath_rei_doi_writeFlag, setValPath_rei_doi_writeFlag, T_INT, NULL },
+    { "rei->doi->collId", getValPath_rei_doi_collId, setValPath_rei_doi_collId, T_DOUBLE, NULL },
+    { "rei->uoio", getValPath_rei_uoio, setValPath_rei_uoio, T_IRODS, UserInfo_MS_T },
+    { "rei->uoic->userName", getValPath_rei_uoic_userName, setValPath_rei_uoic_userName, T_STRING, NULL },
+    { "rei->doi->dataMapId", getValPath_rei_doi_dataMapId, setValPath_rei_doi_dataMapId, T_INT, NULL },
+    { "rei->ruleSet", getValPath_rei_ruleSet, setValPath_rei_ruleSet, T_STRING, NULL },
+    { "rei->doinp->openFlags", getValPath_rei_doinp_openFlags, setValPath_rei_doinp_openFlags, T_INT, NULL },
+    { "rei->coi->collCreate", getValPath_rei_coi_collCreate, setValPath_rei_coi_collCreate, T_STRING, NULL },
+    { "rei->rsComm->connectCnt", getValPath_rei_rsComm_connectCnt, setValPath_rei_rsComm_connectCnt, T_INT, NULL },
+    { "rei->rsComm->reconnPort", getValPath_rei_rsComm_reconnPort, setValPath_rei_rsComm_reconnPort, T_INT, NULL },
+    { "rei->doi->subPath", getValPath_rei_doi_subPath, setValPath_rei_doi_subPath, T_STRING, NULL },
+    { "rei->l1descInx", getValPath_rei_l1descInx, setValPath_rei_l1descInx, T_INT, NULL },
+    { "rei->coi->collOwnerName", getValPath_rei_coi_collOwnerName, setValPath_rei_coi_collOwnerName, T_STRING, NULL },
+    { "rei->doi->dataAccessInx", getValPath_rei_doi_dataAccessInx, setValPath_rei_doi_dataAccessInx, T_INT, NULL },
+    { "rei->coi->collComments", getValPath_rei_coi_collComments, setValPath_rei_coi_collComments, T_STRING, NULL },
+    { "rei->doi->dataAccess", getValPath_rei_doi_dataAccess, setValPath_rei_doi_dataAccess, T_STRING, NULL },
+    { "rei->pluginInstanceName", getValPath_rei_pluginInstanceName, setValPath_rei_pluginInstanceName, T_STRING, NULL },
+    { "rei->uoip->sysUid", getValPath_rei_uoip_sysUid, setValPath_rei_uoip_sysUid, T_INT, NULL },
+    { "rei->rsComm->apiInx", getValPath_rei_rsComm_apiInx, setValPath_rei_rsComm_apiInx, T_INT, NULL },
+    { "rei->doi->chksum", getValPath_rei_doi_chksum, setValPath_rei_doi_chksum, T_STRING, NULL },
+    { "rei->status", getValPath_rei_status, setValPath_rei_status, T_INT, NULL },
+    { "rei->doinp->oprType", getValPath_rei_doinp_oprType, setValPath_rei_doinp_oprType, T_INT, NULL },
+    { "rei->doi->dataExpiry", getValPath_rei_doi_dataExpiry, setValPath_rei_doi_dataExpiry, T_STRING, NULL },
+    { "rei->coi->collInheritance", getValPath_rei_coi_collInheritance, setValPath_rei_coi_collInheritance, T_STRING, NULL },
+    { "rei->uoio->sysUid", getValPath_rei_uoio_sysUid, setValPath_rei_uoio_sysUid, T_INT, NULL },
+    { "rei->uoip", getValPath_rei_uoip, setValPath_rei_uoip, T_IRODS, UserInfo_MS_T },
+    { "rei->rsComm->option", getValPath_rei_rsComm_option, setValPath_rei_rsComm_option, T_STRING, NULL },
+    { "rei->uoip->rodsZone", getValPath_rei_uoip_rodsZone, setValPath_rei_uoip_rodsZone, T_STRING, NULL },
+    { "rei->doi->backupRescName", getValPath_rei_doi_backupRescName, setValPath_rei_doi_backupRescName, T_STRING, NULL },
+    { "rei->rsComm->cookie", getValPath_rei_rsComm_cookie, setValPath_rei_rsComm_cookie, T_INT, NULL },
+    { "rei->rsComm->reconnectedSock", getValPath_rei_rsComm_reconnectedSock, setValPath_rei_rsComm_reconnectedSock, T_INT, NULL },
+    { "rei->doi->replNum", getValPath_rei_doi_replNum, setValPath_rei_doi_replNum, T_INT, NULL },
+    { "rei->uoic", getValPath_rei_uoic, setValPath_rei_uoic, T_IRODS, UserInfo_MS_T },
+    { "rei->doi->objPath", getValPath_rei_doi_objPath, setValPath_rei_doi_objPath, T_STRING, NULL },
+    { "rei->doi->statusString", getValPath_rei_doi_statusString, setValPath_rei_doi_statusString, T_STRING, NULL },
+    { "rei->doi->destRescName", getValPath_rei_doi_destRescName, setValPath_rei_doi_destRescName, T_STRING, NULL },
+    { "rei->coi->collParentName", getValPath_rei_coi_collParentName, setValPath_rei_coi_collParentName, T_STRING, NULL },
+    { "rei->coi->collExpiry", getValPath_rei_coi_collExpiry, setValPath_rei_coi_collExpiry, T_STRING, NULL },
+    { "rei->doi->version", getValPath_rei_doi_version, setValPath_rei_doi_version, T_STRING, NULL },
+    { "rei->doi->replStatus", getValPath_rei_doi_replStatus, setValPath_rei_doi_replStatus, T_INT, NULL },
+    { "rei->doinp->numThreads", getValPath_rei_doinp_numThreads, setValPath_rei_doinp_numThreads, T_INT, NULL },
+    { "rei->rsComm->status", getValPath_rei_rsComm_status, setValPath_rei_rsComm_status, T_INT, NULL },
+    { "rei->doi->regUid", getValPath_rei_doi_regUid, setValPath_rei_doi_regUid, T_INT, NULL },
+    { "rei->rsComm->reconnSock", getValPath_rei_rsComm_reconnSock, setValPath_rei_rsComm_reconnSock, T_INT, NULL },
+    { "rei->doi->dataOwnerZone", getValPath_rei_doi_dataOwnerZone, setValPath_rei_doi_dataOwnerZone, T_STRING, NULL },
+    { "rei->coi->collInfo2", getValPath_rei_coi_collInfo2, setValPath_rei_coi_collInfo2, T_STRING, NULL },
+    { "rei->uoio->userType", getValPath_rei_uoio_userType, setValPath_rei_uoio_userType, T_STRING, NULL },
+    { "rei->uoic->sysUid", getValPath_rei_uoic_sysUid, setValPath_rei_uoic_sysUid, T_INT, NULL },
+    { "rei->uoip->userName", getValPath_rei_uoip_userName, setValPath_rei_uoip_userName, T_STRING, NULL },
+    { "rei->doi->dataMode", getValPath_rei_doi_dataMode, setValPath_rei_doi_dataMode, T_STRING, NULL },
+    { "rei->coi->collType", getValPath_rei_coi_collType, setValPath_rei_coi_collType, T_STRING, NULL },
+    { "rei->coi->collAccess", getValPath_rei_coi_collAccess, setValPath_rei_coi_collAccess, T_STRING, NULL },
+    { "rei->uoio->rodsZone", getValPath_rei_uoio_rodsZone, setValPath_rei_uoio_rodsZone, T_STRING, NULL },
+    { "rei->uoio->userName", getValPath_rei_uoio_userName, setValPath_rei_uoio_userName, T_STRING, NULL },
+    { "rei->rsComm->reconnAddr", getValPath_rei_rsComm_reconnAddr, setValPath_rei_rsComm_reconnAddr, T_STRING, NULL },
+    { "rei->doi->rescName", getValPath_rei_doi_rescName, setValPath_rei_doi_rescName, T_STRING, NULL },
+    { "rei->doi->dataCreate", getValPath_rei_doi_dataCreate, setValPath_rei_doi_dataCreate, T_STRING, NULL },
+    { "rei->doi->dataOwnerName", getValPath_rei_doi_dataOwnerName, setValPath_rei_doi_dataOwnerName, T_STRING, NULL },
+    { "rei->coi->collOwnerZone", getValPath_rei_coi_collOwnerZone, setValPath_rei_coi_collOwnerZone, T_STRING, NULL },
+    { "rei->condInputData->len", getValPath_rei_condInputData_len, setValPath_rei_condInputData_len, T_INT, NULL },
+    { "rei->doi->dataId", getValPath_rei_doi_dataId, setValPath_rei_doi_dataId, T_DOUBLE, NULL },
+    { "rei->doi->otherFlags", getValPath_rei_doi_otherFlags, setValPath_rei_doi_otherFlags, T_INT, NULL },
+    { "rei->condInputData", getValPath_rei_condInputData, setValPath_rei_condInputData, T_IRODS, KeyValPair_MS_T },
+    { "rei->rsComm->sock", getValPath_rei_rsComm_sock, setValPath_rei_rsComm_sock, T_INT, NULL },
+    { "rei->doinp->offset", getValPath_rei_doinp_offset, setValPath_rei_doinp_offset, T_DOUBLE, NULL },
+    { "rei->statusStr", getValPath_rei_statusStr, setValPath_rei_statusStr, T_STRING, NULL },
+    { "rei->doi->dataType", getValPath_rei_doi_dataType, setValPath_rei_doi_dataType, T_STRING, NULL },
+    { "rei->doinp", getValPath_rei_doinp, setValPath_rei_doinp, T_IRODS, DataObjInp_MS_T },
+    { "rei->doi->dataSize", getValPath_rei_doi_dataSize, setValPath_rei_doi_dataSize, T_DOUBLE, NULL },
+    { "rei->coi->collId", getValPath_rei_coi_collId, setValPath_rei_coi_collId, T_DOUBLE, NULL },
+    { "rei->doi->flags", getValPath_rei_doi_flags, setValPath_rei_doi_flags, T_INT, NULL },
+    { "rei->coi->collName", getValPath_rei_coi_collName, setValPath_rei_coi_collName, T_STRING, NULL },
+    { "rei->coi->collAccessInx", getValPath_rei_coi_collAccessInx, setValPath_rei_coi_collAccessInx, T_INT, NULL },
+    { "rei->uoic->rodsZone", getValPath_rei_uoic_rodsZone, setValPath_rei_uoic_rodsZone, T_STRING, NULL },
+    { "rei->rsComm->gsiRequest", getValPath_rei_rsComm_gsiRequest, setValPath_rei_rsComm_gsiRequest, T_INT, NULL },
+    { "rei->doi", getValPath_rei_doi, setValPath_rei_doi, T_IRODS, DataObjInfo_MS_T },
+    { "rei->doinp->createMode", getValPath_rei_doinp_createMode, setValPath_rei_doinp_createMode, T_INT, NULL },
+    { "rei->uoic->userType", getValPath_rei_uoic_userType, setValPath_rei_uoic_userType, T_STRING, NULL },
+};
+
+static const unsigned short variablePathDisplacements[] = {
+    4, 0, 8, 13, 4, 0, 0, 0, 5, 7, 0, 1, 0, 2, 4, 0,
+    10, 2, 4, 7, 1, 9, 20, 0, 15, 13, 8, 0, 0, 0, 8, 12,
+    8, 12, 36, 19, 11, 3, 1, 1, 22, 1, 0, 16, 96, 28, 3,
+};
+
+const VariablePath *lookupVariablePath( const char *path ) {
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    for ( const unsigned char *p = ( const unsigned char * ) path; *p != '\0'; ++p ) {
+        h = ( h ^ *p ) * 0x100000001b3ULL;
+    }
+    const unsigned long long d = variablePathDisplacements[( h >> 32 ) % 47];
+    const VariablePath *entry = &variablePaths[( ( h & 0xffffffffULL ) ^ d ) % 93];
+    return strcmp( entry->path, path ) == 0 ? entry : NULL;
+}
+
+/* END variable path index */
@@ -0,0 +1,245 @@
+#!/usr/bin/python
+from __future__ import print_function
+
+# Generates the variable path index of reVariableMap.gen.cpp.
+#
+# The accessors generated for each structure (getValFromRuleExecInfo, setValFromRuleExecInfo,
+# getVarTypeFromRuleExecInfo, ...) resolve a variable map such as "rei->doi->objPath" one
+# field at a time, comparing the name of the field against every field of the structure.
+#
+# This script walks those accessors, starting from ruleExecInfo_t, and emits one typed
+# getter and setter for every field path they can resolve. The paths are placed in a
+# minimal perfect hash table (hash and displace), so that resolving a variable map takes
+# a single hash of the path and a single comparison.
+#
+# Usage: generate_variable_path_index.py [path/to/reVariableMap.gen.cpp]
+#
+# The section between the BEGIN and END markers of the file is replaced in place.
+
+import os
+import re
+import sys
+
+BEGIN_MARKER = '/* BEGIN variable path index: generated by scripts/generate_variable_path_index.py */'
+END_MARKER = '/* END variable path index */'
+
+ROOT_STRUCT = 'RuleExecInfo'
+ROOT_NAME = 'rei'
+
+# Following these fields would produce an unbounded number of paths.
+RECURSIVE_FIELDS = ('next',)
+
+FNV_OFFSET_BASIS = 0xcbf29ce484222325
+FNV_PRIME = 0x100000001b3
+MASK_64 = (1 << 64) - 1
+
+
+def hash_path(path):
+    h = FNV_OFFSET_BASIS
+    for c in path.encode('ascii'):
+        h ^= c if isinstance(c, int) else ord(c)
+        h = (h * FNV_PRIME) & MASK_64
+    return h
+
+
+def parse_functions(source):
+    # Returns {function name: body} for the accessors that are compiled (i.e. outside #if 0).
+    source = re.sub(r'#if 0.*?#endif', '', source, flags=re.S)
+    functions = {}
+    pattern = re.compile(r'^(?:int|ExprType) \*?((?:getValFrom|setValFrom|getVarTypeFrom)\w+)\(.*?\) \{\n(.*?)^\}', re.S | re.M)
+    for match in pattern.finditer(source):
+        functions[match.group(1)] = match.group(2)
+    return functions
+
+
+def parse_cases(body):
+    # Returns [(field, statement)] in the order the fields are compared.
+    cases = []
+    pattern = re.compile(r'if \( strcmp\( varName, "(\w+)" \) == 0 \) \{\s*(.*?;)', re.S)
+    for match in pattern.finditer(body):
+        cases.append((match.group(1), match.group(2).strip()))
+    return cases
+
+
+class Accessors(object):
+    def __init__(self, functions, struct):
+        self.struct = struct
+        self.c_type = re.search(r'(\w+) \*rei;', functions['setValFrom' + struct]).group(1)
+        self.get = dict(parse_cases(functions['getValFrom' + struct]))
+        self.set = dict(parse_cases(functions['setValFrom' + struct]))
+        self.type = dict(parse_cases(functions['getVarTypeFrom' + struct]))
+        self.fields = [f for f, _ in parse_cases(functions['getValFrom' + struct])]
+
+
+def substitute(statement, expression):
+    return re.sub(r'\brei\b', expression, statement, count=1)
+
+
+def collect_paths(functions):
+    paths = []
+
+    def walk(struct, path, expression, null_checks):
+        accessors = Accessors(functions, struct)
+        for field in accessors.fields:
+            if field in RECURSIVE_FIELDS:
+                continue
+
+            get = accessors.get.get(field, '')
+            set_ = accessors.set.get(field, '')
+            type_ = accessors.type.get(field, '')
+
+            if 'UNDEFINED_VARIABLE_MAP_ERR' in get + set_ + type_:
+                continue
+
+            field_path = path + '->' + field
+            field_expression = expression + '->' + field
+            child = re.match(r'i = getValFrom(\w+)\(', get)
+
+            if child:
+                child_struct = child.group(1)
+                paths.append({
+                    'path': field_path,
+                    'null_checks': null_checks,
+                    'get': 'getPtrLeafValue( varValue, ( void * ) %s, NULL, %s_MS_T, r )' % (field_expression, child_struct),
+                    'set': 'setStructPtrLeafValue( ( void ** ) &( %s ), newVarValue )' % field_expression,
+                    'type': 'T_IRODS',
+                    'irods_type': child_struct + '_MS_T',
+                })
+                walk(child_struct, field_path, field_expression, null_checks + [field_expression])
+            else:
+                leaf_get = re.match(r'i = (get\w+LeafValue\(.*\));', get)
+                leaf_set = re.match(r'i = (set\w+LeafValue\(.*\));', set_)
+                leaf_type = re.match(r'return newSimpType\( (\w+), r \);', type_)
+                if not (leaf_get and leaf_set and leaf_type):
+                    continue
+                paths.append({
+                    'path': field_path,
+                    'null_checks': null_checks,
+                    'get': substitute(leaf_get.group(1), expression),
+                    'set': substitute(leaf_set.group(1), expression),
+                    'type': leaf_type.group(1),
+                    'irods_type': None,
+                })
+
+    walk(ROOT_STRUCT, ROOT_NAME, ROOT_NAME, [ROOT_NAME])
+    return paths
+
+
+def build_perfect_hash(keys):
+    # Hash and displace: keys are grouped into buckets by the upper half of their hash. The
+    # buckets are placed largest first, each one receiving the smallest displacement that
+    # maps all of its keys to free slots.
+    size = len(keys)
+    bucket_count = max(1, (size + 1) // 2)
+    hashes = [hash_path(k) for k in keys]
+
+    buckets = [[] for _ in range(bucket_count)]
+    for i, h in enumerate(hashes):
+        buckets[(h >> 32) % bucket_count].append(i)
+
+    displacements = [0] * bucket_count
+    slots = [None] * size
+
+    for b in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for d in range(1 << 16):
+            positions = [((hashes[i] & 0xffffffff) ^ d) % size for i in buckets[b]]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                for i, p in zip(buckets[b], positions):
+                    slots[p] = i
+                displacements[b] = d
+                break
+        else:
+            raise RuntimeError('could not place bucket %d' % b)
+
+    return displacements, slots
+
+
+def function_name(prefix, path):
+    return prefix + '_' + path.replace('->', '_')
+
+
+def generate(paths):
+    displacements, slots = build_perfect_hash([p['path'] for p in paths])
+    out = [BEGIN_MARKER, '']
+
+    for p in paths:
+        # Like the accessors, only the structures leading to the field must exist. A
+        # structure itself is returned as a pointer, even when null.
+        checks = ' || '.join('%s == NULL' % c for c in p['null_checks'])
+        out.append('static int %s( ruleExecInfo_t *rei, Res **varValue, Region *r ) {' % function_name('getValPath', p['path']))
+        out.append('    if ( %s ) {' % checks)
+        out.append('        return NULL_VALUE_ERR;')
+        out.append('    }')
+        out.append('    return %s;' % p['get'])
+        out.append('}')
+        out.append('static int %s( ruleExecInfo_t *rei, Res *newVarValue ) {' % function_name('setValPath', p['path']))
+        out.append('    if ( %s ) {' % checks)
+        out.append('        return NULL_VALUE_ERR;')
+        out.append('    }')
+        out.append('    return %s;' % p['set'])
+        out.append('}')
+        out.append('')
+
+    out.append('static const VariablePath variablePaths[] = {')
+    for i in slots:
+        p = paths[i]
+        out.append('    { "%s", %s, %s, %s, %s },' % (
+            p['path'],
+            function_name('getValPath', p['path']),
+            function_name('setValPath', p['path']),
+            p['type'],
+            p['irods_type'] or 'NULL'))
+    out.append('};')
+    out.append('')
+
+    out.append('static const unsigned short variablePathDisplacements[] = {')
+    for i in range(0, len(displacements), 16):
+        out.append('    ' + ', '.join(str(d) for d in displacements[i:i + 16]) + ',')
+    out.append('};')
+    out.append('')
+
+    out.append('const VariablePath *lookupVariablePath( const char *path ) {')
+    out.append('    unsigned long long h = 0x%xULL;' % FNV_OFFSET_BASIS)
+    out.append('    for ( const unsigned char *p = ( const unsigned char * ) path; *p != \'\\0\'; ++p ) {')
+    out.append('        h = ( h ^ *p ) * 0x%xULL;' % FNV_PRIME)
+    out.append('    }')
+    out.append('    const unsigned long long d = variablePathDisplacements[( h >> 32 ) %% %d];' % len(displacements))
+    out.append('    const VariablePath *entry = &variablePaths[( ( h & 0xffffffffULL ) ^ d ) %% %d];' % len(slots))
+    out.append('    return strcmp( entry->path, path ) == 0 ? entry : NULL;')
+    out.append('}')
+    out.append('')
+    out.append(END_MARKER)
+
+    return '\n'.join(out)
+
+
+def main():
+    default = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'reVariableMap.gen.cpp')
+    filename = sys.argv[1] if len(sys.argv) > 1 else default
+
+    with open(filename) as f:
+        source = f.read()
+
+    begin = source.find(BEGIN_MARKER)
+    end = source.find(END_MARKER)
+
+    if begin >= 0 and end >= 0:
+        accessors = source[:begin] + source[end + len(END_MARKER):]
+    else:
+        accessors = source
+
+    index = generate(collect_paths(parse_functions(accessors)))
+
+    if begin >= 0 and end >= 0:
+        source = source[:begin] + index + source[end + len(END_MARKER):]
+    else:
+        source = source.rstrip('\n') + '\n\n\n' + index + '\n'
+
+    with open(filename, 'w') as f:
+        f.write(source)
+
+
+if __name__ == '__main__':
+    main()
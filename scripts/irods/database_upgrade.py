@@ -101,6 +101,11 @@ def run_update(irods_config, cursor):
             # TEXT has no upper limit on the number of bytes it can hold.
             database_connect.execute_sql_statement(cursor, "alter table R_RULE_EXEC add column exe_context text;")
 
+    elif new_schema_version == 9:
+        # Register the data types of zstd-compressed tar bundles created by ibun.
+        database_connect.execute_sql_statement(cursor, "insert into R_TOKN_MAIN values ('data_type',1706,'zstdTar','','|.tar.zst|','','','1602720000','1602720000');")
+        database_connect.execute_sql_statement(cursor, "insert into R_TOKN_MAIN values ('data_type',1707,'zstdTar bundle','','','','','1602720000','1602720000');")
+
     else:
         raise IrodsError('Upgrade to schema version %d is unsupported.' % (new_schema_version))
 
@@ -12,7 +12,6 @@ import tempfile
 from . import resource_suite
 from .. import lib
 
-@unittest.skip('Generation of large file causes I/O thrashing... skip for now')
 class Test_Ibun(resource_suite.ResourceBase, unittest.TestCase):
 
     def setUp(self):
@@ -22,6 +21,7 @@ class Test_Ibun(resource_suite.ResourceBase, unittest.TestCase):
     def tearDown(self):
         super(Test_Ibun, self).tearDown()
 
+    @unittest.skip('Generation of large file causes I/O thrashing... skip for now')
     def test_ibun_extraction_of_big_zip_file__issue_4495(self):
         try:
             root_name = tempfile.mkdtemp()
@@ -59,6 +59,7 @@ class Test_Ibun(resource_suite.ResourceBase, unittest.TestCase):
             if os.path.exists(zip_file_name):
                 os.unlink(zip_file_name)
 
+    @unittest.skip('Generation of large file causes I/O thrashing... skip for now')
     def test_ibun_extraction_of_big_tar_file__issue_4118(self):
         try:
             root_name = tempfile.mkdtemp()
@@ -100,3 +101,104 @@ class Test_Ibun(resource_suite.ResourceBase, unittest.TestCase):
             if os.path.exists(tar_file_name):
                 os.unlink(tar_file_name)
 
+    def test_ibun_extraction_resumes_after_a_partial_failure(self):
+        try:
+            root_name = tempfile.mkdtemp()
+            untar_collection_name = 'my_resumed_coll'
+            untar_directory_name = 'my_resumed_dir'
+            tar_file_name = 'resume.tar'
+            blocker_file_name = 'blocker'
+            member_names = ['member_{0}'.format(i) for i in range(10)]
+
+            for name in member_names:
+                lib.make_file(os.path.join(root_name, name), 1024, 'random')
+
+            lib.execute_command(['tar', '-cf', tar_file_name, '-C', root_name] + member_names)
+            self.admin.assert_icommand(['iput', tar_file_name])
+
+            # A data object at the path of one member interrupts the extraction. The other
+            # members are registered before ibun reports the failure.
+            blocked_member = untar_collection_name + '/' + member_names[5]
+            lib.make_file(blocker_file_name, 10)
+            self.admin.assert_icommand(['imkdir', untar_collection_name])
+            self.admin.assert_icommand(['iput', blocker_file_name, blocked_member])
+            self.admin.assert_icommand(['ibun', '-x', tar_file_name, untar_collection_name],
+                                       'STDERR_SINGLELINE', 'SYS_COPY_ALREADY_IN_RESC')
+            self.admin.assert_icommand(['ils', untar_collection_name], 'STDOUT_SINGLELINE', member_names[0])
+
+            # Without --resume, the members registered by the first attempt are in the way.
+            self.admin.assert_icommand(['ibun', '-x', tar_file_name, untar_collection_name],
+                                       'STDERR_SINGLELINE', 'SYS_COPY_ALREADY_IN_RESC')
+
+            # --resume skips them and extracts the member that was interrupted.
+            self.admin.assert_icommand(['irm', '-f', blocked_member])
+            self.admin.assert_icommand(['ibun', '-x', '--resume', tar_file_name, untar_collection_name])
+
+            self.admin.assert_icommand(['iget', '-r', untar_collection_name, untar_directory_name])
+            for name in member_names:
+                lib.execute_command(['cmp', os.path.join(root_name, name), os.path.join(untar_directory_name, name)])
+        finally:
+            self.admin.run_icommand(['irm', '-f', tar_file_name])
+            self.admin.run_icommand(['irm', '-rf', untar_collection_name])
+            shutil.rmtree(root_name, ignore_errors=True)
+            shutil.rmtree(untar_directory_name, ignore_errors=True)
+            for f in [tar_file_name, blocker_file_name]:
+                if os.path.exists(f):
+                    os.unlink(f)
+
+    def test_ibun_resume_does_not_skip_a_data_object_of_the_same_size(self):
+        try:
+            root_name = tempfile.mkdtemp()
+            untar_collection_name = 'my_resumed_coll'
+            tar_file_name = 'resume.tar'
+            other_file_name = 'same_size'
+            member_name = 'member'
+
+            lib.make_file(os.path.join(root_name, member_name), 1024, 'random')
+            lib.execute_command(['tar', '-cf', tar_file_name, '-C', root_name, member_name])
+            self.admin.assert_icommand(['iput', tar_file_name])
+
+            # A data object that did not come from the bundle but has the size of the member.
+            lib.make_file(other_file_name, 1024, 'random')
+            self.admin.assert_icommand(['imkdir', untar_collection_name])
+            self.admin.assert_icommand(['iput', other_file_name, untar_collection_name + '/' + member_name])
+
+            self.admin.assert_icommand(['ibun', '-x', '--resume', tar_file_name, untar_collection_name],
+                                       'STDERR_SINGLELINE', 'SYS_COPY_ALREADY_IN_RESC')
+        finally:
+            self.admin.run_icommand(['irm', '-f', tar_file_name])
+            self.admin.run_icommand(['irm', '-rf', untar_collection_name])
+            shutil.rmtree(root_name, ignore_errors=True)
+            for f in [tar_file_name, other_file_name]:
+                if os.path.exists(f):
+                    os.unlink(f)
+
+    def test_ibun_creation_and_extraction_of_zstd_tar_bundle(self):
+        try:
+            root_name = tempfile.mkdtemp()
+            source_collection_name = 'my_zstd_source_coll'
+            untar_collection_name = 'my_zstd_exploded_coll'
+            untar_directory_name = 'my_zstd_exploded_dir'
+            tar_file_name = 'bundle.tar.zst'
+            member_names = ['member_{0}'.format(i) for i in range(10)]
+
+            for name in member_names:
+                lib.make_file(os.path.join(root_name, name), 1024, 'random')
+
+            self.admin.assert_icommand(['iput', '-r', root_name, source_collection_name])
+
+            # The data type must be known to the catalog for the bundle to be registered.
+            self.admin.assert_icommand(['ibun', '-c', '-D', 'zstdTar', tar_file_name, source_collection_name])
+            self.admin.assert_icommand(['ils', '-L', tar_file_name], 'STDOUT_SINGLELINE', 'zstdTar')
+
+            self.admin.assert_icommand(['ibun', '-x', tar_file_name, untar_collection_name])
+            self.admin.assert_icommand(['iget', '-r', untar_collection_name, untar_directory_name])
+            for name in member_names:
+                lib.execute_command(['cmp', os.path.join(root_name, name),
+                                     os.path.join(untar_directory_name, source_collection_name, name)])
+        finally:
+            self.admin.run_icommand(['irm', '-f', tar_file_name])
+            self.admin.run_icommand(['irm', '-rf', source_collection_name])
+            self.admin.run_icommand(['irm', '-rf', untar_collection_name])
+            shutil.rmtree(root_name, ignore_errors=True)
+            shutil.rmtree(untar_directory_name, ignore_errors=True)
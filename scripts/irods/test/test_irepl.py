@@ -267,6 +267,209 @@ class Test_IRepl(session.make_sessions_mixin([('otherrods', 'rods')], [('alice',
             self.admin.assert_icommand(['iadmin', 'rmresc', resource_1])
             self.admin.assert_icommand(['iadmin', 'rmresc', resource_2])
 
+    def test_resumable_irepl_with_source_and_destination_on_the_same_remote_host(self):
+        resource_1 = 'resumable_resc_1'
+        resource_1_vault = os.path.join(self.admin.local_session_dir, resource_1 + 'vault')
+        resource_2 = 'resumable_resc_2'
+        resource_2_vault = os.path.join(self.admin.local_session_dir, resource_2 + 'vault')
+
+        filename = 'test_resumable_irepl_with_source_and_destination_on_the_same_remote_host'
+        physical_path = os.path.join(self.admin.local_session_dir, filename)
+        logical_path = os.path.join(self.admin.session_collection, filename)
+        downloaded_path = physical_path + '_downloaded'
+
+        config = IrodsConfig()
+
+        try:
+            # Both replicas live on the same host, which is not the catalog provider in a
+            # topology. Reading the source, writing the destination and recording checkpoints
+            # then go through the same server-to-server connection.
+            self.admin.assert_icommand(
+                ['iadmin', 'mkresc', resource_1, 'unixfilesystem', ':'.join([test.settings.HOSTNAME_2, resource_1_vault])],
+                'STDOUT', 'unixfilesystem')
+            self.admin.assert_icommand(
+                ['iadmin', 'mkresc', resource_2, 'unixfilesystem', ':'.join([test.settings.HOSTNAME_2, resource_2_vault])],
+                'STDOUT', 'unixfilesystem')
+
+            lib.make_file(physical_path, 20 * 1024 * 1024, contents='random')
+            self.admin.assert_icommand(['iput', '-K', '-R', resource_1, physical_path, logical_path])
+
+            with lib.file_backed_up(config.server_config_path):
+                lib.update_json_file_from_dict(config.server_config_path, {
+                    'advanced_settings': {
+                        'resumable_replication': {
+                            'minimum_data_size_in_megabytes': 0,
+                            'checkpoint_interval_in_megabytes': 1
+                        }
+                    }
+                })
+
+                self.admin.assert_icommand(['irepl', '-R', resource_2, logical_path])
+
+            self.admin.assert_icommand(['ils', '-L', logical_path], 'STDOUT_MULTILINE', ['1 {}'.format(resource_2), '&'])
+            self.admin.assert_icommand(['iget', '-R', resource_2, logical_path, downloaded_path])
+            lib.execute_command(['cmp', physical_path, downloaded_path])
+
+        finally:
+            self.admin.run_icommand(['irm', '-f', logical_path])
+            self.admin.assert_icommand(['iadmin', 'rmresc', resource_1])
+            self.admin.assert_icommand(['iadmin', 'rmresc', resource_2])
+            for f in [physical_path, downloaded_path]:
+                if os.path.exists(f):
+                    os.unlink(f)
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing: modifies the vault of another host")
+    def test_interrupted_irepl_is_resumed_and_verified(self):
+        resource_1 = 'resumable_resc_1'
+        resource_1_vault = os.path.join(self.admin.local_session_dir, resource_1 + 'vault')
+        resource_2 = 'resumable_resc_2'
+        resource_2_vault = os.path.join(self.admin.local_session_dir, resource_2 + 'vault')
+
+        filename = 'test_interrupted_irepl_is_resumed_and_verified'
+        physical_path = os.path.join(self.admin.local_session_dir, filename)
+        logical_path = os.path.join(self.admin.session_collection, filename)
+        downloaded_path = physical_path + '_downloaded'
+
+        size = 8 * 1024 * 1024
+        offset = 3 * 1024 * 1024
+
+        config = IrodsConfig()
+
+        def replica_column(column, replica_number):
+            out, _, _ = self.admin.run_icommand(['iquest', '%s',
+                "select {} where COLL_NAME = '{}' and DATA_NAME = '{}' and DATA_REPL_NUM = '{}'".format(
+                    column, self.admin.session_collection, filename, replica_number)])
+            return out.strip()
+
+        def source_id(checksum, data_size):
+            # FNV-1a over "<checksum>:<size>", as computed by replication_checkpoint::make_source_id.
+            h = 14695981039346656037
+            for c in bytearray('{}:{}'.format(checksum, data_size).encode('utf-8')):
+                h = ((h ^ c) * 1099511628211) & 0xffffffffffffffff
+            return '{:016x}'.format(h)
+
+        def interrupt_replica_1(corrupt_copied_data):
+            # Leave replica 1 as an attempt that stopped at the offset would: stale, holding the
+            # data up to the offset and a checkpoint for it.
+            destination_path = replica_column('DATA_PATH', 1)
+            with open(destination_path, 'r+b') as f:
+                if corrupt_copied_data:
+                    f.write(b'\0' * 1024)
+                f.truncate(offset)
+
+            checkpoint = 'resume:{}:{}'.format(offset, source_id(replica_column('DATA_CHECKSUM', 0), size))
+
+            for column, value in [('DATA_REPL_STATUS', 0), ('DATA_SIZE', offset), ('DATA_STATUS', checkpoint)]:
+                self.admin.assert_icommand(
+                    ['iadmin', 'modrepl', 'logical_path', logical_path, 'replica_number', '1', column, str(value)])
+
+        try:
+            self.admin.assert_icommand(
+                ['iadmin', 'mkresc', resource_1, 'unixfilesystem', ':'.join([test.settings.HOSTNAME_1, resource_1_vault])],
+                'STDOUT', 'unixfilesystem')
+            self.admin.assert_icommand(
+                ['iadmin', 'mkresc', resource_2, 'unixfilesystem', ':'.join([test.settings.HOSTNAME_2, resource_2_vault])],
+                'STDOUT', 'unixfilesystem')
+
+            lib.make_file(physical_path, size, contents='random')
+            self.admin.assert_icommand(['iput', '-K', '-R', resource_1, physical_path, logical_path])
+
+            with lib.file_backed_up(config.server_config_path):
+                lib.update_json_file_from_dict(config.server_config_path, {
+                    'advanced_settings': {
+                        'resumable_replication': {
+                            'minimum_data_size_in_megabytes': 0,
+                            'checkpoint_interval_in_megabytes': 1
+                        }
+                    }
+                })
+
+                self.admin.assert_icommand(['irepl', '-R', resource_2, logical_path])
+
+                # The replication continues from the checkpoint and the result matches the source.
+                interrupt_replica_1(corrupt_copied_data=False)
+                self.admin.assert_icommand(['irepl', '-R', resource_2, logical_path])
+                self.assertEqual('1', replica_column('DATA_REPL_STATUS', 1))
+                self.assertEqual('', replica_column('DATA_STATUS', 1))
+                out, _, ec = self.admin.run_icommand(['ichksum', '-K', '-n1', logical_path])
+                self.assertTrue(ec == 0 and 'ERROR' not in out)
+                self.admin.assert_icommand(['iget', '-n', '1', logical_path, downloaded_path])
+                lib.execute_command(['cmp', physical_path, downloaded_path])
+
+                # The data before the checkpoint is not copied again, so damage to it is caught by
+                # the checksum of the source and the replica stays stale.
+                interrupt_replica_1(corrupt_copied_data=True)
+                _, _, ec = self.admin.run_icommand(['irepl', '-R', resource_2, logical_path])
+                self.assertNotEqual(0, ec)
+                self.assertEqual('0', replica_column('DATA_REPL_STATUS', 1))
+
+                # The failed attempt discarded the checkpoint, so the next one starts over.
+                self.admin.assert_icommand(['irepl', '-R', resource_2, logical_path])
+                self.assertEqual('1', replica_column('DATA_REPL_STATUS', 1))
+                out, _, ec = self.admin.run_icommand(['ichksum', '-K', '-n1', logical_path])
+                self.assertTrue(ec == 0 and 'ERROR' not in out)
+
+        finally:
+            self.admin.run_icommand(['irm', '-f', logical_path])
+            self.admin.assert_icommand(['iadmin', 'rmresc', resource_1])
+            self.admin.assert_icommand(['iadmin', 'rmresc', resource_2])
+            for f in [physical_path, downloaded_path]:
+                if os.path.exists(f):
+                    os.unlink(f)
+
+    def test_irepl_multi_source(self):
+        resources = ['multi_source_resc_{}'.format(i) for i in range(3)]
+        hostnames = [test.settings.HOSTNAME_1, test.settings.HOSTNAME_2, test.settings.HOSTNAME_3]
+
+        filename = 'test_irepl_multi_source'
+        physical_path = os.path.join(self.admin.local_session_dir, filename)
+        logical_path = os.path.join(self.admin.session_collection, filename)
+        downloaded_path = physical_path + '_downloaded'
+
+        config = IrodsConfig()
+
+        try:
+            for resource, hostname in zip(resources, hostnames):
+                vault = os.path.join(self.admin.local_session_dir, resource + 'vault')
+                self.admin.assert_icommand(
+                    ['iadmin', 'mkresc', resource, 'unixfilesystem', ':'.join([hostname, vault])],
+                    'STDOUT', 'unixfilesystem')
+
+            # Multi-source replication requires a recorded checksum on the source.
+            lib.make_file(physical_path, 20 * 1024 * 1024, contents='random')
+            self.admin.assert_icommand(['iput', '-K', '-R', resources[0], physical_path, logical_path])
+            self.admin.assert_icommand(['irepl', '-R', resources[1], logical_path])
+
+            with lib.file_backed_up(config.server_config_path):
+                lib.update_json_file_from_dict(config.server_config_path, {
+                    'advanced_settings': {
+                        'multi_source_replication': {
+                            'minimum_data_size_in_bytes': 0
+                        }
+                    }
+                })
+
+                # Replicas on the same host are not read together, so outside of a topology
+                # this falls back to a single source.
+                self.admin.assert_icommand(['irepl', '--multi-source=2', '-R', resources[2], logical_path])
+
+            self.admin.assert_icommand(['ils', '-L', logical_path], 'STDOUT_MULTILINE', ['2 {}'.format(resources[2]), '&'])
+            self.admin.assert_icommand(['iget', '-R', resources[2], logical_path, downloaded_path])
+            lib.execute_command(['cmp', physical_path, downloaded_path])
+
+            # A single source is not a valid number of sources.
+            _, _, ec = self.admin.run_icommand(['irepl', '--multi-source=1', '-R', resources[2], logical_path])
+            self.assertNotEqual(0, ec)
+
+        finally:
+            self.admin.run_icommand(['irm', '-f', logical_path])
+            for resource in resources:
+                self.admin.assert_icommand(['iadmin', 'rmresc', resource])
+            for f in [physical_path, downloaded_path]:
+                if os.path.exists(f):
+                    os.unlink(f)
+
+
 class test_invalid_parameters(session.make_sessions_mixin([('otherrods', 'rods')], [('alice', 'apass')]), unittest.TestCase):
     def setUp(self):
         super(test_invalid_parameters, self).setUp()
@@ -0,0 +1,31 @@
+#ifndef IRODS_RS_BATCH_QUERY_HPP
+#define IRODS_RS_BATCH_QUERY_HPP
+
+/// \file
+
+struct RsComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Executes a list of independent GenQuery and specific queries in a single call.
+///
+/// See rc_batch_query() for the JSON input and output formats.
+///
+/// \param[in]  _comm        A pointer to a RsComm.
+/// \param[in]  _json_input  A JSON string containing the batch of queries.
+/// \param[out] _json_output A JSON string containing the result sets.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval non-zero On failure.
+///
+/// \since 4.2.9
+int rs_batch_query(RsComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_RS_BATCH_QUERY_HPP
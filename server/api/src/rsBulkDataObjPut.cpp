@@ -535,7 +535,15 @@ bulkProcAndRegSubfile( rsComm_t *rsComm, const char *_resc_name, const std::stri
         if ( chkOrphanFile( rsComm, dataObjInfo.filePath, _resc_name,
                             &dataObjInfo ) <= 0 ) {
             /* not an orphan file */
-            if ( ( flags & FORCE_FLAG_FLAG ) != 0 && dataObjInfo.dataId > 0 &&
+            if ( ( flags & RESUME_FLAG ) != 0 && dataObjInfo.dataId > 0 &&
+                    strcmp( dataObjInfo.objPath, subObjPath ) == 0 &&
+                    fs::file_size( p ) == static_cast<boost::uintmax_t>( dataSize ) &&
+                    chkSameFileContent( dataObjInfo.filePath, subfilePath ) > 0 ) {
+                /* registered by an earlier extraction of this bundle. the size alone does
+                 * not prove that, so the replica must hold the bytes just extracted. */
+                return 0;
+            }
+            else if ( ( flags & FORCE_FLAG_FLAG ) != 0 && dataObjInfo.dataId > 0 &&
                     strcmp( dataObjInfo.objPath, subObjPath ) == 0 ) {
                 /* overwrite the current file */
                 modFlag = 1;
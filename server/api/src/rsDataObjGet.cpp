@@ -22,6 +22,7 @@
 
 // =-=-=-=-=-=-=-
 #include "irods_resource_redirect.hpp"
+#include "redirect_token.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "irods_resource_backport.hpp"
 #include "key_value_proxy.hpp"
@@ -186,7 +187,10 @@ int rsDataObjGet(
     // =-=-=-=-=-=-=-
     // working on the "home zone", determine if we need to redirect to a different
     // server in this zone for this operation.  if there is a RESC_HIER_STR_KW then
-    // we know that the redirection decision has already been made
+    // we know that the redirection decision has already been made. a valid redirect
+    // token carries that decision as well
+    irods::experimental::redirect_token::consume(*rsComm, *dataObjInp, irods::experimental::redirect_token::get_redirect);
+
     if (!cond_input.contains(RESC_HIER_STR_KW)) {
         try {
             auto result = irods::resolve_resource_hierarchy(irods::OPEN_OPERATION, rsComm, *dataObjInp);
@@ -56,6 +56,7 @@
 #include "irods_log.hpp"
 #include "irods_resource_backport.hpp"
 #include "irods_resource_redirect.hpp"
+#include "redirect_token.hpp"
 #include "irods_server_api_call.hpp"
 #include "irods_server_properties.hpp"
 #include "irods_stacktrace.hpp"
@@ -632,16 +633,10 @@ namespace
         }
 
         if (_replica.cond_input().contains(PHYOPEN_BY_SIZE_KW)) {
-            try {
-                const auto single_buffer_size = irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER) * 1024 * 1024;
-                if (_replica.size() <= single_buffer_size &&
-                    (UNKNOWN_FILE_SZ != _replica.size() || _replica.cond_input().contains(DATA_INCLUDED_KW))) {
-                    return l1_index;
-                }
-            }
-            catch (const irods::exception& e) {
-                freeL1desc(l1_index);
-                throw;
+            const auto single_buffer_size = irods::get_server_configuration().maximum_size_for_single_buffer_in_megabytes * 1024 * 1024;
+            if (_replica.size() <= single_buffer_size &&
+                (UNKNOWN_FILE_SZ != _replica.size() || _replica.cond_input().contains(DATA_INCLUDED_KW))) {
+                return l1_index;
             }
         }
 
@@ -698,6 +693,12 @@ namespace
 
     auto get_data_object_info_for_open(RsComm& _comm, DataObjInp& _inp) -> std::tuple<irods::file_object_ptr, DataObjInfo*, std::string>
     {
+        // A valid redirect token carries the hierarchy chosen by the server which
+        // redirected the client here. Opens that write follow getHostForPut, opens
+        // that only read follow getHostForGet.
+        const auto redirect = getWriteFlag(_inp.openFlags) ? ix::redirect_token::put_redirect : ix::redirect_token::get_redirect;
+        ix::redirect_token::consume(_comm, _inp, redirect);
+
         ix::key_value_proxy kvp{_inp.condInput};
 
         std::string hier{};
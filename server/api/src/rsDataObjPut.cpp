@@ -44,6 +44,7 @@
 #include "irods_logger.hpp"
 #include "irods_resource_backport.hpp"
 #include "irods_resource_redirect.hpp"
+#include "redirect_token.hpp"
 #include "irods_serialization.hpp"
 #include "irods_server_properties.hpp"
 #include "scoped_privileged_client.hpp"
@@ -553,6 +554,10 @@ namespace
 
             throw_if_force_put_to_new_resource(*dataObjInp, file_obj);
 
+            // A valid redirect token carries the hierarchy chosen by the server which
+            // redirected the client here.
+            irods::experimental::redirect_token::consume(*rsComm, *dataObjInp, irods::experimental::redirect_token::put_redirect);
+
             std::string hier{};
             auto cond_input = irods::experimental::make_key_value_proxy(dataObjInp->condInput);
             if (!cond_input.contains(RESC_HIER_STR_KW)) {
@@ -40,11 +40,13 @@
 #include "irods_re_structs.hpp"
 #include "irods_logger.hpp"
 #include "scoped_privileged_client.hpp"
+#include "special_collection_index.hpp"
 
 #define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 #include "filesystem.hpp"
 
 #include <chrono>
+#include <optional>
 
 using logger = irods::experimental::log;
 
@@ -162,6 +164,13 @@ namespace
             return CANT_RM_MV_BUNDLE_TYPE;
         }
 
+        // Moving a collection moves the special collections inside it. The guard is held
+        // until the change is committed or rolled back.
+        std::optional<irods::experimental::special_collection_index::update_guard> sci_guard;
+        if ( srcDataObjInp->oprType == RENAME_COLL ) {
+            sci_guard.emplace();
+        }
+
         // If srcObj is different from destObj, this is a data obj rename...
         if ( strcmp( srcObj, destObj ) != 0 ) {
             if ( srcId < 0 ) {
@@ -8,6 +8,8 @@
 #include "dataObjPut.h"
 #include "dataObjRepl.h"
 #include "dataObjTrim.h"
+#include "fileLseek.h"
+#include "fileRead.h"
 #include "fileStageToCache.h"
 #include "fileSyncToArch.h"
 #include "getRemoteZoneResc.h"
@@ -24,6 +26,7 @@
 #include "rsDataObjClose.hpp"
 #include "rsDataObjCreate.hpp"
 #include "rsDataObjGet.hpp"
+#include "rsDataObjLseek.hpp"
 #include "rsDataObjOpen.hpp"
 #include "rsDataObjPut.hpp"
 #include "rsDataObjRead.hpp"
@@ -33,6 +36,7 @@
 #include "rsFileStageToCache.hpp"
 #include "rsFileSyncToArch.hpp"
 #include "rsGetRescQuota.hpp"
+#include "rsModDataObjMeta.hpp"
 #include "rsL3FileGetSingleBuf.hpp"
 #include "rsL3FilePutSingleBuf.hpp"
 #include "rsUnbunAndRegPhyBunfile.hpp"
@@ -54,7 +58,9 @@
 #include "irods_string_tokenize.hpp"
 #include "json_serialization.hpp"
 #include "key_value_proxy.hpp"
+#include "multi_source_copy.hpp"
 #include "replica_access_table.hpp"
+#include "replication_checkpoint.hpp"
 #include "replication_utilities.hpp"
 #include "voting.hpp"
 
@@ -65,16 +71,22 @@
 #include "replica_state_table.hpp"
 
 #include <algorithm>
+#include <mutex>
+#include <optional>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "fmt/format.h"
 
+#include <boost/any.hpp>
 #include <boost/make_shared.hpp>
 
 namespace
 {
     namespace ir = irods::experimental::replica;
+    namespace msc = irods::experimental::multi_source_copy;
+    namespace rcp = irods::experimental::replication_checkpoint;
     namespace irv = irods::experimental::resource::voting;
     namespace rst = irods::replica_state_table;
 
@@ -398,7 +410,7 @@ namespace
         return destination_inp;
     } // init_destination_replica_input
 
-    int open_destination_replica(RsComm& _comm, DataObjInp& _inp, const int _source_fd)
+    int open_destination_replica(RsComm& _comm, DataObjInp& _inp, const int _source_fd, const bool _truncate)
     {
         auto cond_input = irods::experimental::make_key_value_proxy(_inp.condInput);
         cond_input[REG_REPL_KW] = "";
@@ -406,12 +418,409 @@ namespace
         cond_input.erase(PURGE_CACHE_KW);
 
         _inp.oprType = REPLICATE_DEST;
-        _inp.openFlags = O_CREAT | O_WRONLY | O_TRUNC;
+        _inp.openFlags = _truncate ? O_CREAT | O_WRONLY | O_TRUNC : O_CREAT | O_WRONLY;
 
         return rsDataObjOpen(&_comm, &_inp);
     } // open_destination_replica
 
-    int replicate_data(RsComm& _comm, DataObjInp& _source_inp, DataObjInp& _destination_inp)
+    struct multi_source_settings
+    {
+        rodsLong_t minimum_data_size_in_bytes = 64 * 1024 * 1024;
+        int maximum_number_of_sources = 4;
+    }; // struct multi_source_settings
+
+    auto get_multi_source_settings() -> multi_source_settings
+    {
+        multi_source_settings settings;
+
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto& config = irods::get_advanced_setting<map_type&>(irods::CFG_MULTI_SOURCE_REPLICATION_KW);
+
+            if (const auto iter = config.find(irods::CFG_MINIMUM_DATA_SIZE_IN_BYTES_KW); iter != std::end(config)) {
+                settings.minimum_data_size_in_bytes = boost::any_cast<int>(iter->second);
+            }
+
+            if (const auto iter = config.find(irods::CFG_MAXIMUM_NUMBER_OF_SOURCES_KW); iter != std::end(config)) {
+                settings.maximum_number_of_sources = boost::any_cast<int>(iter->second);
+            }
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Using defaults.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_MULTI_SOURCE_REPLICATION_KW.data());
+        }
+
+        return settings;
+    } // get_multi_source_settings
+
+    struct resumable_replication_settings
+    {
+        // Replications of smaller data objects are never checkpointed. Negative values disable checkpoints,
+        // which is the default: checkpointed replications are copied block by block through this agent
+        // instead of over the parallel streams of dataObjCopy.
+        rodsLong_t minimum_data_size_in_bytes = -1;
+        rodsLong_t checkpoint_interval_in_bytes = 256 * 1024 * 1024;
+    }; // struct resumable_replication_settings
+
+    auto get_resumable_replication_settings() -> resumable_replication_settings
+    {
+        resumable_replication_settings settings;
+
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto& config = irods::get_advanced_setting<map_type&>(irods::CFG_RESUMABLE_REPLICATION_KW);
+
+            if (const auto iter = config.find(irods::CFG_MINIMUM_DATA_SIZE_IN_MEGABYTES_KW); iter != std::end(config)) {
+                settings.minimum_data_size_in_bytes = rodsLong_t{boost::any_cast<int>(iter->second)} * 1024 * 1024;
+            }
+
+            if (const auto iter = config.find(irods::CFG_CHECKPOINT_INTERVAL_IN_MEGABYTES_KW); iter != std::end(config)) {
+                settings.checkpoint_interval_in_bytes = rodsLong_t{boost::any_cast<int>(iter->second)} * 1024 * 1024;
+            }
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Checkpoints are disabled.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_RESUMABLE_REPLICATION_KW.data());
+        }
+
+        return settings;
+    } // get_resumable_replication_settings
+
+    // Returns the offset from which the destination replica can be completed, or 0 if the
+    // replication must start over. Only stale replicas holding a checkpoint taken against the
+    // same contents as the source are resumed. The recorded size of the replica bounds the
+    // offset in case the checkpoint is newer than the data in the vault.
+    auto get_resume_offset(
+        const DataObjInp& _destination_inp,
+        const DataObjInfo& _source,
+        const std::vector<irods::physical_object>& _replicas) -> rodsLong_t
+    {
+        const char* hierarchy = getValByKey(&_destination_inp.condInput, RESC_HIER_STR_KW);
+
+        if (!hierarchy) {
+            return 0;
+        }
+
+        const auto replica = std::find_if(std::begin(_replicas), std::end(_replicas),
+            [hierarchy](const auto& _r) { return _r.resc_hier() == hierarchy; });
+
+        if (replica == std::end(_replicas) || STALE_REPLICA != replica->replica_status()) {
+            return 0;
+        }
+
+        const auto checkpoint = rcp::parse(replica->status());
+
+        if (!checkpoint || checkpoint->source_id != rcp::make_source_id(_source.chksum, _source.dataSize)) {
+            return 0;
+        }
+
+        return std::clamp<rodsLong_t>(std::min<rodsLong_t>(checkpoint->offset, replica->size()), 0, _source.dataSize);
+    } // get_resume_offset
+
+    // Records the checkpoint and the size it implies in the catalog while the replica is
+    // still being written, so that it survives the agent.
+    auto persist_checkpoint(RsComm& _comm, const l1desc& _l1desc, const rcp::checkpoint& _checkpoint) -> int
+    {
+        DataObjInfo info{};
+        rstrcpy(info.objPath, _l1desc.dataObjInfo->objPath, MAX_NAME_LEN);
+        rstrcpy(info.rescHier, _l1desc.dataObjInfo->rescHier, MAX_NAME_LEN);
+
+        KeyValPair kvp{};
+        const irods::at_scope_exit free_kvp{[&kvp]() { clearKeyVal(&kvp); }};
+        addKeyVal(&kvp, STATUS_STRING_KW, rcp::to_string(_checkpoint).data());
+        addKeyVal(&kvp, DATA_SIZE_KW, std::to_string(_checkpoint.offset).data());
+
+        if (getValByKey(&_l1desc.dataObjInp->condInput, ADMIN_KW)) {
+            addKeyVal(&kvp, ADMIN_KW, "");
+        }
+
+        modDataObjMeta_t input{};
+        input.dataObjInfo = &info;
+        input.regParam = &kvp;
+
+        return rsModDataObjMeta(&_comm, &input);
+    } // persist_checkpoint
+
+    // Returns the total number of sources the replication may read from. A value less than
+    // two means the data is copied from the primary source only.
+    auto get_number_of_sources(const DataObjInp& _inp, const multi_source_settings& _settings) -> int
+    {
+        const char* value = getValByKey(&_inp.condInput, MULTI_SOURCE_KW);
+
+        if (!value) {
+            return 1;
+        }
+
+        int number_of_sources = _settings.maximum_number_of_sources;
+
+        if (std::string_view{value}.empty()) {
+            return number_of_sources;
+        }
+
+        try {
+            number_of_sources = std::min(number_of_sources, std::stoi(value));
+        }
+        catch (...) {
+            irods::log(LOG_NOTICE, fmt::format(
+                "[{}:{}] - invalid value for [{}]:[{}]; using [{}]",
+                __FUNCTION__, __LINE__, MULTI_SOURCE_KW, value, number_of_sources));
+        }
+
+        return number_of_sources;
+    } // get_number_of_sources
+
+    auto get_server_host(const int _l1descInx) -> rodsServerHost_t*
+    {
+        return FileDesc[L1desc[_l1descInx].l3descInx].rodsServerHost;
+    } // get_server_host
+
+    // Opens up to _count good replicas, other than the primary source, to be read alongside it.
+    //
+    // Every source must live on its own host. Reads from replicas on the same remote host would
+    // share a single server-to-server connection, which cannot be used by several threads at once.
+    auto open_additional_sources(
+        RsComm& _comm,
+        const DataObjInp& _source_inp,
+        const std::vector<irods::physical_object>& _replicas,
+        const int _source_l1descInx,
+        const int _destination_l1descInx,
+        const std::size_t _count) -> std::vector<int>
+    {
+        const auto& primary = *L1desc[_source_l1descInx].dataObjInfo;
+        const auto& destination = *L1desc[_destination_l1descInx].dataObjInfo;
+
+        std::vector<rodsServerHost_t*> hosts{get_server_host(_source_l1descInx)};
+
+        if (auto* host = get_server_host(_destination_l1descInx); LOCAL_HOST != host->localFlag) {
+            // The primary source would be read while the destination is written.
+            if (host == hosts.front()) {
+                return {};
+            }
+
+            hosts.push_back(host);
+        }
+
+        std::vector<int> sources;
+
+        for (const auto& replica : _replicas) {
+            if (sources.size() == _count) {
+                break;
+            }
+
+            if (GOOD_REPLICA != replica.replica_status() ||
+                replica.checksum() != primary.chksum ||
+                replica.size() != primary.dataSize ||
+                replica.resc_hier() == primary.rescHier ||
+                replica.resc_hier() == destination.rescHier) {
+                continue;
+            }
+
+            DataObjInp inp = _source_inp;
+            replKeyVal(&_source_inp.condInput, &inp.condInput);
+            const irods::at_scope_exit free_cond_input{[&inp]() { clearKeyVal(&inp.condInput); }};
+            addKeyVal(&inp.condInput, RESC_HIER_STR_KW, replica.resc_hier().data());
+
+            const int l1descInx = open_source_replica(_comm, inp);
+
+            if (l1descInx < 0) {
+                irods::log(LOG_DEBUG, fmt::format(
+                    "[{}:{}] - could not open additional source [{}]; ec:[{}]",
+                    __FUNCTION__, __LINE__, replica.resc_hier(), l1descInx));
+                continue;
+            }
+
+            const auto* host = get_server_host(l1descInx);
+
+            if (L1desc[l1descInx].remoteZoneHost ||
+                std::find(std::begin(hosts), std::end(hosts), host) != std::end(hosts)) {
+                if (const int ec = irods::close_replica_without_catalog_update(_comm, l1descInx); ec < 0) {
+                    irods::log(LOG_ERROR, fmt::format(
+                        "[{}:{}] - failed to close additional source [{}]; ec:[{}]",
+                        __FUNCTION__, __LINE__, replica.resc_hier(), ec));
+                }
+                continue;
+            }
+
+            hosts.push_back(get_server_host(l1descInx));
+            sources.push_back(l1descInx);
+        }
+
+        return sources;
+    } // open_additional_sources
+
+    auto close_additional_sources(RsComm& _comm, const std::vector<int>& _sources, std::string_view _logical_path) -> void
+    {
+        for (const int l1descInx : _sources) {
+            if (const int ec = irods::close_replica_without_catalog_update(_comm, l1descInx); ec < 0) {
+                irods::log(LOG_ERROR, fmt::format(
+                    "[{}:{}] - failed to close additional source for [{}]; ec:[{}]",
+                    __FUNCTION__, __LINE__, _logical_path, ec));
+            }
+
+            // Every open for read holds a reference to the entry in the replica state table.
+            if (rst::contains(_logical_path)) {
+                rst::erase(_logical_path);
+            }
+        }
+    } // close_additional_sources
+
+    auto seek(RsComm& _comm, const int _l1descInx, const rodsLong_t _offset) -> int
+    {
+        OpenedDataObjInp inp{};
+        inp.l1descInx = _l1descInx;
+        inp.offset = _offset;
+        inp.whence = SEEK_SET;
+
+        FileLseekOut* out{};
+        const int ec = rsDataObjLseek(&_comm, &inp, &out);
+        free(out);
+
+        return ec;
+    } // seek
+
+    // Reads a source replica on another host with file-level calls on the server-to-server
+    // connection to that host. The connection must not be used by any other thread (see
+    // multi_source_copy), and neither _comm nor the descriptor tables are touched. This
+    // bypasses the read post-processing rule, as the portal copy done by dataObjCopy does.
+    auto make_remote_reader(rcComm_t* _conn, const int _remote_fd) -> msc::read_function
+    {
+        return [_conn, _remote_fd, position = rodsLong_t{0}](std::int64_t _offset, char* _buffer, int _count) mutable -> int {
+            if (_offset != position) {
+                FileLseekInp inp{};
+                inp.fileInx = _remote_fd;
+                inp.offset = _offset;
+                inp.whence = SEEK_SET;
+
+                FileLseekOut* out{};
+                const int ec = rcFileLseek(_conn, &inp, &out);
+                free(out);
+
+                if (ec < 0) {
+                    return ec;
+                }
+            }
+
+            FileReadInp inp{};
+            inp.fileInx = _remote_fd;
+            inp.len = _count;
+
+            BytesBuf buf{};
+            buf.buf = _buffer;
+            buf.len = _count;
+
+            const int n = rcFileRead(_conn, &inp, &buf);
+            position = n > 0 ? _offset + n : -1;
+
+            return n;
+        };
+    } // make_remote_reader
+
+    // Copies the data into the destination replica by reading from all sources at once, starting
+    // at _offset. Each source is read by its own thread while the destination is written by this one.
+    //
+    // The server APIs rely on the error stack of _comm, the L1 and L3 descriptor tables and the
+    // rule engine, none of which are thread-safe. Every call made through them, whether to read a
+    // local source, write the destination or record progress, holds the same mutex. Sources on
+    // other hosts are read in parallel through their own connections, unless the destination or
+    // the catalog provider lives on the same host: writing the destination and recording progress
+    // use that connection too, so such sources are read under the mutex as well.
+    int multi_source_copy(
+        RsComm& _comm,
+        const int _destination_l1descInx,
+        const std::vector<int>& _sources,
+        const rodsLong_t _offset,
+        const msc::progress_function& _progress)
+    {
+        int block_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
+
+        std::mutex api_mutex;
+
+        // Connections used by the writer and the progress callback.
+        std::vector<rodsServerHost_t*> shared_hosts{get_server_host(_destination_l1descInx)};
+
+        if (rodsServerHost_t* rcat_host{}; getRcatHost(MASTER_RCAT, L1desc[_destination_l1descInx].dataObjInfo->objPath, &rcat_host) >= 0) {
+            shared_hosts.push_back(rcat_host);
+        }
+        else {
+            // The host is unknown, so no source may be read without the mutex.
+            shared_hosts.clear();
+        }
+
+        // Blocks are claimed in order, so a source only needs to seek after another source
+        // took the blocks following its previous one.
+        std::vector<msc::read_function> readers;
+        readers.reserve(_sources.size());
+
+        for (const int l1descInx : _sources) {
+            const auto& l3desc = FileDesc[L1desc[l1descInx].l3descInx];
+
+            if (l3desc.rodsServerHost && LOCAL_HOST != l3desc.rodsServerHost->localFlag &&
+                l3desc.rodsServerHost->conn && !L1desc[l1descInx].dataObjInfo->specColl &&
+                !shared_hosts.empty() &&
+                std::find(std::begin(shared_hosts), std::end(shared_hosts), l3desc.rodsServerHost) == std::end(shared_hosts)) {
+                readers.push_back(make_remote_reader(l3desc.rodsServerHost->conn, l3desc.fd));
+                continue;
+            }
+
+            readers.emplace_back([&_comm, &api_mutex, l1descInx, position = rodsLong_t{0}](std::int64_t _offset, char* _buffer, int _count) mutable -> int {
+                std::lock_guard lock{api_mutex};
+
+                if (_offset != position) {
+                    if (const int ec = seek(_comm, l1descInx, _offset); ec < 0) {
+                        return ec;
+                    }
+                }
+
+                OpenedDataObjInp inp{};
+                inp.l1descInx = l1descInx;
+                inp.len = _count;
+
+                BytesBuf buf{};
+                buf.buf = _buffer;
+                buf.len = _count;
+
+                const int n = rsDataObjRead(&_comm, &inp, &buf);
+                position = n > 0 ? _offset + n : -1;
+
+                return n;
+            });
+        }
+
+        auto writer = [&_comm, &api_mutex, _destination_l1descInx, position = rodsLong_t{0}](std::int64_t _offset, const char* _buffer, int _count) mutable -> int {
+            std::lock_guard lock{api_mutex};
+
+            if (_offset != position) {
+                if (const int ec = seek(_comm, _destination_l1descInx, _offset); ec < 0) {
+                    return ec;
+                }
+            }
+
+            OpenedDataObjInp inp{};
+            inp.l1descInx = _destination_l1descInx;
+            inp.len = _count;
+
+            BytesBuf buf{};
+            buf.buf = const_cast<char*>(_buffer);
+            buf.len = _count;
+
+            const int n = rsDataObjWrite(&_comm, &inp, &buf);
+            position = n > 0 ? _offset + n : -1;
+
+            return n;
+        };
+
+        const auto progress = [&api_mutex, &_progress](std::int64_t _offset) {
+            if (_progress) {
+                std::lock_guard lock{api_mutex};
+                _progress(_offset);
+            }
+        };
+
+        return msc::copy(readers, writer, _offset, L1desc[_destination_l1descInx].dataSize, block_size, progress);
+    } // multi_source_copy
+
+    int replicate_data(RsComm& _comm, DataObjInp& _source_inp, DataObjInp& _destination_inp,
+                       const std::vector<irods::physical_object>& _replicas)
     {
         // Open source replica
         int source_l1descInx = open_source_replica(_comm, _source_inp);
@@ -425,8 +834,19 @@ namespace
             "[{}:{}] - source:[{}]",
             __FUNCTION__, __LINE__, source_data_obj_info.rescHier));
 
+        // Large replications are copied in a way that allows a later attempt to continue from where
+        // this one stopped. The result is verified against the checksum of the source replica.
+        const auto resumable_settings = get_resumable_replication_settings();
+        const bool resumable = resumable_settings.minimum_data_size_in_bytes >= 0 &&
+                               !L1desc[source_l1descInx].remoteZoneHost &&
+                               GOOD_REPLICA == source_data_obj_info.replStatus &&
+                               !std::string_view{source_data_obj_info.chksum}.empty() &&
+                               source_data_obj_info.dataSize >= resumable_settings.minimum_data_size_in_bytes;
+
+        const rodsLong_t resume_offset = resumable ? get_resume_offset(_destination_inp, source_data_obj_info, _replicas) : 0;
+
         // Open destination replica
-        int destination_l1descInx = open_destination_replica(_comm, _destination_inp, source_l1descInx);
+        int destination_l1descInx = open_destination_replica(_comm, _destination_inp, source_l1descInx, 0 == resume_offset);
         if (destination_l1descInx < 0) {
             if (const int ec = irods::close_replica_without_catalog_update(_comm, source_l1descInx); ec < 0) {
                 irods::log(LOG_ERROR, fmt::format(
@@ -445,8 +865,73 @@ namespace
         L1desc[destination_l1descInx].srcL1descInx = source_l1descInx;
         L1desc[destination_l1descInx].dataSize = source_data_obj_info.dataSize;
 
+        // Read from several good replicas at once if the client asked for it and the data is
+        // large enough. The result is verified against the checksum of the source replica.
+        std::vector<int> additional_sources;
+
+        if (const auto settings = get_multi_source_settings();
+            !L1desc[source_l1descInx].remoteZoneHost &&
+            !L1desc[destination_l1descInx].remoteZoneHost &&
+            GOOD_REPLICA == source_data_obj_info.replStatus &&
+            !std::string_view{source_data_obj_info.chksum}.empty() &&
+            source_data_obj_info.dataSize >= settings.minimum_data_size_in_bytes)
+        {
+            if (const int number_of_sources = get_number_of_sources(_source_inp, settings); number_of_sources > 1) {
+                additional_sources = open_additional_sources(
+                    _comm, _source_inp, _replicas, source_l1descInx, destination_l1descInx, number_of_sources - 1);
+            }
+        }
+
         // Copy data from source to destination
-        int status = dataObjCopy(&_comm, destination_l1descInx);
+        int status = 0;
+
+        // Any checkpoint left by an earlier attempt is either used now or no longer valid.
+        const bool had_checkpoint = rcp::parse(destination_data_obj_info.statusString).has_value();
+        std::optional<rcp::checkpoint> checkpoint;
+
+        if (additional_sources.empty() && (!resumable || L1desc[destination_l1descInx].remoteZoneHost)) {
+            status = dataObjCopy(&_comm, destination_l1descInx);
+        }
+        else {
+            irods::log(LOG_DEBUG, fmt::format(
+                "[{}:{}] - replicating [{}] from [{}] sources starting at offset [{}]",
+                __FUNCTION__, __LINE__, _destination_inp.objPath, additional_sources.size() + 1, resume_offset));
+
+            std::vector<int> sources{source_l1descInx};
+            sources.insert(std::end(sources), std::begin(additional_sources), std::end(additional_sources));
+
+            checkpoint = rcp::checkpoint{resume_offset, rcp::make_source_id(source_data_obj_info.chksum, source_data_obj_info.dataSize)};
+            rodsLong_t persisted_offset = resume_offset;
+
+            const auto on_progress = [&](const rodsLong_t _offset) {
+                checkpoint->offset = _offset;
+
+                if (!resumable || resumable_settings.checkpoint_interval_in_bytes <= 0 ||
+                    _offset - persisted_offset < resumable_settings.checkpoint_interval_in_bytes ||
+                    _offset == source_data_obj_info.dataSize) {
+                    return;
+                }
+
+                if (const int ec = persist_checkpoint(_comm, L1desc[destination_l1descInx], *checkpoint); ec < 0) {
+                    irods::log(LOG_NOTICE, fmt::format(
+                        "[{}:{}] - failed to record checkpoint for [{}]; ec:[{}]",
+                        __FUNCTION__, __LINE__, _destination_inp.objPath, ec));
+                    return;
+                }
+
+                persisted_offset = _offset;
+            };
+
+            status = multi_source_copy(_comm, destination_l1descInx, sources, resume_offset, on_progress);
+
+            close_additional_sources(_comm, additional_sources, _destination_inp.objPath);
+
+            // Make sure finalizing the destination verifies the new replica against the source checksum.
+            if (std::string_view{destination_data_obj_info.chksum}.empty()) {
+                rstrcpy(destination_data_obj_info.chksum, source_data_obj_info.chksum, sizeof(destination_data_obj_info.chksum));
+            }
+        }
+
         if (status < 0) {
             irods::log(LOG_ERROR, fmt::format(
                 "[{}:{}] - dataObjCopy failed for [{}], src:[{}], dest:[{}]; ec:[{}]",
@@ -462,6 +947,15 @@ namespace
             L1desc[destination_l1descInx].bytesWritten = destination_data_obj_info.dataSize;
         }
 
+        // The data_status of the destination replica carries the checkpoint of a failed resumable
+        // replication, which finalizing the replica on failure records in the catalog.
+        if (status < 0 && resumable && checkpoint && checkpoint->offset > 0) {
+            rstrcpy(destination_data_obj_info.statusString, rcp::to_string(*checkpoint).data(), sizeof(destination_data_obj_info.statusString));
+        }
+        else if (had_checkpoint || checkpoint) {
+            destination_data_obj_info.statusString[0] = '\0';
+        }
+
         // Save the token for the replica access table so that it can be removed
         // in the event of a failure in close. On failure, the entry is restored,
         // but this will prevent retries of the operation as the token information
@@ -646,7 +1140,7 @@ namespace
             destination_cond_input.at(RESC_HIER_STR_KW).value()));
 
         // replicate!
-        const int ec = replicate_data(_comm, source_inp, destination_inp);
+        const int ec = replicate_data(_comm, source_inp, destination_inp, source_obj->replicas());
 
         if (ec < 0) {
             irods::log(LOG_ERROR, fmt::format(
@@ -721,7 +1215,7 @@ namespace
                 destination_cond_input[RESC_HIER_STR_KW] = destination_replica.resc_hier();
                 destination_cond_input[DEST_RESC_HIER_STR_KW] = destination_replica.resc_hier();
 
-                if (const int ec = replicate_data(_comm, source_inp, destination_inp);
+                if (const int ec = replicate_data(_comm, source_inp, destination_inp, source_obj->replicas());
                     ec < 0 && status >= 0) {
                     status = ec;
                 }
@@ -733,13 +1227,7 @@ namespace
 
     int singleL1Copy(rsComm_t *rsComm, dataCopyInp_t& dataCopyInp)
     {
-        int trans_buff_size;
-        try {
-            trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-        } catch ( const irods::exception& e ) {
-            irods::log(e);
-            return e.code();
-        }
+        int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
         dataOprInp_t* dataOprInp = &dataCopyInp.dataOprInp;
         int destL1descInx = dataCopyInp.portalOprOut.l1descInx;
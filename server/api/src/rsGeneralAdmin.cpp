@@ -31,6 +31,7 @@
 #include "irods_at_scope_exit.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "irods_logger.hpp"
+#include "special_collection_index.hpp"
 
 using logger = irods::experimental::log;
 
@@ -817,6 +818,9 @@ _rsGeneralAdmin( rsComm_t *rsComm, generalAdminInp_t *generalAdminInp ) {
                 char newName[MAX_NAME_LEN];
                 snprintf( oldName, sizeof( oldName ), "/%s", generalAdminInp->arg2 );
                 snprintf( newName, sizeof( newName ), "%s", generalAdminInp->arg4 );
+
+                // Renaming the zone moves every special collection inside it.
+                irods::experimental::special_collection_index::update_guard sci_guard;
                 status = chlRenameColl( rsComm, oldName, newName );
                 if ( status == 0 ) {
                     chlCommit( rsComm );
@@ -24,6 +24,7 @@
 // =-=-=-=-=-=-=-
 #include "irods_resource_backport.hpp"
 #include "irods_resource_redirect.hpp"
+#include "redirect_token.hpp"
 
 int rsGetHostForGet(
     rsComm_t*     rsComm,
@@ -72,6 +73,12 @@ int rsGetHostForGet(
                 return -1;
             }
 
+            // =-=-=-=-=-=-=-
+            // hand the resolved hierarchy to the target server so that it does not
+            // need to vote again
+            irods::experimental::redirect_token::append_if_requested(
+                *rsComm, *dataObjInp, irods::experimental::redirect_token::get_redirect, hier, location);
+
             // =-=-=-=-=-=-=-
             // set the out variable
             *outHost = strdup( location.c_str() );
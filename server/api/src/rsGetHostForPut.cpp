@@ -19,6 +19,7 @@
 // =-=-=-=-=-=-=-
 #include "irods_resource_backport.hpp"
 #include "irods_resource_redirect.hpp"
+#include "redirect_token.hpp"
 
 
 int rsGetHostForPut(
@@ -63,6 +64,12 @@ int rsGetHostForPut(
             return -1;
         }
 
+        // =-=-=-=-=-=-=-
+        // hand the resolved hierarchy to the target server so that it does not
+        // need to vote again
+        irods::experimental::redirect_token::append_if_requested(
+            *rsComm, *dataObjInp, irods::experimental::redirect_token::put_redirect, hier, location);
+
         // =-=-=-=-=-=-=-
         // set the out variable
         *outHost = strdup( location.c_str() );
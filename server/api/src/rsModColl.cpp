@@ -9,6 +9,9 @@
 #include "icatHighLevelRoutines.hpp"
 #include "miscServerFunct.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "special_collection_index.hpp"
+
+#include <optional>
 
 int
 rsModColl( rsComm_t *rsComm, collInp_t *modCollInp ) {
@@ -108,6 +111,12 @@ _rsModColl( rsComm_t *rsComm, collInp_t *modCollInp ) {
         }
         /**  June 1 2009 for pre-post processing rule hooks **/
 
+        // Changing the type of a collection may create or remove a special collection.
+        std::optional<irods::experimental::special_collection_index::update_guard> sci_guard;
+        if ( collInfo.collType[0] != '\0' ) {
+            sci_guard.emplace();
+        }
+
         status = chlModColl( rsComm, &collInfo );
 
         /**  June 1 2009 for pre-post processing rule hooks **/
@@ -581,7 +581,8 @@ phyBundle( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo, char *phyBunDir,
     if ( dataType != NULL && // JMC - backport 4633
             ( strstr( dataType, GZIP_TAR_DT_STR )  != NULL || // JMC - backport 4658
               strstr( dataType, BZIP2_TAR_DT_STR ) != NULL ||
-              strstr( dataType, ZIP_DT_STR )       != NULL ) ) {
+              strstr( dataType, ZIP_DT_STR )       != NULL ||
+              strstr( dataType, ZSTD_TAR_DT_STR )  != NULL ) ) {
         addKeyVal( &structFileOprInp.condInput, DATA_TYPE_KW, dataType );
     }
 
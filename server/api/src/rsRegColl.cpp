@@ -9,9 +9,12 @@
 #include "collection.hpp"
 #include "miscServerFunct.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "special_collection_index.hpp"
 #include "rsRegColl.hpp"
 #include "rsObjStat.hpp"
 
+#include <optional>
+
 int
 rsRegColl( rsComm_t *rsComm, collInp_t *regCollInp ) {
     int status;
@@ -99,6 +102,12 @@ _rsRegColl( rsComm_t *rsComm, collInp_t *collCreateInp ) {
             }
         }
 
+        // Registering a typed collection creates a special collection.
+        std::optional<irods::experimental::special_collection_index::update_guard> sci_guard;
+        if ( collInfo.collType[0] != '\0' ) {
+            sci_guard.emplace();
+        }
+
         status = chlRegColl( rsComm, &collInfo );
         clearKeyVal( &collInfo.condInput );
         return status;
@@ -14,7 +14,7 @@
 #include "catalog_utilities.hpp"
 #include "ruleExecSubmit.h"
 #include "server_utilities.hpp"
-#include "json_serialization.hpp"
+#include "rule_execution_context.hpp"
 
 #include <json.hpp>
 
@@ -50,7 +50,7 @@ namespace
         rstrcpy(ruleExecSubmitInp->reiFilePath, "EMPTY_REI_PATH", sizeof(ruleExecSubmitInp_t::reiFilePath));
 
         irods::experimental::key_value_proxy kvp{ruleExecSubmitInp->condInput};
-        kvp[RULE_EXECUTION_CONTEXT_KW] = irods::to_json(rei_info->rei).dump().data();
+        kvp[RULE_EXECUTION_CONTEXT_KW] = irods::rule_execution_context::encode(*rei_info->rei);
 
         // Register the request.
         std::string svc_role;
@@ -12,6 +12,8 @@
 #include "irods_load_plugin.hpp"
 #include "irods_report_plugins_in_json.hpp"
 #include "rsServerReport.hpp"
+#include "transfer_scheduler.hpp"
+#include "agent_connection_health.hpp"
 #include <unistd.h>
 #include <grp.h>
 
@@ -455,6 +457,39 @@ irods::error get_config_dir( json& _cfg_dir )
     return SUCCESS();
 } // get_config_dir
 
+irods::error get_transfer_scheduler_statistics( json& _statistics )
+{
+    namespace tsch = irods::experimental::transfer_scheduler;
+
+    _statistics = json::array();
+
+    for ( const auto& s : tsch::statistics() ) {
+        _statistics.push_back( json::object({
+            {"user", s.user},
+            {"active_streams", s.active_streams},
+            {"denied_streams", s.denied_streams},
+            {"bytes_transferred", s.bytes_transferred},
+            {"seconds_throttled", std::chrono::duration<double>(s.time_throttled).count()}
+        }) );
+    }
+
+    return SUCCESS();
+} // get_transfer_scheduler_statistics
+
+irods::error get_agent_connection_health_statistics( json& _statistics )
+{
+    const auto counters = irods::experimental::agent_connection_health::statistics();
+
+    _statistics = json::object({
+        {"idle_sessions_reaped", counters.idle_sessions_reaped},
+        {"idle_sessions_reaped_with_open_descriptors", counters.idle_sessions_reaped_with_open_descriptors},
+        {"broken_connections", counters.broken_connections},
+        {"heartbeats_received", counters.heartbeats_received}
+    });
+
+    return SUCCESS();
+} // get_agent_connection_health_statistics
+
 irods::error load_version_file( json& _version )
 {
     // =-=-=-=-=-=-=-
@@ -553,6 +588,20 @@ int _rsServerReport( rsComm_t* _comm, bytesBuf_t** _bbuf )
     }
     resc_svr["configuration_directory"] = cfg_dir;
 
+    json transfer_scheduler;
+    ret = get_transfer_scheduler_statistics( transfer_scheduler );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+    }
+    resc_svr["transfer_scheduler"] = transfer_scheduler;
+
+    json agent_connection_health;
+    ret = get_agent_connection_health_statistics( agent_connection_health );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+    }
+    resc_svr["agent_connection_health"] = agent_connection_health;
+
     std::string svc_role;
     ret = get_catalog_service_role(svc_role);
     if(!ret.ok()) {
@@ -233,6 +233,10 @@ rsStructFileExtAndReg(
             != NULL ) {
         flags = flags | FORCE_FLAG_FLAG;
     }
+    if ( getValByKey( &structFileExtAndRegInp->condInput, RESUME_KW )
+            != NULL ) {
+        flags = flags | RESUME_FLAG;
+    }
     if ( getValByKey( &structFileExtAndRegInp->condInput, BULK_OPR_KW )
             != NULL ) {
 
@@ -324,7 +328,7 @@ chkCollForExtAndReg( rsComm_t *rsComm, char *collection,
 
 /* regUnbunSubfiles - non bulk version of registering all files in phyBunDir
  * to the collection. Valid values for flags are:
- *      FORCE_FLAG_FLAG.
+ *      FORCE_FLAG_FLAG, RESUME_FLAG.
  */
 int
 regUnbunSubfiles( rsComm_t *rsComm, const dataObjInfo_t& _dataObjInfo,
@@ -464,7 +468,15 @@ regSubfile( rsComm_t *rsComm, const dataObjInfo_t& _dataObjInfo,
         }
         else {
             /* not an orphan file */
-            if ( ( flags & FORCE_FLAG_FLAG ) != 0 && dataObjInfo.dataId > 0 &&
+            if ( ( flags & RESUME_FLAG ) != 0 && dataObjInfo.dataId > 0 &&
+                    strcmp( dataObjInfo.objPath, subObjPath ) == 0 &&
+                    file_size( p ) == static_cast<boost::uintmax_t>( dataSize ) &&
+                    chkSameFileContent( dataObjInfo.filePath, subfilePath ) > 0 ) {
+                /* registered by an earlier extraction of this bundle. the size alone does
+                 * not prove that, so the replica must hold the bytes just extracted. */
+                return 0;
+            }
+            else if ( ( flags & FORCE_FLAG_FLAG ) != 0 && dataObjInfo.dataId > 0 &&
                     strcmp( dataObjInfo.objPath, subObjPath ) == 0 ) {
                 /* overwrite the current file */
                 modFlag = 1;
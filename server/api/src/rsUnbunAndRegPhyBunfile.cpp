@@ -347,7 +347,8 @@ int unbunPhyBunFile( rsComm_t *rsComm, char *objPath,
     if ( dataType != NULL && // JMC - backport 4632
             ( strstr( dataType, GZIP_TAR_DT_STR )  != NULL || // JMC - backport 4658
               strstr( dataType, BZIP2_TAR_DT_STR ) != NULL ||
-              strstr( dataType, ZIP_DT_STR )       != NULL ) ) {
+              strstr( dataType, ZIP_DT_STR )       != NULL ||
+              strstr( dataType, ZSTD_TAR_DT_STR )  != NULL ) ) {
         addKeyVal( &structFileOprInp.condInput, DATA_TYPE_KW, dataType );
     }
 
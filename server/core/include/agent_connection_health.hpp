@@ -0,0 +1,111 @@
+#ifndef IRODS_AGENT_CONNECTION_HEALTH_HPP
+#define IRODS_AGENT_CONNECTION_HEALTH_HPP
+
+/// \file
+
+#include "connection_health.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+/// Reclaims agents whose client went away.
+///
+/// An agent waits for the next message of its client for at most the configured idle
+/// timeout, then ends the session, releasing its catalog connection, replica locks and L1
+/// descriptors. Dead peers are usually detected much earlier by the TCP keepalive and user
+/// timeout options applied to every client socket (see connection_health.hpp). Every message,
+/// including a heartbeat, restarts the wait. In-tree clients do not send messages while they
+/// are quiet, so the idle timeout must exceed the longest pause of any legitimate client
+/// (e.g. an interactive session or a long-running rule).
+///
+/// The number of sessions ended this way is kept in shared memory and added to the server
+/// report.
+namespace irods::experimental::agent_connection_health
+{
+    /// The settings read from advanced_settings.agent_connection_health.
+    ///
+    /// \since 4.2.9
+    struct config
+    {
+        /// Applied to the sockets accepted by the server and opened by agents.
+        connection_health::tcp_keepalive_options tcp_keepalive;
+
+        /// The time an agent waits for the next message of its client. Must be greater than 0.
+        ///
+        /// Defaults to READ_HEADER_TIMEOUT_IN_SEC. Lowering it ends quiet but healthy sessions,
+        /// because in-tree clients do not send heartbeats on their own. Sessions with open data
+        /// objects are granted MAX_READ_HEADER_RETRY more waits of the same length.
+        int idle_timeout_in_seconds = 86400;
+    }; // struct config
+
+    /// The sessions ended because of an idle or dead client, across all agents.
+    ///
+    /// \since 4.2.9
+    struct counters
+    {
+        /// Sessions ended because the client sent nothing for the idle timeout.
+        std::int64_t idle_sessions_reaped;
+
+        /// The subset of idle_sessions_reaped that still had data objects open.
+        std::int64_t idle_sessions_reaped_with_open_descriptors;
+
+        /// Sessions ended because the connection failed without a disconnect message (e.g.
+        /// the peer was reset or stopped answering keepalive probes).
+        std::int64_t broken_connections;
+
+        /// Heartbeats answered.
+        std::int64_t heartbeats_received;
+    }; // struct counters
+
+    /// Reads the settings from server_config.json.
+    ///
+    /// \since 4.2.9
+    auto read_config() -> config;
+
+    /// Returns the idle timeout of the calling agent.
+    ///
+    /// The configuration is read on the first call only.
+    ///
+    /// \since 4.2.9
+    auto idle_timeout_in_seconds() -> int;
+
+    /// Creates the shared counters.
+    ///
+    /// This function should only be called on startup of the server, before agents are forked.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    ///
+    /// \since 4.2.9
+    auto init(const std::string_view _shm_name) -> void;
+
+    /// Removes the shared counters created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.2.9
+    auto deinit() noexcept -> void;
+
+    /// Counts a session ended because of the idle timeout.
+    ///
+    /// \param[in] _open_descriptors Whether the session still had data objects open.
+    ///
+    /// \since 4.2.9
+    auto record_idle_session_reaped(bool _open_descriptors) noexcept -> void;
+
+    /// Counts a session ended because its connection failed.
+    ///
+    /// \since 4.2.9
+    auto record_broken_connection() noexcept -> void;
+
+    /// Counts a heartbeat.
+    ///
+    /// \since 4.2.9
+    auto record_heartbeat() noexcept -> void;
+
+    /// Returns the current value of the counters, or zeros if init() was not called.
+    ///
+    /// \since 4.2.9
+    auto statistics() -> counters;
+} // namespace irods::experimental::agent_connection_health
+
+#endif // IRODS_AGENT_CONNECTION_HEALTH_HPP
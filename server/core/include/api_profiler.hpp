@@ -0,0 +1,153 @@
+#ifndef IRODS_API_PROFILER_HPP
+#define IRODS_API_PROFILER_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace irods::experimental::api_profiler
+{
+    /// The clock that drives the sampling timer.
+    ///
+    /// \since 4.2.9
+    enum class sampling_clock
+    {
+        /// Samples are taken while the process is consuming CPU. Stacks from every
+        /// thread in the agent are included.
+        cpu,
+
+        /// Samples are taken on elapsed time whether the API is running or blocked
+        /// (e.g. waiting on the catalog or the network). Only the thread that started
+        /// the sampler is sampled.
+        wall
+    }; // enum class sampling_clock
+
+    // clang-format off
+    /// The highest sampling frequency a sampler will accept.
+    constexpr int maximum_sampling_frequency_in_hz = 1000;
+
+    /// The number of samples a sampler can hold. Samples taken once the buffer
+    /// is full are counted and discarded.
+    constexpr std::size_t maximum_number_of_samples    = 4096;
+
+    /// The number of frames recorded per sample. Deeper stacks are truncated.
+    constexpr int maximum_stack_depth                  = 64;
+    // clang-format on
+
+    /// A statistical profiler which captures the call stack on a timer signal.
+    ///
+    /// Samples are written into a fixed-size buffer from the signal handler. Symbol
+    /// resolution only happens when the folded stacks are requested, after sampling has
+    /// stopped. The cost of an active sampler is therefore bounded by the sampling
+    /// frequency (at most ::maximum_sampling_frequency_in_hz calls to backtrace() per
+    /// second) and by a constant amount of memory.
+    ///
+    /// Only one sampler may be active in a process at a time. The first sampler installs a
+    /// SIGPROF handler which stays installed for the life of the process and ignores
+    /// signals while no sampler is running.
+    ///
+    /// \since 4.2.9
+    class sampler
+    {
+    public:
+        /// Installs the signal handler and starts sampling.
+        ///
+        /// \param[in] _frequency_in_hz The number of samples to take per second. Values
+        ///                             outside of [1, maximum_sampling_frequency_in_hz]
+        ///                             are clamped.
+        /// \param[in] _clock           The clock that drives the sampling timer.
+        ///
+        /// \throws irods::exception If another sampler is active or the timer cannot be created.
+        sampler(int _frequency_in_hz, sampling_clock _clock);
+
+        sampler(const sampler&) = delete;
+        auto operator=(const sampler&) -> sampler& = delete;
+
+        /// Stops sampling if the sampler is still running.
+        ~sampler();
+
+        /// Stops sampling and waits for in-flight samples to complete.
+        ///
+        /// Calling this function more than once has no effect.
+        auto stop() noexcept -> void;
+
+        /// Returns the number of samples captured.
+        auto sample_count() const noexcept -> std::size_t;
+
+        /// Returns the number of samples discarded because the buffer was full.
+        auto dropped_sample_count() const noexcept -> std::size_t;
+
+        /// Returns the time between construction and stop().
+        auto elapsed() const noexcept -> std::chrono::microseconds;
+
+        /// Returns the captured stacks in folded form.
+        ///
+        /// Each key is a stack of function names ordered from the outermost frame to the
+        /// innermost frame and separated by semicolons. Each value is the number of samples
+        /// which captured that stack.
+        ///
+        /// Must only be called after stop().
+        auto folded_stacks() const -> std::map<std::string, std::size_t>;
+
+        /// Writes the output of folded_stacks() to \p _out, one "<stack> <count>" line per
+        /// stack. This is the input format expected by flame graph tools such as
+        /// flamegraph.pl and speedscope.
+        ///
+        /// Must only be called after stop().
+        auto write_folded_stacks(std::ostream& _out) const -> void;
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::steady_clock::time_point stop_;
+        bool running_;
+    }; // class sampler
+
+    /// Reads the profiler configuration from server_config.json.
+    ///
+    /// This function should be called once by each agent after the server properties
+    /// have been captured. Profiling is disabled unless
+    /// "advanced_settings.api_profiler.api_numbers" is a non-empty list.
+    ///
+    /// \since 4.2.9
+    auto init() noexcept -> void;
+
+    /// Returns whether calls to the API identified by \p _api_number should be profiled.
+    ///
+    /// \since 4.2.9
+    auto is_enabled_for(int _api_number) noexcept -> bool;
+
+    /// Profiles a single API call if profiling is enabled for its API number.
+    ///
+    /// Sampling starts on construction and ends on stop(). The folded stacks are written
+    /// to "<output_directory>/irods_api_<api_number>.<pid>.<sequence>.folded" on
+    /// destruction, which allows the caller to send the API reply before paying for
+    /// symbol resolution.
+    ///
+    /// Failures are logged and never propagated to the caller.
+    ///
+    /// \since 4.2.9
+    class scoped_api_profile
+    {
+    public:
+        explicit scoped_api_profile(int _api_number) noexcept;
+
+        scoped_api_profile(const scoped_api_profile&) = delete;
+        auto operator=(const scoped_api_profile&) -> scoped_api_profile& = delete;
+
+        ~scoped_api_profile();
+
+        /// Stops sampling. The results are still written on destruction.
+        auto stop() noexcept -> void;
+
+    private:
+        int api_number_;
+        std::unique_ptr<sampler> sampler_;
+    }; // class scoped_api_profile
+} // namespace irods::experimental::api_profiler
+
+#endif // IRODS_API_PROFILER_HPP
@@ -57,6 +57,8 @@ int
 initDataObjInfoQuery( dataObjInp_t *dataObjInp, genQueryInp_t *genQueryInp,
                       int ignoreCondInput );
 int
+chkSameFileContent( const char *filePath1, const char *filePath2 );
+int
 chkOrphanFile( rsComm_t *rsComm, const char *filePath, const char *rescName,
                dataObjInfo_t *dataObjInfo );
 int
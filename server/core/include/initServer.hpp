@@ -29,7 +29,10 @@ int
 initZone( rsComm_t *rsComm );
 int
 initAgent( int processType, rsComm_t *rsComm );
-void cleanup();
+// Releases the resources of the agent. Server-to-server connections are handed to the
+// server connection broker only if _pool_server_connections is true, which must only be
+// the case after the client disconnected cleanly.
+void cleanup( bool _pool_server_connections = false );
 void cleanupAndExit( int status );
 void signalExit( int );
 void
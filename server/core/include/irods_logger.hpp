@@ -116,6 +116,10 @@ namespace irods::experimental
 
             static void set_level(level _level) noexcept;
 
+            /// Returns whether messages at \p _level are written for this category. Use it
+            /// to skip building messages that are expensive to produce.
+            static auto is_enabled(level _level) noexcept -> bool;
+
             // clang-format off
             inline static const auto trace    = impl<level::trace>{};
             inline static const auto debug    = impl<level::debug>{};
@@ -120,6 +120,12 @@ void log::logger<Category>::set_level(log::level _level) noexcept
     logger_config<Category>::level = _level;
 }
 
+template <typename Category>
+auto log::logger<Category>::is_enabled(log::level _level) noexcept -> bool
+{
+    return _level >= logger_config<Category>::level;
+}
+
 template <typename Category>
 template <log::level Level>
 class log::logger<Category>::impl
@@ -22,6 +22,7 @@
 #include "rodsConnect.h"
 
 #include "structFileSync.h" /* JMC */
+#include "transfer_compression.hpp"
 
 #define MAX_RECON_ERROR_CNT	10
 
@@ -45,6 +46,8 @@ typedef struct PortalTransferInp {
     char encryption_algorithm[ NAME_LEN ];
     char shared_secret[ NAME_LEN ]; // JMC - shared secret for each portal thread
 
+    irods::experimental::transfer_compression::statistics compression_stats;
+
 } portalTransferInp_t;
 
 int
@@ -0,0 +1,88 @@
+#ifndef IRODS_MULTI_SOURCE_COPY_HPP
+#define IRODS_MULTI_SOURCE_COPY_HPP
+
+/// \file
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// Copies bytes from several sources holding identical data into a single sink.
+///
+/// Replication uses this to restore a replica from multiple good replicas on different
+/// hosts at once, so that the copy is not limited by the bandwidth of a single source.
+namespace irods::experimental::multi_source_copy
+{
+    /// Reads up to \p _count bytes at \p _offset into \p _buffer.
+    ///
+    /// Returns the number of bytes read or a negative iRODS error code. Returning zero
+    /// before the end of the data is treated as an error.
+    ///
+    /// \since 4.2.9
+    using read_function = std::function<int (std::int64_t _offset, char* _buffer, int _count)>;
+
+    /// Writes \p _count bytes from \p _buffer at \p _offset.
+    ///
+    /// Returns the number of bytes written or a negative iRODS error code.
+    ///
+    /// \since 4.2.9
+    using write_function = std::function<int (std::int64_t _offset, const char* _buffer, int _count)>;
+
+    /// Receives the offset up to which every byte has been written to the sink.
+    ///
+    /// \since 4.2.9
+    using progress_function = std::function<void (std::int64_t _offset)>;
+
+    /// Copies \p _size bytes from \p _sources to \p _sink.
+    ///
+    /// Every source is read by its own thread. Sources claim blocks of \p _block_size bytes
+    /// in order, so a faster source ends up copying more of the data than a slower one. A
+    /// block that fails to be read is handed to the remaining sources, so the copy only fails
+    /// once every source has failed. The sink is only ever called from the calling thread.
+    ///
+    /// \param[in] _sources    The sources. Each source must be safe to call concurrently with
+    ///                        the other sources and with the sink.
+    /// \param[in] _sink       The sink.
+    /// \param[in] _size       The number of bytes to copy.
+    /// \param[in] _block_size The number of bytes moved by a single read or write.
+    ///
+    /// \return An integer.
+    /// \retval 0        On success.
+    /// \retval negative The error reported by the sink, the last error reported by a source,
+    ///                  or SYS_COPY_LEN_ERR if the data ended early.
+    ///
+    /// \since 4.2.9
+    auto copy(const std::vector<read_function>& _sources,
+              const write_function& _sink,
+              std::int64_t _size,
+              int _block_size) -> int;
+
+    /// Copies the bytes between \p _offset and \p _size from \p _sources to \p _sink.
+    ///
+    /// Behaves like the overload above, except that the copy starts at \p _offset. Because
+    /// blocks may reach the sink out of order, \p _progress is invoked every time the range
+    /// of bytes written without gaps, starting at \p _offset, grows. This allows a caller to
+    /// resume an interrupted copy from the last offset it was told about.
+    ///
+    /// \param[in] _sources    The sources.
+    /// \param[in] _sink       The sink.
+    /// \param[in] _offset     The offset of the first byte to copy.
+    /// \param[in] _size       The offset one past the last byte to copy.
+    /// \param[in] _block_size The number of bytes moved by a single read or write.
+    /// \param[in] _progress   Invoked from the calling thread. May be empty.
+    ///
+    /// \return An integer.
+    /// \retval 0        On success.
+    /// \retval negative The error reported by the sink, the last error reported by a source,
+    ///                  or SYS_COPY_LEN_ERR if the data ended early.
+    ///
+    /// \since 4.2.9
+    auto copy(const std::vector<read_function>& _sources,
+              const write_function& _sink,
+              std::int64_t _offset,
+              std::int64_t _size,
+              int _block_size,
+              const progress_function& _progress) -> int;
+} // namespace irods::experimental::multi_source_copy
+
+#endif // IRODS_MULTI_SOURCE_COPY_HPP
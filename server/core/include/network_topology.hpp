@@ -0,0 +1,175 @@
+#ifndef IRODS_NETWORK_TOPOLOGY_HPP
+#define IRODS_NETWORK_TOPOLOGY_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A model of where the servers of a zone are and how quickly data moves between them.
+///
+/// The administrator places each server in a site and a rack (advanced_settings.network_topology
+/// in server_config.json) and states the throughput expected between servers in the same rack,
+/// the same site and different sites. The main server process measures the round trip time to
+/// every other server in the topology in the background and publishes the samples to shared
+/// memory, so that agents can estimate how long reading a replica from another host will take.
+namespace irods::experimental::network_topology
+{
+    /// How close two hosts are to each other.
+    ///
+    /// \since 4.2.9
+    enum class proximity
+    {
+        same_host,
+        same_rack,
+        same_site,
+        remote_site,
+        unknown
+    }; // enum class proximity
+
+    /// The location of a server.
+    ///
+    /// \since 4.2.9
+    struct host_location
+    {
+        /// The hostname of the server, as used for the location of its resources.
+        std::string host;
+
+        /// The name of the site (e.g. a data center) the server is in.
+        std::string site;
+
+        /// The name of the rack the server is in. Racks are only compared within a site.
+        std::string rack;
+    }; // struct host_location
+
+    /// The topology of the zone, as read from server_config.json.
+    ///
+    /// \since 4.2.9
+    struct config
+    {
+        /// The location of each server. A host without a location is never compared.
+        std::vector<host_location> hosts;
+
+        /// The expected throughput between two servers in the same rack.
+        std::int64_t same_rack_bytes_per_second = 1000 * 1024 * 1024;
+
+        /// The expected throughput between two servers in the same site.
+        std::int64_t same_site_bytes_per_second = 500 * 1024 * 1024;
+
+        /// The expected throughput between two servers in different sites.
+        std::int64_t remote_site_bytes_per_second = 50 * 1024 * 1024;
+
+        /// The time between two measurements of the round trip time to a server.
+        std::chrono::seconds sampling_interval{30};
+
+        /// The age at which a round trip time sample is no longer trusted.
+        std::chrono::seconds maximum_sample_age{120};
+    }; // struct config
+
+    /// Reads the topology from server_config.json.
+    ///
+    /// \return The configured topology, or an empty topology if none is configured.
+    ///
+    /// \since 4.2.9
+    auto read_config() -> config;
+
+    /// Returns the topology of the zone.
+    ///
+    /// The configuration is read on the first call and kept for the life of the process.
+    ///
+    /// \since 4.2.9
+    auto get_config() -> const config&;
+
+    /// Returns how close two hosts are to each other.
+    ///
+    /// \param[in] _config The topology.
+    /// \param[in] _from   The hostname of the first server.
+    /// \param[in] _to     The hostname of the second server.
+    ///
+    /// \retval proximity::unknown If either host is not in the topology.
+    ///
+    /// \since 4.2.9
+    auto proximity_between(const config& _config, std::string_view _from, std::string_view _to) -> proximity;
+
+    /// Estimates the time needed to move data from one server to another.
+    ///
+    /// The estimate is the round trip time plus the time needed to move \p _bytes at the
+    /// throughput configured for the proximity of the two hosts. Without a measurement, the
+    /// round trip time is assumed from the proximity.
+    ///
+    /// \param[in] _config          The topology.
+    /// \param[in] _from            The hostname of the server holding the data.
+    /// \param[in] _to              The hostname of the server receiving the data.
+    /// \param[in] _bytes           The number of bytes to move.
+    /// \param[in] _round_trip_time The measured round trip time between the hosts, if any.
+    ///
+    /// \return The expected transfer time, or std::nullopt if the proximity is unknown.
+    ///
+    /// \since 4.2.9
+    auto expected_transfer_time(const config& _config,
+                                std::string_view _from,
+                                std::string_view _to,
+                                std::int64_t _bytes,
+                                std::optional<std::chrono::microseconds> _round_trip_time)
+        -> std::optional<std::chrono::microseconds>;
+
+    /// Initializes the table of round trip time samples.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.2.9
+    auto init(const std::string_view _shm_name = "irods_network_topology", std::size_t _shm_size = 100'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.2.9
+    auto deinit() noexcept -> void;
+
+    /// Inserts a new round trip time sample or replaces the existing one for a host.
+    ///
+    /// \param[in] _host            The hostname of the server.
+    /// \param[in] _round_trip_time The round trip time from this server to \p _host.
+    ///
+    /// \since 4.2.9
+    auto insert_or_assign(const std::string_view _host, std::chrono::microseconds _round_trip_time) -> void;
+
+    /// Returns the most recent round trip time sample for a host if it is not older than \p _max_age.
+    ///
+    /// \param[in] _host    The hostname of the server.
+    /// \param[in] _max_age The maximum age of a sample before it is considered stale.
+    ///
+    /// \since 4.2.9
+    auto lookup(const std::string_view _host, std::chrono::seconds _max_age) -> std::optional<std::chrono::microseconds>;
+
+    /// Removes the round trip time sample for a host.
+    ///
+    /// \since 4.2.9
+    auto erase(const std::string_view _host) -> void;
+
+    /// Measures the round trip time to the server listening on \p _host and \p _port.
+    ///
+    /// The server is sent a heartbeat request, which it answers without spawning an agent.
+    /// The time between sending the request and receiving the answer includes the time the
+    /// server takes to accept the request, so a busy server measures further away.
+    ///
+    /// \param[in] _host    The hostname of the server.
+    /// \param[in] _port    The port of the server.
+    /// \param[in] _timeout The time allowed for connecting and for the answer.
+    ///
+    /// \return The round trip time, or std::nullopt if the server could not be reached.
+    ///
+    /// \since 4.2.9
+    auto measure_round_trip_time(const std::string& _host, int _port, std::chrono::milliseconds _timeout)
+        -> std::optional<std::chrono::microseconds>;
+} // namespace irods::experimental::network_topology
+
+#endif // IRODS_NETWORK_TOPOLOGY_HPP
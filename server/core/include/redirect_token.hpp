@@ -0,0 +1,125 @@
+#ifndef IRODS_REDIRECT_TOKEN_HPP
+#define IRODS_REDIRECT_TOKEN_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+struct RsComm;
+struct DataObjInp;
+
+/// Redirect tokens carry the result of resource hierarchy resolution from the server
+/// that answered getHostForPut / getHostForGet to the server the client is redirected
+/// to. This saves the target server a second voting pass and the catalog queries that
+/// come with it.
+///
+/// A token is bound to the operation, the logical path and the client user, expires
+/// after a short lifetime, and is signed with HMAC-SHA256 using the zone key.
+namespace irods::experimental::redirect_token
+{
+    /// The amount of time a token remains valid after it is issued.
+    ///
+    /// \since 4.2.9
+    constexpr std::chrono::seconds lifetime{60};
+
+    /// The character separating the host name from the token in the output of
+    /// getHostForPut / getHostForGet.
+    ///
+    /// \since 4.2.9
+    constexpr char host_separator = '\n';
+
+    /// The operation bound to tokens returned by getHostForPut. Only requests that write
+    /// accept them.
+    ///
+    /// \since 4.2.9
+    constexpr std::string_view put_redirect = "put";
+
+    /// The operation bound to tokens returned by getHostForGet. Only requests that read
+    /// accept them.
+    ///
+    /// \since 4.2.9
+    constexpr std::string_view get_redirect = "get";
+
+    /// The request a token is bound to.
+    ///
+    /// \since 4.2.9
+    struct context
+    {
+        /// The redirect the token was issued for (put_redirect or get_redirect).
+        std::string_view operation;
+        std::string_view logical_path;
+        std::string_view user_name;
+        std::string_view user_zone;
+    }; // struct context
+
+    /// Creates a signed token for \p _hierarchy.
+    ///
+    /// \param[in] _key        The secret used to sign the token.
+    /// \param[in] _ctx        The request the token is bound to.
+    /// \param[in] _hierarchy  The resolved resource hierarchy.
+    /// \param[in] _expires_at The seconds since epoch after which the token is rejected.
+    ///
+    /// \return The token.
+    ///
+    /// \since 4.2.9
+    auto make(std::string_view _key,
+              const context& _ctx,
+              std::string_view _hierarchy,
+              std::int64_t _expires_at) -> std::string;
+
+    /// Validates a token and returns the hierarchy it carries.
+    ///
+    /// \param[in] _key   The secret used to sign the token.
+    /// \param[in] _ctx   The request the token must be bound to.
+    /// \param[in] _token The token.
+    /// \param[in] _now   The current seconds since epoch.
+    ///
+    /// \return An optional string.
+    /// \retval hierarchy    If the token is well-formed, unexpired, bound to \p _ctx and
+    ///                      carries a valid signature.
+    /// \retval std::nullopt Otherwise.
+    ///
+    /// \since 4.2.9
+    auto verify(std::string_view _key,
+                const context& _ctx,
+                std::string_view _token,
+                std::int64_t _now) -> std::optional<std::string>;
+
+    /// Appends a token for \p _hierarchy to \p _host if the client asked for one.
+    ///
+    /// A client asks for a token by setting REQUEST_REDIRECT_TOKEN_KW. The result has the
+    /// form "<host><host_separator><token>". \p _host is left untouched when the client
+    /// did not ask for a token, \p _hierarchy is empty or the token could not be created.
+    ///
+    /// \param[in] _redirect put_redirect or get_redirect, depending on the API answering.
+    ///
+    /// \since 4.2.9
+    auto append_if_requested(RsComm& _comm,
+                             const DataObjInp& _inp,
+                             std::string_view _redirect,
+                             std::string_view _hierarchy,
+                             std::string& _host) -> void;
+
+    /// Moves the hierarchy carried by REDIRECT_TOKEN_KW into RESC_HIER_STR_KW.
+    ///
+    /// REDIRECT_TOKEN_KW is always removed from \p _inp. An invalid or expired token is
+    /// logged and ignored, in which case the caller resolves the hierarchy as usual. A
+    /// hierarchy explicitly provided by the client takes precedence over the token.
+    ///
+    /// \param[in] _redirect The redirect whose tokens the caller accepts: put_redirect for
+    ///                      requests that write, get_redirect for requests that read. A
+    ///                      token issued for the other redirect is rejected.
+    ///
+    /// \return A boolean.
+    /// \retval true  If RESC_HIER_STR_KW was set from the token.
+    /// \retval false Otherwise.
+    ///
+    /// \since 4.2.9
+    auto consume(RsComm& _comm, DataObjInp& _inp, std::string_view _redirect) -> bool;
+} // namespace irods::experimental::redirect_token
+
+#endif // IRODS_REDIRECT_TOKEN_HPP
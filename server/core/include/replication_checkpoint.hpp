@@ -0,0 +1,56 @@
+#ifndef IRODS_REPLICATION_CHECKPOINT_HPP
+#define IRODS_REPLICATION_CHECKPOINT_HPP
+
+/// \file
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// A replication checkpoint records how much of a destination replica was written before
+/// the replication failed, so that the next attempt can continue from there instead of
+/// copying the data from the beginning.
+///
+/// Checkpoints are stored in the data_status column of the stale destination replica. A
+/// checkpoint is bound to the contents of the source it was written from. A checkpoint
+/// taken against different contents is never resumed from.
+namespace irods::experimental::replication_checkpoint
+{
+    /// \since 4.2.9
+    struct checkpoint
+    {
+        /// Every byte before this offset has been written to the destination replica.
+        std::int64_t offset;
+
+        /// Identifies the contents of the source replica. See make_source_id.
+        std::string source_id;
+    }; // struct checkpoint
+
+    /// Returns a value identifying the contents of a source replica.
+    ///
+    /// All good replicas of a data object share the same identifier, so a replication may
+    /// resume from a different source than the one used by the failed attempt.
+    ///
+    /// \param[in] _checksum The checksum of the source replica.
+    /// \param[in] _size     The size of the source replica.
+    ///
+    /// \since 4.2.9
+    auto make_source_id(std::string_view _checksum, std::int64_t _size) -> std::string;
+
+    /// Converts a checkpoint to the string stored in the catalog.
+    ///
+    /// \since 4.2.9
+    auto to_string(const checkpoint& _checkpoint) -> std::string;
+
+    /// Parses a string produced by to_string.
+    ///
+    /// \param[in] _value The value of the data_status column of a replica.
+    ///
+    /// \return The checkpoint, or std::nullopt if \p _value does not hold a checkpoint.
+    ///
+    /// \since 4.2.9
+    auto parse(std::string_view _value) -> std::optional<checkpoint>;
+} // namespace irods::experimental::replication_checkpoint
+
+#endif // IRODS_REPLICATION_CHECKPOINT_HPP
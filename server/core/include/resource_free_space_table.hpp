@@ -0,0 +1,94 @@
+#ifndef IRODS_RESOURCE_FREE_SPACE_TABLE_HPP
+#define IRODS_RESOURCE_FREE_SPACE_TABLE_HPP
+
+/// \file
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <optional>
+
+namespace irods::experimental::resource::free_space_table
+{
+    /// A sample of the free space available to a resource's vault.
+    ///
+    /// \since 4.2.9
+    struct entry
+    {
+        /// The number of bytes available to unprivileged users.
+        std::uintmax_t free_space_in_bytes;
+
+        /// The seconds since epoch representing when the sample was taken.
+        std::int64_t sampled_at;
+    }; // struct entry
+
+    /// Initializes the resource free space table.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.2.9
+    auto init(const std::string_view _shm_name = "irods_resource_free_space_table",
+              std::size_t _shm_size = 500'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.2.9
+    auto deinit() noexcept -> void;
+
+    /// Inserts a new sample or replaces the existing sample for a resource.
+    ///
+    /// The sample is timestamped with the current time.
+    ///
+    /// \param[in] _resource_name       The name of the resource the sample belongs to.
+    /// \param[in] _free_space_in_bytes The number of bytes available in the resource's vault.
+    ///
+    /// \since 4.2.9
+    auto insert_or_assign(const std::string_view _resource_name, std::uintmax_t _free_space_in_bytes) -> void;
+
+    /// Returns the most recent sample for a resource if it is not older than \p _max_age.
+    ///
+    /// \param[in] _resource_name The name of the resource.
+    /// \param[in] _max_age       The maximum age of a sample before it is considered stale.
+    ///
+    /// \return An optional entry.
+    /// \retval entry        If a sample exists and it is not stale.
+    /// \retval std::nullopt Otherwise.
+    ///
+    /// \since 4.2.9
+    auto lookup(const std::string_view _resource_name, std::chrono::seconds _max_age) -> std::optional<entry>;
+
+    /// Removes the sample for a resource.
+    ///
+    /// \param[in] _resource_name The name of the resource.
+    ///
+    /// \since 4.2.9
+    auto erase(const std::string_view _resource_name) -> void;
+
+    /// Removes all samples from the table.
+    ///
+    /// \since 4.2.9
+    auto clear() -> void;
+
+    /// Returns the number of bytes available to unprivileged users for the filesystem
+    /// containing \p _vault_path.
+    ///
+    /// If \p _vault_path does not exist yet, the closest existing ancestor is sampled instead.
+    /// The root directory is never sampled.
+    ///
+    /// \param[in] _vault_path The path to the vault of a resource.
+    ///
+    /// \return An optional integer.
+    /// \retval std::uintmax_t If the filesystem could be sampled.
+    /// \retval std::nullopt   Otherwise.
+    ///
+    /// \since 4.2.9
+    auto sample_vault(const std::string_view _vault_path) -> std::optional<std::uintmax_t>;
+} // namespace irods::experimental::resource::free_space_table
+
+#endif // IRODS_RESOURCE_FREE_SPACE_TABLE_HPP
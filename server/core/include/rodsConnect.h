@@ -127,6 +127,10 @@ int getAndDisconnRcatHost(int rcatType,
 
 int disconnectAllSvrToSvrConn();
 
+// Like disconnectAllSvrToSvrConn, but hands idle connections to the server
+// connection broker. Must only be called once the agent has no request in flight.
+int releaseAllSvrToSvrConn();
+
 int svrReconnect(rsComm_t *rsComm);
 
 int getAndConnRemoteZone(rsComm_t *rsComm,
@@ -0,0 +1,67 @@
+#ifndef IRODS_RULE_EXECUTION_CONTEXT_HPP
+#define IRODS_RULE_EXECUTION_CONTEXT_HPP
+
+/// \file
+
+#include <string>
+#include <string_view>
+
+struct RuleExecInfo;
+
+/// The rule execution context is the part of the REI a delay rule needs in order to run:
+/// the rule name, the microservice parameters and the users it runs on behalf of. It is
+/// stored in r_rule_exec.exe_context.
+///
+/// Contexts were originally stored as JSON (see json_serialization.hpp). They are now
+/// stored in a compact, versioned binary encoding, which is several times smaller and
+/// decodes without building a document. Because exe_context is a text column, the binary
+/// encoding is stored in base64, behind a prefix identifying the encoding and its version.
+///
+/// Both encodings are accepted when decoding, so rows written before the binary encoding
+/// remain usable until the delay server migrates them.
+namespace irods::rule_execution_context
+{
+    /// The prefix of a binary context, followed by its version and a colon.
+    ///
+    /// \since 4.2.9
+    constexpr std::string_view prefix = "irods_rei:";
+
+    /// The version of the binary encoding produced by encode().
+    ///
+    /// \since 4.2.9
+    constexpr int version = 1;
+
+    /// Encodes the rule execution context of \p _rei.
+    ///
+    /// Only the members stored by irods::to_json(const RuleExecInfo*) are encoded.
+    ///
+    /// \param[in] _rei The rule execution information.
+    ///
+    /// \throws irods::exception If a microservice parameter cannot be encoded.
+    ///
+    /// \return The encoded context.
+    ///
+    /// \since 4.2.9
+    auto encode(const RuleExecInfo& _rei) -> std::string;
+
+    /// Checks whether \p _context uses the binary encoding (of any version).
+    ///
+    /// \since 4.2.9
+    auto is_binary(std::string_view _context) noexcept -> bool;
+
+    /// Decodes a rule execution context into a RuleExecInfo.
+    ///
+    /// \p _context may be a binary context or a JSON context. The caller owns the pointers
+    /// of the returned object (see freeRuleExecInfoInternals).
+    ///
+    /// \param[in] _context The encoded context.
+    ///
+    /// \throws irods::exception If the context is malformed or its version is not supported.
+    ///
+    /// \return The rule execution information.
+    ///
+    /// \since 4.2.9
+    auto decode(std::string_view _context) -> RuleExecInfo;
+} // namespace irods::rule_execution_context
+
+#endif // IRODS_RULE_EXECUTION_CONTEXT_HPP
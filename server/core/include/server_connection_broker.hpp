@@ -0,0 +1,81 @@
+#ifndef IRODS_SERVER_CONNECTION_BROKER_HPP
+#define IRODS_SERVER_CONNECTION_BROKER_HPP
+
+/// \file
+
+#include "rcConnect.h"
+
+#include <string_view>
+
+/// The server connection broker keeps authenticated server-to-server connections alive
+/// after the agent that opened them exits, so that later agents can reuse them instead
+/// of paying for the TCP handshake, negotiation and authentication again.
+///
+/// The broker is a process forked by the main server. Agents talk to it over a UNIX
+/// domain socket and the connections themselves are passed as file descriptors using
+/// SCM_RIGHTS, the same mechanism used to hand client sockets to the agent factory.
+///
+/// A pooled connection is bound to the peer (host and port) and to the proxy and client
+/// users it was authenticated for. Connections using SSL or the reconnect protocol are
+/// never pooled because their state lives in the process that created them.
+namespace irods::experimental::server_connection_broker
+{
+    /// Sets the path of the UNIX domain socket the broker listens on.
+    ///
+    /// This function must be called by the main server before the broker and the agent
+    /// factory are forked so that every agent inherits the path. Agents of a server that
+    /// never called this function always connect to peers directly.
+    ///
+    /// \param[in] _socket_file The path of the UNIX domain socket.
+    ///
+    /// \since 4.2.9
+    auto set_socket_file(std::string_view _socket_file) -> void;
+
+    /// Runs the broker until the main server exits or the broker receives SIGTERM.
+    ///
+    /// This function should only be called in the process forked for the broker.
+    ///
+    /// \return An integer representing the exit status of the broker.
+    ///
+    /// \since 4.2.9
+    auto run() -> int;
+
+    /// Asks the broker for an idle connection to a peer.
+    ///
+    /// \param[in] _host        The host name of the peer.
+    /// \param[in] _port        The port of the peer.
+    /// \param[in] _proxy_user  The user the connection was authenticated as.
+    /// \param[in] _client_user The user the connection acts on behalf of.
+    ///
+    /// \return A pointer to a logged in connection owned by the caller, or a null pointer
+    ///         if the broker is not available or has no idle connection matching the
+    ///         arguments.
+    ///
+    /// \since 4.2.9
+    auto lease(const char* _host,
+               int _port,
+               const userInfo_t& _proxy_user,
+               const userInfo_t& _client_user) -> rcComm_t*;
+
+    /// Hands a connection to the broker so that other agents can reuse it.
+    ///
+    /// The connection is only handed over if the peer answers a heartbeat, which proves
+    /// that no reply to an earlier request is still on its way. This function must only
+    /// be called once the session ended cleanly, never from a signal handler or an error
+    /// path.
+    ///
+    /// On success, the broker owns the connection. \p _conn is freed without notifying
+    /// the peer and must not be used again.
+    ///
+    /// \param[in] _conn The connection to hand over.
+    ///
+    /// \return A boolean.
+    /// \retval true  If the broker took ownership of the connection.
+    /// \retval false If the connection cannot be pooled or the broker refused it. The
+    ///               caller still owns the connection and must disconnect it.
+    ///
+    /// \since 4.2.9
+    auto release(rcComm_t* _conn) -> bool;
+} // namespace irods::experimental::server_connection_broker
+
+#endif // IRODS_SERVER_CONNECTION_BROKER_HPP
@@ -0,0 +1,113 @@
+#ifndef IRODS_SPECIAL_COLLECTION_INDEX_HPP
+#define IRODS_SPECIAL_COLLECTION_INDEX_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A server-wide index of the logical paths of all special collections (mounted,
+/// linked and struct file collections) in the local zone.
+///
+/// The index allows agents to answer "is this path inside a special collection?"
+/// without querying the catalog. Zones usually contain very few special collections
+/// while nearly every path-based API asks the question.
+///
+/// A negative answer is only safe if every change to the special collections of the zone
+/// is seen by the index. That holds on the catalog provider, where all such changes are
+/// written, so the index is only enabled there. Writers announce themselves through an
+/// update_guard for as long as their transaction is open. While any writer is active, and
+/// for every refresh that overlapped one, the index does not answer.
+namespace irods::experimental::special_collection_index
+{
+    /// Initializes the special collection index.
+    ///
+    /// This function should only be called on startup of the server, and only if the index
+    /// is enabled. When it is not called, enabled() returns false, lookup() always returns
+    /// std::nullopt and the other functions do nothing.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.2.9
+    auto init(const std::string_view _shm_name = "irods_special_collection_index",
+              std::size_t _shm_size = 1'000'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.2.9
+    auto deinit() noexcept -> void;
+
+    /// Returns whether init() was called by this process or the process it was forked from.
+    ///
+    /// \since 4.2.9
+    auto enabled() noexcept -> bool;
+
+    /// Returns the number of changes announced so far.
+    ///
+    /// Read this before querying the catalog for the special collections and pass it to
+    /// assign().
+    ///
+    /// \since 4.2.9
+    auto generation() -> std::uint64_t;
+
+    /// Replaces the contents of the index with \p _collections and marks the index as fresh.
+    ///
+    /// Nothing is stored if a change was announced since \p _generation was read or if a
+    /// writer is still active, because \p _collections may not reflect that change.
+    ///
+    /// \param[in] _collections The logical paths of every special collection in the zone.
+    /// \param[in] _generation  The value returned by generation() before the catalog was queried.
+    ///
+    /// \return A boolean indicating whether the index was updated.
+    ///
+    /// \since 4.2.9
+    auto assign(const std::vector<std::string>& _collections, std::uint64_t _generation) -> bool;
+
+    /// Marks the index as stale so that the next lookup forces a refresh.
+    ///
+    /// \since 4.2.9
+    auto invalidate() noexcept -> void;
+
+    /// Returns whether \p _path is a special collection or is inside one.
+    ///
+    /// \param[in] _path    An absolute logical path.
+    /// \param[in] _max_age The age at which the contents of the index are no longer trusted.
+    ///
+    /// \return An optional boolean.
+    /// \retval true         If \p _path or one of its ancestors is a special collection.
+    /// \retval false        If neither \p _path nor any of its ancestors is a special collection.
+    /// \retval std::nullopt If the index is not initialized, has been invalidated, is older
+    ///                      than \p _max_age or a writer is active. The caller must consult
+    ///                      the catalog.
+    ///
+    /// \since 4.2.9
+    auto lookup(const std::string_view _path, std::chrono::seconds _max_age) -> std::optional<bool>;
+
+    /// Announces a catalog change that may create, move or remove special collections.
+    ///
+    /// The index does not answer lookups from construction until destruction, and refreshes
+    /// that overlap this period are discarded. The guard must therefore outlive the commit or
+    /// rollback of the change. If the process dies while holding a guard, the announcement is
+    /// withdrawn by the next refresh.
+    ///
+    /// \since 4.2.9
+    class update_guard
+    {
+    public:
+        update_guard();
+        ~update_guard();
+
+        update_guard(const update_guard&) = delete;
+        auto operator=(const update_guard&) -> update_guard& = delete;
+    }; // class update_guard
+} // namespace irods::experimental::special_collection_index
+
+#endif // IRODS_SPECIAL_COLLECTION_INDEX_HPP
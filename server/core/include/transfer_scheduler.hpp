@@ -0,0 +1,137 @@
+#ifndef IRODS_TRANSFER_SCHEDULER_HPP
+#define IRODS_TRANSFER_SCHEDULER_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A server-wide scheduler for the parallel transfer streams opened by agents.
+///
+/// Agents register the streams of a parallel transfer in shared memory before telling the
+/// client how many to open, and report the bytes each stream moves. The scheduler limits
+/// the number of concurrent streams per user and in total, and throttles every user with a
+/// token bucket whose rate is a weighted share of the server bandwidth. This keeps a single
+/// user's parallel transfers from saturating the disks and network that interactive requests
+/// from other users depend on.
+///
+/// Only the streams of parallel (portal) transfers are scheduled. Agents are admitted as
+/// before, single-buffer transfers are not throttled, and weights are assigned per user only,
+/// not per group or resource.
+namespace irods::experimental::transfer_scheduler
+{
+    /// The limits enforced by the scheduler. A value of zero means unlimited.
+    ///
+    /// \since 4.2.9
+    struct config
+    {
+        /// The number of streams open at the same time across all agents.
+        std::int64_t maximum_number_of_streams = 0;
+
+        /// The number of streams a single user may have open at the same time.
+        std::int64_t maximum_number_of_streams_per_user = 0;
+
+        /// The bytes per second shared among all users with open streams in proportion to
+        /// their weights (see user_weights).
+        std::int64_t maximum_bytes_per_second = 0;
+
+        /// The bytes per second available to a single user.
+        std::int64_t maximum_bytes_per_second_per_user = 0;
+
+        /// The share of maximum_bytes_per_second of each user ("name#zone") relative to the
+        /// other users with open streams. Users not listed have a weight of 1.
+        std::map<std::string, std::int64_t> user_weights;
+    }; // struct config
+
+    /// Describes the activity of a single user.
+    ///
+    /// \since 4.2.9
+    struct user_statistics
+    {
+        /// The name of the user in the form "name#zone".
+        std::string user;
+
+        /// The number of streams the user currently has open.
+        std::int64_t active_streams;
+
+        /// The number of streams requested by the user that were not granted.
+        std::int64_t denied_streams;
+
+        /// The number of bytes moved by the user's streams. Only counted while a bandwidth
+        /// limit is set.
+        std::int64_t bytes_transferred;
+
+        /// The total time the user's streams were delayed.
+        std::chrono::nanoseconds time_throttled;
+    }; // struct user_statistics
+
+    /// Reads the scheduler configuration from server_config.json.
+    ///
+    /// \since 4.2.9
+    auto read_config() -> config;
+
+    /// Initializes the transfer scheduler.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    /// \param[in] _config   The limits to enforce.
+    ///
+    /// \since 4.2.9
+    auto init(const std::string_view _shm_name, std::size_t _shm_size, const config& _config) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.2.9
+    auto deinit() noexcept -> void;
+
+    /// Registers the streams of a parallel transfer for the calling process.
+    ///
+    /// A process runs at most one parallel transfer at a time, so any streams it registered
+    /// before are released first. At least one stream is always granted so that transfers
+    /// slow down rather than fail.
+    ///
+    /// \param[in] _user      The user the transfer is performed for, in the form "name#zone".
+    /// \param[in] _requested The number of streams the transfer would like to use.
+    ///
+    /// \return The number of streams the transfer may use, between 1 and \p _requested. All
+    ///         requested streams are granted, unscheduled, if the shared memory is exhausted.
+    ///
+    /// \since 4.2.9
+    auto acquire(const std::string_view _user, int _requested) -> int;
+
+    /// Releases the streams registered by the calling process.
+    ///
+    /// \since 4.2.9
+    auto release() noexcept -> void;
+
+    /// Accounts for \p _bytes moved by one of \p _user's streams.
+    ///
+    /// \param[in] _user  The user the transfer is performed for, in the form "name#zone".
+    /// \param[in] _bytes The number of bytes just moved.
+    ///
+    /// \return The time the stream should wait before moving more data. Zero if no bandwidth
+    ///         limit is set or the bytes could not be accounted for, e.g. because the shared
+    ///         memory is exhausted.
+    ///
+    /// \since 4.2.9
+    auto throttle(const std::string_view _user, std::int64_t _bytes) -> std::chrono::nanoseconds;
+
+    /// Returns the activity of every user known to the scheduler.
+    ///
+    /// Users without open streams are forgotten after five minutes without activity, or
+    /// earlier if the shared memory runs out.
+    ///
+    /// \since 4.2.9
+    auto statistics() -> std::vector<user_statistics>;
+} // namespace irods::experimental::transfer_scheduler
+
+#endif // IRODS_TRANSFER_SCHEDULER_HPP
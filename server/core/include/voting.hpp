@@ -5,6 +5,8 @@
 #include "irods_resource_plugin.hpp"
 #include "irods_resource_redirect.hpp"
 
+#include <chrono>
+#include <optional>
 #include <string_view>
 
 namespace irods::experimental::resource::voting {
@@ -22,6 +24,19 @@ float calculate(
     std::string_view curr_host,
     const irods::hierarchy_parser& parser);
 
+/// Returns the vote of a good replica on another host for opening it.
+///
+/// The vote falls from just below vote::high towards vote::low as the time needed to move
+/// the replica to this server grows, so a replica on this host (vote::high) always wins.
+///
+/// \param[in] _expected_transfer_time The estimate of network_topology::expected_transfer_time,
+///                                    or std::nullopt if the host is not in the topology.
+///
+/// \retval vote::medium If \p _expected_transfer_time is std::nullopt.
+///
+/// \since 4.2.9
+float calculate_for_expected_transfer_time(std::optional<std::chrono::microseconds> _expected_transfer_time);
+
 } // namespace irods::experimental::resource::voting
 
 #endif // VOTING_HPP
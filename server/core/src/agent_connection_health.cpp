@@ -0,0 +1,161 @@
+#include "agent_connection_health.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsLog.h"
+#include "shared_memory_object.hpp"
+
+#include <boost/any.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace irods::experimental::agent_connection_health
+{
+    namespace
+    {
+        namespace ipc = irods::experimental::interprocess;
+
+        //
+        // Global Variables
+        //
+
+        std::string g_shm_name;
+
+        // On initialization, holds the PID of the process that created the counters.
+        // This ensures that only the process that initialized the system can deinitialize it.
+        pid_t g_owner_pid;
+
+        // Agents inherit the mapping of the counters from the server.
+        std::unique_ptr<ipc::shared_memory_object<counters>> g_counters;
+
+        auto read_int(const std::unordered_map<std::string, boost::any>& _settings,
+                      const std::string& _key,
+                      int& _value,
+                      int _minimum = 0) -> void
+        {
+            if (const auto iter = _settings.find(_key); iter != std::end(_settings)) {
+                const auto value = boost::any_cast<int>(iter->second);
+
+                if (value >= _minimum) {
+                    _value = value;
+                    return;
+                }
+
+                rodsLog(LOG_ERROR, "Invalid value for agent connection health setting [%s=%d]. Using the default [%d].",
+                        _key.data(), value, _value);
+            }
+        } // read_int
+
+        template <typename Function>
+        auto update(Function _func) noexcept -> void
+        {
+            if (!g_counters) {
+                return;
+            }
+
+            try {
+                g_counters->atomic_exec(_func);
+            }
+            catch (...) {}
+        } // update
+    } // anonymous namespace
+
+    auto read_config() -> config
+    {
+        config cfg;
+
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto& settings = irods::get_advanced_setting<map_type&>(irods::CFG_AGENT_CONNECTION_HEALTH_KW);
+
+            read_int(settings, irods::CFG_TCP_KEEPALIVE_IDLE_IN_SECONDS_KW, cfg.tcp_keepalive.idle_in_seconds);
+            read_int(settings, irods::CFG_TCP_KEEPALIVE_INTERVAL_IN_SECONDS_KW, cfg.tcp_keepalive.interval_in_seconds);
+            read_int(settings, irods::CFG_TCP_KEEPALIVE_PROBES_KW, cfg.tcp_keepalive.probe_count);
+            read_int(settings, irods::CFG_TCP_USER_TIMEOUT_IN_MILLISECONDS_KW, cfg.tcp_keepalive.user_timeout_in_milliseconds);
+
+            // The timeout is handed to select(), which fails on negative values and returns
+            // immediately on zero.
+            read_int(settings, irods::CFG_IDLE_TIMEOUT_IN_SECONDS_KW, cfg.idle_timeout_in_seconds, 1);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Using the defaults.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_AGENT_CONNECTION_HEALTH_KW.data());
+        }
+
+        return cfg;
+    } // read_config
+
+    auto idle_timeout_in_seconds() -> int
+    {
+        static const int timeout = read_config().idle_timeout_in_seconds;
+        return timeout;
+    } // idle_timeout_in_seconds
+
+    auto init(const std::string_view _shm_name) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_shm_name = _shm_name.data();
+
+        // Counters left behind by a server that did not shut down cleanly start over.
+        boost::interprocess::shared_memory_object::remove(g_shm_name.data());
+
+        g_owner_pid = getpid();
+        g_counters = std::make_unique<ipc::shared_memory_object<counters>>(g_shm_name);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_counters) {
+                g_counters->remove();
+                g_counters.reset();
+            }
+        }
+        catch (...) {}
+    } // deinit
+
+    auto record_idle_session_reaped(bool _open_descriptors) noexcept -> void
+    {
+        update([_open_descriptors](counters& _counters) {
+            ++_counters.idle_sessions_reaped;
+
+            if (_open_descriptors) {
+                ++_counters.idle_sessions_reaped_with_open_descriptors;
+            }
+        });
+    } // record_idle_session_reaped
+
+    auto record_broken_connection() noexcept -> void
+    {
+        update([](counters& _counters) { ++_counters.broken_connections; });
+    } // record_broken_connection
+
+    auto record_heartbeat() noexcept -> void
+    {
+        update([](counters& _counters) { ++_counters.heartbeats_received; });
+    } // record_heartbeat
+
+    auto statistics() -> counters
+    {
+        if (!g_counters) {
+            return {};
+        }
+
+        return g_counters->atomic_exec([](const counters& _counters) { return _counters; });
+    } // statistics
+} // namespace irods::experimental::agent_connection_health
@@ -0,0 +1,404 @@
+#include "api_profiler.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_logger.hpp"
+#include "irods_server_properties.hpp"
+#include "irods_stacktrace.hpp"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+
+#include <boost/any.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace irods::experimental::api_profiler
+{
+    namespace
+    {
+        using log = irods::experimental::log;
+
+        // The signal handler and the trampoline that invoked it. These frames are the
+        // same for every sample and are not part of the profiled code.
+        constexpr int frames_to_skip = 2;
+
+        struct sample
+        {
+            int depth;
+            void* frames[maximum_stack_depth];
+        }; // struct sample
+
+        // The sample buffer is statically allocated so that the signal handler never
+        // allocates memory.
+        sample g_samples[maximum_number_of_samples];
+
+        std::atomic<std::size_t> g_next_sample{0};
+        std::atomic<int> g_handlers_in_flight{0};
+        std::atomic<bool> g_accepting_samples{false};
+        std::atomic<bool> g_sampler_active{false};
+
+        bool g_handler_installed = false;
+        timer_t g_timer_id;
+
+        struct configuration
+        {
+            std::set<int> api_numbers;
+            int sampling_frequency_in_hz = 99;
+            sampling_clock clock = sampling_clock::wall;
+            std::string output_directory = "/tmp";
+        }; // struct configuration
+
+        configuration g_config;
+
+        auto on_sigprof(int, siginfo_t*, void*) -> void
+        {
+            const auto saved_errno = errno;
+
+            ++g_handlers_in_flight;
+
+            if (g_accepting_samples.load()) {
+                if (const auto i = g_next_sample.fetch_add(1); i < maximum_number_of_samples) {
+                    auto& s = g_samples[i];
+                    s.depth = backtrace(s.frames, maximum_stack_depth);
+                }
+            }
+
+            --g_handlers_in_flight;
+
+            errno = saved_errno;
+        } // on_sigprof
+
+        auto install_signal_handler() -> void
+        {
+            if (g_handler_installed) {
+                return;
+            }
+
+            // backtrace() loads libgcc on first use, which is not async-signal-safe.
+            // Calling it here guarantees the library is loaded before the first signal.
+            void* frame;
+            backtrace(&frame, 1);
+
+            struct sigaction action{};
+            action.sa_sigaction = on_sigprof;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+
+            if (sigaction(SIGPROF, &action, nullptr) != 0) {
+                THROW(SYS_INTERNAL_ERR, fmt::format("Could not install SIGPROF handler [errno={}]", errno));
+            }
+
+            g_handler_installed = true;
+        } // install_signal_handler
+
+        auto replace_separators(std::string _name) -> std::string
+        {
+            // Semicolons separate frames in the folded format.
+            std::replace(std::begin(_name), std::end(_name), ';', ':');
+            return _name;
+        } // replace_separators
+
+        auto read_api_numbers(const std::unordered_map<std::string, boost::any>& _settings) -> std::set<int>
+        {
+            std::set<int> api_numbers;
+
+            for (const auto& n : boost::any_cast<const std::vector<boost::any>&>(_settings.at(CFG_API_NUMBERS_KW))) {
+                api_numbers.insert(boost::any_cast<int>(n));
+            }
+
+            return api_numbers;
+        } // read_api_numbers
+    } // anonymous namespace
+
+    sampler::sampler(int _frequency_in_hz, sampling_clock _clock)
+        : start_{}
+        , stop_{}
+        , running_{false}
+    {
+        if (g_sampler_active.exchange(true)) {
+            THROW(SYS_INTERNAL_ERR, "Another API profiler sampler is already active");
+        }
+
+        try {
+            install_signal_handler();
+
+            g_next_sample.store(0);
+
+            struct sigevent event{};
+            event.sigev_signo = SIGPROF;
+
+            clockid_t clock_id = CLOCK_PROCESS_CPUTIME_ID;
+            event.sigev_notify = SIGEV_SIGNAL;
+
+            if (sampling_clock::wall == _clock) {
+                // Elapsed time passes for every thread, so only the calling thread is
+                // signaled. Otherwise idle threads would dominate the profile.
+                clock_id = CLOCK_MONOTONIC;
+                event.sigev_notify = SIGEV_THREAD_ID;
+                event._sigev_un._tid = static_cast<pid_t>(syscall(SYS_gettid));
+            }
+
+            if (timer_create(clock_id, &event, &g_timer_id) != 0) {
+                THROW(SYS_INTERNAL_ERR, fmt::format("Could not create API profiler timer [errno={}]", errno));
+            }
+
+            const auto frequency = std::clamp(_frequency_in_hz, 1, maximum_sampling_frequency_in_hz);
+            const long interval_in_nanoseconds = 1'000'000'000L / frequency;
+
+            struct itimerspec spec{};
+            spec.it_interval.tv_sec = interval_in_nanoseconds / 1'000'000'000L;
+            spec.it_interval.tv_nsec = interval_in_nanoseconds % 1'000'000'000L;
+            spec.it_value = spec.it_interval;
+
+            g_accepting_samples.store(true);
+            start_ = std::chrono::steady_clock::now();
+
+            if (timer_settime(g_timer_id, 0, &spec, nullptr) != 0) {
+                g_accepting_samples.store(false);
+                timer_delete(g_timer_id);
+                THROW(SYS_INTERNAL_ERR, fmt::format("Could not start API profiler timer [errno={}]", errno));
+            }
+
+            running_ = true;
+        }
+        catch (...) {
+            g_sampler_active.store(false);
+            throw;
+        }
+    } // sampler
+
+    sampler::~sampler()
+    {
+        stop();
+        g_sampler_active.store(false);
+    } // ~sampler
+
+    auto sampler::stop() noexcept -> void
+    {
+        if (!running_) {
+            return;
+        }
+
+        stop_ = std::chrono::steady_clock::now();
+        running_ = false;
+
+        g_accepting_samples.store(false);
+        timer_delete(g_timer_id);
+
+        // A handler may still be writing a sample on another thread.
+        while (g_handlers_in_flight.load() > 0) {
+            std::this_thread::yield();
+        }
+    } // stop
+
+    auto sampler::sample_count() const noexcept -> std::size_t
+    {
+        return std::min(g_next_sample.load(), maximum_number_of_samples);
+    } // sample_count
+
+    auto sampler::dropped_sample_count() const noexcept -> std::size_t
+    {
+        const auto n = g_next_sample.load();
+        return n > maximum_number_of_samples ? n - maximum_number_of_samples : 0;
+    } // dropped_sample_count
+
+    auto sampler::elapsed() const noexcept -> std::chrono::microseconds
+    {
+        const auto end = running_ ? std::chrono::steady_clock::now() : stop_;
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
+    } // elapsed
+
+    auto sampler::folded_stacks() const -> std::map<std::string, std::size_t>
+    {
+        const auto count = sample_count();
+
+        // Every frame other than the interrupted one holds a return address, which may
+        // belong to the next function when the call is the last instruction. Stepping
+        // back one byte keeps the address inside the caller.
+        const auto address_of = [](const sample& _s, int _frame) -> void* {
+            auto* address = static_cast<char*>(_s.frames[_frame]);
+            return _frame == frames_to_skip ? address : address - 1;
+        };
+
+        // Resolve each distinct address once. Symbol resolution is the expensive part
+        // of producing the profile.
+        std::vector<void*> addresses;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            for (int f = frames_to_skip; f < g_samples[i].depth; ++f) {
+                addresses.push_back(address_of(g_samples[i], f));
+            }
+        }
+
+        std::sort(std::begin(addresses), std::end(addresses));
+        addresses.erase(std::unique(std::begin(addresses), std::end(addresses)), std::end(addresses));
+
+        const auto names = irods::stacktrace::resolve_function_names(addresses);
+
+        std::unordered_map<void*, std::string> name_of;
+        for (std::size_t i = 0; i < addresses.size(); ++i) {
+            name_of.emplace(addresses[i], replace_separators(names[i]));
+        }
+
+        std::map<std::string, std::size_t> stacks;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& s = g_samples[i];
+            std::string stack;
+
+            for (int f = s.depth - 1; f >= frames_to_skip; --f) {
+                if (!stack.empty()) {
+                    stack += ';';
+                }
+
+                stack += name_of.at(address_of(s, f));
+            }
+
+            if (!stack.empty()) {
+                ++stacks[stack];
+            }
+        }
+
+        return stacks;
+    } // folded_stacks
+
+    auto sampler::write_folded_stacks(std::ostream& _out) const -> void
+    {
+        for (const auto& [stack, count] : folded_stacks()) {
+            _out << stack << ' ' << count << '\n';
+        }
+    } // write_folded_stacks
+
+    auto init() noexcept -> void
+    {
+        g_config = {};
+
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto& settings = get_advanced_setting<map_type&>(CFG_API_PROFILER_KW);
+
+            g_config.api_numbers = read_api_numbers(settings);
+
+            if (const auto iter = settings.find(CFG_SAMPLING_FREQUENCY_IN_HZ_KW); iter != std::end(settings)) {
+                const auto hz = boost::any_cast<int>(iter->second);
+
+                if (hz > 0 && hz <= maximum_sampling_frequency_in_hz) {
+                    g_config.sampling_frequency_in_hz = hz;
+                }
+                else {
+                    rodsLog(LOG_ERROR, "Invalid sampling frequency for API profiler [hz=%d]. Using default [hz=%d].",
+                            hz, g_config.sampling_frequency_in_hz);
+                }
+            }
+
+            if (const auto iter = settings.find(CFG_SAMPLING_CLOCK_KW); iter != std::end(settings)) {
+                const auto& clock = boost::any_cast<const std::string&>(iter->second);
+
+                if ("cpu" == clock) {
+                    g_config.clock = sampling_clock::cpu;
+                }
+                else if ("wall" != clock) {
+                    rodsLog(LOG_ERROR, "Invalid sampling clock for API profiler [clock=%s]. Using default [clock=wall].",
+                            clock.data());
+                }
+            }
+
+            if (const auto iter = settings.find(CFG_OUTPUT_DIRECTORY_KW); iter != std::end(settings)) {
+                g_config.output_directory = boost::any_cast<const std::string&>(iter->second);
+            }
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. API profiling is disabled.",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_API_PROFILER_KW.data());
+            g_config = {};
+        }
+    } // init
+
+    auto is_enabled_for(int _api_number) noexcept -> bool
+    {
+        return g_config.api_numbers.count(_api_number) > 0;
+    } // is_enabled_for
+
+    scoped_api_profile::scoped_api_profile(int _api_number) noexcept
+        : api_number_{_api_number}
+        , sampler_{}
+    {
+        if (!is_enabled_for(_api_number)) {
+            return;
+        }
+
+        try {
+            sampler_ = std::make_unique<sampler>(g_config.sampling_frequency_in_hz, g_config.clock);
+        }
+        catch (const irods::exception& e) {
+            log::api::error({{"log_message", "Could not start API profiler"},
+                             {"api_number", std::to_string(_api_number)},
+                             {"error_message", e.client_display_what()}});
+        }
+        catch (...) {
+            log::api::error({{"log_message", "Could not start API profiler"},
+                             {"api_number", std::to_string(_api_number)}});
+        }
+    } // scoped_api_profile
+
+    scoped_api_profile::~scoped_api_profile()
+    {
+        if (!sampler_) {
+            return;
+        }
+
+        static std::size_t sequence = 0;
+
+        try {
+            sampler_->stop();
+
+            const auto path = boost::filesystem::path{g_config.output_directory} /
+                              fmt::format("irods_api_{}.{}.{}.folded", api_number_, getpid(), sequence++);
+
+            std::ofstream out{path.string()};
+
+            if (!out) {
+                log::api::error({{"log_message", "Could not open API profile for writing"},
+                                 {"path", path.string()}});
+                return;
+            }
+
+            sampler_->write_folded_stacks(out);
+
+            log::api::info({{"log_message", "Wrote API profile"},
+                            {"api_number", std::to_string(api_number_)},
+                            {"elapsed_in_microseconds", std::to_string(sampler_->elapsed().count())},
+                            {"sample_count", std::to_string(sampler_->sample_count())},
+                            {"dropped_sample_count", std::to_string(sampler_->dropped_sample_count())},
+                            {"path", path.string()}});
+        }
+        catch (...) {
+            log::api::error({{"log_message", "Could not write API profile"},
+                             {"api_number", std::to_string(api_number_)}});
+        }
+    } // ~scoped_api_profile
+
+    auto scoped_api_profile::stop() noexcept -> void
+    {
+        if (sampler_) {
+            sampler_->stop();
+        }
+    } // stop
+} // namespace irods::experimental::api_profiler
@@ -34,6 +34,8 @@
 #include "irods_file_object.hpp"
 
 #include <algorithm>
+#include <fstream>
+#include <vector>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
@@ -764,6 +766,45 @@ initDataObjInfoQuery( dataObjInp_t *dataObjInp, genQueryInp_t *genQueryInp,
     return qcondCnt;
 }
 
+/* chkSameFileContent - check whether two local files hold the same bytes.
+ *    return - 1 - the files are the same file or have the same content.
+ *             0 - the contents differ or a file could not be read.
+ */
+
+int
+chkSameFileContent( const char *filePath1, const char *filePath2 ) {
+    namespace fs = boost::filesystem;
+
+    boost::system::error_code ec;
+    if ( fs::equivalent( filePath1, filePath2, ec ) ) {
+        return 1;
+    }
+
+    const auto size1 = fs::file_size( filePath1, ec );
+    if ( ec || size1 != fs::file_size( filePath2, ec ) || ec ) {
+        return 0;
+    }
+
+    std::ifstream in1( filePath1, std::ios::binary );
+    std::ifstream in2( filePath2, std::ios::binary );
+    if ( !in1 || !in2 ) {
+        return 0;
+    }
+
+    std::vector<char> buf1( 64 * 1024 );
+    std::vector<char> buf2( buf1.size() );
+    while ( in1 && in2 ) {
+        in1.read( buf1.data(), buf1.size() );
+        in2.read( buf2.data(), buf2.size() );
+        if ( in1.gcount() != in2.gcount() ||
+                !std::equal( buf1.begin(), buf1.begin() + in1.gcount(), buf2.begin() ) ) {
+            return 0;
+        }
+    }
+
+    return in1.eof() && in2.eof() ? 1 : 0;
+}
+
 /* chkOrphanFile - check whether a filePath is a orphan file.
  *    return - 1 - the file is orphan.
  *             0 - 0 the file is not an orphan.
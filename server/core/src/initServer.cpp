@@ -136,11 +136,20 @@ namespace
         }
     } // finalize_replica_opened_for_create_or_write
 
-    void close_all_l1_descriptors(RsComm& _comm)
+    // Returns the number of descriptors that were still in use.
+    int close_all_l1_descriptors(RsComm& _comm)
     {
+        int in_use = 0;
+
         for (int fd = 3; fd < NUM_L1_DESC; ++fd) {
             auto& l1desc = L1desc[fd];
-            if (FD_INUSE != l1desc.inuseFlag || l1desc.l3descInx < 3) {
+            if (FD_INUSE != l1desc.inuseFlag) {
+                continue;
+            }
+
+            ++in_use;
+
+            if (l1desc.l3descInx < 3) {
                 continue;
             }
 
@@ -180,6 +189,8 @@ namespace
                 irods::log(e);
             }
         }
+
+        return in_use;
     } // close_all_l1_descriptors
 } // anonymous namespace
 
@@ -669,7 +680,7 @@ initAgent( int processType, rsComm_t *rsComm ) {
 }
 
 void
-cleanup() {
+cleanup( bool _pool_server_connections ) {
     std::string svc_role;
     irods::error ret = get_catalog_service_role(svc_role);
     if(!ret.ok()) {
@@ -677,11 +688,18 @@ cleanup() {
     }
 
     if (INITIAL_DONE == InitialState) {
-        close_all_l1_descriptors(*ThisComm);
+        const int open_descriptors = close_all_l1_descriptors(*ThisComm);
 
         irods::replica_state_table::deinit();
 
-        disconnectAllSvrToSvrConn();
+        // A session that still had data objects open did not end cleanly. Requests may
+        // be outstanding on its server-to-server connections, so they are never reused.
+        if ( _pool_server_connections && 0 == open_descriptors ) {
+            releaseAllSvrToSvrConn();
+        }
+        else {
+            disconnectAllSvrToSvrConn();
+        }
     }
 
     if( irods::CFG_SERVICE_ROLE_PROVIDER == svc_role ) {
@@ -28,6 +28,7 @@
 #include "server_utilities.hpp"
 #include "json_serialization.hpp"
 #include "json_deserialization.hpp"
+#include "rule_execution_context.hpp"
 #include "server_utilities.hpp"
 
 #include <boost/filesystem.hpp>
@@ -48,6 +49,7 @@
 #include <string>
 #include <string_view>
 #include <fstream>
+#include <unordered_set>
 
 // clang-format off
 namespace ix = irods::experimental;
@@ -59,6 +61,21 @@ using json   = nlohmann::json;
 namespace {
     static std::atomic_bool re_server_terminated{};
 
+    // The maximum number of JSON rule execution contexts rewritten per wake cycle.
+    constexpr int context_migration_batch_size = 1000;
+
+    // Tracks the migration of JSON rule execution contexts across wake cycles.
+    struct context_migration_state
+    {
+        // Rules whose context could not be migrated. They are not retried until the rule
+        // execution server restarts.
+        std::unordered_set<std::string> failed_rule_ids;
+
+        // Set once a full pass finds nothing left to migrate. New rules are always stored
+        // using the binary encoding, so the catalog does not need to be scanned again.
+        bool complete = false;
+    }; // struct context_migration_state
+
     void init_logger(
         const bool write_to_stdout,
         const bool enable_test_mode)
@@ -303,13 +320,13 @@ namespace {
 
         ix::key_value_proxy kvp{_inp.condInput};
 
-        // The rule execution context will be stored in the catalog as JSON in
-        // r_rule_exec.exe_context for migrated rules. If the rule has not been migrated,
+        // The rule execution context will be stored in the catalog in r_rule_exec.exe_context
+        // for migrated rules (see rule_execution_context.hpp). If the rule has not been migrated,
         // then the context information must be stored in an REI file.
         if (kvp.contains(RULE_EXECUTION_CONTEXT_KW) && !kvp[RULE_EXECUTION_CONTEXT_KW].value().empty()) {
-            rodsLog(LOG_DEBUG, "Inflating rule execution context from JSON string [rule_id=%s] ...", _inp.ruleExecId);
+            rodsLog(LOG_DEBUG, "Inflating rule execution context from catalog [rule_id=%s] ...", _inp.ruleExecId);
 
-            rei = irods::to_rule_execution_info(kvp[RULE_EXECUTION_CONTEXT_KW].value());
+            rei = irods::rule_execution_context::decode(kvp[RULE_EXECUTION_CONTEXT_KW].value());
             rei_ptr = &rei;
 
             // The nullptr and zero (0) represent the argument vector and its size (i.e. argv and argc).
@@ -384,7 +401,7 @@ namespace {
             migrate_rule_execution_context_into_catalog(_comm,
                                                         _inp.ruleExecId,
                                                         _inp.reiFilePath,
-                                                        irods::to_json(rei_and_arg->rei).dump());
+                                                        irods::rule_execution_context::encode(*rei_and_arg->rei));
         }
 
         if (strlen(_inp.exeFrequency) > 0) {
@@ -460,6 +477,96 @@ namespace {
         }
     }
 
+    // Rewrites rule execution contexts stored as JSON using the binary encoding. At most
+    // \p _batch_size rules are migrated per call, so that the migration proceeds in the
+    // background over several wake cycles instead of delaying rule execution.
+    //
+    // Rules that are queued for execution are skipped. They will be migrated on a later
+    // call if they are still in the catalog. Rules that fail to migrate are reported once
+    // and remembered in \p _state so that later calls skip them.
+    void migrate_json_rule_execution_contexts(rcComm_t& _comm,
+                                              irods::delay_queue& _queue,
+                                              const int _batch_size,
+                                              context_migration_state& _state) noexcept
+    {
+        if (_state.complete) {
+            return;
+        }
+
+        try {
+            int migrated = 0;
+            bool remaining = false;
+
+            const auto fail = [&_state](const std::string& _rule_id, int _ec) {
+                logger::delay_server::error("Cannot migrate rule execution context. The rule will not be "
+                                            "migrated until the server restarts [rule_id={}, error_code={}].",
+                                            _rule_id, _ec);
+                _state.failed_rule_ids.insert(_rule_id);
+            };
+
+            for (auto&& row : irods::query{&_comm, "SELECT RULE_EXEC_ID, RULE_EXEC_CONTEXT WHERE RULE_EXEC_CONTEXT like '{%'"}) {
+                const auto& rule_id = row[0];
+
+                if (_state.failed_rule_ids.count(rule_id) > 0) {
+                    continue;
+                }
+
+                if (re_server_terminated || migrated >= _batch_size) {
+                    remaining = true;
+                    break;
+                }
+
+                if (_queue.contains_rule_id(rule_id)) {
+                    remaining = true;
+                    continue;
+                }
+
+                ruleExecModInp_t input{};
+                rstrcpy(input.ruleId, rule_id.data(), NAME_LEN);
+
+                try {
+                    ruleExecInfo_t rei = irods::rule_execution_context::decode(row[1]);
+
+                    irods::at_scope_exit free_rei{[&rei] {
+                        freeRuleExecInfoInternals(&rei, FREE_MS_PARAM);
+                    }};
+
+                    addKeyVal(&input.condInput, RULE_EXECUTION_CONTEXT_KW, irods::rule_execution_context::encode(rei).data());
+                }
+                catch (const irods::exception& e) {
+                    fail(rule_id, e.code());
+                    continue;
+                }
+
+                const auto ec = rcRuleExecMod(&_comm, &input);
+                clearKeyVal(&input.condInput);
+
+                if (ec < 0) {
+                    fail(rule_id, ec);
+                    continue;
+                }
+
+                ++migrated;
+            }
+
+            if (migrated > 0) {
+                logger::delay_server::info("Migrated {} rule execution context(s) to the binary encoding.", migrated);
+            }
+
+            if (!remaining) {
+                _state.complete = true;
+                logger::delay_server::info("Migration of rule execution contexts complete [failed={}].",
+                                           _state.failed_rule_ids.size());
+            }
+        }
+        catch (const irods::exception& e) {
+            logger::delay_server::error("Failed to migrate rule execution contexts [error_code={}]: {}", e.code(), e.client_display_what());
+        }
+        catch (const std::exception& e) {
+            logger::delay_server::error("Failed to migrate rule execution contexts: {}", e.what());
+        }
+    }
+
     auto make_delay_queue_query_processor(
         irods::thread_pool& thread_pool,
         irods::delay_queue& queue) -> irods::query_processor<rcComm_t>
@@ -550,6 +657,7 @@ int main(int argc, char **argv)
 
     irods::thread_pool thread_pool{thread_count};
     irods::delay_queue queue;
+    context_migration_state context_migration;
 
     try {
         while(!re_server_terminated) {
@@ -573,6 +681,9 @@ int main(int argc, char **argv)
                         logger::delay_server::error("Executing delayed rule failed - [{}]::[{}]", code, msg);
                     }
                 }
+
+                logger::delay_server::trace("Migrating rule execution contexts ...");
+                migrate_json_rule_execution_contexts(query_conn, queue, context_migration_batch_size, context_migration);
             } catch(const irods::exception& e) {
                 irods::log(e);
             } catch(const std::exception& e) {
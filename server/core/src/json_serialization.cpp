@@ -133,10 +133,9 @@ namespace irods
         if (_p->inOutStruct) {
             if (_p->type) {
                 if (std::string_view{STR_MS_T} == _p->type) {
-                    auto* v = to_string(const_cast<msParam_t&>(*_p));
+                    // The string is owned by the parameter.
                     param["type"] = _p->type;
-                    param["in_out_struct"] = v;
-                    std::free(v);
+                    param["in_out_struct"] = to_string(const_cast<msParam_t&>(*_p));
                 }
                 else if (std::string_view{INT_MS_T} == _p->type) {
                     param["type"] = _p->type;
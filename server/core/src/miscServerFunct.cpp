@@ -25,6 +25,9 @@
 #include "sockComm.h"
 #include "modAccessControl.h"
 #include "rsDataObjOpen.hpp"
+#include "server_connection_broker.hpp"
+#include "transfer_compression.hpp"
+#include "transfer_scheduler.hpp"
 #include "rsDataObjClose.hpp"
 #include "rsDataObjLseek.hpp"
 #include "rsDataObjWrite.hpp"
@@ -36,9 +39,12 @@
 #include "rsFileClose.hpp"
 
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/scoped_thread.hpp>
+#include <boost/any.hpp>
 #include <boost/lexical_cast.hpp>
 #include <openssl/md5.h>
 
@@ -65,7 +71,9 @@ char *__loc1;
 #include "irods_random.hpp"
 #include "irods_resource_manager.hpp"
 #include "irods_default_paths.hpp"
+#include "irods_at_scope_exit.hpp"
 using leaf_bundle_t = irods::resource_manager::leaf_bundle_t;
+namespace tc = irods::experimental::transfer_compression;
 
 #include <iomanip>
 #include <fstream>
@@ -91,6 +99,65 @@ int _l3Close( rsComm_t *rsComm, int l3descInx ) {
     return rsFileClose( rsComm, &fileCloseInp );
 } // _l3Close
 
+// Returns the transfer header flags announcing the compression of a transfer. The data
+// is compressed if the client offered the codec configured in
+// advanced_settings.parallel_transfer_compression and the data object is large enough.
+int compression_flags( const char* offered, rodsLong_t dataSize ) {
+    try {
+        using settings_type = std::unordered_map<std::string, boost::any>;
+        const auto& settings = irods::get_advanced_setting<settings_type&>( irods::CFG_PARALLEL_TRANSFER_COMPRESSION_KW );
+
+        const auto& name = boost::any_cast<const std::string&>( settings.at( irods::CFG_CODEC_KW ) );
+        const auto configured = tc::to_codec( name );
+        if ( !configured ) {
+            rodsLog( LOG_ERROR, "compression_flags: unknown codec [%s]. Transfers are not compressed.", name.c_str() );
+            return 0;
+        }
+
+        int level = tc::minimum_level;
+        if ( const auto iter = settings.find( irods::CFG_LEVEL_KW ); iter != std::end( settings ) ) {
+            level = boost::any_cast<int>( iter->second );
+        }
+
+        if ( const auto iter = settings.find( irods::CFG_MINIMUM_DATA_SIZE_IN_BYTES_KW ); iter != std::end( settings ) ) {
+            if ( dataSize < boost::any_cast<int>( iter->second ) ) {
+                return 0;
+            }
+        }
+
+        return tc::to_flags( tc::negotiate( offered, *configured ), level );
+    }
+    catch ( const std::exception& ) {
+        rodsLog( LOG_DEBUG, "Could not read server configuration property [%s.%s]. Transfers are not compressed.",
+                 irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_PARALLEL_TRANSFER_COMPRESSION_KW.data() );
+        return 0;
+    }
+} // compression_flags
+
+void log_compression_stats( int oprType, const tc::statistics& stats ) {
+    if ( stats.frames == 0 ) {
+        return;
+    }
+
+    rodsLog( LOG_DEBUG,
+             "svrPortalPutGet: %s of %lld bytes transferred as %lld bytes, compression ratio %.2f, %lld of %lld frames sent uncompressed",
+             oprType == PUT_OPR ? "put" : "get", stats.raw_bytes, stats.wire_bytes, stats.ratio(),
+             stats.bypassed_frames, stats.frames );
+} // log_compression_stats
+
+// The name under which the transfer scheduler accounts for the streams of a client.
+std::string scheduler_user_name( const rsComm_t* rsComm ) {
+    return std::string{rsComm->clientUser.userName} + '#' + rsComm->clientUser.rodsZone;
+} // scheduler_user_name
+
+void throttle_stream( const std::string& user, rodsLong_t bytes ) {
+    namespace tsch = irods::experimental::transfer_scheduler;
+
+    if ( const auto delay = tsch::throttle( user, bytes ); delay.count() > 0 ) {
+        std::this_thread::sleep_for( delay );
+    }
+} // throttle_stream
+
 }
 
 int
@@ -105,6 +172,18 @@ svrToSvrConnectNoLogin( rsComm_t *rsComm, rodsServerHost_t *rodsServerHost ) {
         }
         else {
             reconnFlag = NO_RECONN;
+
+            // Reuse a connection another agent left with the connection broker.
+            userInfo_t proxyUser{};
+            rstrcpy( proxyUser.userName, rsComm->myEnv.rodsUserName, NAME_LEN );
+            rstrcpy( proxyUser.rodsZone, rsComm->myEnv.rodsZone, NAME_LEN );
+            rodsServerHost->conn = irods::experimental::server_connection_broker::lease(
+                                       rodsServerHost->hostName->name,
+                                       ( ( zoneInfo_t * ) rodsServerHost->zoneInfo )->portNum,
+                                       proxyUser, rsComm->clientUser );
+            if ( rodsServerHost->conn != NULL ) {
+                return rodsServerHost->localFlag;
+            }
         }
         rodsServerHost->conn = _rcConnect( rodsServerHost->hostName->name,
                                            ( ( zoneInfo_t * ) rodsServerHost->zoneInfo )->portNum,
@@ -187,6 +266,13 @@ setupSrvPortalForParaOpr( rsComm_t *rsComm, dataOprInp_t *dataOprInp,
                                       &dataOprInp->condInput,
                                       //getValByKey (&dataOprInp->condInput, RESC_NAME_KW), NULL);
                                       getValByKey( &dataOprInp->condInput,  RESC_HIER_STR_KW ), NULL, oprType );
+
+        // The streams stay registered until svrPortalPutGet completes, or are released
+        // below if the portal cannot be set up.
+        if ( myDataObjPutOut->numThreads > 0 ) {
+            myDataObjPutOut->numThreads = irods::experimental::transfer_scheduler::acquire(
+                                              scheduler_user_name( rsComm ), myDataObjPutOut->numThreads );
+        }
     }
 
     if ( myDataObjPutOut->numThreads == 0 ) {
@@ -199,6 +285,7 @@ setupSrvPortalForParaOpr( rsComm_t *rsComm, dataOprInp_t *dataOprInp,
             const auto svr_port_range_end = irods::get_server_property<const int>(irods::CFG_SERVER_PORT_RANGE_END_KW);
             port_range_count = svr_port_range_end - svr_port_range_start + 1;
         } catch ( irods::exception& e ) {
+            irods::experimental::transfer_scheduler::release();
             return e.code();
         }
 
@@ -215,6 +302,7 @@ setupSrvPortalForParaOpr( rsComm_t *rsComm, dataOprInp_t *dataOprInp,
                      "setupSrvPortalForParaOpr: createSrvPortal error, status = %d",
                      portalSock );
             myDataObjPutOut->status = portalSock;
+            irods::experimental::transfer_scheduler::release();
             return portalSock;
         }
         rsComm->portalOpr = ( portalOpr_t * ) malloc( sizeof( portalOpr_t ) );
@@ -423,6 +511,8 @@ svrPortalPutGet( rsComm_t *rsComm ) {
     int flags = 0;
     int retVal = 0;
 
+    const irods::at_scope_exit release_streams{[] { irods::experimental::transfer_scheduler::release(); }};
+
     myPortalOpr = rsComm->portalOpr;
 
     if ( myPortalOpr == NULL ) {
@@ -449,6 +539,10 @@ svrPortalPutGet( rsComm_t *rsComm ) {
         flags |= STREAMING_FLAG;
     }
 
+    if ( const char* codecs = getValByKey( &dataOprInp->condInput, TRANSFER_COMPRESSION_KW ) ) {
+        flags |= compression_flags( codecs, dataOprInp->dataSize );
+    }
+
     numThreads = dataOprInp->numThreads;
 
     if ( numThreads <= 0 || numThreads > MAX_NUM_CONFIG_TRAN_THR ) {
@@ -498,6 +592,8 @@ svrPortalPutGet( rsComm_t *rsComm ) {
             partialDataGet( &myInput[0] );
         }
 
+        log_compression_stats( oprType, myInput[0].compression_stats );
+
         CLOSE_SOCK( lsock );
 
         return myInput[0].status;
@@ -559,14 +655,17 @@ svrPortalPutGet( rsComm_t *rsComm ) {
             tid[0].reset( new boost::thread( partialDataGet, &myInput[0] ) );
         }
 
+        tc::statistics compression_stats{};
         for ( i = 0; i < numThreads; i++ ) {
             if ( tid[i] != 0 ) {
                 tid[i]->join();
             }
+            compression_stats += myInput[i].compression_stats;
             if ( myInput[i].status < 0 ) {
                 retVal = myInput[i].status;
             }
         } // for i
+        log_compression_stats( oprType, compression_stats );
         CLOSE_SOCK( lsock );
         return retVal;
 
@@ -684,24 +783,22 @@ partialDataPut( portalTransferInp_t *myInput ) {
             &myInput->shared_secret[iv_size] );
     }
 
-    int chunk_size;
-    try {
-        chunk_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_CHUNK_SIZE_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int chunk_size = irods::get_server_configuration().transfer_chunk_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
-    int trans_buff_size = 0;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     buf = ( unsigned char* )malloc( ( 2 * trans_buff_size ) + sizeof( unsigned char ) );
 
+    const auto user_name = scheduler_user_name( myInput->rsComm );
+
+    // =-=-=-=-=-=-=-
+    // the client sends compressed frames if the flags announce them
+    const bool decompress_flg =
+        ( tc::codec_from_flags( myInput->flags ) != tc::codec::none );
+    tc::decoder decompressor;
+    std::vector<unsigned char> frame;
+    std::vector<unsigned char> raw;
+
     while ( bytesToGet > 0 ) {
         int toread0;
         int bytesRead;
@@ -755,14 +852,28 @@ partialDataPut( portalTransferInp_t *myInput ) {
                     break;
                 }
             }
+            else if ( decompress_flg ) {
+                // =-=-=-=-=-=-=-
+                // without encryption, a frame carries the size of its payload
+                myInput->status = readFrame( srcFd, toread0, frame );
+                if ( myInput->status < 0 ) {
+                    break;
+                }
+                new_size = frame.size();
+            }
 
             // =-=-=-=-=-=-=-
             // now read the provided number of bytes as suggested by the incoming size
-            bytesRead = myRead(
-                            srcFd,
-                            buf,
-                            new_size,
-                            NULL, NULL );
+            if ( !decompress_flg || use_encryption_flg ) {
+                bytesRead = myRead(
+                                srcFd,
+                                buf,
+                                new_size,
+                                NULL, NULL );
+            }
+            else {
+                bytesRead = new_size;
+            }
 
             if ( bytesRead == new_size ) {
                 // =-=-=-=-=-=-=-
@@ -795,10 +906,25 @@ partialDataPut( portalTransferInp_t *myInput ) {
 
                 }
 
+                // =-=-=-=-=-=-=-
+                // decompress the frame before writing
+                unsigned char* out_buf = buf;
+                if ( decompress_flg ) {
+                    if ( use_encryption_flg ) {
+                        frame.assign( &buf[0], &buf[ plain_size ] );
+                    }
+                    myInput->status = decodeFrame( decompressor, frame, toread0, raw );
+                    if ( myInput->status < 0 ) {
+                        break;
+                    }
+                    plain_size = raw.size();
+                    out_buf = raw.data();
+                }
+
                 if ( ( bytesWritten = _l3Write(
                                           myInput->rsComm,
                                           destL3descInx,
-                                          buf,
+                                          out_buf,
                                           plain_size ) ) != ( plain_size ) ) {
                     rodsLog( LOG_NOTICE,
                              "_partialDataPut:Bytes written %d don't match read %d",
@@ -816,6 +942,8 @@ partialDataPut( portalTransferInp_t *myInput ) {
                 toread0    -= bytesWritten;
                 myOffset   += bytesWritten;
 
+                throttle_stream( user_name, bytesWritten );
+
             }
             else if ( bytesRead < 0 ) {
                 myInput->status = bytesRead;
@@ -835,6 +963,8 @@ partialDataPut( portalTransferInp_t *myInput ) {
         }
     }           /* while loop bytesToGet */
 
+    myInput->compression_stats = decompressor.stats();
+
     free( buf );
 
     applyRuleForSvrPortal( srcFd, PUT_OPR, 1, myOffset - myInput->offset, myInput->rsComm );
@@ -910,26 +1040,22 @@ void partialDataGet(
             &myInput->shared_secret[iv_size] );
     }
 
-    int trans_buff_size = 0;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     size_t buf_size = ( 2 * trans_buff_size ) * sizeof( unsigned char ) ;
     unsigned char * buf = ( unsigned char* )malloc( buf_size );
 
     bytesToGet = myInput->size;
 
-    int chunk_size;
-    try {
-        chunk_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_CHUNK_SIZE_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int chunk_size = irods::get_server_configuration().transfer_chunk_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
+
+    const auto user_name = scheduler_user_name( myInput->rsComm );
+
+    // =-=-=-=-=-=-=-
+    // send compressed frames if the flags announce them
+    const tc::codec codec = tc::codec_from_flags( myInput->flags );
+    tc::encoder compressor{codec, tc::level_from_flags( myInput->flags )};
+    std::vector<unsigned char> frame;
 
     while ( bytesToGet > 0 ) {
         int toread0;
@@ -974,10 +1100,29 @@ void partialDataGet(
 
 
             if ( bytesRead == toread1 ) {
+                // =-=-=-=-=-=-=-
+                // compress the buffer into a frame, which is then
+                // encrypted like a plain buffer
+                int new_size = bytesRead;
+                if ( codec != tc::codec::none ) {
+                    try {
+                        new_size = compressor.encode( buf, bytesRead, frame );
+                    }
+                    catch ( const irods::exception& e ) {
+                        irods::log( e );
+                        myInput->status = e.code();
+                        break;
+                    }
+
+                    std::copy(
+                        frame.begin(),
+                        frame.end(),
+                        &buf[0] );
+                }
+
                 // =-=-=-=-=-=-=-
                 // compute an iv for this particular transmission and use
                 // it to encrypt this buffer
-                int new_size = bytesRead;
                 if ( use_encryption_flg ) {
                     irods::error ret = crypt.initialization_vector( iv );
                     if ( !ret.ok() ) {
@@ -990,7 +1135,7 @@ void partialDataGet(
                     // encrypt
                     in_buf.assign(
                         &buf[0],
-                        &buf[ bytesRead ] );
+                        &buf[ new_size ] );
 
                     ret = crypt.encrypt(
                               shared_secret,
@@ -1056,6 +1201,7 @@ void partialDataGet(
                 toread0    -= bytesRead;
                 myOffset   += bytesRead;
 
+                throttle_stream( user_name, bytesRead );
             }
             else if ( bytesRead < 0 ) {
                 myInput->status = bytesRead;
@@ -1075,6 +1221,8 @@ void partialDataGet(
         }
     }           /* while loop bytesToGet */
 
+    myInput->compression_stats = compressor.stats();
+
     free( buf );
 
     applyRuleForSvrPortal( destFd, GET_OPR, 1, myOffset - myInput->offset, myInput->rsComm );
@@ -1138,13 +1286,7 @@ remToLocPartialCopy( portalTransferInp_t *myInput ) {
             &myInput->shared_secret[iv_size] );
     }
 
-    int trans_buff_size;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     buf = ( unsigned char* )malloc( ( 2 * trans_buff_size ) * sizeof( unsigned char ) );
 
@@ -1675,13 +1817,7 @@ sameHostPartialCopy( portalTransferInp_t *myInput ) {
         }
     }
 
-    int trans_buff_size;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     buf = malloc( trans_buff_size );
 
@@ -1791,13 +1927,7 @@ void locToRemPartialCopy(portalTransferInp_t *myInput)
 
     }
 
-    int trans_buff_size;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return;
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     buf = ( unsigned char* )malloc( 2 * trans_buff_size * sizeof( unsigned char ) );
 
@@ -2532,13 +2662,7 @@ singleRemToLocCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
         return SYS_INTERNAL_NULL_INPUT_ERR;
     }
 
-    int trans_buff_size;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return e.code();
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     dataOprInp = &dataCopyInp->dataOprInp;
     l1descInx = dataCopyInp->portalOprOut.l1descInx;
@@ -2596,13 +2720,7 @@ singleLocToRemCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
         return SYS_INTERNAL_NULL_INPUT_ERR;
     }
 
-    int trans_buff_size;
-    try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return e.code();
-    }
+    int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes * 1024 * 1024;
 
     dataOprInp = &dataCopyInp->dataOprInp;
     l1descInx = dataCopyInp->portalOprOut.l1descInx;
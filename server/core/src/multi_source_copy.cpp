@@ -0,0 +1,287 @@
+#include "multi_source_copy.hpp"
+
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace irods::experimental::multi_source_copy
+{
+    namespace
+    {
+        struct block
+        {
+            std::int64_t offset;
+            std::vector<char> data;
+        }; // struct block
+
+        class copy_state
+        {
+        public:
+            copy_state(std::int64_t _offset, std::int64_t _size, int _block_size, std::size_t _number_of_sources)
+                : size_{_size}
+                , block_size_{_block_size}
+                , capacity_{2 * _number_of_sources}
+                , next_offset_{_offset}
+                , running_{_number_of_sources}
+            {
+            }
+
+            // Returns the offset of the next block to read, or a negative value when there is
+            // nothing left to read. Blocks given up by failed sources are handed out first. While
+            // other sources still hold blocks, this waits in case one of them gives its block up.
+            auto claim() -> std::int64_t
+            {
+                std::unique_lock lk{mutex_};
+
+                while (true) {
+                    if (stop_) {
+                        return -1;
+                    }
+
+                    if (!retry_.empty()) {
+                        const auto offset = retry_.front();
+                        retry_.pop_front();
+                        ++in_flight_;
+                        return offset;
+                    }
+
+                    if (next_offset_ < size_) {
+                        const auto offset = next_offset_;
+                        next_offset_ += block_size_;
+                        ++in_flight_;
+                        return offset;
+                    }
+
+                    if (0 == in_flight_) {
+                        return -1;
+                    }
+
+                    work_.wait(lk);
+                }
+            } // claim
+
+            auto complete() -> void
+            {
+                std::scoped_lock lk{mutex_};
+                --in_flight_;
+                work_.notify_all();
+            } // complete
+
+            auto length_of(std::int64_t _offset) const noexcept -> int
+            {
+                return static_cast<int>(std::min<std::int64_t>(block_size_, size_ - _offset));
+            } // length_of
+
+            // Blocks while the queue is full. Returns false if the copy was stopped.
+            auto push(block&& _block) -> bool
+            {
+                std::unique_lock lk{mutex_};
+
+                not_full_.wait(lk, [this] { return stop_ || queue_.size() < capacity_; });
+
+                if (stop_) {
+                    return false;
+                }
+
+                queue_.push_back(std::move(_block));
+                not_empty_.notify_one();
+
+                return true;
+            } // push
+
+            // Blocks until a block is available. Returns false once all sources are done.
+            auto pop(block& _block) -> bool
+            {
+                std::unique_lock lk{mutex_};
+
+                not_empty_.wait(lk, [this] { return !queue_.empty() || 0 == running_; });
+
+                if (queue_.empty()) {
+                    return false;
+                }
+
+                _block = std::move(queue_.front());
+                queue_.pop_front();
+                not_full_.notify_one();
+
+                return true;
+            } // pop
+
+            auto give_up(std::int64_t _offset, int _error) -> void
+            {
+                std::scoped_lock lk{mutex_};
+                retry_.push_back(_offset);
+                --in_flight_;
+                source_error_ = _error;
+                work_.notify_all();
+            } // give_up
+
+            auto source_finished() -> void
+            {
+                std::scoped_lock lk{mutex_};
+                --running_;
+                not_empty_.notify_all();
+            } // source_finished
+
+            auto stop() -> void
+            {
+                std::scoped_lock lk{mutex_};
+                stop_ = true;
+                not_full_.notify_all();
+                work_.notify_all();
+            } // stop
+
+            auto source_error() -> int
+            {
+                std::scoped_lock lk{mutex_};
+                return source_error_;
+            } // source_error
+
+        private:
+            const std::int64_t size_;
+            const int block_size_;
+            const std::size_t capacity_;
+
+            std::mutex mutex_;
+            std::condition_variable not_full_;
+            std::condition_variable not_empty_;
+            std::condition_variable work_;
+            std::deque<block> queue_;
+            std::deque<std::int64_t> retry_;
+            std::int64_t next_offset_;
+            std::size_t in_flight_ = 0;
+            std::size_t running_;
+            int source_error_ = 0;
+            bool stop_ = false;
+        }; // class copy_state
+
+        auto read_block(const read_function& _read, std::int64_t _offset, char* _buffer, int _count) -> int
+        {
+            int total = 0;
+
+            while (total < _count) {
+                const int n = _read(_offset + total, _buffer + total, _count - total);
+
+                if (n < 0) {
+                    return n;
+                }
+
+                if (0 == n) {
+                    return SYS_COPY_LEN_ERR;
+                }
+
+                total += n;
+            }
+
+            return total;
+        } // read_block
+
+        auto run_source(const read_function& _read, copy_state& _state) -> void
+        {
+            for (auto offset = _state.claim(); offset >= 0; offset = _state.claim()) {
+                block b{offset, std::vector<char>(_state.length_of(offset))};
+
+                if (const int ec = read_block(_read, offset, b.data.data(), static_cast<int>(b.data.size())); ec < 0) {
+                    // Leave the block to the remaining sources and stop using this one.
+                    _state.give_up(offset, ec);
+                    break;
+                }
+
+                const bool pushed = _state.push(std::move(b));
+                _state.complete();
+
+                if (!pushed) {
+                    break;
+                }
+            }
+
+            _state.source_finished();
+        } // run_source
+    } // anonymous namespace
+
+    auto copy(const std::vector<read_function>& _sources,
+              const write_function& _sink,
+              std::int64_t _size,
+              int _block_size) -> int
+    {
+        return copy(_sources, _sink, 0, _size, _block_size, {});
+    } // copy
+
+    auto copy(const std::vector<read_function>& _sources,
+              const write_function& _sink,
+              std::int64_t _offset,
+              std::int64_t _size,
+              int _block_size,
+              const progress_function& _progress) -> int
+    {
+        if (_sources.empty() || _offset < 0 || _size < _offset || _block_size <= 0) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        copy_state state{_offset, _size, _block_size, _sources.size()};
+
+        std::vector<std::thread> readers;
+        readers.reserve(_sources.size());
+
+        for (const auto& source : _sources) {
+            readers.emplace_back(run_source, std::cref(source), std::ref(state));
+        }
+
+        int sink_error = 0;
+        std::int64_t written = 0;
+
+        // The end of the range written without gaps, and the blocks written beyond it.
+        std::int64_t contiguous_end = _offset;
+        std::set<std::int64_t> pending;
+
+        for (block b; state.pop(b);) {
+            const int count = static_cast<int>(b.data.size());
+
+            if (const int n = _sink(b.offset, b.data.data(), count); n != count) {
+                sink_error = n < 0 ? n : SYS_COPY_LEN_ERR;
+                state.stop();
+                break;
+            }
+
+            written += count;
+
+            if (b.offset != contiguous_end) {
+                pending.insert(b.offset);
+                continue;
+            }
+
+            contiguous_end += count;
+
+            for (auto iter = pending.begin(); iter != pending.end() && *iter == contiguous_end; iter = pending.erase(iter)) {
+                contiguous_end += state.length_of(contiguous_end);
+            }
+
+            if (_progress) {
+                _progress(contiguous_end);
+            }
+        }
+
+        // Wake readers blocked on a full queue or waiting for work after the sink failed.
+        state.stop();
+
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        if (sink_error < 0) {
+            return sink_error;
+        }
+
+        if (written != _size - _offset) {
+            const int ec = state.source_error();
+            return ec < 0 ? ec : SYS_COPY_LEN_ERR;
+        }
+
+        return 0;
+    } // copy
+} // namespace irods::experimental::multi_source_copy
@@ -0,0 +1,474 @@
+#include "network_topology.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_exception.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsDef.h"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+
+#include <boost/any.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace irods::experimental::network_topology
+{
+    namespace
+    {
+        namespace bi = boost::interprocess;
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        using std::chrono::seconds;
+
+        // clang-format off
+        using segment_manager_type = bi::managed_shared_memory::segment_manager;
+        using void_allocator_type  = bi::allocator<void, segment_manager_type>;
+        using char_allocator_type  = bi::allocator<char, segment_manager_type>;
+        using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+        using clock_type           = std::chrono::system_clock;
+        using settings_type        = std::unordered_map<std::string, boost::any>;
+        // clang-format on
+
+        struct sample
+        {
+            std::int64_t round_trip_time_in_microseconds;
+            std::int64_t sampled_at;
+        }; // struct sample
+
+        using value_type           = std::pair<const key_type, sample>;
+        using value_allocator_type = bi::allocator<value_type, segment_manager_type>;
+        using map_type             = bi::map<key_type, sample, std::less<key_type>, value_allocator_type>;
+
+        //
+        // Global Variables
+        //
+
+        std::string g_segment_name;
+        std::size_t g_segment_size;
+        std::string g_mutex_name;
+
+        // On initialization, holds the PID of the process that initialized the table.
+        // This ensures that only the process that initialized the system can deinitialize it.
+        pid_t g_owner_pid;
+
+        std::unique_ptr<bi::managed_shared_memory> g_segment;
+        std::unique_ptr<void_allocator_type> g_allocator;
+        std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+        map_type* g_map;
+
+        auto current_timestamp_in_seconds() noexcept -> std::int64_t
+        {
+            return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+        } // current_timestamp_in_seconds
+
+        // The round trip time assumed between two hosts that have not been measured.
+        auto default_round_trip_time(proximity _proximity) noexcept -> microseconds
+        {
+            switch (_proximity) {
+                case proximity::same_host:   return microseconds{0};
+                case proximity::same_rack:   return microseconds{200};
+                case proximity::same_site:   return microseconds{500};
+                case proximity::remote_site: return microseconds{30'000};
+                default:                     return microseconds{0};
+            }
+        } // default_round_trip_time
+
+        auto find_location(const config& _config, std::string_view _host) -> const host_location*
+        {
+            const auto end = std::end(_config.hosts);
+            const auto iter = std::find_if(std::begin(_config.hosts), end, [_host](const host_location& _l) {
+                return _l.host == _host;
+            });
+
+            return iter == end ? nullptr : &*iter;
+        } // find_location
+
+        auto read_positive_int(const settings_type& _settings, const std::string& _key, std::int64_t _default) -> std::int64_t
+        {
+            if (const auto iter = _settings.find(_key); iter != std::end(_settings)) {
+                const auto* value = boost::any_cast<int>(&iter->second);
+
+                if (value && *value > 0) {
+                    return *value;
+                }
+
+                rodsLog(LOG_ERROR, "Invalid value for network topology setting [%s]. Expected a positive integer. Using default [%s=%lld].",
+                        _key.data(), _key.data(), static_cast<long long>(_default));
+            }
+
+            return _default;
+        } // read_positive_int
+
+        // Returns the string stored under _key in the _index'th entry of the hosts, or nullptr
+        // after logging an error naming the key.
+        auto read_host_string(const settings_type& _entry, std::size_t _index, const std::string& _key) -> const std::string*
+        {
+            if (const auto iter = _entry.find(_key); iter != std::end(_entry)) {
+                if (const auto* value = boost::any_cast<std::string>(&iter->second); value) {
+                    return value;
+                }
+            }
+
+            rodsLog(LOG_ERROR, "Invalid network topology setting [%s[%zu].%s]. Expected a string. Ignoring host.",
+                    irods::CFG_HOSTS_KW.data(), _index, _key.data());
+
+            return nullptr;
+        } // read_host_string
+
+        auto read_hosts(const settings_type& _settings) -> std::vector<host_location>
+        {
+            std::vector<host_location> hosts;
+
+            const auto iter = _settings.find(irods::CFG_HOSTS_KW);
+
+            if (iter == std::end(_settings)) {
+                return hosts;
+            }
+
+            const auto* entries = boost::any_cast<std::vector<boost::any>>(&iter->second);
+
+            if (!entries) {
+                rodsLog(LOG_ERROR, "Invalid network topology setting [%s]. Expected an array. Replicas are not ranked by network distance.",
+                        irods::CFG_HOSTS_KW.data());
+                return hosts;
+            }
+
+            // An invalid host is left out rather than discarding the whole topology. Replicas on
+            // it keep the vote they would have without a topology.
+            for (std::size_t i = 0; i < entries->size(); ++i) {
+                const auto* entry = boost::any_cast<settings_type>(&(*entries)[i]);
+
+                if (!entry) {
+                    rodsLog(LOG_ERROR, "Invalid network topology setting [%s[%zu]]. Expected an object. Ignoring host.",
+                            irods::CFG_HOSTS_KW.data(), i);
+                    continue;
+                }
+
+                const auto* host = read_host_string(*entry, i, irods::CFG_HOST_KW);
+                const auto* site = host ? read_host_string(*entry, i, irods::CFG_SITE_KW) : nullptr;
+
+                if (!site) {
+                    continue;
+                }
+
+                host_location location{*host, *site, {}};
+
+                if (entry->count(irods::CFG_RACK_KW) > 0) {
+                    const auto* rack = read_host_string(*entry, i, irods::CFG_RACK_KW);
+
+                    if (!rack) {
+                        continue;
+                    }
+
+                    location.rack = *rack;
+                }
+
+                hosts.push_back(std::move(location));
+            }
+
+            return hosts;
+        } // read_hosts
+
+        // Closes the socket when it goes out of scope.
+        struct socket_guard
+        {
+            int fd;
+
+            ~socket_guard()
+            {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+        }; // struct socket_guard
+
+        auto wait_for(int _fd, short _events, std::chrono::milliseconds _timeout) -> bool
+        {
+            pollfd p{_fd, _events, 0};
+
+            int ec;
+            while ((ec = poll(&p, 1, static_cast<int>(_timeout.count()))) < 0 && EINTR == errno);
+
+            return ec > 0 && (p.revents & _events);
+        } // wait_for
+
+        auto connect_to(const std::string& _host, int _port, std::chrono::milliseconds _timeout) -> int
+        {
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+
+            addrinfo* results = nullptr;
+            if (getaddrinfo(_host.c_str(), std::to_string(_port).c_str(), &hints, &results) != 0) {
+                return -1;
+            }
+
+            std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> free_results{results, freeaddrinfo};
+
+            for (auto* ai = results; ai; ai = ai->ai_next) {
+                const int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK, ai->ai_protocol);
+
+                if (fd < 0) {
+                    continue;
+                }
+
+                if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+                    return fd;
+                }
+
+                if (EINPROGRESS == errno && wait_for(fd, POLLOUT, _timeout)) {
+                    int error = 0;
+                    socklen_t length = sizeof(error);
+
+                    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && 0 == error) {
+                        return fd;
+                    }
+                }
+
+                close(fd);
+            }
+
+            return -1;
+        } // connect_to
+    } // anonymous namespace
+
+    auto read_config() -> config
+    {
+        config cfg;
+
+        try {
+            const auto& settings = irods::get_advanced_setting<settings_type&>(irods::CFG_NETWORK_TOPOLOGY_KW);
+
+            constexpr std::int64_t megabyte = 1024 * 1024;
+
+            cfg.hosts = read_hosts(settings);
+
+            // clang-format off
+            cfg.same_rack_bytes_per_second   = megabyte * read_positive_int(settings, irods::CFG_SAME_RACK_MEGABYTES_PER_SECOND_KW, cfg.same_rack_bytes_per_second / megabyte);
+            cfg.same_site_bytes_per_second   = megabyte * read_positive_int(settings, irods::CFG_SAME_SITE_MEGABYTES_PER_SECOND_KW, cfg.same_site_bytes_per_second / megabyte);
+            cfg.remote_site_bytes_per_second = megabyte * read_positive_int(settings, irods::CFG_REMOTE_SITE_MEGABYTES_PER_SECOND_KW, cfg.remote_site_bytes_per_second / megabyte);
+            cfg.sampling_interval            = seconds{read_positive_int(settings, irods::CFG_SAMPLING_INTERVAL_IN_SECONDS_KW, cfg.sampling_interval.count())};
+            cfg.maximum_sample_age           = seconds{read_positive_int(settings, irods::CFG_MAXIMUM_SAMPLE_AGE_IN_SECONDS_KW, cfg.maximum_sample_age.count())};
+            // clang-format on
+        }
+        catch (const irods::exception& e) {
+            // Invalid values of individual settings are reported above. Only a missing or
+            // malformed topology as a whole ends up here.
+            const auto level = KEY_NOT_FOUND == e.code() ? LOG_DEBUG : LOG_ERROR;
+            rodsLog(level, "Could not read server configuration property [%s.%s]. Replicas are not ranked by network distance.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_NETWORK_TOPOLOGY_KW.data());
+            cfg = {};
+        }
+
+        return cfg;
+    } // read_config
+
+    auto get_config() -> const config&
+    {
+        static const config cfg = read_config();
+        return cfg;
+    } // get_config
+
+    auto proximity_between(const config& _config, std::string_view _from, std::string_view _to) -> proximity
+    {
+        if (_from == _to) {
+            return proximity::same_host;
+        }
+
+        const auto* from = find_location(_config, _from);
+        const auto* to = find_location(_config, _to);
+
+        if (!from || !to) {
+            return proximity::unknown;
+        }
+
+        if (from->site != to->site) {
+            return proximity::remote_site;
+        }
+
+        if (!from->rack.empty() && from->rack == to->rack) {
+            return proximity::same_rack;
+        }
+
+        return proximity::same_site;
+    } // proximity_between
+
+    auto expected_transfer_time(const config& _config,
+                                std::string_view _from,
+                                std::string_view _to,
+                                std::int64_t _bytes,
+                                std::optional<microseconds> _round_trip_time)
+        -> std::optional<microseconds>
+    {
+        const auto p = proximity_between(_config, _from, _to);
+
+        std::int64_t bytes_per_second = 0;
+
+        switch (p) {
+            case proximity::same_host:   return microseconds{0};
+            case proximity::same_rack:   bytes_per_second = _config.same_rack_bytes_per_second; break;
+            case proximity::same_site:   bytes_per_second = _config.same_site_bytes_per_second; break;
+            case proximity::remote_site: bytes_per_second = _config.remote_site_bytes_per_second; break;
+            default:                     return std::nullopt;
+        }
+
+        const auto round_trip_time = _round_trip_time.value_or(default_round_trip_time(p));
+        const auto transfer_time = microseconds{static_cast<std::int64_t>(1e6 * std::max<std::int64_t>(_bytes, 0) / bytes_per_second)};
+
+        return round_trip_time + transfer_time;
+    } // expected_transfer_time
+
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_map) {
+                g_segment->destroy_ptr(g_map);
+                g_map = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto insert_or_assign(const std::string_view _host, microseconds _round_trip_time) -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+
+        g_map->insert_or_assign(key_type{_host.data(), _host.size(), *g_allocator},
+                                sample{_round_trip_time.count(), current_timestamp_in_seconds()});
+    } // insert_or_assign
+
+    auto lookup(const std::string_view _host, seconds _max_age) -> std::optional<microseconds>
+    {
+        // Processes on hosts that did not initialize the table (e.g. unit tests) simply have no samples.
+        if (!g_map) {
+            return std::nullopt;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+
+        if (auto iter = g_map->find(key_type{_host.data(), _host.size(), *g_allocator}); iter != g_map->end()) {
+            if (current_timestamp_in_seconds() - iter->second.sampled_at <= _max_age.count()) {
+                return microseconds{iter->second.round_trip_time_in_microseconds};
+            }
+        }
+
+        return std::nullopt;
+    } // lookup
+
+    auto erase(const std::string_view _host) -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+        g_map->erase(key_type{_host.data(), _host.size(), *g_allocator});
+    } // erase
+
+    auto measure_round_trip_time(const std::string& _host, int _port, std::chrono::milliseconds _timeout)
+        -> std::optional<microseconds>
+    {
+        socket_guard sock{connect_to(_host, _port, _timeout)};
+
+        if (sock.fd < 0) {
+            return std::nullopt;
+        }
+
+        // The message header of a heartbeat request, preceded by its length in network byte order.
+        const std::string header = fmt::format("<MsgHeader_PI><type>{}</type></MsgHeader_PI>", RODS_HEARTBEAT_T);
+        const std::uint32_t header_length = htonl(static_cast<std::uint32_t>(header.size()));
+
+        std::string request(sizeof(header_length), '\0');
+        std::memcpy(request.data(), &header_length, sizeof(header_length));
+        request += header;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (send(sock.fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+            return std::nullopt;
+        }
+
+        // The server answers with the heartbeat type and closes the connection.
+        std::array<char, sizeof(RODS_HEARTBEAT_T) - 1> answer{};
+        std::size_t received = 0;
+
+        while (received < answer.size()) {
+            if (!wait_for(sock.fd, POLLIN, _timeout)) {
+                return std::nullopt;
+            }
+
+            const auto n = recv(sock.fd, answer.data() + received, answer.size() - received, 0);
+
+            if (n <= 0) {
+                if (n < 0 && (EINTR == errno || EAGAIN == errno)) {
+                    continue;
+                }
+
+                return std::nullopt;
+            }
+
+            received += n;
+        }
+
+        if (std::string_view{answer.data(), answer.size()} != RODS_HEARTBEAT_T) {
+            return std::nullopt;
+        }
+
+        return duration_cast<microseconds>(std::chrono::steady_clock::now() - start);
+    } // measure_round_trip_time
+} // namespace irods::experimental::network_topology
@@ -529,6 +529,10 @@ initDataOprInp( dataOprInp_t *dataOprInp, int l1descInx, int oprType ) {
         addKeyVal( &dataOprInp->condInput, STREAMING_KW, "" );
     }
 
+    if ( char* codecs = getValByKey( &dataObjInp->condInput, TRANSFER_COMPRESSION_KW ) ) {
+        addKeyVal( &dataOprInp->condInput, TRANSFER_COMPRESSION_KW, codecs );
+    }
+
     if ( getValByKey( &dataObjInp->condInput, NO_PARA_OP_KW ) != NULL ) {
         addKeyVal( &dataOprInp->condInput, NO_PARA_OP_KW, "" );
     }
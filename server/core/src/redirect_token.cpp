@@ -0,0 +1,272 @@
+#include "redirect_token.hpp"
+
+#include "dataObjInpOut.h"
+#include "irods_configuration_keywords.hpp"
+#include "irods_logger.hpp"
+#include "irods_server_properties.hpp"
+#include "rcConnect.h"
+#include "rcMisc.h"
+#include "rodsKeyWdDef.h"
+
+#include <fmt/format.h>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <cstddef>
+#include <ctime>
+#include <stdexcept>
+#include <vector>
+
+namespace irods::experimental::redirect_token
+{
+    namespace
+    {
+        using log = irods::experimental::log;
+
+        // Bumped whenever the token layout or the signed message changes.
+        constexpr std::string_view token_version = "1";
+
+        constexpr char field_separator = '.';
+
+        auto to_hex(std::string_view _bytes) -> std::string
+        {
+            constexpr const char* digits = "0123456789abcdef";
+
+            std::string hex;
+            hex.reserve(_bytes.size() * 2);
+
+            for (const auto c : _bytes) {
+                const auto b = static_cast<unsigned char>(c);
+                hex += digits[b >> 4];
+                hex += digits[b & 0x0f];
+            }
+
+            return hex;
+        } // to_hex
+
+        auto from_hex(std::string_view _hex) -> std::optional<std::string>
+        {
+            if (_hex.size() % 2 != 0) {
+                return std::nullopt;
+            }
+
+            const auto value_of = [](char _c) -> int {
+                if (_c >= '0' && _c <= '9') { return _c - '0'; }
+                if (_c >= 'a' && _c <= 'f') { return _c - 'a' + 10; }
+                return -1;
+            };
+
+            std::string bytes;
+            bytes.reserve(_hex.size() / 2);
+
+            for (std::size_t i = 0; i < _hex.size(); i += 2) {
+                const auto hi = value_of(_hex[i]);
+                const auto lo = value_of(_hex[i + 1]);
+
+                if (hi < 0 || lo < 0) {
+                    return std::nullopt;
+                }
+
+                bytes += static_cast<char>((hi << 4) | lo);
+            }
+
+            return bytes;
+        } // from_hex
+
+        // Every field that the token is bound to is part of the signed message. Fields are
+        // length-prefixed so that values containing the separator cannot be shifted from one
+        // field into another.
+        auto make_message(const context& _ctx, std::string_view _hierarchy, std::int64_t _expires_at) -> std::string
+        {
+            std::string msg;
+
+            for (const auto field : {token_version,
+                                     _ctx.operation,
+                                     _ctx.logical_path,
+                                     _ctx.user_name,
+                                     _ctx.user_zone,
+                                     _hierarchy}) {
+                msg += fmt::format("{}:{}|", field.size(), field);
+            }
+
+            msg += std::to_string(_expires_at);
+
+            return msg;
+        } // make_message
+
+        auto sign(std::string_view _key, std::string_view _message) -> std::string
+        {
+            unsigned char mac[EVP_MAX_MD_SIZE];
+            unsigned int mac_length = 0;
+
+            const auto* result = HMAC(EVP_sha256(),
+                                      _key.data(), static_cast<int>(_key.size()),
+                                      reinterpret_cast<const unsigned char*>(_message.data()), _message.size(),
+                                      mac, &mac_length);
+
+            if (!result) {
+                throw std::runtime_error{"HMAC computation failed"};
+            }
+
+            return {reinterpret_cast<const char*>(mac), mac_length};
+        } // sign
+
+        auto split(std::string_view _token) -> std::vector<std::string_view>
+        {
+            std::vector<std::string_view> fields;
+
+            for (std::string_view::size_type pos = 0;;) {
+                const auto next = _token.find(field_separator, pos);
+
+                if (next == std::string_view::npos) {
+                    fields.push_back(_token.substr(pos));
+                    break;
+                }
+
+                fields.push_back(_token.substr(pos, next - pos));
+                pos = next + 1;
+            }
+
+            return fields;
+        } // split
+
+        auto zone_key() -> const std::string&
+        {
+            return irods::get_server_property<const std::string>(irods::CFG_ZONE_KEY_KW);
+        } // zone_key
+
+        auto make_context(const RsComm& _comm, const DataObjInp& _inp, std::string_view _operation) -> context
+        {
+            return {_operation, _inp.objPath, _comm.clientUser.userName, _comm.clientUser.rodsZone};
+        } // make_context
+    } // anonymous namespace
+
+    auto make(std::string_view _key,
+              const context& _ctx,
+              std::string_view _hierarchy,
+              std::int64_t _expires_at) -> std::string
+    {
+        const auto mac = sign(_key, make_message(_ctx, _hierarchy, _expires_at));
+
+        return fmt::format("{1}{0}{2}{0}{3}{0}{4}",
+                           field_separator,
+                           token_version,
+                           _expires_at,
+                           to_hex(_hierarchy),
+                           to_hex(mac));
+    } // make
+
+    auto verify(std::string_view _key,
+                const context& _ctx,
+                std::string_view _token,
+                std::int64_t _now) -> std::optional<std::string>
+    {
+        // Layout: <version>.<expires_at>.<hex(hierarchy)>.<hex(hmac)>
+        const auto fields = split(_token);
+
+        if (fields.size() != 4 || fields[0] != token_version) {
+            return std::nullopt;
+        }
+
+        std::int64_t expires_at = 0;
+
+        try {
+            std::size_t consumed = 0;
+            expires_at = std::stoll(std::string{fields[1]}, &consumed);
+
+            if (consumed != fields[1].size()) {
+                return std::nullopt;
+            }
+        }
+        catch (...) {
+            return std::nullopt;
+        }
+
+        if (_now > expires_at) {
+            return std::nullopt;
+        }
+
+        auto hierarchy = from_hex(fields[2]);
+        const auto mac = from_hex(fields[3]);
+
+        if (!hierarchy || hierarchy->empty() || !mac) {
+            return std::nullopt;
+        }
+
+        const auto expected_mac = sign(_key, make_message(_ctx, *hierarchy, expires_at));
+
+        if (mac->size() != expected_mac.size() ||
+            CRYPTO_memcmp(mac->data(), expected_mac.data(), mac->size()) != 0)
+        {
+            return std::nullopt;
+        }
+
+        return hierarchy;
+    } // verify
+
+    auto append_if_requested(RsComm& _comm,
+                             const DataObjInp& _inp,
+                             std::string_view _redirect,
+                             std::string_view _hierarchy,
+                             std::string& _host) -> void
+    {
+        if (_hierarchy.empty() || !getValByKey(&_inp.condInput, REQUEST_REDIRECT_TOKEN_KW)) {
+            return;
+        }
+
+        try {
+            const auto expires_at = static_cast<std::int64_t>(std::time(nullptr) + lifetime.count());
+            const auto token = make(zone_key(), make_context(_comm, _inp, _redirect), _hierarchy, expires_at);
+
+            _host += host_separator;
+            _host += token;
+        }
+        catch (const std::exception& e) {
+            log::api::warn({{"log_message", "Could not create redirect token"},
+                            {"error_message", e.what()},
+                            {"logical_path", _inp.objPath}});
+        }
+    } // append_if_requested
+
+    auto consume(RsComm& _comm, DataObjInp& _inp, std::string_view _redirect) -> bool
+    {
+        const char* token = getValByKey(&_inp.condInput, REDIRECT_TOKEN_KW);
+
+        if (!token) {
+            return false;
+        }
+
+        // The token only ever applies to the server it was issued for. It must not follow
+        // the request to another server.
+        const std::string token_copy = token;
+        rmKeyVal(&_inp.condInput, REDIRECT_TOKEN_KW);
+
+        if (getValByKey(&_inp.condInput, RESC_HIER_STR_KW)) {
+            return false;
+        }
+
+        try {
+            const auto now = static_cast<std::int64_t>(std::time(nullptr));
+            const auto hierarchy = verify(zone_key(), make_context(_comm, _inp, _redirect), token_copy, now);
+
+            if (!hierarchy) {
+                log::api::info({{"log_message", "Ignoring invalid or expired redirect token"},
+                                {"logical_path", _inp.objPath}});
+                return false;
+            }
+
+            addKeyVal(&_inp.condInput, RESC_HIER_STR_KW, hierarchy->data());
+
+            return true;
+        }
+        catch (const std::exception& e) {
+            log::api::warn({{"log_message", "Could not verify redirect token"},
+                            {"error_message", e.what()},
+                            {"logical_path", _inp.objPath}});
+        }
+
+        return false;
+    } // consume
+} // namespace irods::experimental::redirect_token
@@ -0,0 +1,80 @@
+#include "replication_checkpoint.hpp"
+
+#include <fmt/format.h>
+
+#include <cctype>
+
+namespace irods::experimental::replication_checkpoint
+{
+    namespace
+    {
+        // clang-format off
+        constexpr std::string_view prefix = "resume:";
+        constexpr std::size_t source_id_length = 16;
+        // clang-format on
+
+        // FNV-1a. The identifier only needs to be stable across servers and short enough to fit in
+        // the data_status column next to the offset; it is not a substitute for the checksum.
+        auto hash(std::string_view _value) noexcept -> std::uint64_t
+        {
+            std::uint64_t h = 14695981039346656037ULL;
+
+            for (const unsigned char c : _value) {
+                h ^= c;
+                h *= 1099511628211ULL;
+            }
+
+            return h;
+        } // hash
+    } // anonymous namespace
+
+    auto make_source_id(std::string_view _checksum, std::int64_t _size) -> std::string
+    {
+        return fmt::format("{:016x}", hash(fmt::format("{}:{}", _checksum, _size)));
+    } // make_source_id
+
+    auto to_string(const checkpoint& _checkpoint) -> std::string
+    {
+        return fmt::format("{}{}:{}", prefix, _checkpoint.offset, _checkpoint.source_id);
+    } // to_string
+
+    auto parse(std::string_view _value) -> std::optional<checkpoint>
+    {
+        if (_value.substr(0, prefix.size()) != prefix) {
+            return std::nullopt;
+        }
+
+        _value.remove_prefix(prefix.size());
+
+        const auto colon = _value.find(':');
+
+        if (colon == 0 || colon == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        const auto offset = _value.substr(0, colon);
+        const auto source_id = _value.substr(colon + 1);
+
+        if (source_id.size() != source_id_length) {
+            return std::nullopt;
+        }
+
+        checkpoint cp{0, std::string{source_id}};
+
+        for (const char c : offset) {
+            if (!std::isdigit(static_cast<unsigned char>(c)) || cp.offset > (INT64_MAX - 9) / 10) {
+                return std::nullopt;
+            }
+
+            cp.offset = cp.offset * 10 + (c - '0');
+        }
+
+        for (const char c : source_id) {
+            if (!std::isxdigit(static_cast<unsigned char>(c))) {
+                return std::nullopt;
+            }
+        }
+
+        return cp;
+    } // parse
+} // namespace irods::experimental::replication_checkpoint
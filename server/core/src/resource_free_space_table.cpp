@@ -0,0 +1,196 @@
+#include "resource_free_space_table.hpp"
+
+#include "rodsLog.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <cerrno>
+#include <climits>
+#include <memory>
+#include <utility>
+
+#include <sys/statvfs.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace irods::experimental::resource::free_space_table
+{
+    namespace
+    {
+        namespace bi = boost::interprocess;
+        namespace fs = boost::filesystem;
+
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
+
+        // clang-format off
+        using segment_manager_type = bi::managed_shared_memory::segment_manager;
+        using void_allocator_type  = bi::allocator<void, segment_manager_type>;
+        using char_allocator_type  = bi::allocator<char, segment_manager_type>;
+        using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+        using mapped_type          = entry;
+        using value_type           = std::pair<const key_type, mapped_type>;
+        using value_allocator_type = bi::allocator<value_type, segment_manager_type>;
+        using map_type             = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
+        using clock_type           = std::chrono::system_clock;
+        // clang-format on
+
+        //
+        // Global Variables
+        //
+
+        // The following variables define the names of shared memory objects and other properties.
+        std::string g_segment_name;
+        std::size_t g_segment_size;
+        std::string g_mutex_name;
+
+        // On initialization, holds the PID of the process that initialized the free space table.
+        // This ensures that only the process that initialized the system can deinitialize it.
+        pid_t g_owner_pid;
+
+        // The following are pointers to the shared memory objects and allocator.
+        // Allocating on the heap allows us to know when the free space table is constructed/destructed.
+        std::unique_ptr<bi::managed_shared_memory> g_segment;
+        std::unique_ptr<void_allocator_type> g_allocator;
+        std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+        map_type* g_map;
+
+        auto current_timestamp_in_seconds() noexcept -> std::int64_t
+        {
+            return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+        }
+    } // anonymous namespace
+
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_map) {
+                g_segment->destroy_ptr(g_map);
+                g_map = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto insert_or_assign(const std::string_view _resource_name, std::uintmax_t _free_space_in_bytes) -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+
+        g_map->insert_or_assign(key_type{_resource_name.data(), _resource_name.size(), *g_allocator},
+                                mapped_type{_free_space_in_bytes, current_timestamp_in_seconds()});
+    } // insert_or_assign
+
+    auto lookup(const std::string_view _resource_name, std::chrono::seconds _max_age) -> std::optional<entry>
+    {
+        // Agents on hosts that did not initialize the table (e.g. unit tests) simply have no samples.
+        if (!g_map) {
+            return std::nullopt;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+
+        if (auto iter = g_map->find(key_type{_resource_name.data(), _resource_name.size(), *g_allocator}); iter != g_map->end()) {
+            if (current_timestamp_in_seconds() - iter->second.sampled_at <= _max_age.count()) {
+                return iter->second;
+            }
+        }
+
+        return std::nullopt;
+    } // lookup
+
+    auto erase(const std::string_view _resource_name) -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+        g_map->erase(key_type{_resource_name.data(), _resource_name.size(), *g_allocator});
+    } // erase
+
+    auto clear() -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+        g_map->clear();
+    } // clear
+
+    auto sample_vault(const std::string_view _vault_path) -> std::optional<std::uintmax_t>
+    {
+        try {
+            fs::path path_to_stat{_vault_path.data()};
+            const auto absolute_vault_path = fs::absolute(path_to_stat);
+
+            while (!fs::exists(path_to_stat)) {
+                path_to_stat = path_to_stat.parent_path();
+
+                if (path_to_stat.empty()) {
+                    rodsLog(LOG_DEBUG, "%s: could not find existing path from vault path [%s]", __FUNCTION__, _vault_path.data());
+                    return std::nullopt;
+                }
+            }
+
+            // Using the root directory as a vault path is bad - do not report its free space.
+            if (absolute_vault_path.root_path() == path_to_stat) {
+                rodsLog(LOG_DEBUG, "%s: could not find existing non-root path from vault path [%s]", __FUNCTION__, _vault_path.data());
+                return std::nullopt;
+            }
+
+            struct statvfs statvfs_buf{};
+
+            if (statvfs(path_to_stat.c_str(), &statvfs_buf) != 0) {
+                rodsLog(LOG_ERROR, "%s: statvfs() of [%s] failed with errno %d", __FUNCTION__, path_to_stat.c_str(), errno);
+                return std::nullopt;
+            }
+
+            if (statvfs_buf.f_bavail > ULONG_MAX / statvfs_buf.f_frsize) {
+                return ULONG_MAX;
+            }
+
+            return static_cast<std::uintmax_t>(statvfs_buf.f_bavail) * statvfs_buf.f_frsize;
+        }
+        catch (const fs::filesystem_error& e) {
+            rodsLog(LOG_ERROR, "%s: %s", __FUNCTION__, e.what());
+        }
+
+        return std::nullopt;
+    } // sample_vault
+} // namespace irods::experimental::resource::free_space_table
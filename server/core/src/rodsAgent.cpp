@@ -32,6 +32,8 @@
 #include "server_utilities.hpp"
 #include "plugin_lifetime_manager.hpp"
 #include "version.hpp"
+#include "api_profiler.hpp"
+#include "connection_health.hpp"
 
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -405,6 +407,8 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
                 log::network::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_NETWORK_KW));
                 log::rule_engine::set_level(log::get_level_from_config(irods::CFG_LOG_LEVEL_CATEGORY_RULE_ENGINE_KW));
 
+                irods::experimental::api_profiler::init();
+
                 log::agent::trace("Agent started.");
 
                 irods::error ret2 = setRECacheSaltFromEnv();
@@ -545,9 +549,13 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
         }
     }
 
-    /* send the server version and status as part of the protocol. Put
-     * rsComm.reconnPort as the status */
-    ret = sendVersion( net_obj, status, rsComm.reconnPort,
+    // tell clients that asked that heartbeats are answered (see rsApiHandler.cpp). a
+    // positive status is ignored by clients that did not ask.
+    namespace ch = irods::experimental::connection_health;
+    const int version_status = getenv( ch::heartbeat_request_env_var ) ? ch::heartbeat_supported : 0;
+
+    /* send the server version and status as part of the protocol. */
+    ret = sendVersion( net_obj, version_status, rsComm.reconnPort,
                        rsComm.reconnAddr, rsComm.cookie );
 
     if ( !ret.ok() ) {
@@ -583,7 +591,9 @@ runIrodsAgentFactory( sockaddr_un agent_addr ) {
 
     new_net_obj->to_server( &rsComm );
     // TODO: move this into an at_scope_exit
-    cleanup();
+    // Server-to-server connections are only worth reusing if the client disconnected
+    // cleanly. Every other exit path closes them.
+    cleanup( 0 == status );
     free( rsComm.thread_ctx );
     free( rsComm.auth_scheme );
 
@@ -14,6 +14,7 @@
 #include "rsLog.hpp"
 
 #include "irods_logger.hpp"
+#include "server_connection_broker.hpp"
 
 #include <vector>
 #include <iterator>
@@ -749,6 +750,25 @@ disconnectAllSvrToSvrConn() {
     return 0;
 }
 
+int
+releaseAllSvrToSvrConn() {
+    rodsServerHost_t *tmpRodsServerHost;
+
+    tmpRodsServerHost = ServerHostHead;
+    while ( tmpRodsServerHost != NULL ) {
+        if ( tmpRodsServerHost->conn != NULL ) {
+            // Idle connections are handed to the connection broker so that later
+            // agents can skip the connection setup.
+            if ( !irods::experimental::server_connection_broker::release( tmpRodsServerHost->conn ) ) {
+                rcDisconnect( tmpRodsServerHost->conn );
+            }
+            tmpRodsServerHost->conn = NULL;
+        }
+        tmpRodsServerHost = tmpRodsServerHost->next;
+    }
+    return 0;
+}
+
 /* getAndConnRemoteZone - get the remote zone host (result given in
  * rodsServerHost) based on the dataObjInp->objPath as zoneHint.
  * If the host is a remote zone, automatically connect to the host.
@@ -27,6 +27,17 @@
 #include "hostname_cache.hpp"
 #include "dns_cache.hpp"
 #include "server_utilities.hpp"
+#include "resource_free_space_table.hpp"
+#include "special_collection_index.hpp"
+#include "server_connection_broker.hpp"
+#include "transfer_scheduler.hpp"
+#include "agent_connection_health.hpp"
+#include "connection_health.hpp"
+#include "network_topology.hpp"
+#include "client_connection.hpp"
+#include "irods_query.hpp"
+#include "irods_hostname.hpp"
+#include "generalAdmin.h"
 
 #include <pthread.h>
 #include <sys/socket.h>
@@ -49,11 +60,19 @@
 #include <regex>
 #include <algorithm>
 #include <iterator>
+#include <chrono>
+#include <unordered_map>
 
 // clang-format off
 namespace ix   = irods::experimental;
 namespace hnc  = irods::experimental::net::hostname_cache;
 namespace dnsc = irods::experimental::net::dns_cache;
+namespace fst  = irods::experimental::resource::free_space_table;
+namespace sci  = irods::experimental::special_collection_index;
+namespace scb  = irods::experimental::server_connection_broker;
+namespace tsch = irods::experimental::transfer_scheduler;
+namespace nt   = irods::experimental::network_topology;
+namespace ach  = irods::experimental::agent_connection_health;
 // clang-format on
 
 using namespace boost::filesystem;
@@ -63,9 +82,11 @@ int agent_conn_socket{};
 bool connected_to_agent{};
 
 pid_t agent_spawning_pid{};
+pid_t connection_broker_pid{};
 const char socket_dir_template[]{"/tmp/irods_sockets_XXXXXX"};
 char agent_factory_socket_dir[sizeof(socket_dir_template)]{};
 char agent_factory_socket_file[sizeof(local_addr.sun_path)]{};
+char connection_broker_socket_file[sizeof(local_addr.sun_path)]{};
 
 uint ServerBootTime;
 int SvrSock;
@@ -81,6 +102,8 @@ boost::thread*            ReadWorkerThread[NUM_READ_WORKER_THR];
 boost::thread*            SpawnManagerThread;
 
 boost::thread*            PurgeLockFileThread; // JMC - backport 4612
+boost::thread*            ResourceFreeSpaceMonitorThread;
+boost::thread*            NetworkTopologyMonitorThread;
 
 boost::mutex              ReadReqCondMutex;
 boost::mutex              SpawnReqCondMutex;
@@ -237,6 +260,194 @@ namespace
         }
         catch (...) {}
     }
+
+    struct local_vault
+    {
+        std::string resource_name;
+        std::string vault_path;
+        std::uintmax_t published_free_space;
+    };
+
+    // Returns the unixfilesystem resources whose vaults live on this host.
+    auto get_local_vaults(RcComm& _conn) -> std::vector<local_vault>
+    {
+        std::vector<local_vault> vaults;
+
+        const auto gql = "select RESC_NAME, RESC_LOC, RESC_VAULT_PATH where RESC_TYPE_NAME = 'unixfilesystem'";
+
+        for (auto&& row : irods::query<RcComm>{&_conn, gql}) {
+            if (hostname_resolves_to_local_address(row[1].c_str())) {
+                vaults.push_back({row[0], row[2], 0});
+            }
+        }
+
+        return vaults;
+    }
+
+    auto publish_free_space_to_catalog(RcComm& _conn, const local_vault& _vault, std::uintmax_t _free_space) -> int
+    {
+        const auto free_space = std::to_string(_free_space);
+
+        generalAdminInp_t input{};
+        input.arg0 = "modify";
+        input.arg1 = "resource";
+        input.arg2 = _vault.resource_name.c_str();
+        input.arg3 = "freespace";
+        input.arg4 = free_space.c_str();
+
+        return rcGeneralAdmin(&_conn, &input);
+    }
+
+    // Samples the free space of every local unixfilesystem vault and publishes the results
+    // to shared memory for resource voting. The catalog is updated no more often than the
+    // configured catalog update interval, and only for vaults whose free space changed.
+    void resource_free_space_monitor_task()
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        const std::chrono::seconds sampling_interval{irods::get_resource_free_space_sampling_interval()};
+        const std::chrono::seconds catalog_update_interval{irods::get_resource_free_space_catalog_update_interval()};
+
+        std::unique_ptr<ix::client_connection> conn;
+        std::vector<local_vault> vaults;
+
+        // Forces a sample and a catalog update on the first iteration.
+        auto last_sample = clock_type::now() - sampling_interval;
+        auto last_catalog_update = clock_type::now() - catalog_update_interval;
+
+        irods::server_state& server_state = irods::server_state::instance();
+
+        while (irods::server_state::STOPPED != server_state() &&
+               irods::server_state::EXITED != server_state())
+        {
+            rodsSleep(0, irods::SERVER_CONTROL_POLLING_TIME_MILLI_SEC * 1000);
+
+            if (clock_type::now() - last_sample < sampling_interval) {
+                continue;
+            }
+
+            last_sample = clock_type::now();
+
+            const bool catalog_update_due = clock_type::now() - last_catalog_update >= catalog_update_interval;
+
+            try {
+                if (!conn || !*conn) {
+                    conn = std::make_unique<ix::client_connection>();
+                }
+
+                // Resources may be added, removed or modified at any time. Refreshing the
+                // list at the catalog update rate keeps the number of queries bounded.
+                if (catalog_update_due) {
+                    auto refreshed = get_local_vaults(*conn);
+
+                    for (auto&& v : refreshed) {
+                        const auto end = std::end(vaults);
+                        const auto iter = std::find_if(std::begin(vaults), end, [&v](const local_vault& _v) {
+                            return _v.resource_name == v.resource_name && _v.vault_path == v.vault_path;
+                        });
+
+                        if (iter != end) {
+                            v.published_free_space = iter->published_free_space;
+                        }
+                    }
+
+                    for (auto&& v : vaults) {
+                        const auto end = std::end(refreshed);
+                        const auto iter = std::find_if(std::begin(refreshed), end, [&v](const local_vault& _v) {
+                            return _v.resource_name == v.resource_name;
+                        });
+
+                        if (iter == end) {
+                            fst::erase(v.resource_name);
+                        }
+                    }
+
+                    vaults = std::move(refreshed);
+                }
+            }
+            catch (const irods::exception& e) {
+                ix::log::server::error("Resource free space monitor could not refresh local vaults [error_code={}].", e.code());
+                conn.reset();
+            }
+
+            for (auto&& v : vaults) {
+                const auto free_space = fst::sample_vault(v.vault_path);
+
+                if (!free_space) {
+                    fst::erase(v.resource_name);
+                    continue;
+                }
+
+                fst::insert_or_assign(v.resource_name, *free_space);
+
+                if (catalog_update_due && conn && *conn && *free_space != v.published_free_space) {
+                    if (const auto ec = publish_free_space_to_catalog(*conn, v, *free_space); ec < 0) {
+                        ix::log::server::error("Could not update free space in catalog for resource [{}] [error_code={}].",
+                                               v.resource_name, ec);
+                        conn.reset();
+                    }
+                    else {
+                        v.published_free_space = *free_space;
+                    }
+                }
+            }
+
+            if (catalog_update_due) {
+                last_catalog_update = clock_type::now();
+            }
+        }
+    }
+
+    // Measures the round trip time to every other server in the network topology and
+    // publishes the results to shared memory for resource voting.
+    void network_topology_monitor_task()
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        const auto& topology = nt::get_config();
+
+        if (topology.hosts.empty()) {
+            return;
+        }
+
+        std::vector<std::string> remote_hosts;
+
+        for (auto&& h : topology.hosts) {
+            if (!hostname_resolves_to_local_address(h.host.c_str())) {
+                remote_hosts.push_back(h.host);
+            }
+        }
+
+        const auto port = irods::get_server_property<const int>(irods::CFG_ZONE_PORT);
+        const std::chrono::milliseconds timeout{2000};
+
+        // Forces a sample on the first iteration.
+        auto last_sample = clock_type::now() - topology.sampling_interval;
+
+        irods::server_state& server_state = irods::server_state::instance();
+
+        while (irods::server_state::STOPPED != server_state() &&
+               irods::server_state::EXITED != server_state())
+        {
+            rodsSleep(0, irods::SERVER_CONTROL_POLLING_TIME_MILLI_SEC * 1000);
+
+            if (clock_type::now() - last_sample < topology.sampling_interval) {
+                continue;
+            }
+
+            last_sample = clock_type::now();
+
+            for (auto&& host : remote_hosts) {
+                if (const auto round_trip_time = nt::measure_round_trip_time(host, port, timeout); round_trip_time) {
+                    nt::insert_or_assign(host, *round_trip_time);
+                }
+                else {
+                    ix::log::server::debug("Could not measure round trip time to server [host={}].", host);
+                    nt::erase(host);
+                }
+            }
+        }
+    }
 } // anonymous namespace
 
 static void set_agent_spawner_process_name(const InformationRequiredToSafelyRenameProcess& info) {
@@ -344,6 +555,31 @@ int main(int argc, char** argv)
     ix::replica_access_table::init();
     irods::at_scope_exit deinit_replica_access_table{[] { ix::replica_access_table::deinit(); }};
 
+    fst::init();
+    irods::at_scope_exit deinit_resource_free_space_table{[] { fst::deinit(); }};
+
+    nt::init();
+    irods::at_scope_exit deinit_network_topology{[] { nt::deinit(); }};
+
+    // Only the catalog provider sees every change to the special collections of the zone, so
+    // the index is not trustworthy anywhere else. Agents never consult it if it does not exist.
+    if (std::string svc_role; get_catalog_service_role(svc_role).ok() &&
+        irods::CFG_SERVICE_ROLE_PROVIDER == svc_role &&
+        irods::get_special_collection_index_refresh_interval() > 0)
+    {
+        sci::init("irods_special_collection_index", irods::get_special_collection_index_shared_memory_size());
+    }
+    irods::at_scope_exit deinit_special_collection_index{[] { sci::deinit(); }};
+
+    tsch::init("irods_transfer_scheduler", irods::get_transfer_scheduler_shared_memory_size(), tsch::read_config());
+    irods::at_scope_exit deinit_transfer_scheduler{[] { tsch::deinit(); }};
+
+    // Applied to every client socket accepted from now on, including the ones handed to agents.
+    irods::experimental::connection_health::set_default_tcp_keepalive_options(ach::read_config().tcp_keepalive);
+
+    ach::init("irods_agent_connection_health");
+    irods::at_scope_exit deinit_agent_connection_health{[] { ach::deinit(); }};
+
     remove_leftover_rulebase_pid_files();
 
     irods::parse_and_store_hosts_configuration_file_as_json();
@@ -393,6 +629,27 @@ int main(int argc, char** argv)
     snprintf(agent_factory_socket_file, sizeof(agent_factory_socket_file), "%s/irods_factory_%s", agent_factory_socket_dir, random_suffix);
     snprintf(local_addr.sun_path, sizeof(local_addr.sun_path), "%s", agent_factory_socket_file);
 
+    // The broker must exist before the agent factory is forked so that every agent
+    // inherits the location of its socket.
+    snprintf(connection_broker_socket_file, sizeof(connection_broker_socket_file), "%s/irods_broker_%s", agent_factory_socket_dir, random_suffix);
+    scb::set_socket_file(connection_broker_socket_file);
+
+    ix::log::server::info("Forking server connection broker ...");
+
+    connection_broker_pid = fork();
+
+    if (connection_broker_pid == 0) {
+        // Server connection broker process (child)
+        return scb::run();
+    }
+
+    if (connection_broker_pid < 0) {
+        rodsLog( LOG_ERROR, "fork() failed when attempting to create server connection broker process" );
+        return SYS_FORK_ERROR;
+    }
+
+    ix::log::server::info("Server connection broker PID = [{}]", connection_broker_pid);
+
     ix::log::server::info("Forking agent factory ...");
 
     agent_spawning_pid = fork();
@@ -554,6 +811,20 @@ int serverMain(
             }
         }
 
+        try {
+            ResourceFreeSpaceMonitorThread = new boost::thread( resource_free_space_monitor_task );
+        }
+        catch ( const boost::thread_resource_error& ) {
+            rodsLog( LOG_ERROR, "boost encountered a thread_resource_error during thread construction in serverMain." );
+        }
+
+        try {
+            NetworkTopologyMonitorThread = new boost::thread( network_topology_monitor_task );
+        }
+        catch ( const boost::thread_resource_error& ) {
+            rodsLog( LOG_ERROR, "boost encountered a thread_resource_error during thread construction in serverMain." );
+        }
+
         fd_set sockMask;
         FD_ZERO( &sockMask );
         SvrSock = svrComm.sock;
@@ -566,6 +837,7 @@ int serverMain(
 
                 // Wake up the agent factory process so it can clean up and exit
                 kill( agent_spawning_pid, SIGTERM );
+                kill( connection_broker_pid, SIGTERM );
 
                 rodsLog( LOG_NOTICE, "iRODS Server is exiting with state [%s].", the_server_state.c_str() );
 
@@ -674,6 +946,24 @@ int serverMain(
             }
         }
 
+        if ( ResourceFreeSpaceMonitorThread ) {
+            try {
+                ResourceFreeSpaceMonitorThread->join();
+            }
+            catch ( const boost::thread_resource_error& ) {
+                rodsLog( LOG_ERROR, "boost encountered a thread_resource_error during join in serverMain." );
+            }
+        }
+
+        if ( NetworkTopologyMonitorThread ) {
+            try {
+                NetworkTopologyMonitorThread->join();
+            }
+            catch ( const boost::thread_resource_error& ) {
+                rodsLog( LOG_ERROR, "boost encountered a thread_resource_error during join in serverMain." );
+            }
+        }
+
         procChildren( &ConnectedAgentHead );
         stopProcConnReqThreads();
 
@@ -688,6 +978,7 @@ int serverMain(
 
     close( agent_conn_socket );
     unlink( agent_factory_socket_file );
+    unlink( connection_broker_socket_file );
     rmdir( agent_factory_socket_dir );
 
     ix::log::server::info("iRODS Server is done.");
@@ -710,10 +1001,12 @@ serverExit()
 
     close( agent_conn_socket );
     unlink( agent_factory_socket_file );
+    unlink( connection_broker_socket_file );
     rmdir( agent_factory_socket_dir );
 
     // Wake and terminate agent spawning process
     kill( agent_spawning_pid, SIGTERM );
+    kill( connection_broker_pid, SIGTERM );
 
     exit( 1 );
 }
@@ -980,6 +1273,16 @@ execAgent( int newSock, startupPack_t *startupPack ) {
     // if the client-server negotiation request is in the
     // option variable, set that env var and strip it out
     std::string opt_str( startupPack->option );
+
+    // forward the question whether heartbeats are answered separately so that
+    // it does not become part of the client's program name
+    if ( irods::experimental::connection_health::remove_heartbeat_request( opt_str ) ) {
+        status = sendEnvironmentVarStrToSocket( irods::experimental::connection_health::heartbeat_request_env_var, "1", tmp_socket );
+        if (status < 0) {
+            rodsLog( LOG_ERROR, "Failed to send the heartbeat request to agent" );
+        }
+    }
+
     size_t pos = opt_str.find( REQ_SVR_NEG );
     if ( std::string::npos != pos ) {
         std::string trunc_str = opt_str.substr( 0, pos );
@@ -994,7 +1297,7 @@ execAgent( int newSock, startupPack_t *startupPack ) {
 
     }
     else {
-        status = sendEnvironmentVarStrToSocket( SP_OPTION, startupPack->option, tmp_socket );
+        status = sendEnvironmentVarStrToSocket( SP_OPTION, opt_str.c_str(), tmp_socket );
         if (status < 0) {
             rodsLog( LOG_ERROR, "Failed to send SP_OPTION to agent" );
         }
@@ -30,15 +30,26 @@ jmp_buf Jenv;
 #include "irods_hierarchy_parser.hpp"
 #include "irods_api_number_validator.hpp"
 #include "irods_logger.hpp"
+#include "api_profiler.hpp"
+#include "agent_connection_health.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
 
 #define MAKE_IRODS_ERROR_MAP
 #include "rodsErrorTable.h"
 #undef MAKE_IRODS_ERROR_MAP
 
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include <algorithm>
 
 namespace ix = irods::experimental;
+namespace ach = irods::experimental::agent_connection_health;
 
 namespace
 {
@@ -52,6 +63,106 @@ namespace
         log::set_request_proxy_user(_comm->proxyUser.userName);
         log::set_request_api_number(_api_number);
     }
+
+    // Holds the buffer the byte stream of a request (e.g. the contents of a single buffer put)
+    // is read into. The buffer is kept between requests so that an agent ingesting many small
+    // files does not pay for an allocation, and the page faults and zeroing of fresh pages, on
+    // every request. The network plugins read into the buffer they are given and only allocate
+    // one of their own when it is too small. From there the bytes are handed to the resource
+    // plugin by pointer.
+    class bs_buffer_pool
+    {
+    public:
+        bs_buffer_pool() = default;
+
+        bs_buffer_pool(const bs_buffer_pool&) = delete;
+        auto operator=(const bs_buffer_pool&) -> bs_buffer_pool& = delete;
+
+        ~bs_buffer_pool()
+        {
+            std::free(buf_);
+        }
+
+        // Points _bbuf at the retained buffer if it can hold _size bytes. Returns false if the
+        // buffer is in use by an outer request (see sendAndRecvBranchMsg) or _size is larger
+        // than the buffers worth retaining. _bbuf is left untouched in that case.
+        auto lend(bytesBuf_t& _bbuf, int _size) -> bool
+        {
+            // The network plugins require room for a terminating byte.
+            const auto required = static_cast<std::size_t>(_size) + 1;
+
+            if (in_use_ || _size <= 0 || required > max_retained_size()) {
+                return false;
+            }
+
+            if (capacity_ < required) {
+                static const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+                const auto capacity = (required + page_size - 1) / page_size * page_size;
+
+                std::free(buf_);
+                buf_ = nullptr;
+                capacity_ = 0;
+
+                if (posix_memalign(&buf_, page_size, capacity) != 0) {
+                    buf_ = nullptr;
+                    return false;
+                }
+
+                capacity_ = capacity;
+            }
+
+            in_use_ = true;
+            _bbuf.buf = buf_;
+            _bbuf.len = static_cast<int>(capacity_);
+
+            return true;
+        }
+
+        // Releases the buffer lent to _bbuf, or frees the buffer of _bbuf if it was not lent.
+        // The network plugins free the buffer they read into (and clear the pointer) when
+        // reading the byte stream fails. A lent buffer that was freed that way is forgotten.
+        auto take_back(bytesBuf_t& _bbuf, bool _lent) -> void
+        {
+            if (!_lent) {
+                clearBBuf(&_bbuf);
+                return;
+            }
+
+            if (_bbuf.buf != buf_) {
+                buf_ = nullptr;
+                capacity_ = 0;
+            }
+
+            in_use_ = false;
+            std::memset(&_bbuf, 0, sizeof(_bbuf));
+        }
+
+    private:
+        static auto max_retained_size() -> std::size_t
+        {
+            // Byte streams are bounded by the single buffer limit, except for a few APIs
+            // (e.g. the legacy file APIs) that are rarely worth a retained buffer.
+            static const std::size_t size = [] {
+                constexpr int default_size_in_megabytes = 32;
+
+                try {
+                    const auto mb = irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER);
+                    return static_cast<std::size_t>(mb > 0 ? mb : default_size_in_megabytes) * 1024 * 1024;
+                }
+                catch (const irods::exception&) {
+                    return static_cast<std::size_t>(default_size_in_megabytes) * 1024 * 1024;
+                }
+            }();
+
+            return size;
+        }
+
+        void* buf_ = nullptr;
+        std::size_t capacity_ = 0;
+        bool in_use_ = false;
+    }; // class bs_buffer_pool
+
+    bs_buffer_pool bs_buffers;
 } // anonymous namespace
 
 int rsApiHandler(rsComm_t*   rsComm,
@@ -191,6 +302,14 @@ int rsApiHandler(rsComm_t*   rsComm,
         numArg++;
     };
 
+    // Symbol resolution for the profile happens when this object goes out of scope,
+    // after the reply has been sent.
+    ix::api_profiler::scoped_api_profile profile{apiNumber};
+
+    // The completion record is only built, and the call only timed, when it is written.
+    const bool log_request = log::api::is_enabled(log::level::debug);
+    const auto call_start = log_request ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
     int retVal = 0;
     if ( numArg == 0 ) {
         retVal = api_entry->call_wrapper(
@@ -228,6 +347,18 @@ int rsApiHandler(rsComm_t*   rsComm,
                      myArgv[3]);
     }
 
+    profile.stop();
+
+    // One record per request. These records are what the load generator replays
+    // (see test/load_generator).
+    if ( log_request ) {
+        const auto call_duration = std::chrono::steady_clock::now() - call_start;
+        log::api::debug({{"log_message", "API request completed"},
+                         {"request_status", std::to_string(retVal)},
+                         {"request_duration_in_microseconds",
+                          std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(call_duration).count())}});
+    }
+
     if ( retVal != SYS_NO_HANDLER_REPLY_MSG ) {
         status = sendAndProcApiReply
                  ( rsComm, apiInx, retVal, myOutStruct, &myOutBsBBuf );
@@ -529,7 +660,7 @@ readAndProcClientMsg( rsComm_t * rsComm, int flags ) {
     if ( ( flags & READ_HEADER_TIMEOUT ) != 0 ) {
         int retryCnt = 0;
         struct timeval tv;
-        tv.tv_sec = READ_HEADER_TIMEOUT_IN_SEC;
+        tv.tv_sec = ach::idle_timeout_in_seconds();
         tv.tv_usec = 0;
 
         while ( 1 ) {
@@ -543,8 +674,9 @@ readAndProcClientMsg( rsComm_t * rsComm, int flags ) {
                 }
                 if ( ret.code() == USER_SOCK_CONNECT_TIMEDOUT ) {
                     rodsLog( LOG_ERROR,
-                             "readAndProcClientMsg: readMsgHeader by pid %d timedout",
-                             getpid() );
+                             "readAndProcClientMsg: readMsgHeader by pid %d timedout after %d seconds idle",
+                             getpid(), ach::idle_timeout_in_seconds() );
+                    ach::record_idle_session_reaped( isL1descInuse() );
                     return  ret.code();
                 }
             }
@@ -575,10 +707,17 @@ readAndProcClientMsg( rsComm_t * rsComm, int flags ) {
         }
         else {
             svrChkReconnAtReadEnd( rsComm );
+            ach::record_broken_connection();
             return ret.code();
         }
     } // if !ret.ok()
 
+    const bool bs_buffer_lent = bs_buffers.lend( bsBBuf, myHeader.bsLen );
+
+    irods::at_scope_exit release_bs_buffer{[&bsBBuf, bs_buffer_lent] {
+        bs_buffers.take_back( bsBBuf, bs_buffer_lent );
+    }};
+
     ret = readMsgBody( net_obj, &myHeader, &inputStructBBuf,
                        &bsBBuf, &errorBBuf, rsComm->irodsProt, NULL );
     if ( !ret.ok() ) {
@@ -595,7 +734,6 @@ readAndProcClientMsg( rsComm_t * rsComm, int flags ) {
         status = rsApiHandler( rsComm, myHeader.intInfo, &inputStructBBuf,
                                &bsBBuf );
         clearBBuf( &inputStructBBuf );
-        clearBBuf( &bsBBuf );
         clearBBuf( &errorBBuf );
 
         if ( ( flags & RET_API_STATUS ) != 0 ) {
@@ -609,6 +747,17 @@ readAndProcClientMsg( rsComm_t * rsComm, int flags ) {
         rodsLog( LOG_DEBUG, "readAndProcClientMsg: received disconnect msg from client" );
         return DISCONN_STATUS;
     }
+    else if ( strcmp( myHeader.type, RODS_HEARTBEAT_T ) == 0 ) {
+        /* answer with the idle timeout, which bounds how long the session may stay quiet */
+        ach::record_heartbeat();
+        ret = sendRodsMsg( net_obj, RODS_HEARTBEAT_T, NULL, NULL, NULL,
+                           ach::idle_timeout_in_seconds(), rsComm->irodsProt );
+        if ( !ret.ok() ) {
+            irods::log( PASS( ret ) );
+            return ret.code();
+        }
+        return 0;
+    }
     else if ( strcmp( myHeader.type, RODS_RECONNECT_T ) == 0 ) {
         rodsLog( LOG_NOTICE, "readAndProcClientMsg: received reconnect msg from client" );
         /* call itself again. be careful */
@@ -0,0 +1,599 @@
+#include "rule_execution_context.hpp"
+
+#include "base64.h"
+#include "irods_exception.hpp"
+#include "irods_re_structs.hpp"
+#include "json_deserialization.hpp"
+#include "msParam.h"
+#include "objInfo.h"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// The binary encoding (version 1) is a sequence of the following fields. Integers are
+// stored as LEB128 varints (signed integers are zigzag encoded first). Strings are stored
+// as a varint length followed by the bytes, without a terminating null. Optional structures
+// are preceded by a byte set to 1 if the structure is present and 0 otherwise.
+//
+//   string  rule name
+//   string  plugin instance name
+//   string  resource name
+//   optional microservice parameter array:
+//       int     operation type
+//       varint  number of parameters, followed by each parameter:
+//           string  label
+//           byte    value kind (see value_kind)
+//           string  type (unless the value kind is "none")
+//           value   string, int, 8-byte double or 4-byte float (little endian)
+//   optional user info (client), optional user info (proxy), optional user info (other):
+//       string  name, type, zone
+//       int     system uid
+//       string  auth scheme
+//       int     auth flag, flag, ppid
+//       string  host, auth string
+//       string  info, comments, ctime, mtime
+//   optional conditional input:
+//       varint  number of pairs, followed by the key and value of each pair
+
+namespace
+{
+    namespace rec = irods::rule_execution_context;
+
+    // The unsigned integer used to store the bits of a double or float.
+    template <typename T>
+    using fixed_bits_type = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+
+    // The kinds of microservice parameter values that can be stored. Parameters of any other
+    // type are stored without their type and value, just like with the JSON encoding.
+    enum class value_kind : std::uint8_t
+    {
+        none,
+        string,
+        integer,
+        double_precision,
+        single_precision
+    }; // enum class value_kind
+
+    class writer
+    {
+    public:
+        auto write_byte(std::uint8_t _v) -> void
+        {
+            buffer_.push_back(static_cast<char>(_v));
+        }
+
+        auto write_varint(std::uint64_t _v) -> void
+        {
+            while (_v >= 0x80) {
+                write_byte(static_cast<std::uint8_t>(_v | 0x80));
+                _v >>= 7;
+            }
+
+            write_byte(static_cast<std::uint8_t>(_v));
+        }
+
+        auto write_int(std::int64_t _v) -> void
+        {
+            write_varint((static_cast<std::uint64_t>(_v) << 1) ^ static_cast<std::uint64_t>(_v >> 63));
+        }
+
+        auto write_string(const char* _v) -> void
+        {
+            const std::string_view s = _v ? _v : "";
+            write_varint(s.size());
+            buffer_.append(s);
+        }
+
+        // Writes the bits of _v least significant byte first, regardless of the byte order
+        // of the host.
+        template <typename T>
+        auto write_fixed(T _v) -> void
+        {
+            static_assert(std::is_floating_point_v<T> && sizeof(T) == sizeof(fixed_bits_type<T>));
+
+            fixed_bits_type<T> bits;
+            std::memcpy(&bits, &_v, sizeof(T));
+
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                write_byte(static_cast<std::uint8_t>(bits >> (8 * i)));
+            }
+        }
+
+        auto buffer() const noexcept -> const std::string&
+        {
+            return buffer_;
+        }
+
+    private:
+        std::string buffer_;
+    }; // class writer
+
+    class reader
+    {
+    public:
+        explicit reader(std::string_view _buffer) noexcept
+            : buffer_{_buffer}
+        {
+        }
+
+        auto read_byte() -> std::uint8_t
+        {
+            if (pos_ >= buffer_.size()) {
+                THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context is truncated.");
+            }
+
+            return static_cast<std::uint8_t>(buffer_[pos_++]);
+        }
+
+        auto read_varint() -> std::uint64_t
+        {
+            std::uint64_t v = 0;
+
+            for (int shift = 0; shift < 64; shift += 7) {
+                const auto b = read_byte();
+                v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+
+                if ((b & 0x80) == 0) {
+                    return v;
+                }
+            }
+
+            THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context contains an invalid integer.");
+        }
+
+        auto read_int() -> std::int64_t
+        {
+            const auto v = read_varint();
+            return static_cast<std::int64_t>((v >> 1) ^ (~(v & 1) + 1));
+        }
+
+        auto read_string() -> std::string_view
+        {
+            const auto size = read_varint();
+
+            if (size > buffer_.size() - pos_) {
+                THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context is truncated.");
+            }
+
+            const auto s = buffer_.substr(pos_, size);
+            pos_ += size;
+
+            return s;
+        }
+
+        // Copies a string into a fixed-size buffer, truncating it if necessary.
+        template <std::size_t N>
+        auto read_string(char (&_out)[N]) -> void
+        {
+            const auto s = read_string();
+            const auto n = std::min(s.size(), N - 1);
+            std::memcpy(_out, s.data(), n);
+            _out[n] = '\0';
+        }
+
+        auto read_strdup() -> char*
+        {
+            const auto s = read_string();
+            auto* p = static_cast<char*>(std::malloc(s.size() + 1));
+            std::memcpy(p, s.data(), s.size());
+            p[s.size()] = '\0';
+            return p;
+        }
+
+        template <typename T>
+        auto read_fixed() -> T
+        {
+            static_assert(std::is_floating_point_v<T> && sizeof(T) == sizeof(fixed_bits_type<T>));
+
+            fixed_bits_type<T> bits = 0;
+
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                bits |= static_cast<fixed_bits_type<T>>(read_byte()) << (8 * i);
+            }
+
+            T v;
+            std::memcpy(&v, &bits, sizeof(T));
+            return v;
+        }
+
+        auto remaining() const noexcept -> std::size_t
+        {
+            return buffer_.size() - pos_;
+        }
+
+    private:
+        std::string_view buffer_;
+        std::size_t pos_ = 0;
+    }; // class reader
+
+    auto write_ms_param(writer& _w, const MsParam& _p) -> void
+    {
+        _w.write_string(_p.label);
+
+        // Input parameters have a type and a value. Output parameters have neither, and are
+        // stored without them.
+        auto kind = value_kind::none;
+
+        if (_p.inOutStruct) {
+            if (_p.type) {
+                const std::string_view type = _p.type;
+
+                if (type == STR_MS_T) {
+                    kind = value_kind::string;
+                }
+                else if (type == INT_MS_T) {
+                    kind = value_kind::integer;
+                }
+                else if (type == DOUBLE_MS_T) {
+                    kind = value_kind::double_precision;
+                }
+                else if (type == FLOAT_MS_T) {
+                    kind = value_kind::single_precision;
+                }
+                else {
+                    rodsLog(LOG_WARNING, "Microservice parameter type is not supported. Ignoring parameter.");
+                }
+            }
+            else {
+                rodsLog(LOG_WARNING, "Cannot store microservice parameter (MsParam::inOutStruct). "
+                                     "No type information available.");
+            }
+        }
+
+        _w.write_byte(static_cast<std::uint8_t>(kind));
+
+        switch (kind) {
+            case value_kind::string:
+                _w.write_string(_p.type);
+                _w.write_string(static_cast<const char*>(_p.inOutStruct));
+                break;
+
+            case value_kind::integer:
+                _w.write_string(_p.type);
+                _w.write_int(*static_cast<const int*>(_p.inOutStruct));
+                break;
+
+            case value_kind::double_precision:
+                _w.write_string(_p.type);
+                _w.write_fixed(*static_cast<const double*>(_p.inOutStruct));
+                break;
+
+            case value_kind::single_precision:
+                _w.write_string(_p.type);
+                _w.write_fixed(*static_cast<const float*>(_p.inOutStruct));
+                break;
+
+            default:
+                break;
+        }
+
+        if (_p.inpOutBuf) {
+            rodsLog(LOG_WARNING, "Cannot store microservice parameter (MsParam::inpOutBuf).");
+        }
+    }
+
+    auto read_ms_param(reader& _r) -> MsParam*
+    {
+        auto* p = static_cast<msParam_t*>(std::calloc(1, sizeof(msParam_t)));
+
+        try {
+            p->label = _r.read_strdup();
+
+            const auto kind = static_cast<value_kind>(_r.read_byte());
+
+            if (kind == value_kind::none) {
+                return p;
+            }
+
+            p->type = _r.read_strdup();
+
+            switch (kind) {
+                case value_kind::string:
+                    p->inOutStruct = _r.read_strdup();
+                    break;
+
+                case value_kind::integer: {
+                    auto* v = static_cast<int*>(std::malloc(sizeof(int)));
+                    p->inOutStruct = v;
+                    *v = static_cast<int>(_r.read_int());
+                    break;
+                }
+
+                case value_kind::double_precision: {
+                    auto* v = static_cast<double*>(std::malloc(sizeof(double)));
+                    p->inOutStruct = v;
+                    *v = _r.read_fixed<double>();
+                    break;
+                }
+
+                case value_kind::single_precision: {
+                    auto* v = static_cast<float*>(std::malloc(sizeof(float)));
+                    p->inOutStruct = v;
+                    *v = _r.read_fixed<float>();
+                    break;
+                }
+
+                default:
+                    THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context contains an invalid parameter.");
+            }
+
+            return p;
+        }
+        catch (...) {
+            clearMsParam(p, 1);
+            std::free(p);
+            throw;
+        }
+    }
+
+    auto write_ms_param_array(writer& _w, const MsParamArray* _p) -> void
+    {
+        _w.write_byte(_p ? 1 : 0);
+
+        if (!_p) {
+            return;
+        }
+
+        _w.write_int(_p->oprType);
+
+        std::uint64_t count = 0;
+
+        for (int i = 0; i < _p->len; ++i) {
+            count += _p->msParam[i] ? 1 : 0;
+        }
+
+        _w.write_varint(count);
+
+        for (int i = 0; i < _p->len; ++i) {
+            if (_p->msParam[i]) {
+                write_ms_param(_w, *_p->msParam[i]);
+            }
+        }
+    }
+
+    // The array is attached to \p _rei as soon as it is allocated, so that it is released
+    // with the REI if decoding fails.
+    auto read_ms_param_array(reader& _r, RuleExecInfo& _rei) -> void
+    {
+        if (_r.read_byte() == 0) {
+            return;
+        }
+
+        auto* p = static_cast<msParamArray_t*>(std::calloc(1, sizeof(msParamArray_t)));
+        _rei.msParamArray = p;
+
+        p->oprType = static_cast<int>(_r.read_int());
+
+        const auto count = _r.read_varint();
+
+        // Every parameter occupies at least two bytes.
+        if (count > _r.remaining() / 2) {
+            THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context is truncated.");
+        }
+
+        p->msParam = static_cast<msParam_t**>(std::calloc(count + 1, sizeof(msParam_t*)));
+
+        for (std::uint64_t i = 0; i < count; ++i) {
+            p->msParam[p->len] = read_ms_param(_r);
+            ++p->len;
+        }
+    }
+
+    auto write_user_info(writer& _w, const UserInfo* _p) -> void
+    {
+        _w.write_byte(_p ? 1 : 0);
+
+        if (!_p) {
+            return;
+        }
+
+        _w.write_string(_p->userName);
+        _w.write_string(_p->userType);
+        _w.write_string(_p->rodsZone);
+        _w.write_int(_p->sysUid);
+
+        const auto& auth = _p->authInfo;
+        _w.write_string(auth.authScheme);
+        _w.write_int(auth.authFlag);
+        _w.write_int(auth.flag);
+        _w.write_int(auth.ppid);
+        _w.write_string(auth.host);
+        _w.write_string(auth.authStr);
+
+        const auto& other = _p->userOtherInfo;
+        _w.write_string(other.userInfo);
+        _w.write_string(other.userComments);
+        _w.write_string(other.userCreate);
+        _w.write_string(other.userModify);
+    }
+
+    auto read_user_info(reader& _r, UserInfo*& _out) -> void
+    {
+        if (_r.read_byte() == 0) {
+            return;
+        }
+
+        auto* p = static_cast<userInfo_t*>(std::calloc(1, sizeof(userInfo_t)));
+        _out = p;
+
+        _r.read_string(p->userName);
+        _r.read_string(p->userType);
+        _r.read_string(p->rodsZone);
+        p->sysUid = static_cast<int>(_r.read_int());
+
+        auto& auth = p->authInfo;
+        _r.read_string(auth.authScheme);
+        auth.authFlag = static_cast<int>(_r.read_int());
+        auth.flag = static_cast<int>(_r.read_int());
+        auth.ppid = static_cast<int>(_r.read_int());
+        _r.read_string(auth.host);
+        _r.read_string(auth.authStr);
+
+        auto& other = p->userOtherInfo;
+        _r.read_string(other.userInfo);
+        _r.read_string(other.userComments);
+        _r.read_string(other.userCreate);
+        _r.read_string(other.userModify);
+    }
+
+    auto write_key_value_pair(writer& _w, const KeyValPair* _p) -> void
+    {
+        _w.write_byte(_p ? 1 : 0);
+
+        if (!_p) {
+            return;
+        }
+
+        _w.write_varint(_p->len);
+
+        for (int i = 0; i < _p->len; ++i) {
+            _w.write_string(_p->keyWord[i]);
+            _w.write_string(_p->value[i]);
+        }
+    }
+
+    auto read_key_value_pair(reader& _r, RuleExecInfo& _rei) -> void
+    {
+        if (_r.read_byte() == 0) {
+            return;
+        }
+
+        auto* p = static_cast<keyValPair_t*>(std::calloc(1, sizeof(keyValPair_t)));
+        _rei.condInputData = p;
+
+        const auto count = _r.read_varint();
+
+        // Every pair occupies at least two bytes.
+        if (count > _r.remaining() / 2) {
+            THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context is truncated.");
+        }
+
+        std::string key;
+
+        for (std::uint64_t i = 0; i < count; ++i) {
+            key = _r.read_string();
+            addKeyVal(p, key.c_str(), std::string{_r.read_string()}.c_str());
+        }
+    }
+
+    auto base64_encode(const std::string& _binary) -> std::string
+    {
+        unsigned long size = 4 * ((_binary.size() + 2) / 3) + 1;
+        std::string encoded(size, '\0');
+
+        const auto* in = reinterpret_cast<const unsigned char*>(_binary.data());
+        auto* out = reinterpret_cast<unsigned char*>(encoded.data());
+
+        if (const auto ec = ::base64_encode(in, _binary.size(), out, &size); ec != 0) {
+            THROW(ec, "Failed to encode rule execution context.");
+        }
+
+        encoded.resize(size);
+
+        return encoded;
+    }
+
+    auto base64_decode(std::string_view _encoded) -> std::string
+    {
+        unsigned long size = 3 * (_encoded.size() / 4) + 3;
+        std::string binary(size, '\0');
+
+        const auto* in = reinterpret_cast<const unsigned char*>(_encoded.data());
+        auto* out = reinterpret_cast<unsigned char*>(binary.data());
+
+        if (const auto ec = ::base64_decode(in, _encoded.size(), out, &size); ec != 0) {
+            THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context is not valid base64.");
+        }
+
+        binary.resize(size);
+
+        return binary;
+    }
+
+    auto decode_binary(std::string_view _context) -> RuleExecInfo
+    {
+        // Skip the prefix and read the version.
+        _context.remove_prefix(rec::prefix.size());
+
+        const auto colon = _context.find(':');
+
+        if (colon == std::string_view::npos || _context.substr(0, colon) != std::to_string(rec::version)) {
+            THROW(SYS_INVALID_INPUT_PARAM,
+                  fmt::format("Unsupported rule execution context version [{}].", _context.substr(0, colon)));
+        }
+
+        const auto binary = base64_decode(_context.substr(colon + 1));
+        reader r{binary};
+
+        ruleExecInfo_t rei{};
+
+        try {
+            r.read_string(rei.ruleName);
+            r.read_string(rei.pluginInstanceName);
+            r.read_string(rei.rescName);
+            read_ms_param_array(r, rei);
+            read_user_info(r, rei.uoic);
+            read_user_info(r, rei.uoip);
+            read_user_info(r, rei.uoio);
+            read_key_value_pair(r, rei);
+
+            if (r.remaining() > 0) {
+                THROW(SYS_INVALID_INPUT_PARAM, "Rule execution context contains trailing bytes.");
+            }
+        }
+        catch (...) {
+            freeRuleExecInfoInternals(&rei, FREE_MS_PARAM);
+            throw;
+        }
+
+        return rei;
+    }
+} // anonymous namespace
+
+namespace irods::rule_execution_context
+{
+    auto encode(const RuleExecInfo& _rei) -> std::string
+    {
+        writer w;
+
+        w.write_string(_rei.ruleName);
+        w.write_string(_rei.pluginInstanceName);
+        w.write_string(_rei.rescName);
+        write_ms_param_array(w, _rei.msParamArray);
+        write_user_info(w, _rei.uoic);
+        write_user_info(w, _rei.uoip);
+        write_user_info(w, _rei.uoio);
+        write_key_value_pair(w, _rei.condInputData);
+
+        std::string context{prefix};
+        context += std::to_string(version);
+        context += ':';
+        context += base64_encode(w.buffer());
+
+        return context;
+    }
+
+    auto is_binary(std::string_view _context) noexcept -> bool
+    {
+        return _context.substr(0, prefix.size()) == prefix;
+    }
+
+    auto decode(std::string_view _context) -> RuleExecInfo
+    {
+        if (is_binary(_context)) {
+            return decode_binary(_context);
+        }
+
+        return irods::to_rule_execution_info(_context);
+    }
+} // namespace irods::rule_execution_context
@@ -0,0 +1,620 @@
+#include "server_connection_broker.hpp"
+
+#include "connection_health.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_logger.hpp"
+#include "irods_server_properties.hpp"
+#include "irods_threads.hpp"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "sockComm.h"
+
+#include <boost/any.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace irods::experimental::server_connection_broker
+{
+    namespace
+    {
+        using log = irods::experimental::log;
+        using clock_type = std::chrono::steady_clock;
+
+        enum class operation : int
+        {
+            lease = 1,
+            release
+        }; // enum class operation
+
+        // The fixed-size message exchanged between agents and the broker. Both ends are
+        // the same binary on the same host, so the message is sent as-is.
+        struct message
+        {
+            operation op;
+            int status;
+            int port;
+            int window_size;
+            char host[NAME_LEN];
+            char proxy_user_name[NAME_LEN];
+            char proxy_zone[NAME_LEN];
+            char client_user_name[NAME_LEN];
+            char client_zone[NAME_LEN];
+            char negotiation_results[MAX_NAME_LEN];
+            version_t server_version;
+            sockaddr_in local_address;
+            sockaddr_in remote_address;
+        }; // struct message
+
+        struct idle_connection
+        {
+            int socket;
+            message info;
+            clock_type::time_point released_at;
+        }; // struct idle_connection
+
+        struct broker_config
+        {
+            int maximum_idle_connections = 64;
+            int maximum_idle_connections_per_peer = 4;
+            std::chrono::seconds idle_timeout{30};
+        }; // struct broker_config
+
+        // The time release() waits for the peer to answer a heartbeat.
+        constexpr int heartbeat_timeout_in_seconds = 5;
+
+        std::string g_socket_file;
+
+        volatile std::sig_atomic_t g_terminate = 0;
+
+        auto read_int(const std::unordered_map<std::string, boost::any>& _settings,
+                      const std::string& _key,
+                      int _default) -> int
+        {
+            if (const auto iter = _settings.find(_key); iter != std::end(_settings)) {
+                const auto value = boost::any_cast<int>(iter->second);
+
+                if (value >= 0) {
+                    return value;
+                }
+
+                rodsLog(LOG_ERROR, "Invalid value for server connection broker setting [%s=%d]. Using default [%d].",
+                        _key.data(), value, _default);
+            }
+
+            return _default;
+        } // read_int
+
+        auto read_config() -> broker_config
+        {
+            broker_config config;
+
+            try {
+                using map_type = std::unordered_map<std::string, boost::any>;
+                const auto& settings = get_advanced_setting<map_type&>(CFG_SERVER_CONNECTION_BROKER_KW);
+
+                config.maximum_idle_connections =
+                    read_int(settings, CFG_MAXIMUM_IDLE_CONNECTIONS_KW, config.maximum_idle_connections);
+
+                config.maximum_idle_connections_per_peer =
+                    read_int(settings, CFG_MAXIMUM_IDLE_CONNECTIONS_PER_PEER_KW, config.maximum_idle_connections_per_peer);
+
+                config.idle_timeout = std::chrono::seconds{
+                    read_int(settings, CFG_IDLE_TIMEOUT_IN_SECONDS_KW, static_cast<int>(config.idle_timeout.count()))};
+            }
+            catch (...) {
+                rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Using defaults.",
+                        CFG_ADVANCED_SETTINGS_KW.data(), CFG_SERVER_CONNECTION_BROKER_KW.data());
+            }
+
+            return config;
+        } // read_config
+
+        auto is_enabled() -> bool
+        {
+            static const bool enabled = !g_socket_file.empty() && read_config().maximum_idle_connections > 0;
+            return enabled;
+        } // is_enabled
+
+        auto make_key(const message& _msg) -> std::string
+        {
+            return fmt::format("{}:{}:{}#{}:{}#{}",
+                               _msg.host,
+                               _msg.port,
+                               _msg.proxy_user_name,
+                               _msg.proxy_zone,
+                               _msg.client_user_name,
+                               _msg.client_zone);
+        } // make_key
+
+        auto send_message(int _socket, const message& _msg, int _passed_socket = -1) -> bool
+        {
+            iovec iov{};
+            iov.iov_base = const_cast<message*>(&_msg);
+            iov.iov_len = sizeof(message);
+
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+
+            union {
+                cmsghdr cm;
+                char control[CMSG_SPACE(sizeof(int))];
+            } control_un{};
+
+            if (_passed_socket >= 0) {
+                msg.msg_control = control_un.control;
+                msg.msg_controllen = sizeof(control_un.control);
+
+                cmsghdr* cmptr = CMSG_FIRSTHDR(&msg);
+                cmptr->cmsg_len = CMSG_LEN(sizeof(int));
+                cmptr->cmsg_level = SOL_SOCKET;
+                cmptr->cmsg_type = SCM_RIGHTS;
+                std::memcpy(CMSG_DATA(cmptr), &_passed_socket, sizeof(int));
+            }
+
+            return sendmsg(_socket, &msg, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(message));
+        } // send_message
+
+        auto receive_message(int _socket, message& _msg, int* _passed_socket = nullptr) -> bool
+        {
+            iovec iov{};
+            iov.iov_base = &_msg;
+            iov.iov_len = sizeof(message);
+
+            union {
+                cmsghdr cm;
+                char control[CMSG_SPACE(sizeof(int))];
+            } control_un{};
+
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control_un.control;
+            msg.msg_controllen = sizeof(control_un.control);
+
+            if (recvmsg(_socket, &msg, MSG_WAITALL) != static_cast<ssize_t>(sizeof(message))) {
+                return false;
+            }
+
+            int passed_socket = -1;
+
+            for (cmsghdr* cmptr = CMSG_FIRSTHDR(&msg); cmptr; cmptr = CMSG_NXTHDR(&msg, cmptr)) {
+                if (cmptr->cmsg_level == SOL_SOCKET && cmptr->cmsg_type == SCM_RIGHTS) {
+                    std::memcpy(&passed_socket, CMSG_DATA(cmptr), sizeof(int));
+                }
+            }
+
+            if (_passed_socket) {
+                *_passed_socket = passed_socket;
+            }
+            else if (passed_socket >= 0) {
+                close(passed_socket);
+            }
+
+            return true;
+        } // receive_message
+
+        auto connect_to_broker() -> int
+        {
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", g_socket_file.data());
+
+            const int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+
+            if (sock < 0) {
+                return -1;
+            }
+
+            // The broker answers immediately. Never let a stuck broker stall an agent.
+            timeval timeout{5, 0};
+            setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+            if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+                close(sock);
+                return -1;
+            }
+
+            return sock;
+        } // connect_to_broker
+
+        // An idle connection must have nothing to read. Readable data or a hang-up means
+        // the peer closed its end or the protocol stream is out of sync.
+        auto is_idle(int _socket) -> bool
+        {
+            pollfd pfd{_socket, POLLIN, 0};
+            return poll(&pfd, 1, 0) == 0;
+        } // is_idle
+
+        auto copy_user(const userInfo_t& _user, char (&_name)[NAME_LEN], char (&_zone)[NAME_LEN]) -> void
+        {
+            std::snprintf(_name, NAME_LEN, "%s", _user.userName);
+            std::snprintf(_zone, NAME_LEN, "%s", _user.rodsZone);
+        } // copy_user
+
+        class broker
+        {
+        public:
+            explicit broker(const broker_config& _config)
+                : config_{_config}
+            {
+            }
+
+            auto handle(int _peer) -> void
+            {
+                message msg{};
+                int passed_socket = -1;
+
+                if (!receive_message(_peer, msg, &passed_socket)) {
+                    log::network::debug("Server connection broker could not read request.");
+                    return;
+                }
+
+                switch (msg.op) {
+                    case operation::lease:
+                        handle_lease(_peer, msg);
+                        break;
+
+                    case operation::release:
+                        handle_release(_peer, msg, passed_socket);
+                        break;
+
+                    default:
+                        if (passed_socket >= 0) {
+                            close(passed_socket);
+                        }
+                        break;
+                }
+            } // handle
+
+            auto evict_idle_connections() -> void
+            {
+                const auto now = clock_type::now();
+
+                for (auto iter = std::begin(pool_); iter != std::end(pool_);) {
+                    auto& connections = iter->second;
+
+                    const auto expired = [&](const idle_connection& _c) {
+                        if (now - _c.released_at > config_.idle_timeout || !is_idle(_c.socket)) {
+                            close(_c.socket);
+                            return true;
+                        }
+
+                        return false;
+                    };
+
+                    const auto end = std::remove_if(std::begin(connections), std::end(connections), expired);
+                    size_ -= std::distance(end, std::end(connections));
+                    connections.erase(end, std::end(connections));
+
+                    iter = connections.empty() ? pool_.erase(iter) : std::next(iter);
+                }
+            } // evict_idle_connections
+
+            auto close_all() -> void
+            {
+                for (auto& [key, connections] : pool_) {
+                    for (auto& c : connections) {
+                        close(c.socket);
+                    }
+                }
+
+                pool_.clear();
+                size_ = 0;
+            } // close_all
+
+        private:
+            auto handle_lease(int _peer, message& _msg) -> void
+            {
+                const auto key = make_key(_msg);
+
+                if (auto iter = pool_.find(key); iter != std::end(pool_)) {
+                    auto& connections = iter->second;
+
+                    // The most recently released connection is the least likely to have
+                    // been closed by the peer.
+                    while (!connections.empty()) {
+                        auto c = connections.back();
+                        connections.pop_back();
+                        --size_;
+
+                        if (!is_idle(c.socket)) {
+                            close(c.socket);
+                            continue;
+                        }
+
+                        c.info.op = operation::lease;
+                        c.info.status = 0;
+
+                        if (send_message(_peer, c.info, c.socket)) {
+                            log::network::trace("Server connection broker leased connection [{}].", key);
+                        }
+
+                        // The agent holds its own copy of the descriptor now.
+                        close(c.socket);
+
+                        if (connections.empty()) {
+                            pool_.erase(iter);
+                        }
+
+                        return;
+                    }
+
+                    pool_.erase(iter);
+                }
+
+                _msg.status = SYS_SVR_TO_SVR_CONNECT_FAILED;
+                send_message(_peer, _msg);
+            } // handle_lease
+
+            auto handle_release(int _peer, message& _msg, int _passed_socket) -> void
+            {
+                if (_passed_socket < 0) {
+                    _msg.status = SYS_INTERNAL_NULL_INPUT_ERR;
+                    send_message(_peer, _msg);
+                    return;
+                }
+
+                const auto key = make_key(_msg);
+                auto& connections = pool_[key];
+
+                if (size_ >= config_.maximum_idle_connections ||
+                    static_cast<int>(connections.size()) >= config_.maximum_idle_connections_per_peer)
+                {
+                    if (connections.empty()) {
+                        pool_.erase(key);
+                    }
+
+                    close(_passed_socket);
+                    _msg.status = SYS_SVR_TO_SVR_CONNECT_FAILED;
+                }
+                else {
+                    connections.push_back({_passed_socket, _msg, clock_type::now()});
+                    ++size_;
+                    _msg.status = 0;
+
+                    log::network::trace("Server connection broker pooled connection [{}].", key);
+                }
+
+                // The agent waits for the answer before freeing its side of the connection.
+                send_message(_peer, _msg);
+            } // handle_release
+
+            broker_config config_;
+            std::map<std::string, std::vector<idle_connection>> pool_;
+            int size_ = 0;
+        }; // class broker
+
+        auto terminate_broker(int) -> void
+        {
+            g_terminate = 1;
+        } // terminate_broker
+    } // anonymous namespace
+
+    auto set_socket_file(std::string_view _socket_file) -> void
+    {
+        g_socket_file = _socket_file;
+    } // set_socket_file
+
+    auto run() -> int
+    {
+        log::set_server_type("connection_broker");
+
+        std::signal(SIGINT, terminate_broker);
+        std::signal(SIGHUP, terminate_broker);
+        std::signal(SIGTERM, terminate_broker);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        const auto parent_pid = getppid();
+        const auto config = read_config();
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", g_socket_file.data());
+
+        const int listen_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (listen_socket < 0) {
+            rodsLog(LOG_ERROR, "Unable to create server connection broker socket, errno = [%d]: %s", errno, strerror(errno));
+            return SYS_SOCK_OPEN_ERR;
+        }
+
+        unlink(addr.sun_path);
+
+        if (bind(listen_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            rodsLog(LOG_ERROR, "Unable to bind server connection broker socket, errno = [%d]: %s", errno, strerror(errno));
+            close(listen_socket);
+            return SYS_SOCK_BIND_ERR;
+        }
+
+        if (listen(listen_socket, SOMAXCONN) < 0) {
+            rodsLog(LOG_ERROR, "Unable to listen on server connection broker socket, errno = [%d]: %s", errno, strerror(errno));
+            close(listen_socket);
+            unlink(addr.sun_path);
+            return SYS_SOCK_LISTEN_ERR;
+        }
+
+        log::network::info("Server connection broker started [max_idle_connections={}, max_idle_connections_per_peer={}, idle_timeout={}s].",
+                           config.maximum_idle_connections,
+                           config.maximum_idle_connections_per_peer,
+                           config.idle_timeout.count());
+
+        broker b{config};
+
+        // The socket lives in a directory only the service account can access. Checking the
+        // credentials of the peer also rejects processes that inherited a descriptor to it.
+        const auto uid = getuid();
+
+        while (!g_terminate && getppid() == parent_pid) {
+            b.evict_idle_connections();
+
+            pollfd pfd{listen_socket, POLLIN, 0};
+
+            if (poll(&pfd, 1, 1000) <= 0) {
+                continue;
+            }
+
+            const int peer = accept(listen_socket, nullptr, nullptr);
+
+            if (peer < 0) {
+                continue;
+            }
+
+            ucred credentials{};
+            socklen_t length = sizeof(credentials);
+
+            if (getsockopt(peer, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 && credentials.uid == uid) {
+                timeval timeout{5, 0};
+                setsockopt(peer, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                setsockopt(peer, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+                b.handle(peer);
+            }
+
+            close(peer);
+        }
+
+        b.close_all();
+        close(listen_socket);
+        unlink(addr.sun_path);
+
+        log::network::info("Server connection broker exited.");
+
+        return 0;
+    } // run
+
+    auto lease(const char* _host,
+               int _port,
+               const userInfo_t& _proxy_user,
+               const userInfo_t& _client_user) -> rcComm_t*
+    {
+        if (!is_enabled()) {
+            return nullptr;
+        }
+
+        message msg{};
+        msg.op = operation::lease;
+        msg.port = _port;
+        std::snprintf(msg.host, sizeof(msg.host), "%s", _host);
+        copy_user(_proxy_user, msg.proxy_user_name, msg.proxy_zone);
+        copy_user(_client_user, msg.client_user_name, msg.client_zone);
+
+        const int broker_socket = connect_to_broker();
+
+        if (broker_socket < 0) {
+            return nullptr;
+        }
+
+        int sock = -1;
+        const bool received = send_message(broker_socket, msg) && receive_message(broker_socket, msg, &sock);
+        close(broker_socket);
+
+        if (!received || msg.status < 0 || sock < 0) {
+            if (sock >= 0) {
+                close(sock);
+            }
+
+            return nullptr;
+        }
+
+        // Rebuild the connection handle the way _rcConnect would have left it after a
+        // successful connect and login.
+        auto* conn = static_cast<rcComm_t*>(std::malloc(sizeof(rcComm_t)));
+        std::memset(conn, 0, sizeof(rcComm_t));
+
+        conn->thread_ctx = static_cast<thread_context*>(std::malloc(sizeof(thread_context)));
+        std::memset(conn->thread_ctx, 0, sizeof(thread_context));
+
+        conn->svrVersion = static_cast<version_t*>(std::malloc(sizeof(version_t)));
+        std::memcpy(conn->svrVersion, &msg.server_version, sizeof(version_t));
+
+        conn->irodsProt = NATIVE_PROT;
+        conn->sock = sock;
+        conn->portNum = msg.port;
+        conn->loggedIn = 1;
+        conn->windowSize = msg.window_size;
+        conn->localAddr = msg.local_address;
+        conn->remoteAddr = msg.remote_address;
+        std::snprintf(conn->host, sizeof(conn->host), "%s", msg.host);
+        std::snprintf(conn->negotiation_results, sizeof(conn->negotiation_results), "%s", msg.negotiation_results);
+        setUserInfo(msg.proxy_user_name, msg.proxy_zone, msg.client_user_name, msg.client_zone,
+                    &conn->clientUser, &conn->proxyUser);
+
+        log::network::debug("Reusing pooled connection to [{}:{}].", msg.host, msg.port);
+
+        return conn;
+    } // lease
+
+    auto release(rcComm_t* _conn) -> bool
+    {
+        if (!_conn || !is_enabled()) {
+            return false;
+        }
+
+        // The state of SSL and reconnect threads cannot be moved to another process.
+        if (_conn->ssl_on || _conn->loggedIn != 1 || _conn->irodsProt != NATIVE_PROT || !_conn->svrVersion ||
+            (_conn->thread_ctx && _conn->thread_ctx->reconnThr) || !is_idle(_conn->sock))
+        {
+            return false;
+        }
+
+        // An empty receive buffer does not prove that no reply is on its way. The peer
+        // answers messages in order, so receiving the answer to a heartbeat does. Peers
+        // that do not answer heartbeats are never pooled.
+        if (connection_health::send_heartbeat(*_conn, heartbeat_timeout_in_seconds) < 0) {
+            log::network::debug("Connection to [{}:{}] is not quiescent. Closing it.", _conn->host, _conn->portNum);
+            return false;
+        }
+
+        message msg{};
+        msg.op = operation::release;
+        msg.port = _conn->portNum;
+        msg.window_size = _conn->windowSize;
+        msg.local_address = _conn->localAddr;
+        msg.remote_address = _conn->remoteAddr;
+        std::memcpy(&msg.server_version, _conn->svrVersion, sizeof(version_t));
+        std::snprintf(msg.host, sizeof(msg.host), "%s", _conn->host);
+        std::snprintf(msg.negotiation_results, sizeof(msg.negotiation_results), "%s", _conn->negotiation_results);
+        copy_user(_conn->proxyUser, msg.proxy_user_name, msg.proxy_zone);
+        copy_user(_conn->clientUser, msg.client_user_name, msg.client_zone);
+
+        const int broker_socket = connect_to_broker();
+
+        if (broker_socket < 0) {
+            return false;
+        }
+
+        const bool accepted = send_message(broker_socket, msg, _conn->sock) &&
+                              receive_message(broker_socket, msg) &&
+                              msg.status >= 0;
+        close(broker_socket);
+
+        if (!accepted) {
+            return false;
+        }
+
+        // The broker holds the connection now. Free the handle without sending a
+        // disconnect message to the peer.
+        close(_conn->sock);
+        freeRcComm(_conn);
+
+        return true;
+    } // release
+} // namespace irods::experimental::server_connection_broker
@@ -20,6 +20,17 @@
 // =-=-=-=-=-=-=-
 #include "irods_resource_backport.hpp"
 #include "irods_stacktrace.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsConnect.h"
+#include "scoped_privileged_client.hpp"
+#include "special_collection_index.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sci = irods::experimental::special_collection_index;
 
 static int HaveFailedSpecCollPath = 0;
 static char FailedSpecCollPath[MAX_NAME_LEN];
@@ -251,6 +262,120 @@ matchSpecCollCache(const char *objPath ) {
     return NULL;
 }
 
+/* refreshSpecCollIndex - replace the contents of the special collection index
+ * with the names of all special collections in the local zone.
+ */
+static int
+refreshSpecCollIndex( rsComm_t *rsComm ) {
+    genQueryInp_t genQueryInp;
+    genQueryOut_t *genQueryOut = NULL;
+    char condStr[MAX_NAME_LEN];
+    std::vector<std::string> collections;
+    int status;
+
+    // Read before the query so that changes made while it runs are detected.
+    const auto generation = sci::generation();
+
+    memset( &genQueryInp, 0, sizeof( genQueryInp ) );
+
+    rstrcpy( condStr, "like '_%'", MAX_NAME_LEN );
+    addInxVal( &genQueryInp.sqlCondInp, COL_COLL_TYPE, condStr );
+    addInxIval( &genQueryInp.selectInp, COL_COLL_NAME, 1 );
+
+    genQueryInp.maxRows = MAX_SQL_ROWS;
+
+    {
+        // The index is shared by all clients, so it must not be limited to the
+        // collections visible to the current client.
+        irods::experimental::scoped_privileged_client spc{*rsComm};
+
+        while ( ( status = rsGenQuery( rsComm, &genQueryInp, &genQueryOut ) ) >= 0 ) {
+            sqlResult_t *collection = getSqlResultByInx( genQueryOut, COL_COLL_NAME );
+            if ( collection == NULL ) {
+                status = UNMATCHED_KEY_OR_INDEX;
+                break;
+            }
+
+            for ( int i = 0; i < genQueryOut->rowCnt; ++i ) {
+                collections.emplace_back( &collection->value[collection->len * i] );
+            }
+
+            genQueryInp.continueInx = genQueryOut->continueInx;
+            freeGenQueryOut( &genQueryOut );
+
+            if ( genQueryInp.continueInx == 0 ) {
+                break;
+            }
+        }
+    }
+
+    freeGenQueryOut( &genQueryOut );
+    clearGenQueryInp( &genQueryInp );
+
+    if ( status < 0 && status != CAT_NO_ROWS_FOUND ) {
+        return status;
+    }
+
+    try {
+        if ( !sci::assign( collections, generation ) ) {
+            return SYS_SPEC_COLL_NOT_IN_CACHE;
+        }
+    }
+    catch ( const std::exception& e ) {
+        rodsLog( LOG_NOTICE,
+                 "refreshSpecCollIndex: could not store %zu collections in the special collection index: %s",
+                 collections.size(), e.what() );
+        return SYS_INTERNAL_ERR;
+    }
+
+    return 0;
+}
+
+/* isPathInSpecCollIndex - returns false only if the special collection index
+ * proves that objPath is not in the path of a special collection. Any other
+ * outcome means the catalog must be consulted.
+ *
+ * The index is only enabled on the catalog provider, which sees every change
+ * to the special collections of the zone (see special_collection_index.hpp).
+ */
+static bool
+isPathInSpecCollIndex( rsComm_t *rsComm, const char *objPath ) {
+    if ( !sci::enabled() ) {
+        return true;
+    }
+
+    static const std::chrono::seconds maxAge{irods::get_special_collection_index_refresh_interval()};
+
+    // The index only covers the local zone.
+    const char *localZone = getLocalZoneName();
+    if ( localZone == NULL ) {
+        return true;
+    }
+
+    const std::string zonePrefix = std::string{"/"} + localZone + "/";
+    if ( std::string_view{objPath}.compare( 0, zonePrefix.size(), zonePrefix ) != 0 ) {
+        return true;
+    }
+
+    try {
+        auto inIndex = sci::lookup( objPath, maxAge );
+        if ( !inIndex ) {
+            if ( refreshSpecCollIndex( rsComm ) < 0 ) {
+                return true;
+            }
+            inIndex = sci::lookup( objPath, maxAge );
+        }
+        return inIndex.value_or( true );
+    }
+    catch ( const std::exception& e ) {
+        rodsLog( LOG_NOTICE,
+                 "isPathInSpecCollIndex: special collection index lookup failed for %s: %s",
+                 objPath, e.what() );
+    }
+
+    return true;
+}
+
 int
 getSpecCollCache( rsComm_t *rsComm, char *objPath,
                   int inCachOnly, specCollCache_t **specCollCache ) {
@@ -264,6 +389,13 @@ getSpecCollCache( rsComm_t *rsComm, char *objPath,
         return SYS_SPEC_COLL_NOT_IN_CACHE;
     }
 
+    // Most paths are not in a special collection. On the catalog provider, the
+    // server-wide index answers that without a catalog query. A positive answer still requires
+    // querySpecColl for the details of the special collection.
+    if ( !isPathInSpecCollIndex( rsComm, objPath ) ) {
+        return CAT_NO_ROWS_FOUND;
+    }
+
     status = querySpecColl( rsComm, objPath, &genQueryOut );
     if ( status < 0 ) {
         freeGenQueryOut( &genQueryOut );
@@ -0,0 +1,306 @@
+#include "special_collection_index.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/set.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include "rodsLog.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <iterator>
+#include <memory>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace irods::experimental::special_collection_index
+{
+    namespace
+    {
+        namespace bi = boost::interprocess;
+
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
+
+        // clang-format off
+        using segment_manager_type = bi::managed_shared_memory::segment_manager;
+        using void_allocator_type  = bi::allocator<void, segment_manager_type>;
+        using char_allocator_type  = bi::allocator<char, segment_manager_type>;
+        using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+        using key_allocator_type   = bi::allocator<key_type, segment_manager_type>;
+        using set_type             = bi::set<key_type, std::less<key_type>, key_allocator_type>;
+        using clock_type           = std::chrono::system_clock;
+        // clang-format on
+
+        // Describes the contents of the set. Lives in shared memory next to the set.
+        struct index_state
+        {
+            // The seconds since epoch representing when the set was last assigned.
+            std::int64_t refreshed_at;
+
+            // Incremented whenever a writer starts or finishes.
+            std::uint64_t generation;
+
+            // The PIDs of the processes holding an update_guard. Zero marks a free slot.
+            std::array<pid_t, 64> writers;
+
+            // Set if a writer found no free slot. The index then never answers again.
+            bool overflowed;
+
+            // False until the first assignment and after every invalidation.
+            bool valid;
+        }; // struct index_state
+
+        //
+        // Global Variables
+        //
+
+        // The following variables define the names of shared memory objects and other properties.
+        std::string g_segment_name;
+        std::size_t g_segment_size;
+        std::string g_mutex_name;
+
+        // On initialization, holds the PID of the process that initialized the index.
+        // This ensures that only the process that initialized the system can deinitialize it.
+        pid_t g_owner_pid;
+
+        // The following are pointers to the shared memory objects and allocator.
+        // Allocating on the heap allows us to know when the index is constructed/destructed.
+        std::unique_ptr<bi::managed_shared_memory> g_segment;
+        std::unique_ptr<void_allocator_type> g_allocator;
+        std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+        set_type* g_set;
+        index_state* g_state;
+
+        auto current_timestamp_in_seconds() noexcept -> std::int64_t
+        {
+            return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+        }
+
+        auto has_writers() noexcept -> bool
+        {
+            const auto& w = g_state->writers;
+            return g_state->overflowed || std::any_of(std::begin(w), std::end(w), [](pid_t _pid) { return _pid != 0; });
+        }
+
+        // Frees the slots of writers that exited without releasing them. Their transactions
+        // ended with the process, so the catalog no longer changes on their behalf.
+        //
+        // Requires exclusive ownership of the mutex.
+        auto release_dead_writers() noexcept -> bool
+        {
+            bool released = false;
+
+            for (auto& pid : g_state->writers) {
+                if (pid != 0 && kill(pid, 0) == -1 && ESRCH == errno) {
+                    pid = 0;
+                    released = true;
+                }
+            }
+
+            return released;
+        }
+    } // anonymous namespace
+
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_set = g_segment->construct<set_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+        g_state = g_segment->construct<index_state>(bi::anonymous_instance)(index_state{});
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_set) {
+                g_segment->destroy_ptr(g_set);
+                g_set = nullptr;
+            }
+
+            if (g_segment && g_state) {
+                g_segment->destroy_ptr(g_state);
+                g_state = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto enabled() noexcept -> bool
+    {
+        return g_set != nullptr;
+    } // enabled
+
+    auto generation() -> std::uint64_t
+    {
+        if (!g_state) {
+            return 0;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+        return g_state->generation;
+    } // generation
+
+    auto assign(const std::vector<std::string>& _collections, std::uint64_t _generation) -> bool
+    {
+        if (!g_set) {
+            return false;
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+
+        // A writer that died may have been active while the catalog was queried.
+        if (release_dead_writers()) {
+            ++g_state->generation;
+            return false;
+        }
+
+        if (has_writers() || g_state->generation != _generation) {
+            return false;
+        }
+
+        g_set->clear();
+        g_state->valid = false;
+
+        // If the collections do not fit, the index stays invalid and agents fall back
+        // to querying the catalog.
+        for (const auto& c : _collections) {
+            g_set->emplace(c.data(), c.size(), *g_allocator);
+        }
+
+        g_state->refreshed_at = current_timestamp_in_seconds();
+        g_state->valid = true;
+
+        return true;
+    } // assign
+
+    auto invalidate() noexcept -> void
+    {
+        if (!g_state) {
+            return;
+        }
+
+        try {
+            bi::scoped_lock lk{*g_mutex};
+            g_state->valid = false;
+        }
+        catch (...) {}
+    } // invalidate
+
+    auto lookup(const std::string_view _path, std::chrono::seconds _max_age) -> std::optional<bool>
+    {
+        // Agents on hosts that did not initialize the index (e.g. unit tests) always consult the catalog.
+        if (!g_set) {
+            return std::nullopt;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+
+        if (!g_state->valid || has_writers() || current_timestamp_in_seconds() - g_state->refreshed_at > _max_age.count()) {
+            return std::nullopt;
+        }
+
+        if (g_set->empty()) {
+            return false;
+        }
+
+        // Test each ancestor of the path, from the shortest to the path itself. Each test
+        // is a logarithmic lookup, so the cost depends on the depth of the path and not
+        // on the number of special collections.
+        key_type prefix{*g_allocator};
+
+        for (std::string_view::size_type pos = 1; pos <= _path.size(); ++pos) {
+            if (pos == _path.size() || _path[pos] == '/') {
+                prefix.assign(_path.data(), pos);
+
+                if (g_set->find(prefix) != g_set->end()) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    } // lookup
+
+    update_guard::update_guard()
+    {
+        if (!g_state) {
+            return;
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+
+        ++g_state->generation;
+        g_state->valid = false;
+
+        auto& w = g_state->writers;
+
+        if (auto iter = std::find(std::begin(w), std::end(w), 0); iter != std::end(w)) {
+            *iter = getpid();
+            return;
+        }
+
+        if (!g_state->overflowed) {
+            rodsLog(LOG_ERROR, "Too many concurrent changes to special collections. "
+                               "The special collection index is disabled until the server restarts.");
+            g_state->overflowed = true;
+        }
+    } // update_guard
+
+    update_guard::~update_guard()
+    {
+        if (!g_state) {
+            return;
+        }
+
+        try {
+            bi::scoped_lock lk{*g_mutex};
+
+            ++g_state->generation;
+            g_state->valid = false;
+
+            auto& w = g_state->writers;
+
+            if (auto iter = std::find(std::begin(w), std::end(w), getpid()); iter != std::end(w)) {
+                *iter = 0;
+            }
+        }
+        catch (...) {}
+    } // ~update_guard
+} // namespace irods::experimental::special_collection_index
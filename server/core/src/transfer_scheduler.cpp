@@ -0,0 +1,540 @@
+#include "transfer_scheduler.hpp"
+
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsLog.h"
+
+#include <boost/any.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace irods::experimental::transfer_scheduler
+{
+    namespace
+    {
+        namespace bi = boost::interprocess;
+
+        // clang-format off
+        using segment_manager_type      = bi::managed_shared_memory::segment_manager;
+        using void_allocator_type       = bi::allocator<void, segment_manager_type>;
+        using char_allocator_type       = bi::allocator<char, segment_manager_type>;
+        using key_type                  = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+        using clock_type                = std::chrono::steady_clock;
+        // clang-format on
+
+        struct user_state
+        {
+            std::int64_t active_streams;
+            std::int64_t denied_streams;
+            std::int64_t bytes_transferred;
+            std::int64_t nanoseconds_throttled;
+
+            // The share of the server bandwidth relative to other users.
+            std::int64_t weight;
+
+            // The token bucket. Tokens are bytes and may go negative, in which case the
+            // streams of the user wait until the bucket is refilled.
+            double tokens;
+            std::int64_t last_refill;
+
+            // The last time the user acquired streams or moved bytes.
+            std::int64_t last_active;
+        }; // struct user_state
+
+        // Streams registered by a single process. Lives in shared memory.
+        struct registration
+        {
+            char user[256];
+            std::int64_t streams;
+        }; // struct registration
+
+        // The numeric limits of config. Lives in shared memory.
+        struct limits_type
+        {
+            std::int64_t maximum_number_of_streams;
+            std::int64_t maximum_number_of_streams_per_user;
+            std::int64_t maximum_bytes_per_second;
+            std::int64_t maximum_bytes_per_second_per_user;
+        }; // struct limits_type
+
+        struct scheduler_state
+        {
+            limits_type limits;
+            std::int64_t active_streams;
+
+            // The sum of the weights of the users with open streams.
+            std::int64_t active_weight;
+        }; // struct scheduler_state
+
+        // Users without open streams are forgotten after this long, so that the users of a
+        // long running server do not fill the segment.
+        constexpr std::int64_t idle_user_eviction_age_in_nanoseconds = 300'000'000'000;
+
+        // clang-format off
+        using user_value_type           = std::pair<const key_type, user_state>;
+        using user_allocator_type       = bi::allocator<user_value_type, segment_manager_type>;
+        using user_map_type             = bi::map<key_type, user_state, std::less<key_type>, user_allocator_type>;
+
+        using registration_value_type   = std::pair<const pid_t, registration>;
+        using registration_allocator    = bi::allocator<registration_value_type, segment_manager_type>;
+        using registration_map_type     = bi::map<pid_t, registration, std::less<pid_t>, registration_allocator>;
+        // clang-format on
+
+        //
+        // Global Variables
+        //
+
+        // The following variables define the names of shared memory objects and other properties.
+        std::string g_segment_name;
+        std::size_t g_segment_size;
+        std::string g_mutex_name;
+
+        // On initialization, holds the PID of the process that initialized the scheduler.
+        // This ensures that only the process that initialized the system can deinitialize it.
+        pid_t g_owner_pid;
+
+        // The following are pointers to the shared memory objects and allocator.
+        // Allocating on the heap allows us to know when the scheduler is constructed/destructed.
+        std::unique_ptr<bi::managed_shared_memory> g_segment;
+        std::unique_ptr<void_allocator_type> g_allocator;
+        std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+        user_map_type* g_users;
+        registration_map_type* g_registrations;
+        scheduler_state* g_state;
+
+        // Set by init() and inherited by the agents forked afterwards.
+        std::map<std::string, std::int64_t> g_user_weights;
+        bool g_bandwidth_limited;
+
+        auto now() noexcept -> std::int64_t
+        {
+            using std::chrono::duration_cast;
+            using std::chrono::nanoseconds;
+
+            return duration_cast<nanoseconds>(clock_type::now().time_since_epoch()).count();
+        } // now
+
+        // Forgets the users without open streams that were last active before _cutoff. The
+        // caller must hold the exclusive lock.
+        auto evict_idle_users(std::int64_t _cutoff) -> void
+        {
+            for (auto iter = g_users->begin(); iter != g_users->end();) {
+                if (iter->second.active_streams <= 0 && iter->second.last_active < _cutoff) {
+                    iter = g_users->erase(iter);
+                }
+                else {
+                    ++iter;
+                }
+            }
+        } // evict_idle_users
+
+        // Returns the state of _user, or nullptr if the segment has no room for it even after
+        // every user without open streams was forgotten. The caller must hold the exclusive lock.
+        auto find_or_insert_user(const std::string_view _user) -> user_state*
+        {
+            const auto insert = [_user] {
+                key_type key{_user.data(), _user.size(), *g_allocator};
+
+                if (auto iter = g_users->find(key); iter != g_users->end()) {
+                    return &iter->second;
+                }
+
+                user_state state{};
+                state.last_refill = state.last_active = now();
+
+                const auto weight = g_user_weights.find(std::string{_user});
+                state.weight = weight != std::end(g_user_weights) ? weight->second : 1;
+
+                return &g_users->emplace(std::move(key), state).first->second;
+            };
+
+            try {
+                if (auto iter = g_users->find(key_type{_user.data(), _user.size(), *g_allocator}); iter != g_users->end()) {
+                    return &iter->second;
+                }
+
+                evict_idle_users(now() - idle_user_eviction_age_in_nanoseconds);
+
+                return insert();
+            }
+            catch (const bi::bad_alloc&) {
+                evict_idle_users(now() + 1);
+            }
+
+            try {
+                return insert();
+            }
+            catch (const bi::bad_alloc&) {
+                rodsLog(LOG_ERROR, "transfer_scheduler: shared memory exhausted, not scheduling the streams of [%.*s].",
+                        static_cast<int>(_user.size()), _user.data());
+            }
+
+            return nullptr;
+        } // find_or_insert_user
+
+        // Adds _streams (which may be negative) to the open streams of _user and of the server.
+        // The caller must hold the exclusive lock.
+        auto add_streams(user_state* _user, std::int64_t _streams) -> void
+        {
+            g_state->active_streams += _streams;
+
+            if (!_user) {
+                return;
+            }
+
+            const bool was_active = _user->active_streams > 0;
+            _user->active_streams += _streams;
+            const bool is_active = _user->active_streams > 0;
+
+            if (was_active != is_active) {
+                g_state->active_weight += is_active ? _user->weight : -_user->weight;
+            }
+        } // add_streams
+
+        // Returns the streams of a registration to the pool. The caller must hold the exclusive lock.
+        auto unregister(registration_map_type::iterator _iter) -> void
+        {
+            const auto& r = _iter->second;
+            user_state* user = nullptr;
+
+            if (auto iter = g_users->find(key_type{r.user, *g_allocator}); iter != g_users->end()) {
+                user = &iter->second;
+            }
+
+            add_streams(user, -r.streams);
+            g_registrations->erase(_iter);
+        } // unregister
+
+        // Releases the streams of agents that exited without releasing them.
+        auto purge_exited_processes() -> void
+        {
+            for (auto iter = g_registrations->begin(); iter != g_registrations->end();) {
+                if (kill(iter->first, 0) == -1 && ESRCH == errno) {
+                    auto next = std::next(iter);
+                    unregister(iter);
+                    iter = next;
+                }
+                else {
+                    ++iter;
+                }
+            }
+        } // purge_exited_processes
+
+        // Returns the rate of the token bucket of _user in bytes per second, or 0 if the user is not limited.
+        auto rate_of(const user_state& _user) -> double
+        {
+            const auto& limits = g_state->limits;
+            double rate = 0;
+
+            if (limits.maximum_bytes_per_second > 0) {
+                auto shares = g_state->active_weight;
+
+                // A user that reports bytes without registered streams still takes a share.
+                if (_user.active_streams <= 0) {
+                    shares += _user.weight;
+                }
+
+                rate = static_cast<double>(limits.maximum_bytes_per_second) * _user.weight / std::max<std::int64_t>(1, shares);
+            }
+
+            if (limits.maximum_bytes_per_second_per_user > 0) {
+                const auto per_user = static_cast<double>(limits.maximum_bytes_per_second_per_user);
+                rate = rate > 0 ? std::min(rate, per_user) : per_user;
+            }
+
+            return rate;
+        } // rate_of
+
+        using map_type = std::unordered_map<std::string, boost::any>;
+
+        auto read_int(const map_type& _settings, const std::string& _key) -> std::int64_t
+        {
+            if (const auto iter = _settings.find(_key); iter != std::end(_settings)) {
+                const auto value = boost::any_cast<int>(iter->second);
+
+                if (value >= 0) {
+                    return value;
+                }
+
+                rodsLog(LOG_ERROR, "Invalid value for transfer scheduler setting [%s=%d]. The limit is disabled.",
+                        _key.data(), value);
+            }
+
+            return 0;
+        } // read_int
+
+        auto read_user_weights(const map_type& _settings) -> std::map<std::string, std::int64_t>
+        {
+            std::map<std::string, std::int64_t> weights;
+
+            const auto iter = _settings.find(irods::CFG_USER_WEIGHTS_KW);
+            if (iter == std::end(_settings)) {
+                return weights;
+            }
+
+            for (const auto& [user, value] : boost::any_cast<const map_type&>(iter->second)) {
+                const auto weight = boost::any_cast<int>(value);
+
+                if (weight <= 0) {
+                    rodsLog(LOG_ERROR, "Invalid transfer scheduler weight for user [%s=%d]. Using the default [1].",
+                            user.data(), weight);
+                    continue;
+                }
+
+                weights[user] = weight;
+            }
+
+            return weights;
+        } // read_user_weights
+    } // anonymous namespace
+
+    auto read_config() -> config
+    {
+        config cfg;
+
+        try {
+            const auto& settings = irods::get_advanced_setting<map_type&>(irods::CFG_TRANSFER_SCHEDULER_KW);
+
+            constexpr std::int64_t megabyte = 1024 * 1024;
+
+            cfg.maximum_number_of_streams = read_int(settings, irods::CFG_MAXIMUM_NUMBER_OF_STREAMS_KW);
+            cfg.maximum_number_of_streams_per_user = read_int(settings, irods::CFG_MAXIMUM_NUMBER_OF_STREAMS_PER_USER_KW);
+            cfg.maximum_bytes_per_second = read_int(settings, irods::CFG_MAXIMUM_MEGABYTES_PER_SECOND_KW) * megabyte;
+            cfg.maximum_bytes_per_second_per_user = read_int(settings, irods::CFG_MAXIMUM_MEGABYTES_PER_SECOND_PER_USER_KW) * megabyte;
+            cfg.user_weights = read_user_weights(settings);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s]. Transfers are not limited.",
+                    irods::CFG_ADVANCED_SETTINGS_KW.data(), irods::CFG_TRANSFER_SCHEDULER_KW.data());
+        }
+
+        return cfg;
+    } // read_config
+
+    auto init(const std::string_view _shm_name, std::size_t _shm_size, const config& _config) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_users = g_segment->construct<user_map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+        g_registrations = g_segment->construct<registration_map_type>(bi::anonymous_instance)(std::less<pid_t>{}, *g_allocator);
+        g_state = g_segment->construct<scheduler_state>(bi::anonymous_instance)(scheduler_state{
+            limits_type{_config.maximum_number_of_streams,
+                        _config.maximum_number_of_streams_per_user,
+                        _config.maximum_bytes_per_second,
+                        _config.maximum_bytes_per_second_per_user},
+            0,
+            0});
+        g_user_weights = _config.user_weights;
+        g_bandwidth_limited = _config.maximum_bytes_per_second > 0 || _config.maximum_bytes_per_second_per_user > 0;
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_users) {
+                g_segment->destroy_ptr(g_users);
+                g_users = nullptr;
+            }
+
+            if (g_segment && g_registrations) {
+                g_segment->destroy_ptr(g_registrations);
+                g_registrations = nullptr;
+            }
+
+            if (g_segment && g_state) {
+                g_segment->destroy_ptr(g_state);
+                g_state = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto acquire(const std::string_view _user, int _requested) -> int
+    {
+        if (!g_state || _requested <= 1) {
+            return std::max(_requested, 1);
+        }
+
+        try {
+            bi::scoped_lock lk{*g_mutex};
+
+            if (auto iter = g_registrations->find(getpid()); iter != g_registrations->end()) {
+                unregister(iter);
+            }
+
+            purge_exited_processes();
+
+            auto* user = find_or_insert_user(_user);
+            if (!user) {
+                return _requested;
+            }
+
+            const auto& limits = g_state->limits;
+            std::int64_t available = _requested;
+
+            if (limits.maximum_number_of_streams > 0) {
+                available = std::min(available, limits.maximum_number_of_streams - g_state->active_streams);
+            }
+
+            if (limits.maximum_number_of_streams_per_user > 0) {
+                available = std::min(available, limits.maximum_number_of_streams_per_user - user->active_streams);
+            }
+
+            const auto granted = std::max<std::int64_t>(available, 1);
+
+            registration r{};
+            std::strncpy(r.user, _user.data(), std::min(_user.size(), sizeof(r.user) - 1));
+            r.streams = granted;
+            g_registrations->emplace(getpid(), r);
+
+            add_streams(user, granted);
+            user->denied_streams += _requested - granted;
+            user->last_active = now();
+
+            return static_cast<int>(granted);
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "transfer_scheduler: could not register the streams of [%.*s]: %s",
+                    static_cast<int>(_user.size()), _user.data(), e.what());
+        }
+
+        return _requested;
+    } // acquire
+
+    auto release() noexcept -> void
+    {
+        if (!g_state) {
+            return;
+        }
+
+        try {
+            bi::scoped_lock lk{*g_mutex};
+
+            if (auto iter = g_registrations->find(getpid()); iter != g_registrations->end()) {
+                unregister(iter);
+            }
+        }
+        catch (...) {}
+    } // release
+
+    auto throttle(const std::string_view _user, std::int64_t _bytes) -> std::chrono::nanoseconds
+    {
+        // Without a bandwidth limit there is nothing to compute, so the streams do not
+        // contend for the lock.
+        if (!g_state || !g_bandwidth_limited || _bytes <= 0) {
+            return std::chrono::nanoseconds{0};
+        }
+
+        // Called from the threads of parallel transfers, which must not end because of the
+        // scheduler. Streams that cannot be accounted for are not delayed.
+        try {
+            bi::scoped_lock lk{*g_mutex};
+
+            auto* user = find_or_insert_user(_user);
+            if (!user) {
+                return std::chrono::nanoseconds{0};
+            }
+
+            const auto current_time = now();
+
+            user->bytes_transferred += _bytes;
+            user->last_active = current_time;
+
+            const auto rate = rate_of(*user);
+
+            if (rate <= 0) {
+                return std::chrono::nanoseconds{0};
+            }
+
+            // Refill the bucket for the time that passed. A user may save up at most one second
+            // worth of transfer, which bounds the burst after an idle period.
+            const auto elapsed = static_cast<double>(current_time - user->last_refill) / 1e9;
+
+            user->tokens = std::min(rate, user->tokens + elapsed * rate) - static_cast<double>(_bytes);
+            user->last_refill = current_time;
+
+            if (user->tokens >= 0) {
+                return std::chrono::nanoseconds{0};
+            }
+
+            const auto delay = static_cast<std::int64_t>(-user->tokens / rate * 1e9);
+            user->nanoseconds_throttled += delay;
+
+            return std::chrono::nanoseconds{delay};
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "transfer_scheduler: could not throttle the streams of [%.*s]: %s",
+                    static_cast<int>(_user.size()), _user.data(), e.what());
+        }
+
+        return std::chrono::nanoseconds{0};
+    } // throttle
+
+    auto statistics() -> std::vector<user_statistics>
+    {
+        std::vector<user_statistics> stats;
+
+        if (!g_state) {
+            return stats;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+
+        stats.reserve(g_users->size());
+
+        for (const auto& [user, state] : *g_users) {
+            stats.push_back({std::string{user.data(), user.size()},
+                             state.active_streams,
+                             state.denied_streams,
+                             state.bytes_transferred,
+                             std::chrono::nanoseconds{state.nanoseconds_throttled}});
+        }
+
+        return stats;
+    } // statistics
+} // namespace irods::experimental::transfer_scheduler
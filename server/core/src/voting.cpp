@@ -1,10 +1,16 @@
 #include "voting.hpp"
 
+#include "network_topology.hpp"
 #include "replica_access_table.hpp"
+#include "resource_free_space_table.hpp"
 #include "key_value_proxy.hpp"
+#include "irods_server_properties.hpp"
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <optional>
 
 namespace irods::experimental::resource::voting {
@@ -133,37 +139,48 @@ namespace {
             return true;
         }
 
-        std::string resource_free_space_string{};
-        err = ctx.plugin_ctx.prop_map().get<std::string>(irods::RESOURCE_FREESPACE, resource_free_space_string);
-        if (!err.ok()) {
-            rodsLog(LOG_ERROR,
-                "%s: minimum free space constraint was requested, and failed to get resource free space for resource [%s]",
-                __FUNCTION__,
-                resource_name.c_str());
-            irods::log(err);
-            return true;
-        }
+        uintmax_t resource_free_space = 0;
 
-        // do sign check on string because boost::lexical_cast will wrap negative numbers around instead of throwing when casting string to unsigned
-        if (resource_free_space_string.size()>0 && resource_free_space_string[0] == '-') {
-            rodsLog(LOG_ERROR,
-                "%s: resource free space < 0 [%s] for resource [%s]",
-                __FUNCTION__,
-                resource_free_space_string.c_str(),
-                resource_name.c_str());
-            return true;
+        // Prefer the sample published by the resource server's free space monitor. The catalog
+        // value is only updated periodically and may be considerably older.
+        namespace fst = irods::experimental::resource::free_space_table;
+        const auto max_sample_age = std::chrono::seconds{irods::get_resource_free_space_maximum_sample_age()};
+
+        if (const auto sample = fst::lookup(resource_name, max_sample_age); sample) {
+            resource_free_space = sample->free_space_in_bytes;
         }
+        else {
+            std::string resource_free_space_string{};
+            err = ctx.plugin_ctx.prop_map().get<std::string>(irods::RESOURCE_FREESPACE, resource_free_space_string);
+            if (!err.ok()) {
+                rodsLog(LOG_ERROR,
+                    "%s: minimum free space constraint was requested, and failed to get resource free space for resource [%s]",
+                    __FUNCTION__,
+                    resource_name.c_str());
+                irods::log(err);
+                return true;
+            }
 
-        uintmax_t resource_free_space = 0;
-        try {
-            resource_free_space = boost::lexical_cast<uintmax_t>(resource_free_space_string);
-        } catch (const boost::bad_lexical_cast&) {
-            rodsLog(LOG_ERROR,
-                "%s: invalid free space [%s] for resource [%s]",
-                __FUNCTION__,
-                resource_free_space_string.c_str(),
-                resource_name.c_str());
-            return true;
+            // do sign check on string because boost::lexical_cast will wrap negative numbers around instead of throwing when casting string to unsigned
+            if (resource_free_space_string.size()>0 && resource_free_space_string[0] == '-') {
+                rodsLog(LOG_ERROR,
+                    "%s: resource free space < 0 [%s] for resource [%s]",
+                    __FUNCTION__,
+                    resource_free_space_string.c_str(),
+                    resource_name.c_str());
+                return true;
+            }
+
+            try {
+                resource_free_space = boost::lexical_cast<uintmax_t>(resource_free_space_string);
+            } catch (const boost::bad_lexical_cast&) {
+                rodsLog(LOG_ERROR,
+                    "%s: invalid free space [%s] for resource [%s]",
+                    __FUNCTION__,
+                    resource_free_space_string.c_str(),
+                    resource_name.c_str());
+                return true;
+            }
         }
 
         if (minimum_free_space > resource_free_space) {
@@ -176,6 +193,29 @@ namespace {
         return false;
     } // replica_exceeds_resource_free_space
 
+    // Ranks a good replica on another host by the time it is expected to take to reach this
+    // server, which is where the client is (see calculate_for_expected_transfer_time).
+    auto weigh_by_expected_transfer_time(context& ctx)
+    {
+        namespace nt = irods::experimental::network_topology;
+
+        const auto& topology = nt::get_config();
+        if (topology.hosts.empty()) {
+            return vote::medium;
+        }
+
+        auto repl = find_local_replica(ctx);
+        if (!repl) {
+            return vote::medium;
+        }
+
+        const auto& resource_host = irods::get_resource_location(ctx.plugin_ctx);
+        const auto round_trip_time = nt::lookup(resource_host, topology.maximum_sample_age);
+
+        return calculate_for_expected_transfer_time(nt::expected_transfer_time(
+            topology, resource_host, ctx.canonical_local_hostname, repl->get().size(), round_trip_time));
+    } // weigh_by_expected_transfer_time
+
     auto throw_if_replica_exceeds_resource_free_space(context& ctx)
     {
         if(replica_exceeds_resource_free_space(ctx)) {
@@ -196,7 +236,14 @@ namespace detail {
 
     float calculate_for_open(context& ctx)
     {
-        return calculate_with_repl_status(ctx, GOOD_REPLICA);
+        const auto vote = calculate_with_repl_status(ctx, GOOD_REPLICA);
+
+        // A good replica on another host.
+        if (vote::medium == vote) {
+            return weigh_by_expected_transfer_time(ctx);
+        }
+
+        return vote;
     } // calculate_for_open
 
     float calculate_for_unlink(context& ctx)
@@ -241,4 +288,16 @@ float calculate(
     return vote;
 } // calculate
 
+float calculate_for_expected_transfer_time(std::optional<std::chrono::microseconds> _expected_transfer_time)
+{
+    if (!_expected_transfer_time) {
+        return vote::medium;
+    }
+
+    // An estimate of zero (e.g. an empty replica and a measured round trip time of zero) must
+    // not tie with a replica on this host.
+    const auto seconds = std::chrono::duration<float>{*_expected_transfer_time}.count();
+    return std::min(vote::low + (vote::high - vote::low) / (1.0f + seconds), std::nextafter(vote::high, vote::zero));
+} // calculate_for_expected_transfer_time
+
 } // namespace irods::experimental::resource::voting
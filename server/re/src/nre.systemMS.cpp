@@ -886,13 +886,7 @@ msiStrToBytesBuf( msParam_t* str_msp, msParam_t* buf_msp, ruleExecInfo_t* ) {
 **/
 int
 msiBytesBufToStr( msParam_t* buf_msp, msParam_t* str_msp, ruleExecInfo_t* ) {
-    int single_buff_sz;
-    try {
-        single_buff_sz = irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER) * 1024 * 1024;
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return e.code();
-    }
+    int single_buff_sz = irods::get_server_configuration().maximum_size_for_single_buffer_in_megabytes * 1024 * 1024;
 
     /*check buf_msp */
     if ( buf_msp == NULL || buf_msp->inOutStruct == NULL ) {
@@ -690,13 +690,7 @@ msiSetNumThreads( msParam_t *xsizePerThrInMbStr, msParam_t *xmaxNumThrStr,
     windowSizeStr = ( char * ) xwindowSizeStr->inOutStruct;
 
 
-    int def_num_thr = 0;
-    try {
-        def_num_thr = irods::get_advanced_setting<const int>(irods::CFG_DEF_NUMBER_TRANSFER_THREADS);
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return e.code();
-    }
+    int def_num_thr = irods::get_server_configuration().default_number_of_transfer_threads;
 
     if ( rei->rsComm != NULL ) {
         if ( strcmp( windowSizeStr, "null" ) == 0 ||
@@ -708,13 +702,7 @@ msiSetNumThreads( msParam_t *xsizePerThrInMbStr, msParam_t *xmaxNumThrStr,
         }
     }
 
-    int size_per_tran_thr = 0;
-    try {
-        size_per_tran_thr = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS);
-    } catch ( const irods::exception& e ) {
-        irods::log(e);
-        return e.code();
-    }
+    int size_per_tran_thr = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes;
     if ( 0 >= size_per_tran_thr ) {
         rodsLog( LOG_ERROR, "%d is an invalid size_per_tran_thr value. "
                  "size_per_tran_thr must be greater than zero.", size_per_tran_thr );
@@ -766,13 +754,7 @@ msiSetNumThreads( msParam_t *xsizePerThrInMbStr, msParam_t *xmaxNumThrStr,
 
     if ( doinp->numThreads > 0 ) {
 
-        int trans_buff_size = 0;
-        try {
-            trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS);
-        } catch ( const irods::exception& e ) {
-            irods::log(e);
-            return e.code();
-        }
+        int trans_buff_size = irods::get_server_configuration().transfer_buffer_size_for_parallel_transfer_in_megabytes;
         if ( 0 >= trans_buff_size ) {
             rodsLog( LOG_ERROR, "%d is an invalid trans_buff size. "
                      "trans_buff_size must be greater than zero.", trans_buff_size );
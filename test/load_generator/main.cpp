@@ -0,0 +1,394 @@
+// A load generator for iRODS servers.
+//
+// Drives a workload from many concurrent client sessions and reports the throughput and
+// latency percentiles of each operation. The workload is either a weighted mix of
+// synthetic operations or a replay of the API requests captured in a server log.
+//
+// Examples:
+//
+//   irodsLoadGenerator --workload small-put --sessions 64 --duration 60
+//   irodsLoadGenerator --mix put=4,get=2,list=2,stat=1,metadata=1 --json-out results.json
+//   irodsLoadGenerator --replay /var/log/irods/irods.log --speed 2
+//
+// Every session works in its own collection under "<home>/load_generator.<host>.<pid>",
+// which is removed at the end of the run unless --keep is given.
+
+#include "operations.hpp"
+#include "replay.hpp"
+#include "statistics.hpp"
+
+#include "rodsClient.h"
+#include "apiNumberMap.h"
+#include "connection_pool.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+namespace lg = irods::load_generator;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    using operation_mix = std::vector<std::pair<lg::operation_type, double>>;
+
+    volatile std::sig_atomic_t stop_requested = 0;
+
+    const std::map<std::string, operation_mix> named_workloads{
+        {"small-put", {{lg::operation_type::put, 1}}},
+        {"list",      {{lg::operation_type::list, 1}}},
+        {"metadata",  {{lg::operation_type::metadata, 1}}},
+        {"large",     {{lg::operation_type::large_put, 1}, {lg::operation_type::large_get, 1}}},
+        {"mixed",     {{lg::operation_type::put, 4},
+                       {lg::operation_type::get, 2},
+                       {lg::operation_type::list, 2},
+                       {lg::operation_type::stat, 1},
+                       {lg::operation_type::metadata, 1}}}
+    };
+
+    // Parses a mix of the form "put=4,get=2,list=1".
+    auto parse_mix(const std::string& _mix) -> operation_mix
+    {
+        operation_mix mix;
+
+        std::vector<std::string> entries;
+        boost::split(entries, _mix, boost::is_any_of(","));
+
+        for (const auto& entry : entries) {
+            const auto pos = entry.find('=');
+            const auto op = lg::to_operation_type(entry.substr(0, pos));
+
+            if (!op) {
+                throw std::invalid_argument{"unknown operation in mix: " + entry};
+            }
+
+            const auto weight = pos == std::string::npos ? 1.0 : std::stod(entry.substr(pos + 1));
+
+            if (weight <= 0) {
+                throw std::invalid_argument{"weights must be greater than zero: " + entry};
+            }
+
+            mix.emplace_back(*op, weight);
+        }
+
+        return mix;
+    }
+
+    auto contains(const operation_mix& _mix, lg::operation_type _op) -> bool
+    {
+        return std::any_of(std::begin(_mix), std::end(_mix), [_op](const auto& _e) { return _e.first == _op; });
+    }
+
+    auto create_local_file(const std::string& _path, std::int64_t _size) -> void
+    {
+        std::ofstream out{_path, std::ios::binary};
+        std::vector<char> buffer(std::min<std::int64_t>(_size, 4 * 1024 * 1024));
+
+        for (std::size_t i = 0; i < buffer.size(); ++i) {
+            buffer[i] = static_cast<char>('a' + i % 26);
+        }
+
+        for (std::int64_t written = 0; written < _size;) {
+            const auto n = std::min<std::int64_t>(buffer.size(), _size - written);
+            out.write(buffer.data(), n);
+            written += n;
+        }
+
+        if (!out) {
+            throw std::runtime_error{"cannot create local file: " + _path};
+        }
+    }
+
+    // Runs _func on one thread per session and waits for all of them.
+    template <typename Function>
+    auto for_each_session(std::vector<std::unique_ptr<lg::session>>& _sessions, Function _func) -> void
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(_sessions.size());
+
+        for (auto& s : _sessions) {
+            threads.emplace_back([&_func, &s] { _func(*s); });
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    auto run_mix(std::vector<std::unique_ptr<lg::session>>& _sessions,
+                 const operation_mix& _mix,
+                 std::chrono::seconds _duration,
+                 std::int64_t _operations_per_session) -> void
+    {
+        std::vector<double> weights;
+
+        for (const auto& e : _mix) {
+            weights.push_back(e.second);
+        }
+
+        const auto deadline = clock_type::now() + _duration;
+        std::atomic<int> seed{0};
+
+        for_each_session(_sessions, [&](lg::session& _s) {
+            std::mt19937_64 rng{static_cast<std::mt19937_64::result_type>(seed++)};
+            std::discrete_distribution<std::size_t> pick{std::begin(weights), std::end(weights)};
+
+            for (std::int64_t n = 0; _operations_per_session == 0 || n < _operations_per_session; ++n) {
+                if (stop_requested || clock_type::now() >= deadline) {
+                    break;
+                }
+
+                _s.perform(_mix[pick(rng)].first);
+            }
+        });
+    }
+
+    // Issues the captured requests at the times they were originally made (scaled by
+    // _speed). Requests are handed to whichever session is free, so the concurrency of
+    // the capture is reproduced up to the number of sessions.
+    auto run_replay(std::vector<std::unique_ptr<lg::session>>& _sessions,
+                    const std::vector<lg::replay_event>& _events,
+                    double _speed) -> void
+    {
+        const auto start = clock_type::now();
+        std::atomic<std::size_t> next{0};
+
+        for_each_session(_sessions, [&](lg::session& _s) {
+            for (auto i = next++; i < _events.size() && !stop_requested; i = next++) {
+                const auto& event = _events[i];
+                const std::chrono::duration<double, std::micro> offset = event.offset / _speed;
+
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<clock_type::duration>(offset));
+
+                if (const auto op = lg::to_operation_type(event.api_number); op) {
+                    _s.perform(*op);
+                }
+                else if (const auto iter = irods::api_number_names.find(event.api_number);
+                         iter != std::end(irods::api_number_names))
+                {
+                    _s.statistics().skip(iter->second);
+                }
+                else {
+                    _s.statistics().skip(std::to_string(event.api_number));
+                }
+            }
+        });
+    }
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    po::options_description desc{"Usage: irodsLoadGenerator [options]\n\nOptions"};
+    desc.add_options()
+        ("help,h", "Show this message.")
+        ("workload,w", po::value<std::string>()->default_value("mixed"), "One of: small-put, list, metadata, large, mixed.")
+        ("mix", po::value<std::string>(), "A weighted mix of operations (e.g. put=4,get=2,list=1). Overrides --workload. "
+                                          "Operations: put, get, list, stat, metadata, large_put, large_get.")
+        ("replay", po::value<std::string>(), "Replay the API requests captured in a server log. Overrides --workload and --mix.")
+        ("speed", po::value<double>()->default_value(1.0), "Replay speed relative to the capture.")
+        ("sessions,s", po::value<int>()->default_value(16), "The number of concurrent client sessions.")
+        ("duration,d", po::value<int>()->default_value(60), "How long to run a workload, in seconds.")
+        ("operations,n", po::value<std::int64_t>()->default_value(0), "The number of operations per session (0 means no limit).")
+        ("small-file-size", po::value<std::int64_t>()->default_value(4096), "The size of the files used by put and get, in bytes.")
+        ("large-file-size", po::value<std::int64_t>()->default_value(256 * 1024 * 1024), "The size of the files used by large_put and large_get, in bytes.")
+        ("threads,t", po::value<int>()->default_value(4), "The number of threads requested for large transfers.")
+        ("prepopulate", po::value<int>()->default_value(10), "The number of small data objects each session creates before the run.")
+        ("local-directory", po::value<std::string>()->default_value("/tmp"), "Where to put the local files.")
+        ("json-out", po::value<std::string>(), "Write the results to a JSON file.")
+        ("keep", "Do not remove the data objects created by the run.");
+
+    po::variables_map vm;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+
+    if (vm.count("help")) {
+        std::cout << desc << '\n';
+        return 0;
+    }
+
+    const auto session_count = vm["sessions"].as<int>();
+    const auto speed = vm["speed"].as<double>();
+
+    if (session_count <= 0 || speed <= 0) {
+        std::cerr << "error: --sessions and --speed must be greater than zero.\n";
+        return 1;
+    }
+
+    operation_mix mix;
+    std::vector<lg::replay_event> events;
+
+    try {
+        if (vm.count("replay")) {
+            std::ifstream in{vm["replay"].as<std::string>()};
+
+            if (!in) {
+                std::cerr << "error: cannot open capture [" << vm["replay"].as<std::string>() << "].\n";
+                return 1;
+            }
+
+            events = lg::read_capture(in);
+
+            if (events.empty()) {
+                std::cerr << "error: the capture contains no API requests. Was the log level of the \"api\" category set to \"debug\"?\n";
+                return 1;
+            }
+
+            std::cout << "replaying " << events.size() << " requests spanning "
+                      << std::chrono::duration<double>{events.back().offset}.count() << " seconds\n";
+        }
+        else if (vm.count("mix")) {
+            mix = parse_mix(vm["mix"].as<std::string>());
+        }
+        else if (const auto iter = named_workloads.find(vm["workload"].as<std::string>()); iter != std::end(named_workloads)) {
+            mix = iter->second;
+        }
+        else {
+            std::cerr << "error: unknown workload [" << vm["workload"].as<std::string>() << "].\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+
+    const bool large_files = contains(mix, lg::operation_type::large_put) || contains(mix, lg::operation_type::large_get);
+
+    lg::workload_options options;
+    options.small_file_size = vm["small-file-size"].as<std::int64_t>();
+    options.large_file_size = vm["large-file-size"].as<std::int64_t>();
+    options.transfer_threads = vm["threads"].as<int>();
+    options.local_directory = vm["local-directory"].as<std::string>() + "/irods_load_generator." + std::to_string(getpid());
+    options.small_file = options.local_directory + "/small";
+    options.large_file = options.local_directory + "/large";
+
+    std::signal(SIGINT, [](int) { stop_requested = 1; });
+
+    try {
+        boost::filesystem::create_directories(options.local_directory);
+        create_local_file(options.small_file, options.small_file_size);
+
+        if (large_files) {
+            create_local_file(options.large_file, options.large_file_size);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+
+    load_client_api_plugins();
+
+    rodsEnv env{};
+    _getRodsEnv(env);
+
+    char hostname[HOST_NAME_MAX + 1]{};
+    gethostname(hostname, sizeof(hostname) - 1);
+
+    const auto base_collection = std::string{env.rodsHome} + "/load_generator." + hostname + '.' + std::to_string(getpid());
+
+    int ec = 0;
+
+    try {
+        auto pool = irods::make_connection_pool(session_count);
+
+        std::vector<irods::connection_pool::connection_proxy> connections;
+        std::vector<std::unique_ptr<lg::session>> sessions;
+        connections.reserve(session_count);
+
+        for (int i = 0; i < session_count; ++i) {
+            auto& conn = connections.emplace_back(pool->get_connection());
+            const auto collection = base_collection + "/session." + std::to_string(i);
+            sessions.push_back(std::make_unique<lg::session>(conn, i, collection, options));
+        }
+
+        std::cout << "preparing " << session_count << " sessions ...\n";
+
+        std::atomic<int> setup_error{0};
+
+        for_each_session(sessions, [&](lg::session& _s) {
+            const auto large_objects = contains(mix, lg::operation_type::large_get) ? 1 : 0;
+
+            if (const auto status = _s.setup(vm["prepopulate"].as<int>(), large_objects); status < 0) {
+                setup_error = status;
+            }
+        });
+
+        if (setup_error < 0) {
+            std::cerr << "error: cannot prepare sessions [error_code=" << setup_error << "].\n";
+            ec = 1;
+        }
+        else {
+            std::cout << "running ...\n";
+
+            const auto start = clock_type::now();
+
+            if (events.empty()) {
+                run_mix(sessions, mix, std::chrono::seconds{vm["duration"].as<int>()}, vm["operations"].as<std::int64_t>());
+            }
+            else {
+                run_replay(sessions, events, speed);
+            }
+
+            const std::chrono::duration<double> elapsed = clock_type::now() - start;
+
+            lg::recorder results;
+
+            for (const auto& s : sessions) {
+                results.merge(s->statistics());
+            }
+
+            lg::print_report(results, elapsed, std::cout);
+
+            if (vm.count("json-out")) {
+                std::ofstream out{vm["json-out"].as<std::string>()};
+                lg::write_json_report(results, elapsed, out);
+
+                if (!out) {
+                    std::cerr << "error: cannot write results to [" << vm["json-out"].as<std::string>() << "].\n";
+                    ec = 1;
+                }
+            }
+        }
+
+        if (!vm.count("keep")) {
+            if (const auto rm_ec = lg::remove_collection(connections.front(), base_collection); rm_ec < 0) {
+                std::cerr << "warning: cannot remove collection [" << base_collection << "] [error_code=" << rm_ec << "].\n";
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << '\n';
+        ec = 1;
+    }
+
+    boost::system::error_code fs_ec;
+    boost::filesystem::remove_all(options.local_directory, fs_ec);
+
+    return ec;
+}
@@ -0,0 +1,283 @@
+#include "operations.hpp"
+
+#include "rodsClient.h"
+#include "dataObjGet.h"
+#include "dataObjPut.h"
+#include "genQuery.h"
+#include "modAVUMetadata.h"
+#include "objStat.h"
+#include "collCreate.h"
+#include "rmColl.h"
+#include "irods_at_scope_exit.hpp"
+
+#include <fcntl.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace irods::load_generator
+{
+    namespace
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        constexpr const char* operation_names[] = {
+            "put", "get", "list", "stat", "metadata", "large_put", "large_get"
+        };
+    } // anonymous namespace
+
+    auto to_string(operation_type _op) noexcept -> const char*
+    {
+        return operation_names[static_cast<int>(_op)];
+    }
+
+    auto to_operation_type(std::string_view _name) noexcept -> std::optional<operation_type>
+    {
+        for (int i = 0; i < static_cast<int>(std::size(operation_names)); ++i) {
+            if (_name == operation_names[i]) {
+                return static_cast<operation_type>(i);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto remove_collection(rcComm_t& _conn, const std::string& _path) -> int
+    {
+        collInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearKeyVal(&input.condInput); }};
+
+        std::snprintf(input.collName, sizeof(input.collName), "%s", _path.c_str());
+        addKeyVal(&input.condInput, RECURSIVE_OPR__KW, "");
+        addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+
+        return rcRmColl(&_conn, &input, 0);
+    }
+
+    session::session(rcComm_t& _conn, int _id, std::string _collection, const workload_options& _options)
+        : conn_{_conn}
+        , id_{_id}
+        , collection_{std::move(_collection)}
+        , options_{_options}
+        , rng_{static_cast<std::mt19937_64::result_type>(_id)}
+    {
+    }
+
+    auto session::setup(int _small_objects, int _large_objects) -> int
+    {
+        collInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearKeyVal(&input.condInput); }};
+
+        std::snprintf(input.collName, sizeof(input.collName), "%s", collection_.c_str());
+        addKeyVal(&input.condInput, RECURSIVE_OPR__KW, "");
+
+        if (const auto ec = rcCollCreate(&conn_, &input); ec < 0) {
+            return ec;
+        }
+
+        for (int i = 0; i < _small_objects; ++i) {
+            if (const auto ec = put(options_.small_file, options_.small_file_size, NO_THREADING, small_objects_); ec < 0) {
+                return ec;
+            }
+        }
+
+        for (int i = 0; i < _large_objects; ++i) {
+            if (const auto ec = put(options_.large_file, options_.large_file_size, options_.transfer_threads, large_objects_); ec < 0) {
+                return ec;
+            }
+        }
+
+        return 0;
+    }
+
+    auto session::perform(operation_type _op) -> int
+    {
+        std::int64_t bytes = 0;
+        int ec = 0;
+
+        const auto start = clock_type::now();
+
+        switch (_op) {
+            case operation_type::put:
+                ec = put(options_.small_file, options_.small_file_size, NO_THREADING, small_objects_);
+                bytes = options_.small_file_size;
+                break;
+
+            case operation_type::get:
+                ec = get(small_objects_, options_.small_file_size, NO_THREADING);
+                bytes = options_.small_file_size;
+                break;
+
+            case operation_type::list:
+                ec = list();
+                break;
+
+            case operation_type::stat:
+                ec = stat();
+                break;
+
+            case operation_type::metadata:
+                ec = add_metadata();
+                break;
+
+            case operation_type::large_put:
+                ec = put(options_.large_file, options_.large_file_size, options_.transfer_threads, large_objects_);
+                bytes = options_.large_file_size;
+                break;
+
+            case operation_type::large_get:
+                ec = get(large_objects_, options_.large_file_size, options_.transfer_threads);
+                bytes = options_.large_file_size;
+                break;
+        }
+
+        recorder_.record(to_string(_op), clock_type::now() - start, ec, bytes);
+
+        return ec;
+    }
+
+    auto session::statistics() const noexcept -> const recorder&
+    {
+        return recorder_;
+    }
+
+    auto session::statistics() noexcept -> recorder&
+    {
+        return recorder_;
+    }
+
+    auto session::put(const std::string& _local_file, std::int64_t _size, int _threads, std::vector<std::string>& _created) -> int
+    {
+        dataObjInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearKeyVal(&input.condInput); }};
+
+        std::snprintf(input.objPath, sizeof(input.objPath), "%s/data_object.%lld", collection_.c_str(), static_cast<long long>(counter_++));
+        input.dataSize = _size;
+        input.oprType = PUT_OPR;
+        input.openFlags = O_WRONLY | O_CREAT | O_TRUNC;
+        input.createMode = 0600;
+        input.numThreads = _threads;
+        addKeyVal(&input.condInput, DATA_TYPE_KW, "generic");
+
+        auto local_file = _local_file;
+
+        if (const auto ec = rcDataObjPut(&conn_, &input, local_file.data()); ec < 0) {
+            return ec;
+        }
+
+        _created.push_back(input.objPath);
+
+        return 0;
+    }
+
+    auto session::get(const std::vector<std::string>& _candidates, std::int64_t _size, int _threads) -> int
+    {
+        const auto* path = pick(_candidates);
+
+        if (!path) {
+            return OBJ_PATH_DOES_NOT_EXIST;
+        }
+
+        dataObjInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearKeyVal(&input.condInput); }};
+
+        std::snprintf(input.objPath, sizeof(input.objPath), "%s", path->c_str());
+        input.dataSize = _size;
+        input.oprType = GET_OPR;
+        input.numThreads = _threads;
+        addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+
+        auto local_file = options_.local_directory + "/get." + std::to_string(id_);
+
+        return rcDataObjGet(&conn_, &input, local_file.data());
+    }
+
+    auto session::list() -> int
+    {
+        genQueryInp_t input{};
+        irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+        const auto condition = "= '" + collection_ + "'";
+
+        addInxIval(&input.selectInp, COL_DATA_NAME, 1);
+        addInxIval(&input.selectInp, COL_DATA_SIZE, 1);
+        addInxIval(&input.selectInp, COL_D_MODIFY_TIME, 1);
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, condition.c_str());
+        input.maxRows = MAX_SQL_ROWS;
+
+        // Page through the results the way a client listing a large collection would.
+        while (true) {
+            genQueryOut_t* output = nullptr;
+            const auto ec = rcGenQuery(&conn_, &input, &output);
+            irods::at_scope_exit free_output{[&output] { freeGenQueryOut(&output); }};
+
+            if (ec == CAT_NO_ROWS_FOUND) {
+                return 0;
+            }
+
+            if (ec < 0) {
+                return ec;
+            }
+
+            if (output->continueInx == 0) {
+                return 0;
+            }
+
+            input.continueInx = output->continueInx;
+        }
+    }
+
+    auto session::stat() -> int
+    {
+        const auto* path = pick(small_objects_);
+
+        if (!path) {
+            return OBJ_PATH_DOES_NOT_EXIST;
+        }
+
+        dataObjInp_t input{};
+        std::snprintf(input.objPath, sizeof(input.objPath), "%s", path->c_str());
+
+        rodsObjStat_t* output = nullptr;
+        const auto ec = rcObjStat(&conn_, &input, &output);
+        freeRodsObjStat(output);
+
+        return ec < 0 ? ec : 0;
+    }
+
+    auto session::add_metadata() -> int
+    {
+        const auto* path = pick(small_objects_);
+
+        if (!path) {
+            return OBJ_PATH_DOES_NOT_EXIST;
+        }
+
+        auto object_path = *path;
+        auto attribute = "load_generator_" + std::to_string(counter_++);
+        char operation[] = "add";
+        char type[] = "-d";
+        char value[] = "load_generator_value";
+
+        modAVUMetadataInp_t input{};
+        input.arg0 = operation;
+        input.arg1 = type;
+        input.arg2 = object_path.data();
+        input.arg3 = attribute.data();
+        input.arg4 = value;
+
+        return rcModAVUMetadata(&conn_, &input);
+    }
+
+    auto session::pick(const std::vector<std::string>& _candidates) -> const std::string*
+    {
+        if (_candidates.empty()) {
+            return nullptr;
+        }
+
+        std::uniform_int_distribution<std::size_t> dist{0, _candidates.size() - 1};
+
+        return &_candidates[dist(rng_)];
+    }
+} // namespace irods::load_generator
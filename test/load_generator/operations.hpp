@@ -0,0 +1,90 @@
+#ifndef IRODS_LOAD_GENERATOR_OPERATIONS_HPP
+#define IRODS_LOAD_GENERATOR_OPERATIONS_HPP
+
+#include "statistics.hpp"
+
+#include "rcConnect.h"
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace irods::load_generator
+{
+    enum class operation_type
+    {
+        put,        // Uploads a small file (rcDataObjPut).
+        get,        // Downloads a small data object (rcDataObjGet).
+        list,       // Lists the session's collection (rcGenQuery).
+        stat,       // Stats a data object (rcObjStat).
+        metadata,   // Attaches an AVU to a data object (rcModAVUMetadata).
+        large_put,  // Uploads a large file using parallel transfer (rcDataObjPut).
+        large_get   // Downloads a large data object using parallel transfer (rcDataObjGet).
+    }; // enum class operation_type
+
+    auto to_string(operation_type _op) noexcept -> const char*;
+
+    auto to_operation_type(std::string_view _name) noexcept -> std::optional<operation_type>;
+
+    // Removes a collection and everything in it, bypassing the trash.
+    auto remove_collection(rcComm_t& _conn, const std::string& _path) -> int;
+
+    // Settings shared by every session.
+    struct workload_options
+    {
+        std::int64_t small_file_size = 4096;
+        std::int64_t large_file_size = 256 * 1024 * 1024;
+
+        // The number of threads requested for large transfers.
+        int transfer_threads = 4;
+
+        // Local files. The small and large files are uploaded by put and large_put.
+        std::string small_file;
+        std::string large_file;
+        std::string local_directory;
+    }; // struct workload_options
+
+    // The state of a single client session.
+    class session
+    {
+    public:
+        session(rcComm_t& _conn, int _id, std::string _collection, const workload_options& _options);
+
+        session(const session&) = delete;
+        auto operator=(const session&) -> session& = delete;
+
+        // Creates the session's collection and uploads _small_objects small data objects and
+        // _large_objects large data objects to it, so that reads have something to work on.
+        auto setup(int _small_objects, int _large_objects) -> int;
+
+        // Performs an operation and records its latency.
+        auto perform(operation_type _op) -> int;
+
+        auto statistics() const noexcept -> const recorder&;
+        auto statistics() noexcept -> recorder&;
+
+    private:
+        auto put(const std::string& _local_file, std::int64_t _size, int _threads, std::vector<std::string>& _created) -> int;
+        auto get(const std::vector<std::string>& _candidates, std::int64_t _size, int _threads) -> int;
+        auto list() -> int;
+        auto stat() -> int;
+        auto add_metadata() -> int;
+
+        auto pick(const std::vector<std::string>& _candidates) -> const std::string*;
+
+        rcComm_t& conn_;
+        int id_;
+        std::string collection_;
+        const workload_options& options_;
+        std::mt19937_64 rng_;
+        std::int64_t counter_ = 0;
+        std::vector<std::string> small_objects_;
+        std::vector<std::string> large_objects_;
+        recorder recorder_;
+    }; // class session
+} // namespace irods::load_generator
+
+#endif // IRODS_LOAD_GENERATOR_OPERATIONS_HPP
@@ -0,0 +1,121 @@
+#include "replay.hpp"
+
+#include "apiNumber.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <string>
+
+namespace irods::load_generator
+{
+    namespace
+    {
+        // Converts a timestamp produced by the server logger (e.g. "2020-11-03T15:04:05.123456")
+        // into microseconds since the epoch.
+        auto parse_timestamp(const std::string& _ts) -> std::optional<std::chrono::microseconds>
+        {
+            std::tm tm{};
+            const char* rest = strptime(_ts.c_str(), "%Y-%m-%dT%H:%M:%S", &tm);
+
+            if (!rest) {
+                return std::nullopt;
+            }
+
+            long long usec = 0;
+
+            if (*rest == '.') {
+                usec = std::stoll(rest + 1);
+            }
+
+            return std::chrono::seconds{timegm(&tm)} + std::chrono::microseconds{usec};
+        }
+    } // anonymous namespace
+
+    auto read_capture(std::istream& _in) -> std::vector<replay_event>
+    {
+        using json = nlohmann::json;
+
+        std::vector<replay_event> events;
+        std::string line;
+
+        while (std::getline(_in, line)) {
+            const auto pos = line.find('{');
+
+            if (pos == std::string::npos) {
+                continue;
+            }
+
+            const auto record = json::parse(line.begin() + pos, line.end(), nullptr, false);
+
+            if (record.is_discarded() || record.value("log_message", "") != "API request completed") {
+                continue;
+            }
+
+            const auto api_number = record.find("request_api_number");
+            const auto timestamp = record.find("server_timestamp");
+            const auto duration = record.find("request_duration_in_microseconds");
+
+            if (api_number == record.end() || timestamp == record.end()) {
+                continue;
+            }
+
+            const auto completed = parse_timestamp(timestamp->get<std::string>());
+
+            if (!completed) {
+                continue;
+            }
+
+            auto started = *completed;
+
+            if (duration != record.end()) {
+                started -= std::chrono::microseconds{std::stoll(duration->get<std::string>())};
+            }
+
+            events.push_back({started, api_number->get<int>()});
+        }
+
+        std::stable_sort(std::begin(events), std::end(events), [](const auto& _l, const auto& _r) {
+            return _l.offset < _r.offset;
+        });
+
+        if (!events.empty()) {
+            const auto first = events.front().offset;
+
+            for (auto& e : events) {
+                e.offset -= first;
+            }
+        }
+
+        return events;
+    }
+
+    auto to_operation_type(int _api_number) noexcept -> std::optional<operation_type>
+    {
+        switch (_api_number) {
+            case DATA_OBJ_PUT_AN:
+            case DATA_OBJ_CREATE_AN:
+            case DATA_OBJ_CREATE_AND_STAT_AN:
+                return operation_type::put;
+
+            case DATA_OBJ_GET_AN:
+            case DATA_OBJ_OPEN_AN:
+            case DATA_OBJ_OPEN_AND_STAT_AN:
+                return operation_type::get;
+
+            case GEN_QUERY_AN:
+            case OPEN_COLLECTION_AN:
+                return operation_type::list;
+
+            case OBJ_STAT_AN:
+                return operation_type::stat;
+
+            case MOD_AVU_METADATA_AN:
+                return operation_type::metadata;
+
+            default:
+                return std::nullopt;
+        }
+    }
+} // namespace irods::load_generator
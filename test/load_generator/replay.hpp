@@ -0,0 +1,39 @@
+#ifndef IRODS_LOAD_GENERATOR_REPLAY_HPP
+#define IRODS_LOAD_GENERATOR_REPLAY_HPP
+
+#include "operations.hpp"
+
+#include <chrono>
+#include <istream>
+#include <optional>
+#include <vector>
+
+namespace irods::load_generator
+{
+    // An API request captured from the server log.
+    struct replay_event
+    {
+        // The time the request started, relative to the first request of the capture.
+        std::chrono::microseconds offset;
+        int api_number;
+    }; // struct replay_event
+
+    // Reads the "API request completed" records written by rsApiHandler when the log level
+    // of the "api" category is "debug" or lower.
+    //
+    // Each line may carry a syslog prefix; everything before the first '{' is ignored, as
+    // are lines which are not JSON or not such a record. The events are returned in the
+    // order the requests started.
+    auto read_capture(std::istream& _in) -> std::vector<replay_event>;
+
+    // Returns the operation that stands in for an API request, or nothing if the request
+    // is not replayed.
+    //
+    // The log does not record the arguments of a request, so each API is replayed as the
+    // synthetic operation exercising the same code path in the server. The reads, writes
+    // and seeks of an open data object are covered by the operation standing in for the
+    // open or create and are not replayed on their own.
+    auto to_operation_type(int _api_number) noexcept -> std::optional<operation_type>;
+} // namespace irods::load_generator
+
+#endif // IRODS_LOAD_GENERATOR_REPLAY_HPP
@@ -0,0 +1,164 @@
+#include "statistics.hpp"
+
+#include "rodsLog.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+namespace irods::load_generator
+{
+    namespace
+    {
+        constexpr double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+
+        // Returns the nearest-rank percentile of a sorted, non-empty sample.
+        auto percentile(const std::vector<std::chrono::nanoseconds>& _sorted, double _p) -> std::chrono::nanoseconds
+        {
+            const auto rank = static_cast<std::size_t>(_p / 100.0 * _sorted.size() + 0.5);
+            return _sorted[std::clamp<std::size_t>(rank, 1, _sorted.size()) - 1];
+        }
+
+        auto to_milliseconds(std::chrono::nanoseconds _d) -> double
+        {
+            return std::chrono::duration<double, std::milli>{_d}.count();
+        }
+
+        auto error_count(const operation_statistics& _stats) -> std::int64_t
+        {
+            return std::accumulate(std::begin(_stats.errors), std::end(_stats.errors), std::int64_t{0},
+                                   [](auto _sum, const auto& _e) { return _sum + _e.second; });
+        }
+    } // anonymous namespace
+
+    auto recorder::record(const std::string& _operation,
+                          std::chrono::nanoseconds _latency,
+                          int _status,
+                          std::int64_t _bytes) -> void
+    {
+        auto& stats = operations_[_operation];
+
+        if (_status < 0) {
+            ++stats.errors[_status];
+            return;
+        }
+
+        stats.latencies.push_back(_latency);
+        stats.bytes += _bytes;
+    }
+
+    auto recorder::skip(const std::string& _operation) -> void
+    {
+        ++skipped_[_operation];
+    }
+
+    auto recorder::merge(const recorder& _other) -> void
+    {
+        for (const auto& [name, other] : _other.operations_) {
+            auto& stats = operations_[name];
+
+            stats.latencies.insert(std::end(stats.latencies), std::begin(other.latencies), std::end(other.latencies));
+            stats.bytes += other.bytes;
+
+            for (const auto& [ec, count] : other.errors) {
+                stats.errors[ec] += count;
+            }
+        }
+
+        for (const auto& [name, count] : _other.skipped_) {
+            skipped_[name] += count;
+        }
+    }
+
+    auto recorder::operations() const noexcept -> const std::map<std::string, operation_statistics>&
+    {
+        return operations_;
+    }
+
+    auto recorder::skipped() const noexcept -> const std::map<std::string, std::int64_t>&
+    {
+        return skipped_;
+    }
+
+    auto print_report(const recorder& _recorder, std::chrono::duration<double> _elapsed, std::ostream& _out) -> void
+    {
+        char line[256];
+
+        std::snprintf(line, sizeof(line), "%-12s %10s %8s %10s %10s %10s %10s %10s %10s %10s\n",
+                      "operation", "count", "errors", "ops/s", "MiB/s", "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms");
+        _out << line;
+
+        for (const auto& [name, stats] : _recorder.operations()) {
+            auto sorted = stats.latencies;
+            std::sort(std::begin(sorted), std::end(sorted));
+
+            const auto count = static_cast<std::int64_t>(sorted.size());
+            const auto mib_per_second = stats.bytes / _elapsed.count() / (1024 * 1024);
+
+            std::snprintf(line, sizeof(line), "%-12s %10lld %8lld %10.1f %10.1f",
+                          name.c_str(), static_cast<long long>(count), static_cast<long long>(error_count(stats)),
+                          count / _elapsed.count(), mib_per_second);
+            _out << line;
+
+            for (auto p : percentiles) {
+                std::snprintf(line, sizeof(line), " %10.2f", sorted.empty() ? 0.0 : to_milliseconds(percentile(sorted, p)));
+                _out << line;
+            }
+
+            std::snprintf(line, sizeof(line), " %10.2f\n", sorted.empty() ? 0.0 : to_milliseconds(sorted.back()));
+            _out << line;
+
+            for (const auto& [ec, n] : stats.errors) {
+                _out << "    " << n << " x " << rodsErrorName(ec, nullptr) << " (" << ec << ")\n";
+            }
+        }
+
+        for (const auto& [name, count] : _recorder.skipped()) {
+            _out << "skipped " << count << " x " << name << " (no equivalent operation)\n";
+        }
+
+        _out << "elapsed: " << _elapsed.count() << " seconds\n";
+    }
+
+    auto write_json_report(const recorder& _recorder, std::chrono::duration<double> _elapsed, std::ostream& _out) -> void
+    {
+        using json = nlohmann::json;
+
+        auto operations = json::object();
+
+        for (const auto& [name, stats] : _recorder.operations()) {
+            auto sorted = stats.latencies;
+            std::sort(std::begin(sorted), std::end(sorted));
+
+            auto latencies = json::object();
+
+            if (!sorted.empty()) {
+                for (auto p : percentiles) {
+                    char key[16];
+                    std::snprintf(key, sizeof(key), "p%g", p);
+                    latencies[key] = to_milliseconds(percentile(sorted, p));
+                }
+
+                latencies["max"] = to_milliseconds(sorted.back());
+            }
+
+            auto errors = json::object();
+
+            for (const auto& [ec, n] : stats.errors) {
+                errors[std::to_string(ec)] = n;
+            }
+
+            operations[name] = {{"count", sorted.size()},
+                                {"errors", errors},
+                                {"operations_per_second", sorted.size() / _elapsed.count()},
+                                {"bytes_per_second", stats.bytes / _elapsed.count()},
+                                {"latency_in_milliseconds", latencies}};
+        }
+
+        _out << json{{"elapsed_in_seconds", _elapsed.count()},
+                     {"operations", operations},
+                     {"skipped", _recorder.skipped()}}.dump(4) << '\n';
+    }
+} // namespace irods::load_generator
@@ -0,0 +1,60 @@
+#ifndef IRODS_LOAD_GENERATOR_STATISTICS_HPP
+#define IRODS_LOAD_GENERATOR_STATISTICS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace irods::load_generator
+{
+    // The measurements of a single kind of operation (e.g. "put").
+    struct operation_statistics
+    {
+        // Latencies of the operations that succeeded.
+        std::vector<std::chrono::nanoseconds> latencies;
+
+        // The number of failures, keyed by iRODS error code.
+        std::map<int, std::int64_t> errors;
+
+        // The number of bytes moved by the operations that succeeded.
+        std::int64_t bytes = 0;
+    }; // struct operation_statistics
+
+    // Collects the outcome of every operation performed by a session.
+    //
+    // A recorder is not thread-safe. Each session owns one, and the recorders are merged
+    // once the sessions are done.
+    class recorder
+    {
+    public:
+        auto record(const std::string& _operation,
+                    std::chrono::nanoseconds _latency,
+                    int _status,
+                    std::int64_t _bytes = 0) -> void;
+
+        // Counts an operation which was not performed (e.g. an API number without an
+        // equivalent operation during a replay).
+        auto skip(const std::string& _operation) -> void;
+
+        auto merge(const recorder& _other) -> void;
+
+        auto operations() const noexcept -> const std::map<std::string, operation_statistics>&;
+
+        auto skipped() const noexcept -> const std::map<std::string, std::int64_t>&;
+
+    private:
+        std::map<std::string, operation_statistics> operations_;
+        std::map<std::string, std::int64_t> skipped_;
+    }; // class recorder
+
+    // Prints the throughput and latency percentiles of each operation.
+    auto print_report(const recorder& _recorder, std::chrono::duration<double> _elapsed, std::ostream& _out) -> void;
+
+    // Writes the same information as print_report() as a JSON document.
+    auto write_json_report(const recorder& _recorder, std::chrono::duration<double> _elapsed, std::ostream& _out) -> void;
+} // namespace irods::load_generator
+
+#endif // IRODS_LOAD_GENERATOR_STATISTICS_HPP
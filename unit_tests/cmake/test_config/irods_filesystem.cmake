@@ -1,6 +1,7 @@
 set(IRODS_TEST_TARGET irods_filesystem)
 
 set(IRODS_TEST_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                            ${CMAKE_CURRENT_SOURCE_DIR}/src/filesystem/test_metadata_cache.cpp
                             ${CMAKE_CURRENT_SOURCE_DIR}/src/filesystem/test_path.cpp
                             ${CMAKE_CURRENT_SOURCE_DIR}/src/filesystem/test_filesystem.cpp)
 
@@ -735,6 +735,47 @@ TEST_CASE("filesystem")
         // Show that normal collections are not considered to be special collections.
         REQUIRE_FALSE(fs::client::is_special_collection(conn, sandbox));
     }
+
+    SECTION("metadata cache")
+    {
+        const auto col = sandbox / "cached.d";
+        REQUIRE(fs::client::create_collection(conn, col));
+
+        for (auto&& e : {"f1.txt", "f2.txt", "f3.txt"}) {
+            default_transport tp{conn};
+            odstream{tp, col / e} << "test file";
+        }
+
+        fs::client::metadata_cache cache{100, std::chrono::seconds{60}};
+        fs::client::scoped_metadata_cache install_cache{cache};
+
+        // Stats every entry of the collection, like tools traversing a tree repeatedly do.
+        const auto traverse = [&conn, &col] {
+            for (auto&& e : fs::client::recursive_collection_iterator{conn, col}) {
+                REQUIRE(fs::client::exists(conn, e.path()));
+                REQUIRE(fs::client::is_data_object(conn, e.path()));
+                REQUIRE(fs::client::get_metadata(conn, e.path()).empty());
+            }
+        };
+
+        traverse();
+        const auto first = cache.statistics();
+        REQUIRE(first.misses == 6);
+        REQUIRE(first.hits == 6);
+
+        // The second traversal is answered from the cache.
+        traverse();
+        const auto second = cache.statistics();
+        REQUIRE(second.misses == first.misses);
+        REQUIRE(second.hits == first.hits + 9);
+
+        // Modifications made through the library are observed immediately.
+        fs::client::add_metadata(conn, col / "f1.txt", {"a", "v", "u"});
+        REQUIRE(fs::client::get_metadata(conn, col / "f1.txt").size() == 1);
+
+        REQUIRE(fs::client::remove(conn, col / "f2.txt", fs::remove_options::no_trash));
+        REQUIRE_FALSE(fs::client::exists(conn, col / "f2.txt"));
+    }
 }
 
 auto get_hostname() noexcept -> std::string
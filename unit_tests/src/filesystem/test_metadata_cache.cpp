@@ -0,0 +1,184 @@
+#include "catch.hpp"
+
+#include "filesystem.hpp"
+#include "rcConnect.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace fs = irods::experimental::filesystem;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    auto make_comm(const char* _host, const char* _user) -> RcComm
+    {
+        RcComm comm{};
+        std::strncpy(comm.host, _host, sizeof(comm.host) - 1);
+        comm.portNum = 1247;
+
+        for (auto* u : {&comm.proxyUser, &comm.clientUser}) {
+            std::strncpy(u->userName, _user, sizeof(u->userName) - 1);
+            std::strncpy(u->rodsZone, "tempZone", sizeof(u->rodsZone) - 1);
+        }
+
+        return comm;
+    }
+} // anonymous namespace
+
+TEST_CASE("metadata_cache")
+{
+    fs::client::metadata_cache cache{3, 60s};
+
+    auto comm = make_comm("localhost", "rods");
+
+    const fs::object_status collection{fs::object_type::collection};
+    const fs::object_status data_object{fs::object_type::data_object};
+
+    SECTION("lookups count hits and misses")
+    {
+        REQUIRE_FALSE(cache.find_status(comm, "/tempZone/home/rods"));
+
+        cache.insert_status(comm, "/tempZone/home/rods", collection);
+
+        const auto s = cache.find_status(comm, "/tempZone/home/rods");
+        REQUIRE(s);
+        REQUIRE(s->type() == fs::object_type::collection);
+
+        // Only the status was cached.
+        REQUIRE_FALSE(cache.find_metadata(comm, "/tempZone/home/rods"));
+
+        const auto stats = cache.statistics();
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.misses == 2);
+    }
+
+    SECTION("equivalent paths share an entry")
+    {
+        cache.insert_status(comm, "/tempZone/home/rods/", collection);
+
+        REQUIRE(cache.find_status(comm, "/tempZone/home/rods"));
+        REQUIRE(cache.find_status(comm, "/tempZone/home/./rods"));
+        REQUIRE(cache.size() == 1);
+    }
+
+    SECTION("every kind of information is cached independently")
+    {
+        const fs::path p = "/tempZone/home/rods/foo";
+        const auto mtime = fs::object_time_type{std::chrono::seconds{1600000000}};
+
+        cache.insert_status(comm, p, data_object);
+        cache.insert_metadata(comm, p, {{"a", "v", "u"}});
+        cache.insert_data_object_size(comm, p, 42);
+        cache.insert_last_write_time(comm, p, mtime);
+
+        REQUIRE(cache.find_status(comm, p)->type() == fs::object_type::data_object);
+        REQUIRE(cache.find_metadata(comm, p)->at(0).attribute == "a");
+        REQUIRE(cache.find_data_object_size(comm, p).value() == 42);
+        REQUIRE(cache.find_last_write_time(comm, p).value() == mtime);
+        REQUIRE(cache.size() == 1);
+    }
+
+    SECTION("information is only shared between connections with the same identity")
+    {
+        auto alice = make_comm("localhost", "alice");
+        auto alice_on_other_host = make_comm("otherhost", "alice");
+        auto same_as_comm = make_comm("localhost", "rods");
+
+        cache.insert_status(comm, "/tempZone/home/rods", collection);
+
+        REQUIRE(cache.find_status(same_as_comm, "/tempZone/home/rods"));
+        REQUIRE_FALSE(cache.find_status(alice, "/tempZone/home/rods"));
+
+        cache.insert_status(alice, "/tempZone/home/rods", data_object);
+        REQUIRE(cache.find_status(alice, "/tempZone/home/rods")->type() == fs::object_type::data_object);
+        REQUIRE(cache.find_status(comm, "/tempZone/home/rods")->type() == fs::object_type::collection);
+        REQUIRE_FALSE(cache.find_status(alice_on_other_host, "/tempZone/home/rods"));
+
+        // A proxied connection does not see what the client user cached directly.
+        auto proxied = make_comm("localhost", "alice");
+        std::strncpy(proxied.proxyUser.userName, "rods", sizeof(proxied.proxyUser.userName) - 1);
+        REQUIRE_FALSE(cache.find_status(proxied, "/tempZone/home/rods"));
+
+        // Identities share the path's slot and are all invalidated together.
+        REQUIRE(cache.size() == 1);
+        cache.invalidate("/tempZone/home/rods");
+        REQUIRE_FALSE(cache.find_status(comm, "/tempZone/home/rods"));
+        REQUIRE_FALSE(cache.find_status(alice, "/tempZone/home/rods"));
+    }
+
+    SECTION("the least recently used path is evicted")
+    {
+        cache.insert_status(comm, "/tempZone/a", collection);
+        cache.insert_status(comm, "/tempZone/b", collection);
+        cache.insert_status(comm, "/tempZone/c", collection);
+
+        REQUIRE(cache.find_status(comm, "/tempZone/a"));
+
+        cache.insert_status(comm, "/tempZone/d", collection);
+
+        REQUIRE(cache.size() == 3);
+        REQUIRE(cache.statistics().evictions == 1);
+        REQUIRE(cache.find_status(comm, "/tempZone/a"));
+        REQUIRE_FALSE(cache.find_status(comm, "/tempZone/b"));
+    }
+
+    SECTION("invalidation")
+    {
+        cache.insert_status(comm, "/tempZone/home/rods", collection);
+        cache.insert_status(comm, "/tempZone/home/rods/foo", data_object);
+        cache.insert_status(comm, "/tempZone/home/rodsadmin", collection);
+
+        cache.invalidate("/tempZone/home/rods/foo");
+        REQUIRE_FALSE(cache.find_status(comm, "/tempZone/home/rods/foo"));
+        REQUIRE(cache.find_status(comm, "/tempZone/home/rods"));
+
+        cache.insert_status(comm, "/tempZone/home/rods/foo", data_object);
+        cache.invalidate_all("/tempZone/home/rods");
+        REQUIRE_FALSE(cache.find_status(comm, "/tempZone/home/rods"));
+        REQUIRE_FALSE(cache.find_status(comm, "/tempZone/home/rods/foo"));
+        REQUIRE(cache.find_status(comm, "/tempZone/home/rodsadmin"));
+
+        cache.clear();
+        REQUIRE(cache.size() == 0);
+        REQUIRE(cache.statistics().invalidations == 4);
+    }
+
+    SECTION("information expires")
+    {
+        fs::client::metadata_cache short_lived{3, 10ms};
+
+        short_lived.insert_status(comm, "/tempZone/home/rods", collection);
+        REQUIRE(short_lived.find_status(comm, "/tempZone/home/rods"));
+
+        std::this_thread::sleep_for(20ms);
+        REQUIRE_FALSE(short_lived.find_status(comm, "/tempZone/home/rods"));
+    }
+
+    SECTION("caches are installed per scope")
+    {
+        REQUIRE(fs::client::current_metadata_cache() == nullptr);
+
+        {
+            fs::client::scoped_metadata_cache outer{cache};
+            REQUIRE(fs::client::current_metadata_cache() == &cache);
+
+            fs::client::metadata_cache other{1, 60s};
+
+            {
+                fs::client::scoped_metadata_cache inner{other};
+                REQUIRE(fs::client::current_metadata_cache() == &other);
+            }
+
+            REQUIRE(fs::client::current_metadata_cache() == &cache);
+
+            cache.insert_status(comm, "/tempZone/home/rods/foo", data_object);
+            fs::client::invalidate_metadata_cache("/tempZone/home/rods");
+            REQUIRE(cache.size() == 0);
+        }
+
+        REQUIRE(fs::client::current_metadata_cache() == nullptr);
+    }
+}
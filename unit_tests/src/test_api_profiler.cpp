@@ -0,0 +1,101 @@
+#include "catch.hpp"
+
+#include "api_profiler.hpp"
+#include "irods_exception.hpp"
+#include "irods_stacktrace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace prof = irods::experimental::api_profiler;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Stands in for an API handler. Symbol resolution is CPU heavy and lives in an
+    // exported library function, so the frames are guaranteed to have names.
+    auto synthetic_api(std::chrono::milliseconds _duration) -> void
+    {
+        const auto end = std::chrono::steady_clock::now() + _duration;
+
+        while (std::chrono::steady_clock::now() < end) {
+            irods::stacktrace{}.dump();
+        }
+    }
+} // anonymous namespace
+
+TEST_CASE("api_profiler")
+{
+    SECTION("cpu sampling captures the synthetic api")
+    {
+        prof::sampler sampler{prof::maximum_sampling_frequency_in_hz, prof::sampling_clock::cpu};
+        synthetic_api(300ms);
+        sampler.stop();
+
+        REQUIRE(sampler.sample_count() > 0);
+        REQUIRE(sampler.dropped_sample_count() == 0);
+
+        const auto stacks = sampler.folded_stacks();
+        REQUIRE_FALSE(stacks.empty());
+
+        const auto total = std::accumulate(std::begin(stacks), std::end(stacks), std::size_t{0},
+                                           [](auto _sum, const auto& _e) { return _sum + _e.second; });
+        REQUIRE(total == sampler.sample_count());
+
+        const auto found = std::any_of(std::begin(stacks), std::end(stacks), [](const auto& _e) {
+            return _e.first.find("irods::stacktrace::") != std::string::npos;
+        });
+        REQUIRE(found);
+
+        std::stringstream ss;
+        sampler.write_folded_stacks(ss);
+
+        for (std::string line; std::getline(ss, line);) {
+            const auto space = line.rfind(' ');
+            REQUIRE(space != std::string::npos);
+            REQUIRE(std::stoul(line.substr(space + 1)) > 0);
+        }
+    }
+
+    SECTION("wall sampling captures blocked time")
+    {
+        prof::sampler sampler{100, prof::sampling_clock::wall};
+        std::this_thread::sleep_for(200ms);
+        sampler.stop();
+
+        REQUIRE(sampler.sample_count() > 0);
+        REQUIRE(sampler.elapsed() >= 200ms);
+    }
+
+    SECTION("sample rate is bounded by the sampling frequency")
+    {
+        prof::sampler sampler{prof::maximum_sampling_frequency_in_hz * 10, prof::sampling_clock::wall};
+        std::this_thread::sleep_for(100ms);
+        sampler.stop();
+
+        const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(sampler.elapsed()).count();
+        REQUIRE(sampler.sample_count() <= static_cast<std::size_t>(elapsed_ms + 1));
+
+        // Stopping again has no effect.
+        const auto count = sampler.sample_count();
+        sampler.stop();
+        synthetic_api(20ms);
+        REQUIRE(sampler.sample_count() == count);
+    }
+
+    SECTION("only one sampler can be active")
+    {
+        prof::sampler sampler{99, prof::sampling_clock::cpu};
+        REQUIRE_THROWS_AS((prof::sampler{99, prof::sampling_clock::cpu}), irods::exception);
+    }
+
+    SECTION("profiling is disabled without configuration")
+    {
+        REQUIRE_FALSE(prof::is_enabled_for(700));
+    }
+}
@@ -0,0 +1,264 @@
+#include "catch.hpp"
+
+#include "async_connection.hpp"
+#include "client_connection.hpp"
+#include "filesystem.hpp"
+#include "getRodsEnv.h"
+#include "obf.h"
+#include "rcMisc.h"
+#include "rodsClient.h"
+#include "rodsErrorTable.h"
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <fcntl.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/yield.hpp>
+
+namespace ix = irods::experimental;
+namespace fs = irods::experimental::filesystem;
+
+namespace
+{
+    auto get_password() -> std::string
+    {
+        char password[MAX_PASSWORD_LEN + 2]{};
+        obfGetPw(password);
+        return password;
+    }
+
+    // Connects, logs in and stats a path a number of times, one operation after the other.
+    struct stat_session : boost::asio::coroutine
+    {
+        ix::async_connection* conn;
+        const rodsEnv* env;
+        const std::string* password;
+        std::string path;
+        int iterations;
+        int* completed;
+        int* failed;
+
+        void operator()(int _status = 0, rodsObjStat_t* _stat = nullptr)
+        {
+            if (_stat) {
+                freeRodsObjStat(_stat);
+            }
+
+            if (_status < 0) {
+                ++*failed;
+                return;
+            }
+
+            reenter (this) {
+                yield conn->async_connect(env->rodsHost, env->rodsPort, env->rodsUserName, env->rodsZone, *this);
+                yield conn->async_login(*password, *this);
+
+                while (iterations-- > 0) {
+                    yield conn->async_stat(path, *this);
+                    ++*completed;
+                }
+
+                yield conn->async_disconnect(*this);
+            }
+        }
+    }; // struct stat_session
+} // anonymous namespace
+
+TEST_CASE("async_connection")
+{
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    const auto password = get_password();
+
+    boost::asio::io_context io_context;
+
+    SECTION("connect, login and stat")
+    {
+        ix::async_connection conn{io_context};
+
+        int connect_status = -1;
+        int login_status = -1;
+        int stat_status = -1;
+        int object_type = UNKNOWN_OBJ_T;
+
+        conn.async_connect(env.rodsHost, env.rodsPort, env.rodsUserName, env.rodsZone, [&](int _status) {
+            connect_status = _status;
+
+            conn.async_login(password, [&](int _status) {
+                login_status = _status;
+
+                conn.async_stat(env.rodsHome, [&](int _status, rodsObjStat_t* _stat) {
+                    stat_status = _status;
+
+                    if (_stat) {
+                        object_type = _stat->objType;
+                        freeRodsObjStat(_stat);
+                    }
+                });
+            });
+        });
+
+        io_context.run();
+
+        REQUIRE(connect_status == 0);
+        REQUIRE_FALSE(conn.server_version().empty());
+        REQUIRE(login_status == 0);
+        REQUIRE(stat_status >= 0);
+        REQUIRE(object_type == COLL_OBJ_T);
+    }
+
+    SECTION("errors are passed to the handler")
+    {
+        ix::async_connection conn{io_context};
+
+        int stat_status = 0;
+        rodsObjStat_t* stat = nullptr;
+
+        conn.async_connect(env.rodsHost, env.rodsPort, env.rodsUserName, env.rodsZone, [&](int) {
+            conn.async_login(password, [&](int) {
+                conn.async_stat(std::string{env.rodsHome} + "/does_not_exist", [&](int _status, rodsObjStat_t* _stat) {
+                    stat_status = _status;
+                    stat = _stat;
+                });
+            });
+        });
+
+        io_context.run();
+
+        REQUIRE(stat_status < 0);
+        REQUIRE(stat == nullptr);
+
+        // The connection remains usable.
+        REQUIRE(conn.is_open());
+    }
+
+    SECTION("a wrong password is rejected")
+    {
+        ix::async_connection conn{io_context};
+
+        int login_status = 0;
+
+        conn.async_connect(env.rodsHost, env.rodsPort, env.rodsUserName, env.rodsZone, [&](int) {
+            conn.async_login(password + "_wrong", [&](int _status) { login_status = _status; });
+        });
+
+        io_context.run();
+
+        REQUIRE(login_status == CAT_INVALID_AUTHENTICATION);
+    }
+
+    SECTION("general queries")
+    {
+        ix::async_connection conn{io_context};
+
+        int query_status = -1;
+        int row_count = 0;
+
+        conn.async_connect(env.rodsHost, env.rodsPort, env.rodsUserName, env.rodsZone, [&](int) {
+            conn.async_login(password, [&](int) {
+                genQueryInp_t input{};
+                input.maxRows = MAX_SQL_ROWS;
+                addInxIval(&input.selectInp, COL_COLL_NAME, 0);
+
+                const auto condition = "= '" + std::string{env.rodsHome} + "'";
+                addInxVal(&input.sqlCondInp, COL_COLL_NAME, condition.c_str());
+
+                conn.async_gen_query(input, [&](int _status, genQueryOut_t* _output) {
+                    query_status = _status;
+
+                    if (_output) {
+                        row_count = _output->rowCnt;
+                        freeGenQueryOut(&_output);
+                    }
+                });
+
+                // The input is packed before async_gen_query returns.
+                clearGenQueryInp(&input);
+            });
+        });
+
+        io_context.run();
+
+        REQUIRE(query_status >= 0);
+        REQUIRE(row_count == 1);
+    }
+
+    SECTION("write and read a data object")
+    {
+        const auto path = fs::path{env.rodsHome} / "async_connection_data_object";
+        const std::string contents = "the quick brown fox jumps over the lazy dog";
+        std::string read_back(contents.size(), '\0');
+
+        ix::async_connection conn{io_context};
+
+        int write_status = -1;
+        int read_status = -1;
+
+        conn.async_connect(env.rodsHost, env.rodsPort, env.rodsUserName, env.rodsZone, [&](int) {
+            conn.async_login(password, [&](int) {
+                dataObjInp_t input{};
+                rstrcpy(input.objPath, path.c_str(), MAX_NAME_LEN);
+                input.openFlags = O_CREAT | O_WRONLY | O_TRUNC;
+                input.createMode = 0600;
+
+                conn.async_open(input, [&](int _fd) {
+                    conn.async_write(_fd, contents.data(), contents.size(), [&, _fd](int _status) {
+                        write_status = _status;
+
+                        conn.async_close(_fd, [&](int) {
+                            dataObjInp_t input{};
+                            rstrcpy(input.objPath, path.c_str(), MAX_NAME_LEN);
+                            input.openFlags = O_RDONLY;
+
+                            conn.async_open(input, [&](int _fd) {
+                                conn.async_read(_fd, read_back.data(), read_back.size(), [&, _fd](int _status) {
+                                    read_status = _status;
+                                    conn.async_close(_fd, [](int) {});
+                                });
+                            });
+                        });
+                    });
+                });
+            });
+        });
+
+        io_context.run();
+
+        ix::client_connection sync_conn;
+        fs::client::remove(sync_conn, path, fs::remove_options::no_trash);
+
+        REQUIRE(write_status == static_cast<int>(contents.size()));
+        REQUIRE(read_status == static_cast<int>(contents.size()));
+        REQUIRE(read_back == contents);
+    }
+
+    SECTION("many connections are driven by a single thread")
+    {
+        constexpr int session_count = 32;
+        constexpr int iterations = 10;
+
+        std::vector<std::unique_ptr<ix::async_connection>> conns;
+        int completed = 0;
+        int failed = 0;
+
+        for (int i = 0; i < session_count; ++i) {
+            conns.push_back(std::make_unique<ix::async_connection>(io_context));
+            stat_session{{}, conns.back().get(), &env, &password, env.rodsHome, iterations, &completed, &failed}();
+        }
+
+        io_context.run();
+
+        REQUIRE(failed == 0);
+        REQUIRE(completed == session_count * iterations);
+    }
+}
+
+#include <boost/asio/unyield.hpp>
@@ -0,0 +1,195 @@
+#include "catch.hpp"
+
+#include "agent_connection_health.hpp"
+#include "connection_health.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsErrorTable.h"
+
+#include <boost/any.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ach = irods::experimental::agent_connection_health;
+namespace ch  = irods::experimental::connection_health;
+
+namespace
+{
+    auto get_option(int _socket, int _name) -> int
+    {
+        int value = 0;
+        socklen_t size = sizeof(value);
+        REQUIRE(getsockopt(_socket, IPPROTO_TCP, _name, &value, &size) == 0);
+        return value;
+    }
+} // anonymous namespace
+
+TEST_CASE("connection_health")
+{
+    SECTION("keepalive options are applied to a socket")
+    {
+        const int sock = socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(sock >= 0);
+
+        ch::tcp_keepalive_options options;
+        options.idle_in_seconds = 45;
+        options.interval_in_seconds = 5;
+        options.probe_count = 3;
+        options.user_timeout_in_milliseconds = 750;
+
+        CHECK(ch::set_tcp_keepalive_options(sock, options) == 0);
+        CHECK(get_option(sock, TCP_KEEPIDLE) == 45);
+        CHECK(get_option(sock, TCP_KEEPINTVL) == 5);
+        CHECK(get_option(sock, TCP_KEEPCNT) == 3);
+        CHECK(get_option(sock, TCP_USER_TIMEOUT) == 750);
+
+        // Zeros leave the current values in place.
+        CHECK(ch::set_tcp_keepalive_options(sock, ch::tcp_keepalive_options{}) == 0);
+        CHECK(get_option(sock, TCP_KEEPIDLE) == 45);
+        CHECK(get_option(sock, TCP_USER_TIMEOUT) == 750);
+
+        close(sock);
+    }
+
+    SECTION("the process default options can be replaced")
+    {
+        const auto saved = ch::default_tcp_keepalive_options();
+
+        ch::tcp_keepalive_options options;
+        options.idle_in_seconds = 30;
+        ch::set_default_tcp_keepalive_options(options);
+
+        CHECK(ch::default_tcp_keepalive_options().idle_in_seconds == 30);
+        CHECK(ch::default_tcp_keepalive_options().user_timeout_in_milliseconds == 0);
+
+        ch::set_default_tcp_keepalive_options(saved);
+    }
+
+    SECTION("heartbeats are only sent to agents that said they answer them")
+    {
+        version_t version{};
+        std::snprintf(version.relVersion, sizeof(version.relVersion), "%s", "rods4.3.0");
+
+        // The release version alone does not tell whether the agent answers heartbeats.
+        CHECK_FALSE(ch::server_supports_heartbeat(version));
+
+        version.status = ch::heartbeat_supported;
+        CHECK(ch::server_supports_heartbeat(version));
+
+        version.status = SYS_AGENT_INIT_ERR;
+        CHECK_FALSE(ch::server_supports_heartbeat(version));
+
+        rcComm_t conn{};
+        CHECK(ch::send_heartbeat(conn) == SYS_NOT_SUPPORTED);
+
+        version.status = 0;
+        conn.svrVersion = &version;
+        CHECK(ch::send_heartbeat(conn) == SYS_NOT_SUPPORTED);
+    }
+
+    SECTION("the heartbeat request travels in the option of the startup pack")
+    {
+        startupPack_t startup_pack{};
+        std::snprintf(startup_pack.option, sizeof(startup_pack.option), "%s%s", "iput", REQ_SVR_NEG);
+
+        ch::add_heartbeat_request(startup_pack.option, sizeof(startup_pack.option));
+
+        std::string option = startup_pack.option;
+        CHECK(option == std::string{"iput"} + REQ_SVR_NEG + ch::heartbeat_request);
+
+        // Servers predating the request drop everything from the negotiation token onwards.
+        CHECK(option.substr(0, option.find(REQ_SVR_NEG)) == "iput");
+
+        CHECK(ch::remove_heartbeat_request(option));
+        CHECK(option == std::string{"iput"} + REQ_SVR_NEG);
+        CHECK_FALSE(ch::remove_heartbeat_request(option));
+
+        // Without the negotiation token, an old server would forward the request to the agent
+        // as part of the client program name.
+        std::snprintf(startup_pack.option, sizeof(startup_pack.option), "%s", "iput");
+        ch::add_heartbeat_request(startup_pack.option, sizeof(startup_pack.option));
+        CHECK(std::string{startup_pack.option} == "iput");
+
+        std::snprintf(startup_pack.option, sizeof(startup_pack.option), "%s%s%s", "iput", REQ_SVR_NEG, "x");
+        ch::add_heartbeat_request(startup_pack.option, sizeof(startup_pack.option));
+        CHECK(std::string{startup_pack.option} == std::string{"iput"} + REQ_SVR_NEG + "x");
+
+        // A full option string is left alone.
+        const std::string full = std::string(sizeof(startup_pack.option) - 1 - std::strlen(REQ_SVR_NEG), 'x') + REQ_SVR_NEG;
+        std::snprintf(startup_pack.option, sizeof(startup_pack.option), "%s", full.c_str());
+        ch::add_heartbeat_request(startup_pack.option, sizeof(startup_pack.option));
+        CHECK(startup_pack.option == full);
+    }
+
+    SECTION("the idle timeout must be positive")
+    {
+        using map_type = std::unordered_map<std::string, boost::any>;
+
+        const irods::configuration_parser::key_path_t path{irods::CFG_ADVANCED_SETTINGS_KW,
+                                                           irods::CFG_AGENT_CONNECTION_HEALTH_KW};
+
+        map_type original;
+        try {
+            original = irods::get_server_property<map_type&>(path);
+        }
+        catch (...) {}
+
+        irods::at_scope_exit restore_settings{[&path, &original] {
+            irods::set_server_property<map_type>(path, original);
+        }};
+
+        const auto read_idle_timeout = [&path](int _value) {
+            irods::set_server_property<map_type>(path, map_type{{irods::CFG_IDLE_TIMEOUT_IN_SECONDS_KW, _value}});
+            return ach::read_config().idle_timeout_in_seconds;
+        };
+
+        CHECK(read_idle_timeout(60) == 60);
+        CHECK(read_idle_timeout(0) == ach::config{}.idle_timeout_in_seconds);
+        CHECK(read_idle_timeout(-5) == ach::config{}.idle_timeout_in_seconds);
+
+        // Clients that do not send heartbeats keep their agent as long as before.
+        CHECK(ach::config{}.idle_timeout_in_seconds == 86400);
+    }
+
+    SECTION("reaped sessions are counted across processes")
+    {
+        CHECK(ach::statistics().idle_sessions_reaped == 0);
+
+        ach::init("irods_unit_test_agent_connection_health");
+
+        ach::record_idle_session_reaped(false);
+        ach::record_idle_session_reaped(true);
+        ach::record_heartbeat();
+
+        if (const auto pid = fork(); pid == 0) {
+            ach::record_broken_connection();
+            ach::record_idle_session_reaped(true);
+            _exit(0);
+        }
+        else {
+            REQUIRE(pid > 0);
+            int status = 0;
+            REQUIRE(waitpid(pid, &status, 0) == pid);
+        }
+
+        const auto counters = ach::statistics();
+        CHECK(counters.idle_sessions_reaped == 3);
+        CHECK(counters.idle_sessions_reaped_with_open_descriptors == 2);
+        CHECK(counters.broken_connections == 1);
+        CHECK(counters.heartbeats_received == 1);
+
+        ach::deinit();
+
+        CHECK(ach::statistics().broken_connections == 0);
+    }
+}
@@ -0,0 +1,165 @@
+#include "catch.hpp"
+
+#include "multi_source_copy.hpp"
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace msc = irods::experimental::multi_source_copy;
+
+namespace
+{
+    auto make_data(std::size_t _size) -> std::string
+    {
+        std::string data(_size, '\0');
+
+        for (std::size_t i = 0; i < _size; ++i) {
+            data[i] = static_cast<char>('a' + (i * 7) % 26);
+        }
+
+        return data;
+    }
+
+    // A source backed by an in-memory copy of the data that counts the bytes it served.
+    auto make_source(const std::string& _data, std::atomic<std::int64_t>& _served,
+                     std::chrono::microseconds _delay = {}) -> msc::read_function
+    {
+        return [&_data, &_served, _delay](std::int64_t _offset, char* _buffer, int _count) -> int {
+            std::this_thread::sleep_for(_delay);
+            const auto n = std::min<std::int64_t>(_count, static_cast<std::int64_t>(_data.size()) - _offset);
+            std::memcpy(_buffer, _data.data() + _offset, n);
+            _served += n;
+            return static_cast<int>(n);
+        };
+    }
+
+    auto make_sink(std::string& _out) -> msc::write_function
+    {
+        return [&_out](std::int64_t _offset, const char* _buffer, int _count) -> int {
+            std::memcpy(_out.data() + _offset, _buffer, _count);
+            return _count;
+        };
+    }
+} // anonymous namespace
+
+TEST_CASE("multi_source_copy")
+{
+    const auto data = make_data(1'000'003);
+    std::string out(data.size(), '\0');
+    std::atomic<std::int64_t> served_a{0};
+    std::atomic<std::int64_t> served_b{0};
+    std::atomic<std::int64_t> served_c{0};
+
+    SECTION("all sources contribute and the sink receives every byte once")
+    {
+        const std::vector<msc::read_function> sources{make_source(data, served_a, std::chrono::microseconds{50}),
+                                                      make_source(data, served_b, std::chrono::microseconds{50}),
+                                                      make_source(data, served_c, std::chrono::microseconds{50})};
+
+        REQUIRE(msc::copy(sources, make_sink(out), data.size(), 4096) == 0);
+        REQUIRE(out == data);
+        REQUIRE(served_a + served_b + served_c == static_cast<std::int64_t>(data.size()));
+        REQUIRE(served_a > 0);
+        REQUIRE(served_b > 0);
+        REQUIRE(served_c > 0);
+    }
+
+    SECTION("a failing source hands its blocks to the others")
+    {
+        std::atomic<int> calls{0};
+        const msc::read_function failing = [&calls](std::int64_t, char*, int) -> int {
+            ++calls;
+            return SYS_SOCK_READ_ERR;
+        };
+
+        const std::vector<msc::read_function> sources{failing, make_source(data, served_a)};
+
+        REQUIRE(msc::copy(sources, make_sink(out), data.size(), 4096) == 0);
+        REQUIRE(out == data);
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("the copy fails when every source fails")
+    {
+        const msc::read_function failing = [](std::int64_t, char*, int) { return SYS_SOCK_READ_ERR; };
+        REQUIRE(msc::copy({failing, failing}, make_sink(out), data.size(), 4096) == SYS_SOCK_READ_ERR);
+    }
+
+    SECTION("short sources are reported")
+    {
+        const std::string truncated = data.substr(0, data.size() / 2);
+        REQUIRE(msc::copy({make_source(truncated, served_a)}, make_sink(out), data.size(), 4096) == SYS_COPY_LEN_ERR);
+    }
+
+    SECTION("sink errors stop the copy")
+    {
+        std::atomic<int> writes{0};
+        const msc::write_function sink = [&writes](std::int64_t, const char*, int) {
+            return ++writes < 3 ? 4096 : SYS_COPY_LEN_ERR - 1;
+        };
+
+        const std::vector<msc::read_function> sources{make_source(data, served_a), make_source(data, served_b)};
+        REQUIRE(msc::copy(sources, sink, data.size(), 4096) == SYS_COPY_LEN_ERR - 1);
+        REQUIRE(writes == 3);
+    }
+
+    SECTION("empty data")
+    {
+        REQUIRE(msc::copy({make_source(data, served_a)}, make_sink(out), 0, 4096) == 0);
+        REQUIRE(served_a == 0);
+    }
+
+    SECTION("copies resume at an offset and report contiguous progress")
+    {
+        const std::int64_t offset = 4096 * 10;
+        std::vector<std::int64_t> progress;
+
+        const std::vector<msc::read_function> sources{make_source(data, served_a, std::chrono::microseconds{50}),
+                                                      make_source(data, served_b)};
+
+        const auto ec = msc::copy(sources, make_sink(out), offset, data.size(), 4096,
+                                  [&progress](std::int64_t _offset) { progress.push_back(_offset); });
+
+        REQUIRE(ec == 0);
+        REQUIRE(out.substr(0, offset) == std::string(offset, '\0'));
+        REQUIRE(out.substr(offset) == data.substr(offset));
+        REQUIRE(served_a + served_b == static_cast<std::int64_t>(data.size()) - offset);
+        REQUIRE_FALSE(progress.empty());
+        REQUIRE(std::is_sorted(std::begin(progress), std::end(progress)));
+        REQUIRE(progress.front() > offset);
+        REQUIRE(progress.back() == static_cast<std::int64_t>(data.size()));
+    }
+
+    SECTION("progress stops at the first gap when the copy fails")
+    {
+        // The sink fails on the third block. Everything before it was written without gaps.
+        std::int64_t last_progress = -1;
+        const msc::write_function sink = [&out](std::int64_t _offset, const char* _buffer, int _count) {
+            if (_offset == 2 * 4096) {
+                return SYS_COPY_LEN_ERR - 1;
+            }
+            std::memcpy(out.data() + _offset, _buffer, _count);
+            return _count;
+        };
+
+        const auto ec = msc::copy({make_source(data, served_a)}, sink, 0, data.size(), 4096,
+                                  [&last_progress](std::int64_t _offset) { last_progress = _offset; });
+
+        REQUIRE(ec == SYS_COPY_LEN_ERR - 1);
+        REQUIRE(last_progress == 2 * 4096);
+    }
+
+    SECTION("invalid arguments")
+    {
+        REQUIRE(msc::copy({}, make_sink(out), data.size(), 4096) == SYS_INVALID_INPUT_PARAM);
+        REQUIRE(msc::copy({make_source(data, served_a)}, make_sink(out), data.size(), 0) == SYS_INVALID_INPUT_PARAM);
+        REQUIRE(msc::copy({make_source(data, served_a)}, make_sink(out), 10, 5, 4096, {}) == SYS_INVALID_INPUT_PARAM);
+    }
+}
@@ -0,0 +1,95 @@
+#include "catch.hpp"
+
+#include "network_topology.hpp"
+#include "voting.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <chrono>
+
+namespace nt = irods::experimental::network_topology;
+namespace voting = irods::experimental::resource::voting;
+
+using namespace std::chrono_literals;
+
+TEST_CASE("network_topology")
+{
+    nt::config topology;
+    topology.hosts = {{"east-1", "east", "rack-1"},
+                      {"east-2", "east", "rack-1"},
+                      {"east-3", "east", "rack-2"},
+                      {"west-1", "west", "rack-1"}};
+
+    SECTION("proximity")
+    {
+        CHECK(nt::proximity_between(topology, "east-1", "east-1") == nt::proximity::same_host);
+        CHECK(nt::proximity_between(topology, "east-1", "east-2") == nt::proximity::same_rack);
+        CHECK(nt::proximity_between(topology, "east-1", "east-3") == nt::proximity::same_site);
+
+        // Racks are only compared within a site.
+        CHECK(nt::proximity_between(topology, "east-1", "west-1") == nt::proximity::remote_site);
+
+        CHECK(nt::proximity_between(topology, "east-1", "unknown") == nt::proximity::unknown);
+    }
+
+    SECTION("expected transfer time")
+    {
+        constexpr std::int64_t gigabyte = 1024 * 1024 * 1024;
+
+        const auto same_rack = nt::expected_transfer_time(topology, "east-2", "east-1", gigabyte, std::nullopt);
+        const auto same_site = nt::expected_transfer_time(topology, "east-3", "east-1", gigabyte, std::nullopt);
+        const auto remote_site = nt::expected_transfer_time(topology, "west-1", "east-1", gigabyte, std::nullopt);
+
+        REQUIRE(same_rack);
+        REQUIRE(same_site);
+        REQUIRE(remote_site);
+        CHECK(*same_rack < *same_site);
+        CHECK(*same_site < *remote_site);
+
+        CHECK_FALSE(nt::expected_transfer_time(topology, "unknown", "east-1", gigabyte, std::nullopt));
+
+        // A measured round trip time replaces the assumed one.
+        const auto small_file = nt::expected_transfer_time(topology, "west-1", "east-1", 0, 80ms);
+        REQUIRE(small_file);
+        CHECK(*small_file == 80ms);
+    }
+
+    SECTION("votes for opening a replica on another host")
+    {
+        constexpr std::int64_t gigabyte = 1024 * 1024 * 1024;
+
+        const auto vote_from = [&topology](const char* _host, std::int64_t _bytes, std::optional<std::chrono::microseconds> _rtt) {
+            return voting::calculate_for_expected_transfer_time(nt::expected_transfer_time(topology, _host, "east-1", _bytes, _rtt));
+        };
+
+        const auto same_rack = vote_from("east-2", gigabyte, std::nullopt);
+        const auto same_site = vote_from("east-3", gigabyte, std::nullopt);
+        const auto remote_site = vote_from("west-1", gigabyte, std::nullopt);
+
+        CHECK(same_rack > same_site);
+        CHECK(same_site > remote_site);
+        CHECK(remote_site > voting::vote::low);
+
+        // A replica on this host votes vote::high, even against an empty replica next to it.
+        CHECK(same_rack < voting::vote::high);
+        CHECK(vote_from("east-2", 0, 0ms) < voting::vote::high);
+
+        // Hosts outside of the topology keep the vote they had without one.
+        CHECK(vote_from("unknown", gigabyte, std::nullopt) == voting::vote::medium);
+    }
+
+    SECTION("round trip time samples")
+    {
+        nt::init("irods_network_topology_test", 100'000);
+        irods::at_scope_exit cleanup{[] { nt::deinit(); }};
+
+        REQUIRE_FALSE(nt::lookup("west-1", 60s));
+
+        nt::insert_or_assign("west-1", 30ms);
+        auto sample = nt::lookup("west-1", 60s);
+        REQUIRE(sample);
+        CHECK(*sample == 30ms);
+
+        nt::erase("west-1");
+        CHECK_FALSE(nt::lookup("west-1", 60s));
+    }
+}
@@ -19,6 +19,8 @@
 #include <thread>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 
 namespace ix = irods::experimental;
 namespace io = irods::experimental::io;
@@ -28,6 +30,37 @@ using stream_factory_functor = std::function<Stream(std::ios_base::openmode, Str
 
 auto create_local_file(const boost::filesystem::path& _p, std::size_t _size) noexcept -> bool;
 
+// An input file stream whose reads can be slowed down. Used to simulate a slow channel.
+struct throttled_fstream
+    : public std::fstream
+{
+    throttled_fstream(const std::string& _path, std::ios_base::openmode _mode, bool _throttled)
+        : std::fstream{_path, _mode}
+        , throttled{_throttled}
+    {
+    }
+
+    throttled_fstream(throttled_fstream&& _other)
+        : std::fstream{std::move(_other)}
+        , throttled{_other.throttled}
+    {
+    }
+
+    // Hides std::fstream::read. The parallel transfer engine only ever calls read() through
+    // the source stream type, so this is enough to slow down a single channel.
+    auto read(char_type* _buffer, std::streamsize _count) -> std::fstream&
+    {
+        if (throttled) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+
+        std::fstream::read(_buffer, _count);
+        return *this;
+    }
+
+    bool throttled;
+}; // struct throttled_fstream
+
 constexpr auto operator ""_mb(unsigned long long _x) noexcept -> std::size_t
 {
     return _x * 1024 * 1024;
@@ -185,6 +218,81 @@ TEST_CASE("parallel transfer engine")
     }
 }
 
+TEST_CASE("parallel transfer engine redistributes chunks of slow channels")
+{
+    namespace fs = boost::filesystem;
+
+    const auto local_file = fs::current_path() / "irods_parallel_transfer_engine_throttled_test_file";
+    const auto local_file_copy = fs::current_path() / "irods_parallel_transfer_engine_throttled_test_file.copy";
+    irods::at_scope_exit remove_local_files{[&local_file, &local_file_copy] {
+        fs::remove(local_file);
+        fs::remove(local_file_copy);
+    }};
+
+    // Fill the file with a pattern so that misplaced chunks are detected.
+    {
+        std::ofstream out{local_file.string(), std::ios::binary};
+        for (std::size_t i = 0; i < 16_mb; ++i) {
+            out.put(static_cast<char>(i % 251));
+        }
+        REQUIRE(out);
+    }
+
+    // The second source stream created by the engine belongs to channel 1.
+    std::atomic<int> streams_created{};
+    const auto slow_channel = 1;
+
+    auto source_fac = [&](std::ios_base::openmode _mode, throttled_fstream*) {
+        return throttled_fstream{local_file.string(), _mode, streams_created++ == slow_channel};
+    };
+
+    const auto sink_fac = io::make_fstream_factory(local_file_copy.string());
+
+    const auto total_bytes_to_transfer = static_cast<std::int64_t>(16_mb);
+    const auto channel_count = 4;
+
+    io::parallel_transfer_engine_builder<throttled_fstream, std::fstream>
+        builder{source_fac, sink_fac, io::close_stream<std::fstream>, total_bytes_to_transfer};
+
+    auto transfer = builder.number_of_channels(channel_count)
+                           .chunk_size(1_mb)
+                           .transfer_buffer_size(64 * 1024)
+                           .build();
+
+    transfer.wait();
+
+    REQUIRE(transfer.success());
+    REQUIRE(transfer.errors().empty());
+
+    const auto stats = transfer.statistics();
+    REQUIRE(stats.size() == channel_count);
+
+    std::int64_t bytes_transferred = 0;
+    std::int64_t chunks_stolen = 0;
+
+    for (auto&& s : stats) {
+        bytes_transferred += s.bytes_transferred;
+        chunks_stolen += s.chunks_stolen;
+    }
+
+    // Every byte was transferred exactly once and the other channels took over the
+    // chunks the slow channel did not get to.
+    REQUIRE(bytes_transferred == total_bytes_to_transfer);
+    REQUIRE(stats[slow_channel].bytes_transferred < total_bytes_to_transfer / channel_count);
+    REQUIRE(chunks_stolen > 0);
+
+    const auto fastest = std::max_element(std::begin(stats), std::end(stats), [](auto&& _a, auto&& _b) {
+        return _a.throughput() < _b.throughput();
+    });
+    REQUIRE(stats[slow_channel].throughput() < fastest->throughput());
+
+    // Verify the contents of the copy.
+    std::ifstream original{local_file.string(), std::ios::binary};
+    std::ifstream copy{local_file_copy.string(), std::ios::binary};
+    REQUIRE(fs::file_size(local_file_copy) == fs::file_size(local_file));
+    REQUIRE(std::equal(std::istreambuf_iterator<char>{original}, {}, std::istreambuf_iterator<char>{copy}));
+}
+
 auto create_local_file(const boost::filesystem::path& _p, std::size_t _size) noexcept -> bool
 {
     std::array<char, 1024 * 1024> buf{};
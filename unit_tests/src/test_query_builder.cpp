@@ -70,6 +70,44 @@ TEST_CASE("query builder")
         }());
     }
 
+    SECTION("batch of queries")
+    {
+        auto conn = conn_pool.get_connection();
+
+        const std::vector<std::string> queries{
+            "select COLL_NAME where COLL_NAME = '" + user_home.string() + "'",
+            "select COLL_NAME where COLL_NAME = '" + user_home.string() + "/does_not_exist'",
+            "select NO_SUCH_COLUMN"
+        };
+
+        const auto results = ix::query_builder{}
+            .zone_hint(env.rodsZone)
+            .build<rcComm_t>(conn, queries);
+
+        REQUIRE(results.size() == queries.size());
+
+        // Results are returned in the same order as the queries.
+        REQUIRE(results[0].error_code == 0);
+        REQUIRE(results[0].rows.size() == 1);
+        REQUIRE(results[0].rows[0][0] == user_home.string());
+
+        // A query that matches nothing is not an error.
+        REQUIRE(results[1].error_code == 0);
+        REQUIRE(results[1].rows.empty());
+
+        // A failed query does not prevent the other queries from executing.
+        REQUIRE(results[2].error_code < 0);
+        REQUIRE_FALSE(results[2].error_message.empty());
+    }
+
+    SECTION("throw exception on empty query list")
+    {
+        REQUIRE_THROWS([&conn_pool] {
+            auto conn = conn_pool.get_connection();
+            ix::query_builder{}.build<rcComm_t>(conn, std::vector<std::string>{});
+        }(), "query list is empty");
+    }
+
     SECTION("throw exception on empty query string")
     {
         REQUIRE_THROWS([&conn_pool] {
@@ -0,0 +1,72 @@
+#include "catch.hpp"
+
+#include "redirect_token.hpp"
+
+#include <ctime>
+#include <string>
+
+namespace rt = irods::experimental::redirect_token;
+
+TEST_CASE("redirect_token")
+{
+    const std::string key = "TEMPORARY_zone_key";
+    const std::string hierarchy = "root_resc;child_resc;leaf_resc";
+    const rt::context ctx{rt::put_redirect, "/tempZone/home/rods/foo", "rods", "tempZone"};
+    const auto now = static_cast<std::int64_t>(std::time(nullptr));
+    const auto expires_at = now + rt::lifetime.count();
+
+    const auto token = rt::make(key, ctx, hierarchy, expires_at);
+
+    SECTION("round trip")
+    {
+        const auto result = rt::verify(key, ctx, token, now);
+        REQUIRE(result);
+        REQUIRE(*result == hierarchy);
+
+        // The host separator must never appear in a token.
+        REQUIRE(token.find(rt::host_separator) == std::string::npos);
+    }
+
+    SECTION("expired token is rejected")
+    {
+        REQUIRE(rt::verify(key, ctx, token, expires_at));
+        REQUIRE_FALSE(rt::verify(key, ctx, token, expires_at + 1));
+    }
+
+    SECTION("token is bound to the request")
+    {
+        REQUIRE_FALSE(rt::verify(key, {rt::get_redirect, ctx.logical_path, ctx.user_name, ctx.user_zone}, token, now));
+        REQUIRE_FALSE(rt::verify(key, {ctx.operation, "/tempZone/home/rods/bar", ctx.user_name, ctx.user_zone}, token, now));
+        REQUIRE_FALSE(rt::verify(key, {ctx.operation, ctx.logical_path, "alice", ctx.user_zone}, token, now));
+        REQUIRE_FALSE(rt::verify(key, {ctx.operation, ctx.logical_path, ctx.user_name, "otherZone"}, token, now));
+    }
+
+    SECTION("token signed with another key is rejected")
+    {
+        REQUIRE_FALSE(rt::verify("another_zone_key", ctx, token, now));
+    }
+
+    SECTION("tampered token is rejected")
+    {
+        // Substituting the hierarchy invalidates the signature.
+        const auto forged = rt::make("another_zone_key", ctx, "other_resc", expires_at);
+        const auto forged_hier = forged.substr(0, forged.rfind('.'));
+        const auto original_mac = token.substr(token.rfind('.'));
+        REQUIRE_FALSE(rt::verify(key, ctx, forged_hier + original_mac, now));
+
+        // Extending the lifetime invalidates the signature.
+        auto extended = token;
+        extended.replace(2, std::to_string(expires_at).size(), std::to_string(expires_at + 3600));
+        REQUIRE_FALSE(rt::verify(key, ctx, extended, expires_at + 1));
+    }
+
+    SECTION("malformed tokens are rejected")
+    {
+        REQUIRE_FALSE(rt::verify(key, ctx, "", now));
+        REQUIRE_FALSE(rt::verify(key, ctx, "1.2.3", now));
+        REQUIRE_FALSE(rt::verify(key, ctx, "2" + token.substr(1), now));
+        REQUIRE_FALSE(rt::verify(key, ctx, token + ".", now));
+        REQUIRE_FALSE(rt::verify(key, ctx, token.substr(0, token.size() - 1), now));
+        REQUIRE_FALSE(rt::verify(key, ctx, rt::make(key, ctx, "", expires_at), now));
+    }
+}
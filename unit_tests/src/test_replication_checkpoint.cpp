@@ -0,0 +1,43 @@
+#include "catch.hpp"
+
+#include "replication_checkpoint.hpp"
+
+namespace rc = irods::experimental::replication_checkpoint;
+
+TEST_CASE("replication_checkpoint")
+{
+    const auto source_id = rc::make_source_id("sha2:z4DNiu1ILV0VJ9fccvzv+E5jJlkoSER9LcCw6H38mpA=", 1024);
+
+    SECTION("source identifiers depend on the checksum and the size")
+    {
+        REQUIRE(source_id.size() == 16);
+        REQUIRE(source_id == rc::make_source_id("sha2:z4DNiu1ILV0VJ9fccvzv+E5jJlkoSER9LcCw6H38mpA=", 1024));
+        REQUIRE(source_id != rc::make_source_id("sha2:z4DNiu1ILV0VJ9fccvzv+E5jJlkoSER9LcCw6H38mpA=", 1025));
+        REQUIRE(source_id != rc::make_source_id("sha2:ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0=", 1024));
+    }
+
+    SECTION("checkpoints round-trip and fit in the data_status column")
+    {
+        const rc::checkpoint cp{5'497'558'138'880, source_id};
+        const auto value = rc::to_string(cp);
+
+        REQUIRE(value.size() < 64);
+
+        const auto parsed = rc::parse(value);
+        REQUIRE(parsed);
+        REQUIRE(parsed->offset == cp.offset);
+        REQUIRE(parsed->source_id == cp.source_id);
+    }
+
+    SECTION("other values are not checkpoints")
+    {
+        REQUIRE_FALSE(rc::parse(""));
+        REQUIRE_FALSE(rc::parse("locked"));
+        REQUIRE_FALSE(rc::parse("resume:"));
+        REQUIRE_FALSE(rc::parse("resume::" + source_id));
+        REQUIRE_FALSE(rc::parse("resume:-1:" + source_id));
+        REQUIRE_FALSE(rc::parse("resume:12:abc"));
+        REQUIRE_FALSE(rc::parse("resume:12:zzzzzzzzzzzzzzzz"));
+        REQUIRE_FALSE(rc::parse("resume:99999999999999999999:" + source_id));
+    }
+}
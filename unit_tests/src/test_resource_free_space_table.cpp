@@ -0,0 +1,63 @@
+#include "catch.hpp"
+
+#include "resource_free_space_table.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <thread>
+
+namespace fst = irods::experimental::resource::free_space_table;
+
+using namespace std::chrono_literals;
+
+TEST_CASE("resource_free_space_table")
+{
+    fst::init("irods_resource_free_space_table_test", 100'000);
+    irods::at_scope_exit cleanup{[] { fst::deinit(); }};
+
+    SECTION("insert / update / staleness")
+    {
+        REQUIRE_FALSE(fst::lookup("resc_a", 60s));
+
+        fst::insert_or_assign("resc_a", 1000);
+        auto sample = fst::lookup("resc_a", 60s);
+        REQUIRE(sample);
+        REQUIRE(sample->free_space_in_bytes == 1000);
+
+        fst::insert_or_assign("resc_a", 500);
+        sample = fst::lookup("resc_a", 60s);
+        REQUIRE(sample);
+        REQUIRE(sample->free_space_in_bytes == 500);
+
+        std::this_thread::sleep_for(2s);
+        REQUIRE_FALSE(fst::lookup("resc_a", 1s));
+        REQUIRE(fst::lookup("resc_a", 60s));
+    }
+
+    SECTION("erasure operations")
+    {
+        fst::insert_or_assign("resc_a", 1);
+        fst::insert_or_assign("resc_b", 2);
+
+        fst::erase("resc_a");
+        REQUIRE_FALSE(fst::lookup("resc_a", 60s));
+        REQUIRE(fst::lookup("resc_b", 60s));
+
+        fst::clear();
+        REQUIRE_FALSE(fst::lookup("resc_b", 60s));
+    }
+
+    SECTION("sample vault")
+    {
+        namespace fs = boost::filesystem;
+
+        // A vault that has not been created yet is sampled through its closest existing ancestor.
+        const auto vault = fs::temp_directory_path() / "irods_unit_test_vault_does_not_exist" / "child";
+        REQUIRE(fst::sample_vault(vault.string()));
+
+        // The root directory is never sampled.
+        REQUIRE_FALSE(fst::sample_vault("/"));
+    }
+}
@@ -0,0 +1,134 @@
+#include "catch.hpp"
+
+#include "base64.h"
+#include "irods_at_scope_exit.hpp"
+#include "irods_exception.hpp"
+#include "irods_re_structs.hpp"
+#include "json_serialization.hpp"
+#include "msParam.h"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rule_execution_context.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace rec = irods::rule_execution_context;
+
+TEST_CASE("rule_execution_context")
+{
+    msParamArray_t params{};
+    irods::at_scope_exit clear_params{[&params] { clearMsParamArray(&params, 1); }};
+
+    addMsParam(&params, "*path", STR_MS_T, strdup("/tempZone/home/rods/foo"), nullptr);
+    auto* count = static_cast<int*>(std::malloc(sizeof(int)));
+    *count = 42;
+    addMsParam(&params, "*count", INT_MS_T, count, nullptr);
+    addMsParam(&params, "*out", nullptr, nullptr, nullptr);
+
+    userInfo_t client{};
+    std::strncpy(client.userName, "alice", sizeof(client.userName) - 1);
+    std::strncpy(client.rodsZone, "tempZone", sizeof(client.rodsZone) - 1);
+    client.authInfo.authFlag = 3;
+
+    keyValPair_t cond_input{};
+    irods::at_scope_exit clear_cond_input{[&cond_input] { clearKeyVal(&cond_input); }};
+    addKeyVal(&cond_input, "instance_name", "irods_rule_engine_plugin-irods_rule_language-instance");
+
+    ruleExecInfo_t rei{};
+    std::strncpy(rei.ruleName, "delayed_rule", sizeof(rei.ruleName) - 1);
+    std::strncpy(rei.rescName, "demoResc", sizeof(rei.rescName) - 1);
+    rei.status = -1;
+    rei.msParamArray = &params;
+    rei.uoic = &client;
+    rei.condInputData = &cond_input;
+
+    const auto context = rec::encode(rei);
+
+    SECTION("round trip")
+    {
+        REQUIRE(rec::is_binary(context));
+
+        auto decoded = rec::decode(context);
+        irods::at_scope_exit free_decoded{[&decoded] { freeRuleExecInfoInternals(&decoded, FREE_MS_PARAM); }};
+
+        CHECK(std::string{decoded.ruleName} == rei.ruleName);
+        CHECK(std::string{decoded.rescName} == rei.rescName);
+        CHECK(decoded.status == rei.status);
+
+        REQUIRE(decoded.msParamArray);
+        REQUIRE(decoded.msParamArray->len == 3);
+        CHECK(std::string{parseMspForStr(decoded.msParamArray->msParam[0])} == "/tempZone/home/rods/foo");
+        CHECK(parseMspForPosInt(decoded.msParamArray->msParam[1]) == 42);
+        CHECK(std::string{decoded.msParamArray->msParam[2]->label} == "*out");
+
+        REQUIRE(decoded.uoic);
+        CHECK(std::string{decoded.uoic->userName} == "alice");
+        CHECK(decoded.uoic->authInfo.authFlag == 3);
+        CHECK_FALSE(decoded.uoip);
+
+        REQUIRE(decoded.condInputData);
+        CHECK(std::string{getValByKey(decoded.condInputData, "instance_name")} ==
+              "irods_rule_engine_plugin-irods_rule_language-instance");
+    }
+
+    SECTION("floating point values are stored least significant byte first")
+    {
+        auto* d = static_cast<double*>(std::malloc(sizeof(double)));
+        *d = 1.5; // 0x3ff8000000000000
+        addMsParam(&params, "*ratio", DOUBLE_MS_T, d, nullptr);
+
+        const auto with_double = rec::encode(rei);
+
+        const auto encoded = with_double.substr(with_double.find(':') + 1);
+        std::string binary(encoded.size(), '\0');
+        unsigned long size = binary.size();
+        REQUIRE(base64_decode(reinterpret_cast<const unsigned char*>(encoded.data()), encoded.size(),
+                              reinterpret_cast<unsigned char*>(binary.data()), &size) == 0);
+        binary.resize(size);
+
+        CHECK(binary.find(std::string{"\x00\x00\x00\x00\x00\x00\xf8\x3f", 8}) != std::string::npos);
+
+        auto decoded = rec::decode(with_double);
+        irods::at_scope_exit free_decoded{[&decoded] { freeRuleExecInfoInternals(&decoded, FREE_MS_PARAM); }};
+
+        REQUIRE(decoded.msParamArray->len == 4);
+        CHECK(*static_cast<double*>(decoded.msParamArray->msParam[3]->inOutStruct) == 1.5);
+    }
+
+    SECTION("binary context is smaller than the json context")
+    {
+        CHECK(context.size() < irods::to_json(&rei).dump().size());
+    }
+
+    SECTION("json contexts are still accepted")
+    {
+        const auto json_context = irods::to_json(&rei).dump();
+        REQUIRE_FALSE(rec::is_binary(json_context));
+
+        auto decoded = rec::decode(json_context);
+        irods::at_scope_exit free_decoded{[&decoded] { freeRuleExecInfoInternals(&decoded, FREE_MS_PARAM); }};
+
+        CHECK(std::string{decoded.ruleName} == rei.ruleName);
+        REQUIRE(decoded.msParamArray);
+        CHECK(decoded.msParamArray->len == 3);
+    }
+
+    SECTION("malformed contexts are rejected")
+    {
+        const auto truncated = context.substr(0, context.size() - 8);
+        const auto unsupported = std::string{rec::prefix} + std::to_string(rec::version + 1) + ':' +
+                                 context.substr(rec::prefix.size() + std::to_string(rec::version).size() + 1);
+
+        for (const auto& c : {truncated, unsupported}) {
+            try {
+                rec::decode(c);
+                FAIL("malformed context was decoded");
+            }
+            catch (const irods::exception& e) {
+                CHECK(e.code() == SYS_INVALID_INPUT_PARAM);
+            }
+        }
+    }
+}
@@ -0,0 +1,223 @@
+#include "catch.hpp"
+
+#include "server_connection_broker.hpp"
+#include "connection_health.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_network_factory.hpp"
+#include "irods_threads.hpp"
+#include "rcConnect.h"
+#include "sockCommNetworkInterface.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace scb = irods::experimental::server_connection_broker;
+
+namespace
+{
+    // Returns a logged in connection whose socket is one end of a socket pair. The
+    // other end plays the role of the peer server.
+    auto make_connection(int _sock, const char* _client_user) -> rcComm_t*
+    {
+        auto* conn = static_cast<rcComm_t*>(std::malloc(sizeof(rcComm_t)));
+        std::memset(conn, 0, sizeof(rcComm_t));
+
+        conn->thread_ctx = static_cast<thread_context*>(std::malloc(sizeof(thread_context)));
+        std::memset(conn->thread_ctx, 0, sizeof(thread_context));
+
+        conn->svrVersion = static_cast<version_t*>(std::malloc(sizeof(version_t)));
+        std::memset(conn->svrVersion, 0, sizeof(version_t));
+        std::strcpy(conn->svrVersion->relVersion, "rods4.2.9");
+        conn->svrVersion->status = irods::experimental::connection_health::heartbeat_supported;
+
+        conn->irodsProt = NATIVE_PROT;
+        conn->sock = _sock;
+        conn->portNum = 1247;
+        conn->loggedIn = 1;
+        std::strcpy(conn->host, "peer.example.org");
+        setUserInfo("rods", "tempZone", _client_user, "tempZone", &conn->clientUser, &conn->proxyUser);
+
+        return conn;
+    }
+
+    // Plays the peer agent: reads one message from _sock and answers it with a heartbeat,
+    // optionally preceded by the reply to an earlier request. Catch assertions are not
+    // thread-safe, so the result is checked by the caller.
+    auto answer_heartbeat(int _sock, bool _stale_reply_first = false) -> std::future<bool>
+    {
+        return std::async(std::launch::async, [_sock, _stale_reply_first] {
+            auto* peer = make_connection(_sock, "alice");
+            irods::at_scope_exit free_peer{[peer] { freeRcComm(peer); }};
+
+            irods::network_object_ptr net_obj;
+            if (!irods::network_factory(peer, net_obj).ok()) {
+                return false;
+            }
+
+            msgHeader_t header{};
+            timeval tv{5, 0};
+            if (!readMsgHeader(net_obj, &header, &tv).ok() || std::string{header.type} != RODS_HEARTBEAT_T) {
+                return false;
+            }
+
+            if (_stale_reply_first &&
+                !sendRodsMsg(net_obj, RODS_API_REPLY_T, nullptr, nullptr, nullptr, 0, NATIVE_PROT).ok())
+            {
+                return false;
+            }
+
+            return sendRodsMsg(net_obj, RODS_HEARTBEAT_T, nullptr, nullptr, nullptr, 60, NATIVE_PROT).ok();
+        });
+    }
+
+    auto make_user(const char* _name) -> userInfo_t
+    {
+        userInfo_t user{};
+        std::strcpy(user.userName, _name);
+        std::strcpy(user.rodsZone, "tempZone");
+        return user;
+    }
+} // anonymous namespace
+
+TEST_CASE("server_connection_broker")
+{
+    using namespace std::chrono_literals;
+
+    const auto socket_file = boost::filesystem::temp_directory_path() /
+                             boost::filesystem::unique_path("irods_broker_test_%%%%-%%%%");
+
+    scb::set_socket_file(socket_file.string());
+
+    const auto broker_pid = fork();
+    REQUIRE(broker_pid >= 0);
+
+    if (broker_pid == 0) {
+        std::_Exit(scb::run());
+    }
+
+    irods::at_scope_exit stop_broker{[broker_pid] {
+        kill(broker_pid, SIGTERM);
+        waitpid(broker_pid, nullptr, 0);
+    }};
+
+    for (int i = 0; i < 100 && !boost::filesystem::exists(socket_file); ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    REQUIRE(boost::filesystem::exists(socket_file));
+
+    const auto proxy = make_user("rods");
+    const auto alice = make_user("alice");
+    const auto bob = make_user("bob");
+
+    SECTION("released connections are leased to matching requests only")
+    {
+        REQUIRE_FALSE(scb::lease("peer.example.org", 1247, proxy, alice));
+
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        irods::at_scope_exit close_peer{[&fds] { close(fds[1]); }};
+
+        auto peer = answer_heartbeat(fds[1]);
+        REQUIRE(scb::release(make_connection(fds[0], "alice")));
+        CHECK(peer.get());
+
+        REQUIRE_FALSE(scb::lease("peer.example.org", 1247, proxy, bob));
+        REQUIRE_FALSE(scb::lease("peer.example.org", 1248, proxy, alice));
+        REQUIRE_FALSE(scb::lease("other.example.org", 1247, proxy, alice));
+
+        auto* conn = scb::lease("peer.example.org", 1247, proxy, alice);
+        REQUIRE(conn);
+        irods::at_scope_exit free_conn{[conn] {
+            close(conn->sock);
+            freeRcComm(conn);
+        }};
+
+        CHECK(conn->loggedIn == 1);
+        CHECK(conn->portNum == 1247);
+        CHECK(std::string{conn->clientUser.userName} == "alice");
+        CHECK(std::string{conn->proxyUser.userName} == "rods");
+        CHECK(std::string{conn->svrVersion->relVersion} == "rods4.2.9");
+
+        // The leased descriptor still talks to the same peer.
+        REQUIRE(write(fds[1], "x", 1) == 1);
+        char c{};
+        REQUIRE(read(conn->sock, &c, 1) == 1);
+        CHECK(c == 'x');
+
+        // A connection is leased at most once.
+        REQUIRE_FALSE(scb::lease("peer.example.org", 1247, proxy, alice));
+    }
+
+    SECTION("connections closed by the peer are discarded")
+    {
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+        auto peer = answer_heartbeat(fds[1]);
+        REQUIRE(scb::release(make_connection(fds[0], "alice")));
+        CHECK(peer.get());
+        close(fds[1]);
+
+        REQUIRE_FALSE(scb::lease("peer.example.org", 1247, proxy, alice));
+    }
+
+    SECTION("connections with pending data are not pooled")
+    {
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        irods::at_scope_exit close_peer{[&fds] { close(fds[1]); }};
+
+        REQUIRE(write(fds[1], "x", 1) == 1);
+
+        auto* conn = make_connection(fds[0], "alice");
+        REQUIRE_FALSE(scb::release(conn));
+
+        close(conn->sock);
+        freeRcComm(conn);
+    }
+
+    SECTION("connections with a reply in flight are not pooled")
+    {
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        irods::at_scope_exit close_peer{[&fds] { close(fds[1]); }};
+
+        // The receive buffer is empty when release() is called, but the peer still
+        // answers an earlier request before the heartbeat.
+        auto peer = answer_heartbeat(fds[1], true);
+        auto* conn = make_connection(fds[0], "alice");
+        REQUIRE_FALSE(scb::release(conn));
+        CHECK(peer.get());
+
+        close(conn->sock);
+        freeRcComm(conn);
+
+        REQUIRE_FALSE(scb::lease("peer.example.org", 1247, proxy, alice));
+    }
+
+    SECTION("connections to peers that do not answer heartbeats are not pooled")
+    {
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        irods::at_scope_exit close_peer{[&fds] { close(fds[1]); }};
+
+        auto* conn = make_connection(fds[0], "alice");
+        conn->svrVersion->status = 0;
+        REQUIRE_FALSE(scb::release(conn));
+
+        close(conn->sock);
+        freeRcComm(conn);
+    }
+}
@@ -0,0 +1,122 @@
+#include "catch.hpp"
+
+#include "special_collection_index.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <chrono>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace sci = irods::experimental::special_collection_index;
+
+using namespace std::chrono_literals;
+
+TEST_CASE("special_collection_index")
+{
+    SECTION("lookup before initialization consults the catalog")
+    {
+        REQUIRE_FALSE(sci::enabled());
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods", 60s));
+    }
+
+    sci::init("irods_special_collection_index_test", 100'000);
+    irods::at_scope_exit cleanup{[] { sci::deinit(); }};
+
+    REQUIRE(sci::enabled());
+
+    SECTION("index is stale until assigned")
+    {
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods", 60s));
+
+        REQUIRE(sci::assign({}, sci::generation()));
+        const auto result = sci::lookup("/tempZone/home/rods", 60s);
+        REQUIRE(result);
+        REQUIRE_FALSE(*result);
+    }
+
+    SECTION("paths inside special collections")
+    {
+        REQUIRE(sci::assign({"/tempZone/home/rods/mount", "/tempZone/home/rods/tar/bundle"}, sci::generation()));
+
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount", 60s).value());
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount/foo", 60s).value());
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount/foo/bar.txt", 60s).value());
+        REQUIRE(sci::lookup("/tempZone/home/rods/tar/bundle/x", 60s).value());
+
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods", 60s).value());
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/tar", 60s).value());
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mountain", 60s).value());
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/moun", 60s).value());
+        REQUIRE_FALSE(sci::lookup("/otherZone/home/rods/mount", 60s).value());
+    }
+
+    SECTION("invalidation and staleness")
+    {
+        REQUIRE(sci::assign({"/tempZone/home/rods/mount"}, sci::generation()));
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount", 60s));
+
+        sci::invalidate();
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", 60s));
+
+        REQUIRE(sci::assign({"/tempZone/home/rods/mount"}, sci::generation()));
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount", 60s));
+
+        // Once the index is older than the maximum age, the catalog must be consulted.
+        REQUIRE(sci::assign({"/tempZone/home/rods/mount"}, sci::generation()));
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", -1s));
+    }
+
+    SECTION("the index does not answer while a writer is active")
+    {
+        REQUIRE(sci::assign({}, sci::generation()));
+
+        {
+            sci::update_guard guard;
+
+            REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", 60s));
+
+            // A refresh that may not include the change is discarded.
+            REQUIRE_FALSE(sci::assign({}, sci::generation()));
+            REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", 60s));
+        }
+
+        REQUIRE(sci::assign({"/tempZone/home/rods/mount"}, sci::generation()));
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount", 60s).value());
+    }
+
+    SECTION("refreshes that overlap a change are discarded")
+    {
+        const auto generation = sci::generation();
+
+        // The change starts and ends while the catalog is being queried.
+        { sci::update_guard guard; }
+
+        REQUIRE_FALSE(sci::assign({}, generation));
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", 60s));
+
+        REQUIRE(sci::assign({"/tempZone/home/rods/mount"}, sci::generation()));
+        REQUIRE(sci::lookup("/tempZone/home/rods/mount", 60s).value());
+    }
+
+    SECTION("writers that exit without releasing the index are withdrawn")
+    {
+        const auto pid = fork();
+
+        if (0 == pid) {
+            // Skip the destructor, as a crashed agent would.
+            new sci::update_guard;
+            _exit(0);
+        }
+
+        REQUIRE(pid > 0);
+        REQUIRE(waitpid(pid, nullptr, 0) == pid);
+
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", 60s));
+
+        // The first refresh withdraws the writer but may have overlapped its transaction.
+        REQUIRE_FALSE(sci::assign({}, sci::generation()));
+        REQUIRE(sci::assign({}, sci::generation()));
+        REQUIRE_FALSE(sci::lookup("/tempZone/home/rods/mount", 60s).value());
+    }
+}
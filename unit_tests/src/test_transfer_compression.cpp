@@ -0,0 +1,179 @@
+#include "catch.hpp"
+
+#include "dataObjInpOut.h"
+#include "irods_exception.hpp"
+#include "transfer_compression.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace tc = irods::experimental::transfer_compression;
+
+namespace
+{
+    auto text_buffer(std::size_t _size) -> std::vector<unsigned char>
+    {
+        const std::string line = "2020-06-01T12:00:00Z sensor=17 temperature=21.5 humidity=0.43 status=ok\n";
+
+        std::vector<unsigned char> buffer;
+        buffer.reserve(_size);
+
+        while (buffer.size() < _size) {
+            buffer.push_back(static_cast<unsigned char>(line[buffer.size() % line.size()]));
+        }
+
+        return buffer;
+    }
+
+    auto random_buffer(std::size_t _size) -> std::vector<unsigned char>
+    {
+        std::mt19937 gen{42};
+        std::uniform_int_distribution<int> dist{0, 255};
+
+        std::vector<unsigned char> buffer(_size);
+
+        for (auto& c : buffer) {
+            c = static_cast<unsigned char>(dist(gen));
+        }
+
+        return buffer;
+    }
+} // anonymous namespace
+
+TEST_CASE("transfer_compression")
+{
+    std::vector<unsigned char> frame;
+    std::vector<unsigned char> raw;
+
+    SECTION("compressible buffers round trip through smaller frames")
+    {
+        const auto text = text_buffer(1 << 20);
+
+        tc::encoder encoder{tc::codec::deflate, 1};
+        const auto frame_size = encoder.encode(text.data(), text.size(), frame);
+
+        REQUIRE(frame_size == frame.size());
+        CHECK(frame.size() < text.size() / 3);
+
+        const auto header = tc::read_frame_header(frame.data());
+        CHECK(header.method == tc::codec::deflate);
+        CHECK(header.raw_size == text.size());
+        CHECK(header.payload_size + tc::frame_header_size == frame.size());
+
+        CHECK(tc::decode(frame.data(), frame.size(), raw) == text.size());
+        CHECK(raw == text);
+
+        CHECK(encoder.stats().frames == 1);
+        CHECK(encoder.stats().bypassed_frames == 0);
+        CHECK(encoder.stats().ratio() > 3.0);
+    }
+
+    SECTION("incompressible buffers are sent as is and later attempts are skipped")
+    {
+        const auto noise = random_buffer(1 << 16);
+        const auto text = text_buffer(1 << 16);
+
+        tc::encoder encoder{tc::codec::deflate, 1};
+
+        encoder.encode(noise.data(), noise.size(), frame);
+        CHECK(tc::read_frame_header(frame.data()).method == tc::codec::none);
+        CHECK(frame.size() == noise.size() + tc::frame_header_size);
+        CHECK(tc::decode(frame.data(), frame.size(), raw) == noise.size());
+        CHECK(raw == noise);
+
+        // The next buffer is not compressed, even though it could be.
+        encoder.encode(text.data(), text.size(), frame);
+        CHECK(tc::read_frame_header(frame.data()).method == tc::codec::none);
+
+        // Compression is attempted again afterwards.
+        encoder.encode(text.data(), text.size(), frame);
+        CHECK(tc::read_frame_header(frame.data()).method == tc::codec::deflate);
+
+        CHECK(encoder.stats().frames == 3);
+        CHECK(encoder.stats().bypassed_frames == 2);
+        CHECK(encoder.stats().raw_bytes == 3 * (1 << 16));
+    }
+
+    SECTION("the decoder keeps statistics of the frames it decodes")
+    {
+        const auto text = text_buffer(1 << 16);
+
+        tc::encoder encoder{tc::codec::deflate, 9};
+        tc::decoder decoder;
+
+        for (int i = 0; i < 4; ++i) {
+            encoder.encode(text.data(), text.size(), frame);
+            decoder.decode(frame.data(), frame.size(), raw);
+            CHECK(raw == text);
+        }
+
+        CHECK(decoder.stats().frames == encoder.stats().frames);
+        CHECK(decoder.stats().raw_bytes == encoder.stats().raw_bytes);
+        CHECK(decoder.stats().wire_bytes == encoder.stats().wire_bytes);
+
+        auto total = encoder.stats();
+        total += decoder.stats();
+        CHECK(total.frames == 8);
+    }
+
+    SECTION("malformed frames are rejected")
+    {
+        const auto text = text_buffer(4096);
+
+        tc::encoder encoder{tc::codec::deflate, 1};
+        encoder.encode(text.data(), text.size(), frame);
+
+        // Truncated.
+        CHECK_THROWS_AS(tc::decode(frame.data(), frame.size() - 1, raw), irods::exception);
+        CHECK_THROWS_AS(tc::decode(frame.data(), tc::frame_header_size - 1, raw), irods::exception);
+
+        // Unknown codec.
+        auto unknown = frame;
+        unknown[0] = 0x7f;
+        CHECK_THROWS_AS(tc::decode(unknown.data(), unknown.size(), raw), irods::exception);
+
+        // Corrupted payload.
+        auto corrupted = frame;
+        for (auto i = tc::frame_header_size; i < corrupted.size(); ++i) {
+            corrupted[i] ^= 0x5a;
+        }
+        CHECK_THROWS_AS(tc::decode(corrupted.data(), corrupted.size(), raw), irods::exception);
+
+        // A raw size smaller than the payload.
+        auto inconsistent = frame;
+        inconsistent[4] = inconsistent[5] = inconsistent[6] = 0;
+        inconsistent[7] = 1;
+        CHECK_THROWS_AS(tc::read_frame_header(inconsistent.data()), irods::exception);
+    }
+
+    SECTION("the server only chooses a codec the client offered")
+    {
+        CHECK(tc::negotiate(tc::supported_codecs(), tc::codec::deflate) == tc::codec::deflate);
+        CHECK(tc::negotiate("zstd,deflate", tc::codec::deflate) == tc::codec::deflate);
+        CHECK(tc::negotiate("zstd", tc::codec::deflate) == tc::codec::none);
+        CHECK(tc::negotiate("", tc::codec::deflate) == tc::codec::none);
+        CHECK(tc::negotiate("deflatex", tc::codec::deflate) == tc::codec::none);
+        CHECK(tc::negotiate("deflate", tc::codec::none) == tc::codec::none);
+
+        CHECK(tc::to_codec("deflate") == tc::codec::deflate);
+        CHECK(tc::to_codec("none") == tc::codec::none);
+        CHECK_FALSE(tc::to_codec("lz4"));
+        CHECK(tc::to_string(tc::codec::deflate) == "deflate");
+    }
+
+    SECTION("transfer header flags carry the codec and the level")
+    {
+        const auto flags = STREAMING_FLAG | tc::to_flags(tc::codec::deflate, 6);
+
+        CHECK((flags & STREAMING_FLAG) != 0);
+        CHECK((flags & TRANSFER_COMPRESSION_FLAG) != 0);
+        CHECK(tc::codec_from_flags(flags) == tc::codec::deflate);
+        CHECK(tc::level_from_flags(flags) == 6);
+
+        CHECK(tc::to_flags(tc::codec::none, 6) == 0);
+        CHECK(tc::codec_from_flags(STREAMING_FLAG) == tc::codec::none);
+        CHECK(tc::level_from_flags(tc::to_flags(tc::codec::deflate, 42)) == tc::maximum_level);
+    }
+}
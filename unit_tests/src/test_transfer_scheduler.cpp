@@ -0,0 +1,171 @@
+#include "catch.hpp"
+
+#include "transfer_scheduler.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace tsch = irods::experimental::transfer_scheduler;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    auto statistics_of(const std::string& _user) -> tsch::user_statistics
+    {
+        const auto stats = tsch::statistics();
+        const auto iter = std::find_if(std::begin(stats), std::end(stats), [&_user](const auto& _s) {
+            return _s.user == _user;
+        });
+
+        REQUIRE(iter != std::end(stats));
+
+        return *iter;
+    }
+} // anonymous namespace
+
+TEST_CASE("transfer_scheduler")
+{
+    SECTION("requests are granted before initialization")
+    {
+        REQUIRE(tsch::acquire("rods#tempZone", 16) == 16);
+        REQUIRE(tsch::throttle("rods#tempZone", 1024 * 1024) == 0ns);
+        REQUIRE(tsch::statistics().empty());
+    }
+
+    tsch::config cfg;
+    cfg.maximum_number_of_streams = 8;
+    cfg.maximum_number_of_streams_per_user = 4;
+    cfg.maximum_bytes_per_second_per_user = 1024 * 1024;
+
+    tsch::init("irods_transfer_scheduler_test", 100'000, cfg);
+    irods::at_scope_exit cleanup{[] { tsch::deinit(); }};
+
+    SECTION("streams are capped per user")
+    {
+        REQUIRE(tsch::acquire("rods#tempZone", 16) == 4);
+
+        const auto stats = statistics_of("rods#tempZone");
+        REQUIRE(stats.active_streams == 4);
+        REQUIRE(stats.denied_streams == 12);
+
+        tsch::release();
+        REQUIRE(statistics_of("rods#tempZone").active_streams == 0);
+    }
+
+    SECTION("at least one stream is always granted")
+    {
+        REQUIRE(tsch::acquire("rods#tempZone", 1) == 1);
+        REQUIRE(tsch::acquire("rods#tempZone", 0) == 1);
+        tsch::release();
+    }
+
+    SECTION("registering again replaces the previous registration")
+    {
+        REQUIRE(tsch::acquire("rods#tempZone", 3) == 3);
+        REQUIRE(tsch::acquire("alice#tempZone", 4) == 4);
+
+        REQUIRE(statistics_of("rods#tempZone").active_streams == 0);
+        REQUIRE(statistics_of("alice#tempZone").active_streams == 4);
+
+        tsch::release();
+        REQUIRE(statistics_of("alice#tempZone").active_streams == 0);
+    }
+
+    SECTION("streams exceeding the rate are delayed")
+    {
+        REQUIRE(tsch::acquire("rods#tempZone", 2) == 2);
+
+        // The bucket starts empty, so one second worth of bytes must wait about one second.
+        const auto delay = tsch::throttle("rods#tempZone", 1024 * 1024);
+        REQUIRE(delay > 900ms);
+        REQUIRE(delay <= 1s);
+
+        const auto stats = statistics_of("rods#tempZone");
+        REQUIRE(stats.bytes_transferred == 1024 * 1024);
+        REQUIRE(stats.time_throttled == delay);
+
+        tsch::release();
+    }
+
+    SECTION("streams are not delayed once the shared memory is exhausted")
+    {
+        // Far more users than the segment can hold.
+        for (int i = 0; i < 10'000; ++i) {
+            const auto user = "user_" + std::to_string(i) + "#tempZone";
+            REQUIRE_NOTHROW(tsch::throttle(user, 1));
+        }
+
+        REQUIRE(tsch::acquire("rods#tempZone", 2) == 2);
+        REQUIRE(statistics_of("rods#tempZone").active_streams == 2);
+        tsch::release();
+    }
+}
+
+TEST_CASE("transfer_scheduler weights")
+{
+    tsch::config cfg;
+    cfg.maximum_bytes_per_second = 4 * 1024 * 1024;
+    cfg.user_weights = {{"rods#tempZone", 3}};
+
+    tsch::init("irods_transfer_scheduler_test", 100'000, cfg);
+    irods::at_scope_exit cleanup{[] { tsch::deinit(); }};
+
+    // alice has open streams. rods moving bytes takes a share as well, so the bandwidth is
+    // split 3:1 between rods and alice. The bucket starts empty: 3 MiB at 3 MiB/s wait about
+    // one second.
+    REQUIRE(tsch::acquire("alice#tempZone", 2) == 2);
+
+    const auto rods_delay = tsch::throttle("rods#tempZone", 3 * 1024 * 1024);
+    REQUIRE(rods_delay > 900ms);
+    REQUIRE(rods_delay <= 1s);
+
+    // rods has no open streams, so alice alone shares the bandwidth: 4 MiB at 4 MiB/s.
+    const auto alice_delay = tsch::throttle("alice#tempZone", 4 * 1024 * 1024);
+    REQUIRE(alice_delay > 900ms);
+    REQUIRE(alice_delay <= 1s);
+
+    tsch::release();
+}
+
+TEST_CASE("transfer_scheduler weights follow open streams")
+{
+    tsch::config cfg;
+    cfg.maximum_bytes_per_second = 4 * 1024 * 1024;
+    cfg.user_weights = {{"rods#tempZone", 3}};
+
+    tsch::init("irods_transfer_scheduler_test", 100'000, cfg);
+    irods::at_scope_exit cleanup{[] { tsch::deinit(); }};
+
+    // alice registers and releases her streams. Her weight must not remain in the shares,
+    // so rods alone gets the whole bandwidth: 4 MiB at 4 MiB/s wait about one second.
+    REQUIRE(tsch::acquire("alice#tempZone", 2) == 2);
+    tsch::release();
+
+    REQUIRE(tsch::acquire("rods#tempZone", 2) == 2);
+
+    const auto delay = tsch::throttle("rods#tempZone", 4 * 1024 * 1024);
+    REQUIRE(delay > 900ms);
+    REQUIRE(delay <= 1s);
+
+    tsch::release();
+}
+
+TEST_CASE("transfer_scheduler without bandwidth limits")
+{
+    tsch::config cfg;
+    cfg.maximum_number_of_streams_per_user = 4;
+
+    tsch::init("irods_transfer_scheduler_test", 100'000, cfg);
+    irods::at_scope_exit cleanup{[] { tsch::deinit(); }};
+
+    REQUIRE(tsch::acquire("rods#tempZone", 16) == 4);
+
+    // Bytes are neither delayed nor accounted for.
+    REQUIRE(tsch::throttle("rods#tempZone", 1024 * 1024 * 1024) == 0ns);
+    REQUIRE(statistics_of("rods#tempZone").bytes_transferred == 0);
+
+    tsch::release();
+}